@@ -882,7 +882,7 @@ bool DefaultContentManager::loadArmyData()
 	return true;
 }
 
-void DefaultContentManager::loadStringRes(const ST::string& name, std::vector<const ST::string*> &strings) const
+ST::string DefaultContentManager::getStringResPath(const ST::string& name) const
 {
 	ST::string fullName(name);
 
@@ -904,7 +904,12 @@ void DefaultContentManager::loadStringRes(const ST::string& name, std::vector<co
 	}
 
 	fullName += ".json";
-	auto json = readJsonDataFileWithSchema(fullName.c_str());
+	return fullName;
+}
+
+void DefaultContentManager::loadStringRes(const ST::string& name, std::vector<const ST::string*> &strings) const
+{
+	auto json = readJsonDataFileWithSchema(getStringResPath(name));
 	std::vector<ST::string> utf8_encoded;
 	JsonUtility::parseListStrings(*json, utf8_encoded);
 	for (const ST::string &str : utf8_encoded)
@@ -913,8 +918,102 @@ void DefaultContentManager::loadStringRes(const ST::string& name, std::vector<co
 	}
 }
 
-/** Load the game data. */
+/** Json files that can be read and validated without knowing about any other data. */
+static const char* const INDEPENDENT_JSON_FILES[] = {
+	"items.json",
+	"calibres.json",
+	"ammo-types.json",
+	"magazines.json",
+	"weapons.json",
+	"army-gun-choice-normal.json",
+	"army-gun-choice-extended.json",
+	"army-compositions.json",
+	"army-garrison-groups.json",
+	"army-patrol-groups.json",
+	"music.json",
+	"tactical-map-item-replacements.json",
+	"mercs-profile-info.json",
+	"mercs-rpc-small-faces.json",
+	"mercs-MERC-listings.json",
+	"dealers.json",
+	"bobby-ray-inventory-new.json",
+	"bobby-ray-inventory-used.json",
+	"game.json",
+	"imp.json",
+	"strategic-ai-policy.json",
+	"shipping-destinations.json",
+	"loading-screens.json",
+	"loading-screens-mapping.json",
+	"strategic-bloodcat-placements.json",
+	"strategic-bloodcat-spawns.json",
+	"strategic-map-creature-lairs.json",
+	"strategic-fact-params.json",
+	"strategic-mines.json",
+	"strategic-map-sam-sites.json",
+	"strategic-map-sam-sites-air-control.json",
+	"strategic-map-towns.json",
+	"strategic-map-underground-sectors.json",
+	"strategic-map-traversibility-ratings.json",
+	"strategic-map-movement-costs.json",
+	"strategic-map-sectors-descriptions.json",
+	"strategic-map-secrets.json",
+	"strategic-map-npc-placements.json",
+	"strategic-map-cache-sectors.json",
+	"tactical-npc-action-params.json",
+	"vehicles.json",
+};
+
+/** String resources read by loadGameData(), without language suffix. */
+static const char* const STRING_RES_FILES[] = {
+	"strings/shipping-destinations",
+	"strings/ammo-calibre",
+	"strings/ammo-calibre-bobbyray",
+	"strings/new-strings",
+	"strings/strategic-map-land-types",
+	"strings/strategic-map-town-names",
+	"strings/strategic-map-town-name-locatives",
+};
+
+/** Load the game data.
+ *
+ * Reading, parsing and validating the json files is independent per file, so
+ * all of them are queued on a thread pool up front. The models are then built
+ * and linked to each other (magazines to calibres, weapons to ammo, ...) on
+ * this thread in a fixed order, which consumes the parsed documents as they
+ * become ready. Because of the fixed order the first error reported is always
+ * the same, no matter which worker finished first. */
 bool DefaultContentManager::loadGameData()
+{
+	std::vector<ST::string> jsonPaths;
+	for (const char* path : INDEPENDENT_JSON_FILES)
+	{
+		jsonPaths.push_back(path);
+	}
+	for (const char* name : STRING_RES_FILES)
+	{
+		jsonPaths.push_back(getStringResPath(name));
+	}
+	jsonPaths.push_back(getTranslationTablePath());
+
+	m_loaderPool = std::make_unique<ThreadPool>();
+	prefetchJsonDataFiles(jsonPaths);
+
+	bool result;
+	try
+	{
+		result = linkGameData();
+	}
+	catch (...)
+	{
+		discardPrefetchedJson();
+		throw;
+	}
+	discardPrefetchedJson();
+
+	return result;
+}
+
+bool DefaultContentManager::linkGameData()
 {
 	m_items.resize(MAXITEMS);
 	bool result = loadItems()
@@ -1022,7 +1121,41 @@ ST::string typeToString(rapidjson::Type t) {
 	}
 }
 
+void DefaultContentManager::prefetchJsonDataFiles(const std::vector<ST::string>& jsonPaths)
+{
+	if (!m_loaderPool) return;
+
+	for (const ST::string& jsonPath : jsonPaths)
+	{
+		if (m_prefetchedJson.find(jsonPath) != m_prefetchedJson.end()) continue;
+
+		m_prefetchedJson.emplace(jsonPath, m_loaderPool->enqueue([this, jsonPath]() {
+			return parseJsonDataFileWithSchema(jsonPath);
+		}));
+	}
+}
+
+void DefaultContentManager::discardPrefetchedJson()
+{
+	// joins the workers, so no task is left referencing this object
+	m_loaderPool.reset();
+	m_prefetchedJson.clear();
+}
+
 std::unique_ptr<rapidjson::Document> DefaultContentManager::readJsonDataFileWithSchema(const ST::string& jsonPath) const
+{
+	auto it = m_prefetchedJson.find(jsonPath);
+	if (it == m_prefetchedJson.end())
+	{
+		return parseJsonDataFileWithSchema(jsonPath);
+	}
+
+	auto pending = std::move(it->second);
+	m_prefetchedJson.erase(it);
+	return pending.get();
+}
+
+std::unique_ptr<rapidjson::Document> DefaultContentManager::parseJsonDataFileWithSchema(const ST::string& jsonPath) const
 {
 	auto schemaString = RustPointer<char>(SchemaManager_getSchemaForPath(m_schemaManager.get(), jsonPath.c_str()));
 	if (schemaString.get() == NULL) {
@@ -1151,6 +1284,13 @@ bool DefaultContentManager::loadAllDealersAndInventory()
 	}
 	DealerModel::validateData(m_dealers, this);
 
+	std::vector<ST::string> inventoryPaths;
+	for (auto dealer : m_dealers)
+	{
+		inventoryPaths.push_back(dealer->getInventoryDataFileName(this));
+	}
+	prefetchJsonDataFiles(inventoryPaths);
+
 	m_dealersInventory = std::vector<const DealerInventory*>(m_dealers.size());
 	for (auto dealer : m_dealers)
 	{
@@ -1424,9 +1564,8 @@ void DefaultContentManager::loadVehicles()
 	VehicleModel::validateData(m_vehicles);
 }
 
-void DefaultContentManager::loadTranslationTable()
+ST::string DefaultContentManager::getTranslationTablePath() const
 {
-	m_translationTable.clear();
 	ST::string name = "translation_tables/translation-table";
 	ST::string suffix;
 	switch (m_gameVersion)
@@ -1451,7 +1590,13 @@ void DefaultContentManager::loadTranslationTable()
 		break;
 	}
 
-	auto fullName = ST::format("{}-{}.json", name, suffix);
+	return ST::format("{}-{}.json", name, suffix);
+}
+
+void DefaultContentManager::loadTranslationTable()
+{
+	m_translationTable.clear();
+	auto fullName = getTranslationTablePath();
 
 	auto json = readJsonDataFileWithSchema(fullName);
 	int count = 0;
@@ -9,8 +9,10 @@
 #include "RustInterface.h"
 
 #include "rapidjson/document.h"
+#include "sgp/ThreadPool.h"
 #include <string_theory/string>
 
+#include <future>
 #include <map>
 #include <memory>
 #include <stdexcept>
@@ -246,6 +248,12 @@ protected:
 
 	RustPointer<Vfs> m_vfs;
 
+	/** Workers parsing json files while loadGameData() runs, null otherwise. */
+	std::unique_ptr<ThreadPool> m_loaderPool;
+	/** Json documents queued on m_loaderPool that have not been consumed yet. Only accessed from the loading thread. */
+	mutable std::map<ST::string, std::future<std::unique_ptr<rapidjson::Document>>> m_prefetchedJson;
+
+	bool linkGameData();
 	bool loadWeapons();
 	bool loadItems();
 	bool loadMagazines();
@@ -257,6 +265,7 @@ protected:
 
 	const DealerInventory * loadDealerInventory(const ST::string& fileName);
 	bool loadAllDealersAndInventory();
+	ST::string getStringResPath(const ST::string& name) const;
 	void loadStringRes(const ST::string& name, std::vector<const ST::string*> &strings) const;
 
 	bool readWeaponTable(
@@ -267,10 +276,18 @@ protected:
 	bool loadTacticalLayerData();
 	bool loadMercsData();
 	void loadVehicles();
+	ST::string getTranslationTablePath() const;
 	void loadTranslationTable();
 
+	/** Queue json files to be read and validated on m_loaderPool. Does nothing if no pool is running. */
+	void prefetchJsonDataFiles(const std::vector<ST::string>& jsonPaths);
+	/** Wait for the loader pool to stop and drop all unconsumed documents. */
+	void discardPrefetchedJson();
+
 	std::unique_ptr<rapidjson::Document> readJsonFromString(const ST::string& jsonData, const ST::string& label) const;
+	/** Take the prefetched document if one was queued, otherwise read it now. */
 	std::unique_ptr<rapidjson::Document> readJsonDataFileWithSchema(const ST::string& jsonPath) const;
+	std::unique_ptr<rapidjson::Document> parseJsonDataFileWithSchema(const ST::string& jsonPath) const;
 
 	/**
 	 * @param profileID
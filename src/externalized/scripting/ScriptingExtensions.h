@@ -1,5 +1,9 @@
 #pragma once
 
+#include <stdint.h>
+#include <string_theory/string>
+#include <vector>
+
 /*! \mainpage Scripting in JA2 Stracciatella
  *
  * # Extending mods by Lua scripting
@@ -34,6 +38,21 @@
  * log.warn("Log at WARN level")
  * log.error("Log at ERROR level")
  * ```
+ *
+ * ## Batched listeners
+ *
+ * Observables that fire many times in a row, like OnStructureDamaged during an explosion,
+ * can be received once per frame as an array:
+ *
+ * ```lua
+ * RegisterBatchedListener("OnStructureDamaged", "HandleStructuresDamaged")
+ *
+ * function HandleStructuresDamaged(events)
+ *     for _, e in ipairs(events) do
+ *         log.debug("structure damaged at " .. e.sGridNo)
+ *     end
+ * end
+ * ```
  */
 
 /**
@@ -41,3 +60,20 @@
  * started or loaded, because there might be states in the lua space.
  */
 void InitScriptingEngine();
+
+/**
+ * Delivers the events queued for batched listeners and closes the per-frame
+ * timing of all listeners. Called once at the end of every frame.
+ */
+void HandleScriptingFrameEnd();
+
+/** Time spent in a Lua listener since the scripting engine was initialized */
+struct ScriptingHookStats
+{
+	ST::string observable;
+	ST::string function;
+	uint32_t calls;
+	uint64_t totalMicroseconds;
+};
+
+std::vector<ScriptingHookStats> GetScriptingHookStats();
@@ -19,9 +19,12 @@
 #include "Quests.h"
 #include "StrategicMap.h"
 #include "Structure.h"
+#include <chrono>
+#include <memory>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include <string_theory/format>
 #include <string_theory/string>
 
@@ -44,11 +47,71 @@ static sol::state lua;
 // an increment counter used to generate unique keys for listeners
 static unsigned int counter;
 
+// frames where Lua listeners take longer than this are logged at debug level
+#define SLOW_FRAME_MICROSECONDS 2000
+
+/**
+ * A Lua function registered as listener with an Observable.
+ * The function is looked up once after the entry point has run and then
+ * called through the cached handle, as long as the global of that name
+ * still holds it.
+ */
+struct LuaListener
+{
+	ST::string observable;
+	ST::string functionName;
+	sol::protected_function function;
+
+	// for batched listeners, hands the events queued during the frame to Lua
+	std::function<void()> deliverBatch;
+
+	UINT32 calls = 0;
+	UINT64 totalMicroseconds = 0;
+	UINT64 frameMicroseconds = 0;
+};
+
+// the only owner of the listeners, Observables hold weak references
+static std::vector<std::shared_ptr<LuaListener>> luaListeners;
+
+/**
+ * Value copy of the OnStructureDamaged arguments, as the structure itself
+ * might be gone when batched events are delivered.
+ */
+struct StructureDamagedEvent
+{
+	StructureDamagedEvent(INT16 sectorX, INT16 sectorY, INT8 sectorZ, INT16 gridNo, STRUCTURE* structure, UINT8 damage, BOOLEAN destroyed) :
+		sSectorX(sectorX), sSectorY(sectorY), bSectorZ(sectorZ), sGridNo(gridNo),
+		uiFlags(structure ? structure->fFlags : 0), ubDamage(damage), fDestroyed(destroyed) {}
+
+	INT16 sSectorX;
+	INT16 sSectorY;
+	INT8 bSectorZ;
+	INT16 sGridNo;
+	UINT32 uiFlags;
+	UINT8 ubDamage;
+	BOOLEAN fDestroyed;
+};
+
+/**
+ * Identifies a soldier for a batched OnSoldierCreated, as the soldier might
+ * have been removed, or its slot reused, when the batch is delivered.
+ */
+struct SoldierCreatedEvent
+{
+	SoldierCreatedEvent(SOLDIERTYPE* s) :
+		ubID(s->ubID), uiUniqueSoldierIdValue(s->uiUniqueSoldierIdValue) {}
+
+	UINT8 ubID;
+	UINT32 uiUniqueSoldierIdValue;
+};
+
 static void RegisterUserTypes();
 static void RegisterGlobals();
 static void RegisterLogger();
 static void RegisterListener(std::string observable, std::string luaFunctionName);
+static void RegisterBatchedListener(std::string observable, std::string luaFunctionName);
 static void UnregisterListener(std::string observable, std::string key);
+static void ResolveListeners();
 
 int StracciatellaLoadFileRequire(lua_State* L)
 {
@@ -92,6 +155,9 @@ void InitScriptingEngine()
 	isLuaDisabled = false;
 	counter = 0;
 
+	// cached handles refer to the old state and must be released before it is replaced
+	luaListeners.clear();
+
 	if (!GCM->doesGameResExists(SCRIPTS_DIR "/" ENTRYPOINT_SCRIPT))
 	{
 		return;
@@ -118,6 +184,7 @@ void InitScriptingEngine()
 		RegisterLogger();
 
 		RunEntryPoint();
+		ResolveListeners();
 
 		isLuaInitialized = true;
 	} 
@@ -219,6 +286,16 @@ static void RegisterUserTypes()
 		"ubBattleSoundID", &SOLDIERTYPE::ubBattleSoundID
 		);
 
+	lua.new_usertype<StructureDamagedEvent>("StructureDamagedEvent",
+		"sSectorX", &StructureDamagedEvent::sSectorX,
+		"sSectorY", &StructureDamagedEvent::sSectorY,
+		"bSectorZ", &StructureDamagedEvent::bSectorZ,
+		"sGridNo", &StructureDamagedEvent::sGridNo,
+		"uiFlags", &StructureDamagedEvent::uiFlags,
+		"ubDamage", &StructureDamagedEvent::ubDamage,
+		"fDestroyed", &StructureDamagedEvent::fDestroyed
+		);
+
 	lua.new_usertype<BOOLEAN_S>("BOOLEAN_S",
 		"val", &BOOLEAN_S::val
 		);
@@ -250,6 +327,7 @@ static void RegisterGlobals()
 
 	lua.set_function("___noop", []() {});
 	lua.set_function("RegisterListener", RegisterListener);
+	lua.set_function("RegisterBatchedListener", RegisterBatchedListener);
 	lua.set_function("UnregisterListener", UnregisterListener);
 }
 
@@ -274,11 +352,54 @@ static void RegisterLogger()
 	lua.set_function("print", [](std::string msg) { LogLuaMessage(LogLevel::Info, msg); });
 }
 
+static void DisableOnError(const sol::protected_function_result& result)
+{
+	if (!result.valid())
+	{
+		sol::error err = result;
+		SLOGE("Lua script had an error. Scripting engine is now DISABLED. The error was:");
+		SLOGE(err.what());
+		isLuaDisabled = true;
+	}
+}
+
+/**
+ * Looks up the function of a listener, unless the cached handle still is what
+ * the global of that name holds. Scripts may redefine the global at any time,
+ * comparing it is cheaper than a new handle.
+ */
+static bool ResolveListener(LuaListener& listener)
+{
+	if (listener.function.valid())
+	{
+		lua_State* L = lua.lua_state();
+		lua_getglobal(L, listener.functionName.c_str());
+		listener.function.push();
+		bool current = lua_rawequal(L, -1, -2);
+		lua_pop(L, 2);
+		if (current) return true;
+	}
+	listener.function = lua[listener.functionName.to_std_string()];
+	return listener.function.valid();
+}
+
+/**
+ * Binds all listeners registered by the entry point to their functions.
+ * Functions that are not defined yet are looked up again on first call.
+ */
+static void ResolveListeners()
+{
+	for (auto& listener : luaListeners)
+	{
+		ResolveListener(*listener);
+	}
+}
+
 /**
- * Invokes a Lua function by name
+ * Invokes the Lua function of a listener and records the time spent in it
  */
 template<typename ...A>
-static void InvokeFunction(ST::string functionName, A... args)
+static void InvokeListener(LuaListener& listener, A&&... args)
 {
 	if (isLuaDisabled)
 	{
@@ -286,31 +407,91 @@ static void InvokeFunction(ST::string functionName, A... args)
 		return;
 	}
 
-	sol::protected_function func = lua[functionName.to_std_string()];
-	if (!func.valid())
+	if (!ResolveListener(listener))
 	{
 		SLOGE("Lua script had an error. Scripting engine is now DISABLED. The error was:");
-		STLOGE("Function {} is not defined", functionName);
+		STLOGE("Function {} is not defined", listener.functionName);
 		isLuaDisabled = true;
 		return;
 	}
-	
-	auto result = func.call(args...);
-	if (!result.valid())
-	{
-		sol::error err = result;
-		SLOGE("Lua script had an error. Scripting engine is now DISABLED. The error was:");
-		SLOGE(err.what());
-		isLuaDisabled = true;
-	}
+
+	auto start = std::chrono::steady_clock::now();
+	auto result = listener.function.call(std::forward<A>(args)...);
+	UINT64 elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+	listener.calls++;
+	listener.totalMicroseconds += elapsed;
+	listener.frameMicroseconds += elapsed;
+
+	DisableOnError(result);
+}
+
+static std::shared_ptr<LuaListener> CreateListener(const std::string& observable, const std::string& luaFunc)
+{
+	auto listener = std::make_shared<LuaListener>();
+	listener->observable = ST::string(observable);
+	listener->functionName = ST::string(luaFunc);
+	luaListeners.push_back(listener);
+	return listener;
 }
 
 // Creates a typed std::function out of a Lua function
 template<typename ...A>
-static std::function<void(A...)> wrap(std::string luaFunc)
+static std::function<void(A...)> wrap(const std::string& observable, const std::string& luaFunc)
+{
+	std::weak_ptr<LuaListener> weak = CreateListener(observable, luaFunc);
+	return [weak](A... args) {
+		if (auto listener = weak.lock())
+		{
+			InvokeListener(*listener, args...);
+		}
+	};
+}
+
+// Turns the queued events into what the Lua function receives
+static std::vector<StructureDamagedEvent> ResolveBatch(std::vector<StructureDamagedEvent>& events)
+{
+	return std::move(events);
+}
+
+// Leaves out the soldiers which are gone by now
+static std::vector<SOLDIERTYPE*> ResolveBatch(std::vector<SoldierCreatedEvent> const& events)
+{
+	std::vector<SOLDIERTYPE*> soldiers;
+	for (SoldierCreatedEvent const& e : events)
+	{
+		SOLDIERTYPE& s = GetMan(e.ubID);
+		if (s.bActive && s.uiUniqueSoldierIdValue == e.uiUniqueSoldierIdValue)
+		{
+			soldiers.push_back(&s);
+		}
+	}
+	return soldiers;
+}
+
+// Creates a typed std::function that queues events of type E, to be passed to the Lua function as one array per frame
+template<typename E, typename ...A>
+static std::function<void(A...)> wrapBatched(const std::string& observable, const std::string& luaFunc)
 {
-	return [luaFunc](A... args) {
-		InvokeFunction(luaFunc, args...);
+	auto listener = CreateListener(observable, luaFunc);
+	auto queue = std::make_shared<std::vector<E>>();
+	LuaListener* l = listener.get();
+	listener->deliverBatch = [l, queue]() {
+		if (queue->empty()) return;
+
+		std::vector<E> events;
+		events.swap(*queue);
+		auto batch = ResolveBatch(events);
+		if (batch.empty()) return;
+		InvokeListener(*l, sol::as_table(batch));
+	};
+
+	std::weak_ptr<LuaListener> weak = listener;
+	return [weak, queue](A... args) {
+		if (!weak.expired())
+		{
+			queue->emplace_back(args...);
+		}
 	};
 }
 
@@ -321,19 +502,70 @@ static void _RegisterListener(std::string observable, std::string luaFunc, ST::s
 		throw std::runtime_error("RegisterListener is not allowed after initialization");
 	}
 
-	if      (observable == "OnStructureDamaged")         OnStructureDamaged.addListener(key, wrap<INT16, INT16, INT8, INT16, STRUCTURE*, UINT8, BOOLEAN>(luaFunc));
-	else if (observable == "BeforeStructureDamaged")     BeforeStructureDamaged.addListener(key, wrap<INT16, INT16, INT8, INT16, STRUCTURE*, UINT32, BOOLEAN_S*>(luaFunc));
-	else if (observable == "OnAirspaceControlUpdated")   OnAirspaceControlUpdated.addListener(key, wrap<>(luaFunc));
-	else if (observable == "BeforePrepareSector")        BeforePrepareSector.addListener(key, wrap<>(luaFunc));
-	else if (observable == "OnSoldierCreated")           OnSoldierCreated.addListener(key, wrap<SOLDIERTYPE*>(luaFunc));
-	else if (observable == "BeforeGameSaved")            BeforeGameSaved.addListener(key, wrap<>(luaFunc));
-	else if (observable == "OnGameLoaded")               OnGameLoaded.addListener(key, wrap<>(luaFunc));
+	if      (observable == "OnStructureDamaged")         OnStructureDamaged.addListener(key, wrap<INT16, INT16, INT8, INT16, STRUCTURE*, UINT8, BOOLEAN>(observable, luaFunc));
+	else if (observable == "BeforeStructureDamaged")     BeforeStructureDamaged.addListener(key, wrap<INT16, INT16, INT8, INT16, STRUCTURE*, UINT32, BOOLEAN_S*>(observable, luaFunc));
+	else if (observable == "OnAirspaceControlUpdated")   OnAirspaceControlUpdated.addListener(key, wrap<>(observable, luaFunc));
+	else if (observable == "BeforePrepareSector")        BeforePrepareSector.addListener(key, wrap<>(observable, luaFunc));
+	else if (observable == "OnSoldierCreated")           OnSoldierCreated.addListener(key, wrap<SOLDIERTYPE*>(observable, luaFunc));
+	else if (observable == "BeforeGameSaved")            BeforeGameSaved.addListener(key, wrap<>(observable, luaFunc));
+	else if (observable == "OnGameLoaded")               OnGameLoaded.addListener(key, wrap<>(observable, luaFunc));
 	else {
 		ST::string err = ST::format("There is no observable named '{}'", observable);
 		throw std::logic_error(err.to_std_string());
 	}
 }
 
+static void _RegisterBatchedListener(std::string observable, std::string luaFunc, ST::string key)
+{
+	if (isLuaInitialized)
+	{
+		throw std::runtime_error("RegisterBatchedListener is not allowed after initialization");
+	}
+
+	if      (observable == "OnStructureDamaged")         OnStructureDamaged.addListener(key, wrapBatched<StructureDamagedEvent, INT16, INT16, INT8, INT16, STRUCTURE*, UINT8, BOOLEAN>(observable, luaFunc));
+	else if (observable == "OnSoldierCreated")           OnSoldierCreated.addListener(key, wrapBatched<SoldierCreatedEvent, SOLDIERTYPE*>(observable, luaFunc));
+	else {
+		ST::string err = ST::format("Observable '{}' does not support batched listeners", observable);
+		throw std::logic_error(err.to_std_string());
+	}
+}
+
+void HandleScriptingFrameEnd()
+{
+	if (!isLuaInitialized) return;
+
+	UINT64 frameMicroseconds = 0;
+	for (auto& listener : luaListeners)
+	{
+		if (listener->deliverBatch && !isLuaDisabled)
+		{
+			listener->deliverBatch();
+		}
+		frameMicroseconds += listener->frameMicroseconds;
+		listener->frameMicroseconds = 0;
+	}
+
+	if (frameMicroseconds > SLOW_FRAME_MICROSECONDS)
+	{
+		STLOGD("Lua listeners took {}us this frame", frameMicroseconds);
+	}
+}
+
+std::vector<ScriptingHookStats> GetScriptingHookStats()
+{
+	std::vector<ScriptingHookStats> stats;
+	for (auto& listener : luaListeners)
+	{
+		stats.push_back(ScriptingHookStats{
+			listener->observable,
+			listener->functionName,
+			listener->calls,
+			listener->totalMicroseconds
+		});
+	}
+	return stats;
+}
+
 /**
  * Registers a callback listener with an Observable, to receive notifications in Lua scripts.
  * This function can only be used during initialization.
@@ -347,6 +579,23 @@ static void RegisterListener(std::string observable, std::string luaFunc)
 	_RegisterListener(observable, luaFunc, key);
 }
 
+/**
+ * Registers a callback listener that receives the notifications of one frame at once.
+ * Instead of being called for every notification, the Lua function is called once per
+ * frame with an array of all events. Supported for OnStructureDamaged (as an array of
+ * StructureDamagedEvent) and OnSoldierCreated (as an array of SOLDIERTYPE,
+ * leaving out soldiers removed before the end of the frame).
+ * This function can only be used during initialization.
+ * @param observable the name of an Observable
+ * @param luaFunc name of the function handling the array of events
+ * @ingroup funclib-general
+ */
+static void RegisterBatchedListener(std::string observable, std::string luaFunc)
+{
+	ST::string key = ST::format("mod:{03d}", counter++);
+	_RegisterBatchedListener(observable, luaFunc, key);
+}
+
 /**
  * Unregisters a listener from the Observable.
  * This function can only be used during initialization.
@@ -1,4 +1,3 @@
-#include "PODObj.h"
 #include "Structure.h"
 #include "TileDef.h"
 #include "WorldDef.h"
@@ -14,6 +13,12 @@
 #include "Exit_Grids.h"
 #include "MemMan.h"
 
+#include <algorithm>
+#include <bitset>
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
 
 /*
 Kris -- Notes on how the undo code works:
@@ -24,7 +29,7 @@ down and painting various objects in the world would all constitute a single und
 the mouse is release, then a new undo command is setup.  So, to automate this, there is a call every
 frame to DetermineUndoState().
 
-At the next level, there is a binary tree that keeps track of what map indices have been backup up in
+At the next level, there is a bitset over all gridnos that keeps track of what map indices have been backup up in
 the current undo command.  The whole reason to maintain this list, is to avoid multiple map elements of
 the same map index from being saved.  In the outer code, everytime something is changed, a call to
 AddToUndoList() is called, so there are many cases (especially with building/terrain smoothing) that the
@@ -32,15 +37,15 @@ same mapindex is added to the undo list.  This is also completely transparent, a
 maintained.
 
 In the outer code, there are several calls to AddToUndoList( iMapIndex ).  This function basically looks
-in the binary tree for an existing entry, and if there isn't, then the entire mapelement is saved (with
+in the bitset for an existing entry, and if there isn't, then the entire mapelement is saved (with
 the exception of the merc level ).  Lights are also supported, but there is a totally different methodology
 for accomplishing this.  The equivalent function is AddLightToUndoList( iMapIndex ).  In this case, only the
 light is saved, along with internal maintanance of several flags.
 
-The actual mapelement copy code, is very complex.  The mapelement is copied in parallel with a new one which
-has to allocate several nodes of several types because a mapelement contains over a dozen separate lists, and
-all of them need to be saved.  The structure information of certain mapelements may be multitiled and must
-also save the affected gridno's as well.  This is also done internally.  Basically, your call to
+The actual mapelement copy code, is very complex.  A mapelement contains over a dozen separate lists, and
+all of them need to be saved.  The nodes and structures are copied by value into flat arrays of the undo
+command, and the lists are only rebuilt from them when the command is undone.  The structure information of
+certain mapelements may be multitiled and must also save the affected gridno's as well.  This is also done internally.  Basically, your call to
 AddToUndoList() for any particular gridno, may actually save several entries (like for a car which could be 6+
 tiles)
 
@@ -64,180 +69,92 @@ void DisableUndo()
 	gfUndoEnabled = FALSE;
 }
 
-// undo node data element
-struct undo_struct
+// A tile saved for undo. Its levelnodes and structures are stored by value in
+// the arrays of the command, so saving a tile does not allocate per node.
+struct undo_tile
 {
-	INT32       iMapIndex;
-	MAP_ELEMENT *pMapTile;
-	BOOLEAN     fLightSaved;   //determines that a light has been saved
-	UINT8       ubLightRadius; //the radius of the light to build if undo is called
-	UINT8       ubRoomNum;
+	INT32   iMapIndex;
+	BOOLEAN fLightSaved;   //determines that a light has been saved
+	UINT8   ubLightRadius; //the radius of the light to build if undo is called
+	UINT8   ubRoomNum;
+	UINT32  uiFirstNode;
+	UINT32  uiFirstStructure;
+	UINT16  usNumNodes[9]; // per layer, the pLandStart and merc layers are never saved
+	UINT8   ubNumStructures;
+	INT16   sLandStart;    // position of pLandStart in the land layer, -1 if none
+	UINT16  uiFlags;
+	UINT8   sHeight;
+	UINT8   ubTerrainID;
+	UINT8   ubReservedSoldierID;
 };
 
-// Undo stack node
-struct undo_stack
-{
-	INT32										iCmdCount;
-	undo_struct							*pData;
-	undo_stack*  pNext;
-	INT32										iUndoType;
-};
-undo_stack			*gpTileUndoStack = NULL;
-
-
-BOOLEAN fNewUndoCmd = TRUE;
-BOOLEAN gfIgnoreUndoCmdsForLights = FALSE;
-
-//New pre-undo binary tree stuff
-//With this, new undo commands will not duplicate saves in the same command.  This will
-//increase speed, and save memory.
-struct MapIndexBinaryTree
+// A saved levelnode, its structure data is referred to by its position in the tile's structures
+struct undo_node
 {
-	MapIndexBinaryTree* left;
-	MapIndexBinaryTree* right;
-	UINT16 usMapIndex;
+	LEVELNODE node;
+	UINT8     ubStructure;
 };
 
-MapIndexBinaryTree *top = NULL;
+#define NO_UNDO_STRUCTURE 0xFF
 
-
-//Recursively deletes all nodes below the node passed including itself.
-static void DeleteTreeNode(MapIndexBinaryTree** node)
-{
-	if( (*node)->left )
-		DeleteTreeNode( &((*node)->left) );
-	if( (*node)->right )
-		DeleteTreeNode( &((*node)->right) );
-	delete *node;
-	*node = NULL;
-}
-
-
-//Recursively delete all nodes (from the top down).
-static void ClearUndoMapIndexTree(void)
+// All tiles and lights saved by one undo command, in the order they were saved
+struct undo_command
 {
-	if( top )
-		DeleteTreeNode( &top );
-}
-
+	std::vector<undo_tile> tiles;
+	std::vector<undo_node> nodes;
+	std::vector<STRUCTURE> structures;
 
-static BOOLEAN AddMapIndexToTree(UINT16 usMapIndex)
-{
-	MapIndexBinaryTree *curr, *parent;
-	if( !top )
-	{
-		top = new MapIndexBinaryTree{};
-		top->usMapIndex = usMapIndex;
-		top->left = NULL;
-		top->right = NULL;
-		return TRUE;
-	}
-	curr = top;
-	parent = NULL;
-	//Traverse down the tree and attempt to find a matching mapindex.
-	//If one is encountered, then we fail, and don't add the mapindex to the
-	//tree.
-	while( curr )
+	size_t Bytes() const
 	{
-		parent = curr;
-		if( curr->usMapIndex == usMapIndex ) //found a match, so stop
-			return FALSE;
-		//if the mapIndex is < node's mapIndex, then go left, else right
-		curr = ( usMapIndex < curr->usMapIndex ) ? curr->left : curr->right;
+		return
+			tiles.capacity()      * sizeof(undo_tile) +
+			nodes.capacity()      * sizeof(undo_node) +
+			structures.capacity() * sizeof(STRUCTURE);
 	}
-	//if we made it this far, then curr is null and parent is pointing
-	//directly above.
-	//Create the new node and fill in the information.
-	curr = new MapIndexBinaryTree{};
-	curr->usMapIndex = usMapIndex;
-	curr->left = NULL;
-	curr->right = NULL;
-	//Now link the new node to the parent.
-	if( curr->usMapIndex < parent->usMapIndex )
-		parent->left = curr;
-	else
-		parent->right = curr;
-	return TRUE;
-}
-
+};
 
-static undo_stack* DeleteStackNode(undo_stack* const del)
-{
-	undo_struct* const undo = del->pData;
-	undo_stack*  const succ = del->pNext;
-	delete del;
+// Most recent command last
+static std::deque<undo_command> gUndoCommands;
+static size_t gUndoBytes = 0; // of all commands but the most recent one
 
-	MAP_ELEMENT* const me = undo->pMapTile;
-	if (me != NULL) // light was saved -- mapelement, too?
-	{
-		// Free the memory associated with the map tile lists
-		FreeLevelNodeList(&me->pLandHead);
-		FreeLevelNodeList(&me->pObjectHead);
-		FreeLevelNodeList(&me->pStructHead);
-		FreeLevelNodeList(&me->pShadowHead);
-		FreeLevelNodeList(&me->pMercHead);
-		FreeLevelNodeList(&me->pRoofHead);
-		FreeLevelNodeList(&me->pOnRoofHead);
-		FreeLevelNodeList(&me->pTopmostHead);
-
-		for (STRUCTURE* s = me->pStructureHead; s != NULL;)
-		{
-			STRUCTURE* const next = s->pNext;
-			if (s->usStructureID > INVALID_STRUCTURE_ID)
-			{ /* Okay to delete the structure data -- otherwise, this would be merc
-				 * structure data that we DON'T want to delete, because the merc node that
-				 * hasn't been modified will still use this structure data! */
-				delete s;
-			}
-			s = next;
-		}
-		me->pStructureHead = NULL;
 
-		delete me;
-		delete undo;
-	}
+BOOLEAN fNewUndoCmd = TRUE;
+BOOLEAN gfIgnoreUndoCmdsForLights = FALSE;
 
-	return succ;
-}
+//With this, new undo commands will not duplicate saves in the same command.  This will
+//increase speed, and save memory.
+static std::bitset<WORLD_MAX> gUndoSavedTiles;
 
 
-static void DeleteTopStackNode(void)
+static undo_command& NewUndoCommand()
 {
-	gpTileUndoStack = DeleteStackNode(gpTileUndoStack);
+	if (!gUndoCommands.empty()) gUndoBytes += gUndoCommands.back().Bytes();
+	gUndoCommands.emplace_back();
+	gUndoSavedTiles.reset();
+	return gUndoCommands.back();
 }
 
 
-static void CropStackToMaxLength(INT32 iMaxCmds)
+static void DeleteTopUndoCommand()
 {
-	INT32				iCmdCount;
-	undo_stack	*pCurrent;
-
-	iCmdCount = 0;
-	pCurrent = gpTileUndoStack;
-
-	// If stack is empty, leave
-	if ( pCurrent == NULL )
-		return;
+	gUndoCommands.pop_back();
+	if (!gUndoCommands.empty()) gUndoBytes -= gUndoCommands.back().Bytes();
+}
 
-	while ( (iCmdCount <= (iMaxCmds - 1)) && (pCurrent != NULL) )
-	{
-		if ( pCurrent->iCmdCount == 1 )
-			iCmdCount++;
-		pCurrent = pCurrent->pNext;
-	}
 
-	// If the max number of commands was reached, and there is something
-	// to crop, from the rest of the stack, remove it.
-	if ( (iCmdCount >= iMaxCmds) && pCurrent != NULL )
+// Drops the oldest commands until the undo memory fits into the budget, the most recent command is always kept
+static void CropStackToMaxBytes(size_t const max_bytes)
+{
+	while (gUndoCommands.size() > 1 && gUndoBytes + gUndoCommands.back().Bytes() > max_bytes)
 	{
-		while ( pCurrent->pNext != NULL )
-			pCurrent->pNext = DeleteStackNode(pCurrent->pNext);
+		gUndoBytes -= gUndoCommands.front().Bytes();
+		gUndoCommands.pop_front();
 	}
 }
 
 
 //We are adding a light to the undo list.  We won't save the mapelement, nor will
-//we validate the gridno in the binary tree.  This works differently than a mapelement,
+//we validate the gridno in the bitset.  This works differently than a mapelement,
 //because lights work on a different system.  By setting the fLightSaved flag to TRUE,
 //this will handle the way the undo command is handled.  If there is no lightradius in
 //our saved light, then we intend on erasing the light upon undo execution, otherwise, we
@@ -253,175 +170,140 @@ void AddLightToUndoList(INT32 const iMapIndex, INT32 const iLightRadius)
 	 * cleared, and lights are again allowed to be saved in the undo list. */
 	if (gfIgnoreUndoCmdsForLights) return;
 
-	SGP::PODObj<undo_struct> undo_info;
-	undo_info->fLightSaved = TRUE;
+	undo_tile undo_info{};
+	undo_info.fLightSaved = TRUE;
 	/* if ubLightRadius is 0, then we don't need to save the light information
 	 * because we will erase it when it comes time to execute the undo command. */
-	undo_info->ubLightRadius = iLightRadius;
-	undo_info->iMapIndex     = iMapIndex;
-	undo_info->pMapTile      = NULL;
-
-	//Add to undo stack
-	SGP::PODObj<undo_stack> n;
-	n->iCmdCount    = 1;
-	n->pData        = undo_info.Release();
-	n->pNext        = gpTileUndoStack;
-	gpTileUndoStack = n.Release();
-
-	CropStackToMaxLength(MAX_UNDO_COMMAND_LENGTH);
+	undo_info.ubLightRadius = iLightRadius;
+	undo_info.iMapIndex     = iMapIndex;
+
+	// A light is a command of its own, tiles saved after it start a new one
+	NewUndoCommand().tiles.push_back(undo_info);
+	fNewUndoCmd = TRUE;
+
+	CropStackToMaxBytes(MAX_UNDO_BYTES);
 }
 
 
-static void AddToUndoListCmd(INT32 iMapIndex, INT32 iCmdCount);
+static void AddToUndoListCmd(INT32 iMapIndex);
 
 
 BOOLEAN AddToUndoList( INT32 iMapIndex )
 {
-	static INT32 iCount = 1;
-
 	if(	!gfUndoEnabled )
 		return FALSE;
-	if ( fNewUndoCmd )
-	{
-		iCount = 0;
-		fNewUndoCmd = FALSE;
-	}
 
 	//Check to see if the tile in question is even on the visible map, then
 	//if that is true, then check to make sure we don't already have the mapindex
-	//saved in the new binary tree (which only holds unique mapindex values).
-	if( GridNoOnVisibleWorldTile( (INT16)iMapIndex ) && AddMapIndexToTree( (UINT16)iMapIndex ) )
+	//saved in the current command.
+	if (!GridNoOnVisibleWorldTile((INT16)iMapIndex)) return FALSE;
+	if (!fNewUndoCmd && gUndoSavedTiles[iMapIndex]) return FALSE;
 
+	try
 	{
-		try
+		if (fNewUndoCmd)
 		{
-			AddToUndoListCmd(iMapIndex, ++iCount);
-			return TRUE;
+			NewUndoCommand();
+			fNewUndoCmd = FALSE;
 		}
-		catch (...) { --iCount; }
+		gUndoSavedTiles[iMapIndex] = true;
+		AddToUndoListCmd(iMapIndex);
+		return TRUE;
 	}
-	return FALSE;
+	catch (...) { return FALSE; }
 }
 
 
-static MAP_ELEMENT* CopyMapElementFromWorld(INT32 map_index);
+static void SaveMapElement(undo_command&, INT32 map_index);
 
 
-static void AddToUndoListCmd(INT32 const iMapIndex, INT32 const iCmdCount)
+static void AddToUndoListCmd(INT32 const iMapIndex)
 {
-	INT32					iCoveredMapIndex;
-	UINT8					ubLoop;
-
-	SGP::PODObj<undo_stack>  pNode;
-	SGP::PODObj<undo_struct> pUndoInfo;
-
-	// Copy the world map's tile
-	MAP_ELEMENT* const pData = CopyMapElementFromWorld(iMapIndex);
+	undo_command& cmd = gUndoCommands.back();
 
-	STRUCTURE* pStructure = pData->pStructureHead;
+	// Save the world map's tile
+	SaveMapElement(cmd, iMapIndex);
 
-	// copy the room number information (it's not in the mapelement structure)
-	pUndoInfo->ubRoomNum = gubWorldRoomInfo[ iMapIndex ];
-
-	pUndoInfo->fLightSaved = FALSE;
-	pUndoInfo->ubLightRadius = 0;
-	pUndoInfo->pMapTile = pData;
-	pUndoInfo->iMapIndex = iMapIndex;
-
-	pNode->pData = pUndoInfo.Release();
-	pNode->iCmdCount = iCmdCount;
-	pNode->pNext = gpTileUndoStack;
-	gpTileUndoStack = pNode.Release();
-
-	// loop through pData->pStructureHead list
+	// loop through the structures of the tile
 	// for each structure
 	//   find the base tile
 	//   reference the db structure
 	//   if number of tiles > 1
 	//     add all covered tiles to undo list
-	while (pStructure)
+	for (STRUCTURE const* pStructure = gpWorldLevelData[iMapIndex].pStructureHead; pStructure; pStructure = pStructure->pNext)
 	{
-		for (ubLoop = 1; ubLoop < pStructure->pDBStructureRef->pDBStructure->ubNumberOfTiles; ubLoop++)
+		DB_STRUCTURE_REF const* const ref = pStructure->pDBStructureRef;
+		for (UINT8 ubLoop = 1; ubLoop < ref->pDBStructure->ubNumberOfTiles; ubLoop++)
 		{
 			// this loop won't execute for single-tile structures; for multi-tile structures, we have to
 			// add to the undo list all the other tiles covered by the structure
-			iCoveredMapIndex = pStructure->sBaseGridNo + pStructure->pDBStructureRef->ppTile[ubLoop]->sPosRelToBase;
+			INT32 const iCoveredMapIndex = pStructure->sBaseGridNo + ref->ppTile[ubLoop]->sPosRelToBase;
 			AddToUndoList( iCoveredMapIndex );
 		}
-		pStructure = pStructure->pNext;
 	}
 
-	CropStackToMaxLength( MAX_UNDO_COMMAND_LENGTH );
+	CropStackToMaxBytes(MAX_UNDO_BYTES);
 }
 
 
 void RemoveAllFromUndoList(void)
 {
-	ClearUndoMapIndexTree();
-
-	while ( gpTileUndoStack != NULL )
-		DeleteTopStackNode();
+	gUndoSavedTiles.reset();
+	gUndoCommands.clear();
+	gUndoBytes  = 0;
+	fNewUndoCmd = TRUE;
 }
 
 
-static void SwapMapElementWithWorld(INT32 iMapIndex, MAP_ELEMENT* pUndoMapElement);
+static void RestoreMapElement(undo_command const&, undo_tile const&);
 
 
 BOOLEAN ExecuteUndoList( void )
 {
-	INT32				iCmdCount, iCurCount;
-	INT32				iUndoMapIndex;
-
 	if(	!gfUndoEnabled )
 		return FALSE;
 
 	// Is there something on the undo stack?
-	if ( gpTileUndoStack == NULL )
+	if (gUndoCommands.empty())
 		return( TRUE );
 
-	// Get number of stack entries for this command (top node will tell this)
-	iCmdCount = gpTileUndoStack->iCmdCount;
+	// Take the most recent command off the stack and undo its tiles, last saved first
+	undo_command const cmd = std::move(gUndoCommands.back());
+	DeleteTopUndoCommand();
+	fNewUndoCmd = TRUE;
 
-	// Execute each stack node in command, and remove each from stack.
-	iCurCount = 0;
-	while ( (iCurCount < iCmdCount) && (gpTileUndoStack != NULL) )
+	for (auto i = cmd.tiles.rbegin(); i != cmd.tiles.rend(); ++i)
 	{
-		iUndoMapIndex = gpTileUndoStack->pData->iMapIndex;
+		undo_tile const& undo = *i;
+		INT32 const iUndoMapIndex = undo.iMapIndex;
 
 		BOOLEAN fExitGrid = FALSE; // XXX HACK000E
 		// Find which map tile we are to "undo"
-		if( gpTileUndoStack->pData->fLightSaved )
+		if (undo.fLightSaved)
 		{ //We saved a light, so delete that light
 			//Turn on this flag so that the following code, when executed, doesn't attempt to
 			//add lights to the undo list.  That would cause problems...
 			gfIgnoreUndoCmdsForLights = TRUE;
-			if( !gpTileUndoStack->pData->ubLightRadius )
+			if (!undo.ubLightRadius)
 				RemoveLight(iUndoMapIndex);
 			else
-				PlaceLight(gpTileUndoStack->pData->ubLightRadius, iUndoMapIndex);
+				PlaceLight(undo.ubLightRadius, iUndoMapIndex);
 			//Turn off the flag so lights can again be added to the undo list.
 			gfIgnoreUndoCmdsForLights = FALSE;
 		}
 		else
-		{	// We execute the undo command node by simply swapping the contents
-			// of the undo's MAP_ELEMENT with the world's element.
+		{	// We execute the undo command by rebuilding the world's element
+			// from the saved one.
 			fExitGrid = ExitGridAtGridNo( (UINT16)iUndoMapIndex );
-			SwapMapElementWithWorld( iUndoMapIndex, gpTileUndoStack->pData->pMapTile );
+			RestoreMapElement(cmd, undo);
 
 			// copy the room number information back
-			gubWorldRoomInfo[ iUndoMapIndex ] = gpTileUndoStack->pData->ubRoomNum;
+			gubWorldRoomInfo[iUndoMapIndex] = undo.ubRoomNum;
 
 			// Now we smooth out the changes...
-			//SmoothUndoMapTileTerrain( iUndoMapIndex, gpTileUndoStack->pData->pMapTile );
 			SmoothAllTerrainTypeRadius( iUndoMapIndex, 1, TRUE );
 		}
 
-		// ...trash the top element of the stack...
-		DeleteTopStackNode( );
-
-		// ...and bump the command counter up by 1
-		iCurCount++;
-
 		//Kris:
 		//The new cursor system is somehow interfering with the undo stuff.  When
 		//an undo is called, the item is erased, but a cursor is added!  I'm quickly
@@ -441,144 +323,175 @@ BOOLEAN ExecuteUndoList( void )
 	return( TRUE );
 }
 
-namespace
+
+// Merc structures belong to the soldiers, which are not part of undo
+static bool IsMercStructure(STRUCTURE const* const s)
 {
-	//Because of the potentially huge amounts of memory that can be allocated due to the inefficient
-	//undo methods coded by Bret, it is feasible that it could fail.  Instead of using assertions to
-	//terminate the program, destroy the memory allocated thusfar.
-	void DeleteMapElementContentsAfterCreationFail(MAP_ELEMENT* pNewMapElement)
-	{
-		LEVELNODE *pLevelNode;
-		STRUCTURE *pStructure;
-		INT32 x;
-		for( x = 0; x < 9; x++ )
-		{
-			if( x == 1 )
-				continue;
-			pLevelNode = pNewMapElement->pLevelNodes[ x ];
-			while( pLevelNode )
-			{
-				LEVELNODE *temp;
-				temp = pLevelNode;
-				pLevelNode = pLevelNode->pNext;
-				delete temp;
-			}
-		}
-		pStructure = pNewMapElement->pStructureHead;
-		while( pStructure )
-		{
-			STRUCTURE *temp;
-			temp = pStructure;
-			pStructure = pStructure->pNext;
-			delete temp;
-		}
-	}
+	return s->usStructureID <= INVALID_STRUCTURE_ID;
 }
 
 
-static MAP_ELEMENT* CopyMapElementFromWorld(INT32 const map_index)
+static void SaveMapElement(undo_command& cmd, INT32 const map_index)
 {
-	SGP::AutoObj<MAP_ELEMENT, DeleteMapElementContentsAfterCreationFail> new_me(new MAP_ELEMENT{});
+	MAP_ELEMENT const& me = gpWorldLevelData[map_index];
 
-	MAP_ELEMENT const* const old_me = &gpWorldLevelData[map_index];
+	undo_tile undo{};
+	undo.iMapIndex        = map_index;
+	undo.ubRoomNum        = gubWorldRoomInfo[map_index]; // it's not in the mapelement structure
+	undo.uiFirstNode      = static_cast<UINT32>(cmd.nodes.size());
+	undo.uiFirstStructure = static_cast<UINT32>(cmd.structures.size());
+	undo.sLandStart       = -1;
 
 	// Save the structure information from the mapelement
-	STRUCTURE*  tail   = 0;
-	STRUCTURE** anchor = &new_me->pStructureHead;
-	for (STRUCTURE const* i = old_me->pStructureHead; i; i = i->pNext)
+	std::vector<STRUCTURE const*> saved_structures;
+	for (STRUCTURE const* i = me.pStructureHead; i; i = i->pNext)
 	{
-		STRUCTURE* const s = new STRUCTURE{};
-		*s       = *i;
-		s->pPrev = tail;
-		s->pNext = 0;
-		tail     = s;
-		*anchor  = s;
-		anchor   = &s->pNext;
+		if (IsMercStructure(i)) continue;
+		if (saved_structures.size() == NO_UNDO_STRUCTURE) throw std::length_error("Too many structures to undo");
+		saved_structures.push_back(i);
+		cmd.structures.push_back(*i);
 	}
-	new_me->pStructureTail = tail;
+	undo.ubNumStructures = static_cast<UINT8>(saved_structures.size());
 
 	/* For each of the 9 levelnodes, save each one, except for levelnode[1] which
 	 * is a pointer to the first land to render. */
 	for (INT32 x = 0; x != 9; ++x)
 	{
 		if (x == 1 || x == 5) continue; // Skip the pLandStart and pMercLevel levelnodes
-		LEVELNODE*  tail   = 0;
-		LEVELNODE** anchor = &new_me->pLevelNodes[x];
-		for (LEVELNODE const* i = old_me->pLevelNodes[x]; i; i = i->pNext)
+		UINT16 n = 0;
+		for (LEVELNODE const* i = me.pLevelNodes[x]; i; i = i->pNext, ++n)
 		{
-			LEVELNODE* const l = new LEVELNODE{};
-			*l       = *i;
-			if (x == 0) l->pPrevNode = tail; // Land layer only
-			l->pNext = 0;
-			tail     = l;
-			*anchor  = l;
-			anchor   = &l->pNext;
+			undo_node saved;
+			saved.node        = *i;
+			saved.ubStructure = NO_UNDO_STRUCTURE;
 
 			// Handle levelnode layer specific stuff
 			switch (x)
 			{
 				case 0: // Land layer
-					// Set the new landstart to point to the new levelnode.
-					if (old_me->pLandStart == i) new_me->pLandStart = l;
+					if (me.pLandStart == i) undo.sLandStart = n;
 					break;
 
 				case 3: // Struct layer
 				case 6:	// Roof layer
 				case 7: // On roof layer
 					if (i->pStructureData)
-					{ /* Make sure the structuredata pointer points to the parallel
-						 * structure. Both lists are exactly the same size and contain the
-						 * same information, but the addresses are different.  We will
-						 * traverse the old list until we find the match, then */
-						STRUCTURE const* o = old_me->pStructureHead;
-						STRUCTURE*       n = new_me->pStructureHead;
-						for (;; o = o->pNext, n = n->pNext)
-						{
-							/* Kris: If this assert should fail, that means there is something
-							 * wrong with the preservation of the structure data within the
-							 * mapelement. */
-							// OUCH!!! THIS IS HAPPENING.  DISABLED IT FOR LINDA'S SAKE
-							if (!o) break;
-							Assert(o);
-							Assert(n);
-							if (o == i->pStructureData)
-							{
-								l->pStructureData = n;
-								break;
-							}
-						}
+					{ // Remember which of the saved structures it points to
+						auto const s = std::find(saved_structures.begin(), saved_structures.end(), i->pStructureData);
+						if (s != saved_structures.end()) saved.ubStructure = static_cast<UINT8>(s - saved_structures.begin());
 					}
 					break;
 			}
+			cmd.nodes.push_back(saved);
 		}
+		undo.usNumNodes[x] = n;
 	}
 
 	// Save the rest of the information in the mapelement.
-	new_me->uiFlags							= old_me->uiFlags;
-	new_me->sHeight							= old_me->sHeight;
-	new_me->ubTerrainID					= old_me->ubTerrainID;
-	new_me->ubReservedSoldierID = old_me->ubReservedSoldierID;
-	return new_me.Release();
+	undo.uiFlags             = me.uiFlags;
+	undo.sHeight             = me.sHeight;
+	undo.ubTerrainID         = me.ubTerrainID;
+	undo.ubReservedSoldierID = me.ubReservedSoldierID;
+	cmd.tiles.push_back(undo);
 }
 
 
-static void SwapMapElementWithWorld(INT32 const iMapIndex, MAP_ELEMENT* const pUndoMapElement)
+static void RestoreMapElement(undo_command const& cmd, undo_tile const& undo)
 {
-	MAP_ELEMENT			*pCurrentMapElement;
-	MAP_ELEMENT			TempMapElement;
+	MAP_ELEMENT& me = gpWorldLevelData[undo.iMapIndex];
+
+	// Throw away the current contents, except for the mercs
+	for (INT32 x = 0; x != 9; ++x)
+	{
+		if (x == 1 || x == 5) continue;
+		FreeLevelNodeList(&me.pLevelNodes[x]);
+	}
+	me.pLandStart = NULL;
+
+	STRUCTURE* mercs      = NULL;
+	STRUCTURE* mercs_tail = NULL;
+	for (STRUCTURE* s = me.pStructureHead; s;)
+	{
+		STRUCTURE* const next = s->pNext;
+		if (IsMercStructure(s))
+		{ // Keep it, the merc level node still uses this structure data
+			s->pPrev = mercs_tail;
+			s->pNext = NULL;
+			if (mercs_tail) mercs_tail->pNext = s; else mercs = s;
+			mercs_tail = s;
+		}
+		else
+		{
+			delete s;
+		}
+		s = next;
+	}
+
+	// Rebuild the saved structures, followed by the merc structures
+	std::vector<STRUCTURE*> structures;
+	structures.reserve(undo.ubNumStructures);
+	STRUCTURE*  tail   = NULL;
+	STRUCTURE** anchor = &me.pStructureHead;
+	for (UINT8 n = 0; n != undo.ubNumStructures; ++n)
+	{
+		STRUCTURE* const s = new STRUCTURE{cmd.structures[undo.uiFirstStructure + n]};
+		s->pPrev = tail;
+		s->pNext = NULL;
+		tail     = s;
+		*anchor  = s;
+		anchor   = &s->pNext;
+		structures.push_back(s);
+	}
+	if (mercs)
+	{
+		mercs->pPrev = tail;
+		*anchor      = mercs;
+		tail         = mercs_tail;
+	}
+	else
+	{
+		*anchor = NULL;
+	}
+	me.pStructureTail = tail;
+
+	// Rebuild the levelnode layers
+	undo_node const* saved = cmd.nodes.data() + undo.uiFirstNode;
+	for (INT32 x = 0; x != 9; ++x)
+	{
+		if (x == 1 || x == 5) continue;
+		LEVELNODE*  tail   = NULL;
+		LEVELNODE** anchor = &me.pLevelNodes[x];
+		for (UINT16 n = 0; n != undo.usNumNodes[x]; ++n, ++saved)
+		{
+			LEVELNODE* const l = new LEVELNODE{saved->node};
+			l->pNext = NULL;
+			*anchor  = l;
+			anchor   = &l->pNext;
 
-	pCurrentMapElement = &gpWorldLevelData[ iMapIndex ];
+			switch (x)
+			{
+				case 0: // Land layer
+					l->pPrevNode = tail;
+					if (n == undo.sLandStart) me.pLandStart = l;
+					break;
 
-	//Transfer the merc level node from the current world to the undo mapelement
-	//that will replace it.  We do this, because mercs aren't associated with
-	//undo commands.
-	pUndoMapElement->pMercHead = gpWorldLevelData[ iMapIndex ].pMercHead;
-	gpWorldLevelData[ iMapIndex ].pMercHead = NULL;
+				case 3: // Struct layer
+				case 6:	// Roof layer
+				case 7: // On roof layer
+					if (saved->ubStructure != NO_UNDO_STRUCTURE)
+					{
+						l->pStructureData = structures[saved->ubStructure];
+					}
+					break;
+			}
+			tail = l;
+		}
+	}
 
-	//Swap the mapelements
-	TempMapElement = *pCurrentMapElement;
-	*pCurrentMapElement = *pUndoMapElement;
-	*pUndoMapElement = TempMapElement;
+	me.uiFlags             = undo.uiFlags;
+	me.sHeight             = undo.sHeight;
+	me.ubTerrainID         = undo.ubTerrainID;
+	me.ubReservedSoldierID = undo.ubReservedSoldierID;
 }
 
 
@@ -590,9 +503,175 @@ void DetermineUndoState()
 		if( (!gfLeftButtonState  && !gfCurrentSelectionWithRightButton) ||
 			(!gfRightButtonState &&  gfCurrentSelectionWithRightButton) )
 		{
-			//Clear the mapindex binary tree list, and set up flag for new undo command.
+			//Set up flag for new undo command, which starts with an empty set of saved tiles.
 			fNewUndoCmd = TRUE;
-			ClearUndoMapIndexTree();
 		}
 	}
 }
+
+
+#ifdef WITH_UNITTESTS
+#include "gtest/gtest.h"
+
+#include <memory>
+
+// Everything about a tile that undo has to bring back
+static std::vector<INT32> DescribeTile(MAP_ELEMENT const& me)
+{
+	std::vector<INT32> d;
+	std::vector<STRUCTURE const*> structures;
+	for (STRUCTURE const* s = me.pStructureHead; s; s = s->pNext)
+	{
+		structures.push_back(s);
+		d.push_back(s->usStructureID);
+		d.push_back(s->sGridNo);
+		d.push_back(s->fFlags);
+		d.push_back(s->pPrev == (structures.size() > 1 ? structures[structures.size() - 2] : NULL));
+	}
+	d.push_back(me.pStructureTail == (structures.empty() ? NULL : structures.back()));
+
+	for (INT32 x = 0; x != 9; ++x)
+	{
+		if (x == 1) continue;
+		d.push_back(-1);
+		LEVELNODE const* prev = NULL;
+		for (LEVELNODE const* l = me.pLevelNodes[x]; l; prev = l, l = l->pNext)
+		{
+			d.push_back(l->usIndex);
+			d.push_back(l->uiFlags);
+			d.push_back(l->sRelativeZ);
+			d.push_back(l->ubShadeLevel);
+			if (x == 0)
+			{
+				d.push_back(l->pPrevNode == prev);
+				d.push_back(me.pLandStart == l);
+			}
+			else if (x == 3 || x == 6 || x == 7)
+			{
+				d.push_back(std::find(structures.begin(), structures.end(), l->pStructureData) - structures.begin());
+			}
+		}
+	}
+
+	d.push_back(me.uiFlags);
+	d.push_back(me.sHeight);
+	d.push_back(me.ubTerrainID);
+	d.push_back(me.ubReservedSoldierID);
+	return d;
+}
+
+static LEVELNODE* AddTestNode(MAP_ELEMENT& me, INT32 const layer, UINT16 const index)
+{
+	LEVELNODE* const l = new LEVELNODE{};
+	l->usIndex      = index;
+	l->uiFlags      = LEVELNODE_REVEAL;
+	l->sRelativeZ   = index * 2;
+	l->ubShadeLevel = index % 16;
+	LEVELNODE** anchor = &me.pLevelNodes[layer];
+	LEVELNODE*  prev   = NULL;
+	while (*anchor) { prev = *anchor; anchor = &(*anchor)->pNext; }
+	if (layer == 0) l->pPrevNode = prev;
+	*anchor = l;
+	return l;
+}
+
+static STRUCTURE* AddTestStructure(MAP_ELEMENT& me, UINT16 const id)
+{
+	STRUCTURE* const s = new STRUCTURE{};
+	s->usStructureID = id;
+	s->sGridNo       = 100;
+	s->fFlags        = STRUCTURE_BASE_TILE;
+	s->pPrev         = me.pStructureTail;
+	if (me.pStructureTail) me.pStructureTail->pNext = s; else me.pStructureHead = s;
+	me.pStructureTail = s;
+	return s;
+}
+
+static void FreeTestTile(MAP_ELEMENT& me)
+{
+	for (LEVELNODE*& head : me.pLevelNodes) if (&head != &me.pLandStart) FreeLevelNodeList(&head);
+	for (STRUCTURE* s = me.pStructureHead; s;)
+	{
+		STRUCTURE* const next = s->pNext;
+		delete s;
+		s = next;
+	}
+}
+
+TEST(EditorUndo, tileRoundTrip)
+{
+	std::unique_ptr<MAP_ELEMENT[]> const world(new MAP_ELEMENT[WORLD_MAX]{});
+	MAP_ELEMENT* const old_world = gpWorldLevelData;
+	gpWorldLevelData = world.get();
+	MAP_ELEMENT& me = world[100];
+
+	AddTestNode(me, 0, 11);
+	me.pLandStart = AddTestNode(me, 0, 12);
+	AddTestStructure(me, INVALID_STRUCTURE_ID + 1);
+	STRUCTURE* const merc = AddTestStructure(me, 1);
+	STRUCTURE* const wall = AddTestStructure(me, INVALID_STRUCTURE_ID + 2);
+	AddTestNode(me, 2, 21);
+	AddTestNode(me, 3, 31)->pStructureData = wall;
+	AddTestNode(me, 6, 61);
+	AddTestNode(me, 8, 81);
+	me.uiFlags     = MAPELEMENT_REVEALED;
+	me.sHeight     = 3;
+	me.ubTerrainID = 4;
+	gubWorldRoomInfo[100] = 5;
+
+	undo_command cmd;
+	SaveMapElement(cmd, 100);
+	ASSERT_EQ(cmd.tiles.size(), 1u);
+	EXPECT_EQ(cmd.structures.size(), 2u); // without the merc
+	EXPECT_EQ(cmd.nodes.size(), 6u);
+	EXPECT_EQ(cmd.tiles[0].ubRoomNum, 5);
+
+	// Without the merc structure, which undo leaves alone and puts last
+	std::vector<INT32> expected;
+	{
+		merc->pPrev->pNext = merc->pNext;
+		merc->pNext->pPrev = merc->pPrev;
+		merc->pPrev = me.pStructureTail;
+		merc->pNext = NULL;
+		me.pStructureTail->pNext = merc;
+		me.pStructureTail = merc;
+		expected = DescribeTile(me);
+	}
+
+	// Paint over the tile
+	FreeLevelNodeList(&me.pObjectHead);
+	AddTestNode(me, 0, 13);
+	AddTestNode(me, 4, 41);
+	wall->usStructureID = INVALID_STRUCTURE_ID + 3;
+	me.sHeight = 0;
+	EXPECT_NE(DescribeTile(me), expected);
+
+	RestoreMapElement(cmd, cmd.tiles[0]);
+	EXPECT_EQ(DescribeTile(me), expected);
+	EXPECT_EQ(me.pStructureTail, merc);
+
+	FreeTestTile(me);
+	gpWorldLevelData = old_world;
+}
+
+TEST(EditorUndo, cropToBudget)
+{
+	RemoveAllFromUndoList();
+	for (int i = 0; i != 4; ++i)
+	{
+		NewUndoCommand().nodes.resize(1000);
+	}
+	size_t const command = gUndoCommands.back().Bytes();
+
+	CropStackToMaxBytes(command * 2);
+	EXPECT_EQ(gUndoCommands.size(), 2u);
+
+	// The most recent command stays, even if it alone is too large
+	CropStackToMaxBytes(0);
+	EXPECT_EQ(gUndoCommands.size(), 1u);
+
+	RemoveAllFromUndoList();
+	EXPECT_TRUE(gUndoCommands.empty());
+}
+
+#endif
@@ -12,7 +12,7 @@ void DisableUndo(void);
 
 void DetermineUndoState(void);
 
-// Undo command flags
-#define MAX_UNDO_COMMAND_LENGTH		10
+// Memory the undo commands may take up, the most recent command is always kept
+#define MAX_UNDO_BYTES		(16 * 1024 * 1024)
 
 #endif
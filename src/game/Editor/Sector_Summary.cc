@@ -2223,67 +2223,31 @@ static void RegenerateSummaryInfoForAllOutdatedMaps(void)
 	gusTotal = gusNumEntriesWithOutdatedOrNoSummaryInfo;
 	UpdateMasterProgress();
 
+	static const UINT8 level_masks[] =
+	{
+		GROUND_LEVEL_MASK, BASEMENT1_LEVEL_MASK, BASEMENT2_LEVEL_MASK, BASEMENT3_LEVEL_MASK,
+		ALTERNATE_GROUND_MASK, ALTERNATE_B1_MASK, ALTERNATE_B2_MASK, ALTERNATE_B3_MASK
+	};
+
+	// Collect the outdated maps first, so they can be evaluated all at once
+	std::vector<SUMMARY_MAP> maps;
 	for( y = 0; y < 16; y++ ) for( x = 0; x < 16; x++ )
 	{
-		char str[40];
-		sprintf( str, "%c%d", y + 'A', x + 1 );
-		if( gbSectorLevels[x][y] & GROUND_LEVEL_MASK )
-		{
-			pSF = gpSectorSummary[x][y][0];
-			if( !pSF || pSF->ubSummaryVersion != GLOBAL_SUMMARY_VERSION )
-				if( !EvaluateWorld( str, 0 ) )
-					ReportError( str, 0 );
-		}
-		if( gbSectorLevels[x][y] & BASEMENT1_LEVEL_MASK )
-		{
-			pSF = gpSectorSummary[x][y][1];
-			if( !pSF || pSF->ubSummaryVersion != GLOBAL_SUMMARY_VERSION )
-				if( !EvaluateWorld( str, 1 ) )
-					ReportError( str, 1 );
-		}
-		if( gbSectorLevels[x][y] & BASEMENT2_LEVEL_MASK )
+		ST::string const str = ST::format("{c}{}", char(y + 'A'), x + 1);
+		for (UINT8 level = 0; level != lengthof(level_masks); ++level)
 		{
-			pSF = gpSectorSummary[x][y][2];
+			if (!(gbSectorLevels[x][y] & level_masks[level])) continue;
+			pSF = gpSectorSummary[x][y][level];
 			if( !pSF || pSF->ubSummaryVersion != GLOBAL_SUMMARY_VERSION )
-				if( !EvaluateWorld( str, 2 ) )
-					ReportError( str, 2 );
-		}
-		if( gbSectorLevels[x][y] & BASEMENT3_LEVEL_MASK )
-		{
-			pSF = gpSectorSummary[x][y][3];
-			if( !pSF || pSF->ubSummaryVersion != GLOBAL_SUMMARY_VERSION )
-				if( !EvaluateWorld( str, 3 ) )
-					ReportError( str, 3 );
-		}
-		if( gbSectorLevels[x][y] & ALTERNATE_GROUND_MASK )
-		{
-			pSF = gpSectorSummary[x][y][4];
-			if( !pSF || pSF->ubSummaryVersion != GLOBAL_SUMMARY_VERSION )
-				if( !EvaluateWorld( str, 4 ) )
-					ReportError( str, 4 );
-		}
-		if( gbSectorLevels[x][y] & ALTERNATE_B1_MASK )
-		{
-			pSF = gpSectorSummary[x][y][5];
-			if( !pSF || pSF->ubSummaryVersion != GLOBAL_SUMMARY_VERSION )
-				if( !EvaluateWorld( str, 5 ) )
-					ReportError( str, 5 );
-		}
-		if( gbSectorLevels[x][y] & ALTERNATE_B2_MASK )
-		{
-			pSF = gpSectorSummary[x][y][6];
-			if( !pSF || pSF->ubSummaryVersion != GLOBAL_SUMMARY_VERSION )
-				if( !EvaluateWorld( str, 6 ) )
-					ReportError( str, 6 );
-		}
-		if( gbSectorLevels[x][y] & ALTERNATE_B3_MASK )
-		{
-			pSF = gpSectorSummary[x][y][7];
-			if( !pSF || pSF->ubSummaryVersion != GLOBAL_SUMMARY_VERSION )
-				if( !EvaluateWorld( str, 7 ) )
-					ReportError( str, 7 );
+				maps.push_back(SUMMARY_MAP{str, level});
 		}
 	}
+
+	std::vector<bool> const evaluated = EvaluateWorlds(maps);
+	for (size_t i = 0; i != maps.size(); ++i)
+	{
+		if (!evaluated[i]) ReportError(maps[i].sector.c_str(), maps[i].ubLevel);
+	}
 	RemoveProgressBar( 0 );
 	RemoveProgressBar( 1 );
 	gfUpdatingNow = FALSE;
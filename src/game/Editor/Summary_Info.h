@@ -3,6 +3,10 @@
 
 #include "Types.h"
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #define GLOBAL_SUMMARY_VERSION	14
 #define MINIMUMVERSION		7
 
@@ -96,6 +100,29 @@ struct SUMMARYFILE
 extern BOOLEAN gfAutoLoadA9;
 
 extern BOOLEAN EvaluateWorld(const char* pSector, UINT8 ubLevel);
+
+/* Builds the summary of a map from the contents of its file. Touches no
+ * globals, so it can run on any thread. Throws if the map is malformed. */
+SUMMARYFILE* ParseWorldSummary(const BYTE* data, size_t size);
+// The same, reading the map from a file as it goes
+SUMMARYFILE* ParseWorldSummary(SGPFile* f);
+
+/* Parses the summaries of several maps on worker threads. load(i) returns the
+ * contents of map i and is called on the workers. The summaries are returned
+ * in map order, NULL for a map that could not be loaded or parsed. */
+std::vector<std::unique_ptr<SUMMARYFILE>> ParseWorldSummaries(size_t n_maps, std::function<std::vector<UINT8>(size_t)> const& load);
+
+// A map to summarize, by sector name (e.g. "A9") and level 0-7 as in EvaluateWorld()
+struct SUMMARY_MAP
+{
+	ST::string sector;
+	UINT8      ubLevel;
+};
+
+/* Like EvaluateWorld() for several maps at once. The maps are parsed in
+ * parallel and the summaries written in the order given. Returns whether each
+ * map could be evaluated. */
+std::vector<bool> EvaluateWorlds(std::vector<SUMMARY_MAP> const& maps);
 void WriteSectorSummaryUpdate(const ST::string &filename, UINT8 ubLevel, SUMMARYFILE*);
 
 extern BOOLEAN gfMustForceUpdateAllMaps;
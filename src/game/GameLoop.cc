@@ -28,6 +28,7 @@
 #include "Video.h"
 #include "MemMan.h"
 #include "Button_System.h"
+#include "ScriptingExtensions.h"
 #include "Font_Control.h"
 #include "UILayout.h"
 #include "GameMode.h"
@@ -211,6 +212,8 @@ try
 		guiCurrentScreen = uiOldScreen;
 	}
 
+	HandleScriptingFrameEnd();
+
 	RefreshScreen();
 
 	guiGameCycleCounter++;
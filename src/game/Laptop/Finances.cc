@@ -23,6 +23,7 @@
 
 #include "ContentManager.h"
 #include "GameInstance.h"
+#include "Ledger.h"
 
 #include <string_theory/format>
 #include <string_theory/string>
@@ -114,15 +115,15 @@ enum{
 
 
 
-// sizeof one record
-#define RECORD_SIZE ( sizeof( UINT32 ) + sizeof( INT32 ) + sizeof( INT32 ) + sizeof( UINT8 ) + sizeof( UINT8 ) )
-
 
 
 
 // the financial record list
 static FinanceUnit* pFinanceListHead = NULL;
 
+// the balance and records of the finances file
+static Ledger g_finances_file([]() { return GCM->tempFiles(); }, FINANCES_DATA_FILE, FINANCE_HEADER_SIZE, FINANCE_RECORD_SIZE);
+
 // current page displayed
 static INT32 iCurrentPage = 0;
 
@@ -255,6 +256,7 @@ void GameInitFinances()
 {
 	// initialize finances on game start up
 	GCM->tempFiles()->deleteFile(FINANCES_DATA_FILE);
+	g_finances_file.Reset();
 	GetBalanceFromDisk( );
 }
 
@@ -874,8 +876,7 @@ static void DisplayFinancePageNumberAndDateRange(void)
 static void WriteBalanceToDisk(void)
 {
 	// will write the current balance to disk
-	AutoSGPFile hFileHandle(GCM->tempFiles()->openForWriting(FINANCES_DATA_FILE, false));
-	hFileHandle->write(&LaptopSaveInfo.iCurrentBalance, sizeof(INT32));
+	g_finances_file.SetHeader(reinterpret_cast<BYTE const*>(&LaptopSaveInfo.iCurrentBalance));
 }
 
 
@@ -883,21 +884,19 @@ static void WriteBalanceToDisk(void)
 // this procedure will open and read in data to the finance list	
 static void GetBalanceFromDisk(void)
 {
-	if (!GCM->tempFiles()->exists(FINANCES_DATA_FILE)) {
+	BYTE const* const header = g_finances_file.Header();
+	if (!header) {
 		LaptopSaveInfo.iCurrentBalance = 0;
 		return;
 	}
-	AutoSGPFile f(GCM->tempFiles()->openForReading(FINANCES_DATA_FILE));
 	// get balance from disk first
-	f->read(&LaptopSaveInfo.iCurrentBalance, sizeof(INT32));
+	memcpy(&LaptopSaveInfo.iCurrentBalance, header, sizeof(INT32));
 }
 
 
 // will write the current finance to disk
 static void AppendFinanceToEndOfFile(void)
 {
-	AutoSGPFile f(GCM->tempFiles()->openForAppend(FINANCES_DATA_FILE));
-
 	const FinanceUnit* const fu = pFinanceListHead;
 	BYTE  data[FINANCE_RECORD_SIZE];
 	DataWriter d{data};
@@ -908,26 +907,35 @@ static void AppendFinanceToEndOfFile(void)
 	INJ_I32(d, fu->iBalanceToDate);
 	Assert(d.getConsumed() == lengthof(data));
 
-	f->write(data, sizeof(data));
+	g_finances_file.Append(data);
 }
 
 
-// Grabs the size of the file and interprets number of pages it will take up
-static void SetLastPageInRecords(void)
+// reads record i of the finances file
+static void GetFinanceRecord(UINT32 const i, FinanceUnit& fu)
 {
-	AutoSGPFile f(GCM->tempFiles()->openForReading(FINANCES_DATA_FILE));
+	DataReader d{g_finances_file.Record(i)};
+	EXTR_U8(d, fu.ubCode);
+	EXTR_U8(d, fu.ubSecondCode);
+	EXTR_U32(d, fu.uiDate);
+	EXTR_I32(d, fu.iAmount);
+	EXTR_I32(d, fu.iBalanceToDate);
+	Assert(d.getConsumed() == FINANCE_RECORD_SIZE);
+}
 
-	const UINT32 size = f->size();
 
-	if (size < FINANCE_HEADER_SIZE + FINANCE_RECORD_SIZE)
+// Grabs the number of records and interprets number of pages they will take up
+static void SetLastPageInRecords(void)
+{
+	UINT32 const records = g_finances_file.Count();
+
+	if (records == 0)
 	{
 		guiLastPageInRecordsList = 0;
 		return;
 	}
 
-	guiLastPageInRecordsList =
-		(size - FINANCE_HEADER_SIZE - FINANCE_RECORD_SIZE) /
-		(FINANCE_RECORD_SIZE * NUM_RECORDS_PER_PAGE);
+	guiLastPageInRecordsList = (records - 1) / NUM_RECORDS_PER_PAGE;
 }
 
 
@@ -954,38 +962,16 @@ static void LoadInRecords(UINT32 const page)
 	ClearFinanceList();
 	if (page == 0) return; // check if bad page
 
-	AutoSGPFile f(GCM->tempFiles()->openForReading(FINANCES_DATA_FILE));
-
-	UINT32 const size = f->size();
-	if (size < FINANCE_HEADER_SIZE) return;
-
-	UINT32       records      = (size - FINANCE_HEADER_SIZE) / FINANCE_RECORD_SIZE;
+	UINT32 const records      = g_finances_file.Count();
 	UINT32 const skip_records = NUM_RECORDS_PER_PAGE * (page - 1);
 	if (records <= skip_records) return;
 
-	records -= skip_records;
-	f->seek(FINANCE_HEADER_SIZE + FINANCE_RECORD_SIZE * skip_records, FILE_SEEK_FROM_START);
-
-	if (records > NUM_RECORDS_PER_PAGE) records = NUM_RECORDS_PER_PAGE;
-	for (; records > 0; --records)
+	UINT32 const end = MIN(records, skip_records + NUM_RECORDS_PER_PAGE);
+	for (UINT32 i = skip_records; i != end; ++i)
 	{
-		BYTE data[FINANCE_RECORD_SIZE];
-		f->read(data, sizeof(data));
-
-		UINT8  code;
-		UINT8  second_code;
-		UINT32 date;
-		INT32  amount;
-		INT32  balance_to_date;
-		DataReader d{data};
-		EXTR_U8(d, code);
-		EXTR_U8(d, second_code);
-		EXTR_U32(d, date);
-		EXTR_I32(d, amount);
-		EXTR_I32(d, balance_to_date);
-		Assert(d.getConsumed() == lengthof(data));
-
-		ProcessAndEnterAFinacialRecord(code, date, amount, second_code, balance_to_date);
+		FinanceUnit r;
+		GetFinanceRecord(i, r);
+		ProcessAndEnterAFinacialRecord(r.ubCode, r.uiDate, r.iAmount, r.ubSecondCode, r.iBalanceToDate);
 	}
 }
 
@@ -1032,36 +1018,23 @@ static INT32 GetPreviousDaysBalance(void)
 
 	if (date_in_days < 2) return 0;
 
-	AutoSGPFile f(GCM->tempFiles()->openForReading(FINANCES_DATA_FILE));
-
 	INT32 balance = 0;
 	// start at the end, move back until Date / 24 * 60 on the record equals date_in_days - 2
 	// loop, make sure we don't pass beginning of file, if so, we have an error, and check for condifition above
-	for (UINT32 pos = f->size(); pos >= FINANCE_HEADER_SIZE + RECORD_SIZE;)
+	for (UINT32 i = g_finances_file.Count(); i-- != 0;)
 	{
-		f->seek(pos -= RECORD_SIZE, FILE_SEEK_FROM_START);
-
-		BYTE data[RECORD_SIZE];
-		f->read(data, sizeof(data));
-
-		UINT32 date;
-		INT32 balance_to_date;
-		DataReader d{data};
-		EXTR_SKIP(d, 2);
-		EXTR_U32(d, date);
-		EXTR_SKIP(d, 4);
-		EXTR_I32(d, balance_to_date);
-		Assert(d.getConsumed() == lengthof(data));
+		FinanceUnit r;
+		GetFinanceRecord(i, r);
 
 		// check to see if we are far enough
-		if (date / (24 * 60) == date_in_days - 2)
+		if (r.uiDate / (24 * 60) == date_in_days - 2)
 		{
-			balance = balance_to_date;
+			balance = r.iBalanceToDate;
 			break;
 		}
 
 		// there are no entries for the previous day
-		if (date / (24 * 60) < date_in_days - 2) break;
+		if (r.uiDate / (24 * 60) < date_in_days - 2) break;
 	}
 
 	return balance;
@@ -1073,30 +1046,17 @@ static INT32 GetTodaysBalance(void)
 	const UINT32 date_in_minutes = GetWorldTotalMin();
 	const UINT32 date_in_days    = date_in_minutes / (24 * 60);
 
-	AutoSGPFile f(GCM->tempFiles()->openForReading(FINANCES_DATA_FILE));
-
 	INT32 balance = 0;
 	// loop, make sure we don't pass beginning of file, if so, we have an error, and check for condifition above
-	for (UINT32 pos = f->size(); pos >= FINANCE_HEADER_SIZE + RECORD_SIZE;)
+	for (UINT32 i = g_finances_file.Count(); i-- != 0;)
 	{
-		f->seek(pos -= RECORD_SIZE, FILE_SEEK_FROM_START);
-
-		BYTE data[RECORD_SIZE];
-		f->read(data, sizeof(data));
-
-		UINT32 date;
-		INT32 balance_to_date;
-		DataReader d{data};
-		EXTR_SKIP(d, 2);
-		EXTR_U32(d, date);
-		EXTR_SKIP(d, 4);
-		EXTR_I32(d, balance_to_date);
-		Assert(d.getConsumed() == lengthof(data));
+		FinanceUnit r;
+		GetFinanceRecord(i, r);
 
 		// check to see if we are far enough
-		if (date / (24 * 60) == date_in_days - 1)
+		if (r.uiDate / (24 * 60) == date_in_days - 1)
 		{
-			balance = balance_to_date;
+			balance = r.iBalanceToDate;
 			break;
 		}
 	}
@@ -1112,41 +1072,26 @@ static INT32 GetPreviousDaysIncome(void)
 	const UINT32 date_in_minutes = GetWorldTotalMin();
 	const UINT32 date_in_days    = date_in_minutes / (24 * 60);
 
-	AutoSGPFile f(GCM->tempFiles()->openForReading(FINANCES_DATA_FILE));
-
 	INT32 iTotalPreviousIncome = 0;
 	// start at the end, move back until Date / 24 * 60 on the record is = date_in_days - 2
 	// loop, make sure we don't pass beginning of file, if so, we have an error, and check for condifition above
 	BOOLEAN fOkToIncrement = FALSE;
-	for (UINT32 pos = f->size(); pos >= FINANCE_HEADER_SIZE + RECORD_SIZE;)
+	for (UINT32 i = g_finances_file.Count(); i-- != 0;)
 	{
-		f->seek(pos -= RECORD_SIZE, FILE_SEEK_FROM_START);
-
-		BYTE data[RECORD_SIZE];
-		f->read(data, sizeof(data));
-
-		UINT8  code;
-		UINT32 date;
-		INT32  amount;
-		DataReader d{data};
-		EXTR_U8(d, code);
-		EXTR_SKIP(d, 1);
-		EXTR_U32(d, date);
-		EXTR_I32(d, amount);
-		EXTR_SKIP(d, 4);
-		Assert(d.getConsumed() == lengthof(data));
+		FinanceUnit r;
+		GetFinanceRecord(i, r);
 
 		// now ok to increment amount
-		if (date / (24 * 60) == date_in_days - 1) fOkToIncrement = TRUE;
+		if (r.uiDate / (24 * 60) == date_in_days - 1) fOkToIncrement = TRUE;
 
-		if (fOkToIncrement && (code == DEPOSIT_FROM_GOLD_MINE || code == DEPOSIT_FROM_SILVER_MINE))
+		if (fOkToIncrement && (r.ubCode == DEPOSIT_FROM_GOLD_MINE || r.ubCode == DEPOSIT_FROM_SILVER_MINE))
 		{
 			// increment total
-			iTotalPreviousIncome += amount;
+			iTotalPreviousIncome += r.iAmount;
 		}
 
 		// check to see if we are far enough
-		if (date / (24 * 60) <= date_in_days - 2) break;
+		if (r.uiDate / (24 * 60) <= date_in_days - 2) break;
 	}
 
 	return iTotalPreviousIncome;
@@ -1158,41 +1103,26 @@ static INT32 GetTodaysDaysIncome(void)
 	const UINT32 date_in_minutes = GetWorldTotalMin();
 	const UINT32 date_in_days    = date_in_minutes / (24 * 60);
 
-	AutoSGPFile f(GCM->tempFiles()->openForReading(FINANCES_DATA_FILE));
-
 	INT32 iTotalIncome = 0;
 	// loop, make sure we don't pass beginning of file, if so, we have an error, and check for condifition above
 	BOOLEAN fOkToIncrement = FALSE;
-	for (UINT32 pos = f->size(); pos >= FINANCE_HEADER_SIZE + RECORD_SIZE;)
+	for (UINT32 i = g_finances_file.Count(); i-- != 0;)
 	{
-		f->seek(pos -= RECORD_SIZE, FILE_SEEK_FROM_START);
-
-		BYTE data[RECORD_SIZE];
-		f->read(data, sizeof(data));
-
-		UINT8  code;
-		UINT32 date;
-		INT32  amount;
-		DataReader d{data};
-		EXTR_U8(d, code);
-		EXTR_SKIP(d, 1);
-		EXTR_U32(d, date);
-		EXTR_I32(d, amount);
-		EXTR_SKIP(d, 4);
-		Assert(d.getConsumed() == lengthof(data));
+		FinanceUnit r;
+		GetFinanceRecord(i, r);
 
 		// now ok to increment amount
-		if (date / (24 * 60) > date_in_days - 1) fOkToIncrement = TRUE;
+		if (r.uiDate / (24 * 60) > date_in_days - 1) fOkToIncrement = TRUE;
 
-		if (fOkToIncrement && (code == DEPOSIT_FROM_GOLD_MINE || code == DEPOSIT_FROM_SILVER_MINE))
+		if (fOkToIncrement && (r.ubCode == DEPOSIT_FROM_GOLD_MINE || r.ubCode == DEPOSIT_FROM_SILVER_MINE))
 		{
 			// increment total
-			iTotalIncome += amount;
+			iTotalIncome += r.iAmount;
 			fOkToIncrement = FALSE;
 		}
 
 		// check to see if we are far enough
-		if (date / (24 * 60) == date_in_days - 1) break;
+		if (r.uiDate / (24 * 60) == date_in_days - 1) break;
 	}
 
 	return iTotalIncome;
@@ -1219,43 +1149,28 @@ static INT32 GetTodaysOtherDeposits(void)
 	const UINT32 date_in_minutes = GetWorldTotalMin();
 	const UINT32 date_in_days    = date_in_minutes / (24 * 60);
 
-	AutoSGPFile f(GCM->tempFiles()->openForReading(FINANCES_DATA_FILE));
-
 	INT32 iTotalIncome = 0;
 	// loop, make sure we don't pass beginning of file, if so, we have an error, and check for condifition above
 	BOOLEAN fOkToIncrement = FALSE;
-	for (UINT32 pos = f->size(); pos >= FINANCE_HEADER_SIZE + RECORD_SIZE;)
+	for (UINT32 i = g_finances_file.Count(); i-- != 0;)
 	{
-		f->seek(pos -= RECORD_SIZE, FILE_SEEK_FROM_START);
-
-		BYTE data[RECORD_SIZE];
-		f->read(data, sizeof(data));
-
-		UINT8  code;
-		UINT32 date;
-		INT32  amount;
-		DataReader d{data};
-		EXTR_U8(d, code);
-		EXTR_SKIP(d, 1);
-		EXTR_U32(d, date);
-		EXTR_I32(d, amount);
-		EXTR_SKIP(d, 4);
-		Assert(d.getConsumed() == lengthof(data));
+		FinanceUnit r;
+		GetFinanceRecord(i, r);
 
 		// now ok to increment amount
-		if (date / (24 * 60) > date_in_days - 1) fOkToIncrement = TRUE;
+		if (r.uiDate / (24 * 60) > date_in_days - 1) fOkToIncrement = TRUE;
 
 		if (fOkToIncrement &&
-				(code != DEPOSIT_FROM_GOLD_MINE && code != DEPOSIT_FROM_SILVER_MINE) &&
-				amount > 0)
+				(r.ubCode != DEPOSIT_FROM_GOLD_MINE && r.ubCode != DEPOSIT_FROM_SILVER_MINE) &&
+				r.iAmount > 0)
 		{
 			// increment total
-			iTotalIncome += amount;
+			iTotalIncome += r.iAmount;
 			fOkToIncrement = FALSE;
 		}
 
 		// check to see if we are far enough
-		if (date / (24 * 60) == date_in_days - 1) break;
+		if (r.uiDate / (24 * 60) == date_in_days - 1) break;
 	}
 
 	return iTotalIncome;
@@ -1267,43 +1182,28 @@ static INT32 GetYesterdaysOtherDeposits(void)
 	const UINT32 iDateInMinutes = GetWorldTotalMin();
 	const UINT32 date_in_days   = iDateInMinutes / (24 * 60);
 
-	AutoSGPFile f(GCM->tempFiles()->openForReading(FINANCES_DATA_FILE));
-
 	INT32 iTotalPreviousIncome = 0;
 	// start at the end, move back until Date / 24 * 60 on the record is =  date_in_days - 2
 	// loop, make sure we don't pass beginning of file, if so, we have an error, and check for condifition above
 	BOOLEAN fOkToIncrement = FALSE;
-	for (UINT32 pos = f->size(); pos >= FINANCE_HEADER_SIZE + RECORD_SIZE;)
+	for (UINT32 i = g_finances_file.Count(); i-- != 0;)
 	{
-		f->seek(pos -= RECORD_SIZE, FILE_SEEK_FROM_START);
-
-		BYTE data[RECORD_SIZE];
-		f->read(data, sizeof(data));
-
-		UINT8  code;
-		UINT32 date;
-		INT32  amount;
-		DataReader d{data};
-		EXTR_U8(d, code);
-		EXTR_SKIP(d, 1);
-		EXTR_U32(d, date);
-		EXTR_I32(d, amount);
-		EXTR_SKIP(d, 4);
-		Assert(d.getConsumed() == lengthof(data));
+		FinanceUnit r;
+		GetFinanceRecord(i, r);
 
 		// now ok to increment amount
-		if (date / (24 * 60) == date_in_days - 1) fOkToIncrement = TRUE;
+		if (r.uiDate / (24 * 60) == date_in_days - 1) fOkToIncrement = TRUE;
 
 		if (fOkToIncrement &&
-				(code != DEPOSIT_FROM_GOLD_MINE && code != DEPOSIT_FROM_SILVER_MINE) &&
-				amount > 0)
+				(r.ubCode != DEPOSIT_FROM_GOLD_MINE && r.ubCode != DEPOSIT_FROM_SILVER_MINE) &&
+				r.iAmount > 0)
 		{
 			// increment total
-			iTotalPreviousIncome += amount;
+			iTotalPreviousIncome += r.iAmount;
 		}
 
 		// check to see if we are far enough
-		if (date / (24 * 60) <= date_in_days - 2) break;
+		if (r.uiDate / (24 * 60) <= date_in_days - 2) break;
 	}
 
 	return iTotalPreviousIncome;
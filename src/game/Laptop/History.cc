@@ -25,6 +25,7 @@
 
 #include "ContentManager.h"
 #include "GameInstance.h"
+#include "Ledger.h"
 
 #include <string_theory/format>
 #include <string_theory/string>
@@ -100,6 +101,9 @@ static INT32 iCurrentHistoryPage = 1;
 // the History record list
 static HistoryUnit* pHistoryListHead = NULL;
 
+// the records of the History file
+static Ledger g_history_file([]() { return GCM->tempFiles(); }, HISTORY_DATA_FILE, 0, SIZE_OF_HISTORY_FILE_RECORD);
+
 
 void ClearHistoryList( void );
 
@@ -126,6 +130,7 @@ void AddHistoryToPlayersLog(const UINT8 ubCode, const UINT8 ubSecondCode, const
 void GameInitHistory()
 {
 	GCM->tempFiles()->deleteFile(HISTORY_DATA_FILE);
+	g_history_file.Reset();
 }
 
 
@@ -343,33 +348,37 @@ static void ProcessAndEnterAHistoryRecord(const UINT8 ubCode, const UINT32 uiDat
 	*anchor = h;
 }
 
+// reads record i of the History file into the History list
+static void ReadHistoryRecord(UINT32 const i)
+{
+	UINT8  ubCode;
+	UINT8  ubSecondCode;
+	UINT32 uiDate;
+	INT16  sSectorX;
+	INT16  sSectorY;
+	INT8   bSectorZ;
+
+	DataReader d{g_history_file.Record(i)};
+	EXTR_U8(d, ubCode)
+	EXTR_U8(d, ubSecondCode)
+	EXTR_U32(d, uiDate)
+	EXTR_I16(d, sSectorX)
+	EXTR_I16(d, sSectorY)
+	EXTR_I8(d, bSectorZ)
+	EXTR_SKIP(d, 1)
+	Assert(d.getConsumed() == SIZE_OF_HISTORY_FILE_RECORD);
+
+	ProcessAndEnterAHistoryRecord(ubCode, uiDate, ubSecondCode, sSectorX, sSectorY, bSectorZ);
+}
+
+
 // open and read in data to the History list
 static void OpenAndReadHistoryFile(void)
 {
 	ClearHistoryList();
 
-	AutoSGPFile f(GCM->tempFiles()->openForReading(HISTORY_DATA_FILE));
-
-	UINT entry_count = f->size() / SIZE_OF_HISTORY_FILE_RECORD;
-	while (entry_count-- > 0)
-	{
-		UINT8  ubCode;
-		UINT8  ubSecondCode;
-		UINT32 uiDate;
-		INT16  sSectorX;
-		INT16  sSectorY;
-		INT8   bSectorZ;
-
-		f->read(&ubCode,       sizeof(UINT8));
-		f->read(&ubSecondCode, sizeof(UINT8));
-		f->read(&uiDate,       sizeof(UINT32));
-		f->read(&sSectorX,     sizeof(INT16));
-		f->read(&sSectorY,     sizeof(INT16));
-		f->read(&bSectorZ,     sizeof(INT8));
-		f->seek(1, FILE_SEEK_FROM_CURRENT);
-
-		ProcessAndEnterAHistoryRecord(ubCode, uiDate, ubSecondCode, sSectorX, sSectorY, bSectorZ);
-	}
+	UINT const entry_count = g_history_file.Count();
+	for (UINT i = 0; i != entry_count; ++i) ReadHistoryRecord(i);
 }
 
 
@@ -684,36 +693,12 @@ try
 	// check if bad page
 	if (uiPage == 0) return FALSE;
 
-	AutoSGPFile f(GCM->tempFiles()->openForReading(HISTORY_DATA_FILE));
-
-	UINT       entry_count = f->size() / SIZE_OF_HISTORY_FILE_RECORD;
+	UINT const entry_count = g_history_file.Count();
 	UINT const skip        = (uiPage - 1) * NUM_RECORDS_PER_PAGE;
 	if (entry_count <= skip) return FALSE;
 
-	f->seek(skip * SIZE_OF_HISTORY_FILE_RECORD, FILE_SEEK_FROM_START);
-	entry_count -= skip;
-
-	if (entry_count > NUM_RECORDS_PER_PAGE) entry_count = NUM_RECORDS_PER_PAGE;
-
-	while (entry_count-- > 0)
-	{
-		UINT8  ubCode;
-		UINT8  ubSecondCode;
-		UINT32 uiDate;
-		INT16  sSectorX;
-		INT16  sSectorY;
-		INT8   bSectorZ;
-
-		f->read(&ubCode,       sizeof(UINT8));
-		f->read(&ubSecondCode, sizeof(UINT8));
-		f->read(&uiDate,       sizeof(UINT32));
-		f->read(&sSectorX,     sizeof(INT16));
-		f->read(&sSectorY,     sizeof(INT16));
-		f->read(&bSectorZ,     sizeof(INT8));
-		f->seek(1, FILE_SEEK_FROM_CURRENT);
-
-		ProcessAndEnterAHistoryRecord(ubCode, uiDate,  ubSecondCode, sSectorX, sSectorY, bSectorZ);
-	}
+	UINT const end = MIN(entry_count, skip + NUM_RECORDS_PER_PAGE);
+	for (UINT i = skip; i != end; ++i) ReadHistoryRecord(i);
 
 	return TRUE;
 }
@@ -749,8 +734,6 @@ static void LoadPreviousHistoryPage(void)
 
 static void AppendHistoryToEndOfFile(void)
 {
-	AutoSGPFile f(GCM->tempFiles()->openForAppend(HISTORY_DATA_FILE));
-
 	const HistoryUnit* const h = pHistoryListHead;
 
 	BYTE  data[12];
@@ -764,7 +747,7 @@ static void AppendHistoryToEndOfFile(void)
 	INJ_SKIP(d, 1)
 	Assert(d.getConsumed() == lengthof(data));
 
-	f->write(data, sizeof(data));
+	g_history_file.Append(data);
 }
 
 
@@ -804,11 +787,9 @@ static ST::string GetQuestEndedString(const UINT8 ubQuestValue)
 
 static INT32 GetNumberOfHistoryPages(void)
 {
-	AutoSGPFile f(GCM->tempFiles()->openForReading(HISTORY_DATA_FILE));
-
-	const UINT32 uiFileSize = f->size();
+	UINT32 const entry_count = g_history_file.Count();
 
-	if (uiFileSize == 0) return 1;
+	if (entry_count == 0) return 1;
 
-	return (uiFileSize / SIZE_OF_HISTORY_FILE_RECORD + NUM_RECORDS_PER_PAGE - 1) / NUM_RECORDS_PER_PAGE;
+	return (entry_count + NUM_RECORDS_PER_PAGE - 1) / NUM_RECORDS_PER_PAGE;
 }
@@ -16,6 +16,7 @@
 #include "Cursors.h"
 #include "Event_Pump.h"
 #include "Laptop.h"
+#include "Ledger.h"
 #include "AIM.h"
 #include "AIMMembers.h"
 #include "AIMFacialIndex.h"
@@ -485,23 +486,20 @@ static void EnterLaptop(void)
 	// sub page
 	giCurrentSubPage = 0;
 
-	// load the laptop graphic and add it
-	guiLAPTOP = AddVideoObjectFromFile(LAPTOPDIR "/laptop3.sti");
-
-	// background for panel
-	guiLaptopBACKGROUND = AddVideoObjectFromFile(LAPTOPDIR "/taskbar.sti");
-
-	// background for panel
-	guiTITLEBARLAPTOP = AddVideoObjectFromFile(LAPTOPDIR "/programtitlebar.sti");
-
-	// lights for power and HD
-	guiLIGHTS = AddVideoObjectFromFile(LAPTOPDIR "/lights.sti");
-
-	// icons for title bars
-	guiTITLEBARICONS = AddVideoObjectFromFile(LAPTOPDIR "/icons.sti");
-
-	// load, blt and delete graphics
-	guiEmailWarning = AddVideoObjectFromFile(LAPTOPDIR "/newmailwarning.sti");
+	AddVideoObjectsFromFiles({
+		// the laptop graphic
+		{ &guiLAPTOP,           LAPTOPDIR "/laptop3.sti" },
+		// background for panel
+		{ &guiLaptopBACKGROUND, LAPTOPDIR "/taskbar.sti" },
+		// background for panel
+		{ &guiTITLEBARLAPTOP,   LAPTOPDIR "/programtitlebar.sti" },
+		// lights for power and HD
+		{ &guiLIGHTS,           LAPTOPDIR "/lights.sti" },
+		// icons for title bars
+		{ &guiTITLEBARICONS,    LAPTOPDIR "/icons.sti" },
+		// load, blt and delete graphics
+		{ &guiEmailWarning,     LAPTOPDIR "/newmailwarning.sti" },
+	});
 	// load background
 	LoadDesktopBackground();
 
@@ -1654,11 +1652,13 @@ void SetBookMark(INT32 iBookId)
 static void LoadBookmark(void)
 {
 	// grab download bars too
-	guiDOWNLOADTOP = AddVideoObjectFromFile(LAPTOPDIR "/downloadtop.sti");
-	guiDOWNLOADMID = AddVideoObjectFromFile(LAPTOPDIR "/downloadmid.sti");
-	guiDOWNLOADBOT = AddVideoObjectFromFile(LAPTOPDIR "/downloadbot.sti");
-	guiBOOKMARK    = AddVideoObjectFromFile(LAPTOPDIR "/webpages.sti");
-	guiBOOKHIGH    = AddVideoObjectFromFile(LAPTOPDIR "/hilite.sti");
+	AddVideoObjectsFromFiles({
+		{ &guiDOWNLOADTOP, LAPTOPDIR "/downloadtop.sti" },
+		{ &guiDOWNLOADMID, LAPTOPDIR "/downloadmid.sti" },
+		{ &guiDOWNLOADBOT, LAPTOPDIR "/downloadbot.sti" },
+		{ &guiBOOKMARK,    LAPTOPDIR "/webpages.sti" },
+		{ &guiBOOKHIGH,    LAPTOPDIR "/hilite.sti" },
+	});
 }
 
 
@@ -3272,6 +3272,7 @@ void ClearOutTempLaptopFiles(void)
 	GCM->tempFiles()->deleteFile(FILES_DATA_FILE);
 	GCM->tempFiles()->deleteFile(FINANCES_DATA_FILE);
 	GCM->tempFiles()->deleteFile(HISTORY_DATA_FILE);
+	ResetLedgers();
 }
 
 
@@ -0,0 +1,179 @@
+#include "Ledger.h"
+
+#include "Debug.h"
+#include "DirFs.h"
+
+#include <algorithm>
+#include <string.h>
+
+
+static std::vector<Ledger*>& Ledgers()
+{
+	static std::vector<Ledger*> ledgers;
+	return ledgers;
+}
+
+
+Ledger::Ledger(std::function<DirFs*()> dir, ST::string filename, UINT32 const header_size, UINT32 const record_size) :
+	m_dir(std::move(dir)),
+	m_filename(std::move(filename)),
+	m_header_size(header_size),
+	m_record_size(record_size),
+	m_open(false),
+	m_has_header(false),
+	m_header_dirty(false),
+	m_count(0),
+	m_on_disk(0),
+	m_page_reads(0)
+{
+	Ledgers().push_back(this);
+}
+
+
+Ledger::~Ledger()
+{
+	std::vector<Ledger*>& l = Ledgers();
+	l.erase(std::remove(l.begin(), l.end(), this), l.end());
+}
+
+
+void Ledger::Open()
+{
+	if (m_open) return;
+	m_open = true;
+
+	m_header.assign(m_header_size, 0);
+	m_has_header = false;
+	m_on_disk    = 0;
+
+	DirFs* const dir = m_dir();
+	if (dir->exists(m_filename))
+	{
+		AutoSGPFile f(dir->openForReading(m_filename));
+		UINT32 const size = f->size();
+		if (size >= m_header_size)
+		{
+			f->read(m_header.data(), m_header_size);
+			m_has_header = true;
+			m_on_disk    = (size - m_header_size) / m_record_size;
+		}
+	}
+
+	m_count = m_on_disk;
+	m_pages.clear();
+	m_pages.resize((m_count + LEDGER_PAGE_RECORDS - 1) / LEDGER_PAGE_RECORDS);
+}
+
+
+BYTE* Ledger::Page(UINT32 const page)
+{
+	if (page == m_pages.size()) m_pages.emplace_back();
+
+	std::unique_ptr<BYTE[]>& p = m_pages[page];
+	if (!p)
+	{
+		p.reset(new BYTE[LEDGER_PAGE_RECORDS * m_record_size]{});
+
+		UINT32 const first = page * LEDGER_PAGE_RECORDS;
+		if (first < m_on_disk)
+		{
+			UINT32 const n = std::min<UINT32>(m_on_disk - first, LEDGER_PAGE_RECORDS);
+			AutoSGPFile f(m_dir()->openForReading(m_filename));
+			f->seek(m_header_size + first * m_record_size, FILE_SEEK_FROM_START);
+			f->read(p.get(), n * m_record_size);
+			++m_page_reads;
+		}
+	}
+	return p.get();
+}
+
+
+UINT32 Ledger::Count()
+{
+	Open();
+	return m_count;
+}
+
+
+BYTE const* Ledger::Record(UINT32 const i)
+{
+	Open();
+	Assert(i < m_count);
+	return Page(i / LEDGER_PAGE_RECORDS) + i % LEDGER_PAGE_RECORDS * m_record_size;
+}
+
+
+void Ledger::Append(BYTE const* const record)
+{
+	Open();
+	BYTE* const dst = Page(m_count / LEDGER_PAGE_RECORDS) + m_count % LEDGER_PAGE_RECORDS * m_record_size;
+	memcpy(dst, record, m_record_size);
+	++m_count;
+}
+
+
+BYTE const* Ledger::Header()
+{
+	Open();
+	return m_has_header ? m_header.data() : NULL;
+}
+
+
+void Ledger::SetHeader(BYTE const* const header)
+{
+	Open();
+	memcpy(m_header.data(), header, m_header_size);
+	m_has_header   = true;
+	m_header_dirty = true;
+}
+
+
+void Ledger::Flush()
+{
+	if (!m_open) return;
+	if (!m_header_dirty && m_on_disk == m_count) return;
+
+	AutoSGPFile f(m_dir()->openForReadWrite(m_filename));
+	// The records only start after a header, so there is one once there are records
+	if (m_header_dirty || m_on_disk == 0)
+	{
+		f->seek(0, FILE_SEEK_FROM_START);
+		f->write(m_header.data(), m_header_size);
+		m_has_header   = true;
+		m_header_dirty = false;
+	}
+
+	f->seek(m_header_size + m_on_disk * m_record_size, FILE_SEEK_FROM_START);
+	while (m_on_disk != m_count)
+	{
+		UINT32 const page   = m_on_disk / LEDGER_PAGE_RECORDS;
+		UINT32 const offset = m_on_disk % LEDGER_PAGE_RECORDS;
+		UINT32 const n      = std::min<UINT32>(m_count - m_on_disk, LEDGER_PAGE_RECORDS - offset);
+		f->write(m_pages[page].get() + offset * m_record_size, n * m_record_size);
+		m_on_disk += n;
+	}
+}
+
+
+void Ledger::Reset()
+{
+	m_open         = false;
+	m_has_header   = false;
+	m_header_dirty = false;
+	m_header.clear();
+	m_count        = 0;
+	m_on_disk      = 0;
+	m_pages.clear();
+}
+
+
+void FlushLedgers()
+{
+	for (Ledger* const l : Ledgers()) l->Flush();
+}
+
+
+void ResetLedgers()
+{
+	for (Ledger* const l : Ledgers()) l->Reset();
+}
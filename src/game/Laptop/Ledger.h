@@ -0,0 +1,79 @@
+#ifndef __LEDGER_H
+#define __LEDGER_H
+
+#include "Types.h"
+
+#include <functional>
+#include <memory>
+#include <string_theory/string>
+#include <vector>
+
+class DirFs;
+
+// Records read from the file at a time
+#define LEDGER_PAGE_RECORDS	256
+
+
+/* An append-only file of fixed size records behind a fixed size header, like
+ * the laptop history and finances. Record i lies at header + i * record size,
+ * so any record is found without reading the ones before it. The records are
+ * read a page at a time when they are first needed and kept in memory.
+ * Appended records and header changes stay in memory until Flush() writes
+ * them, which has to happen before the file is copied into a saved game. */
+class Ledger
+{
+public:
+	Ledger(std::function<DirFs*()> dir, ST::string filename, UINT32 header_size, UINT32 record_size);
+	~Ledger();
+
+	Ledger(Ledger const&) = delete;
+	Ledger& operator=(Ledger const&) = delete;
+
+	UINT32 Count();
+
+	/* Returns record i, which stays valid until Reset(). Appending never moves
+	 * the records already there. */
+	BYTE const* Record(UINT32 i);
+
+	void Append(BYTE const* record);
+
+	// Returns the header, NULL if the file has none yet
+	BYTE const* Header();
+	void SetHeader(BYTE const* header);
+
+	// Writes the appended records and the header if they changed
+	void Flush();
+
+	/* Forgets everything read or appended, for when the file was replaced or
+	 * deleted behind the ledger's back */
+	void Reset();
+
+	// Number of times a page was read from the file
+	UINT32 PageReads() const { return m_page_reads; }
+
+private:
+	void Open();
+	BYTE* Page(UINT32 page);
+
+	std::function<DirFs*()>           m_dir;
+	ST::string                        m_filename;
+	UINT32                            m_header_size;
+	UINT32                            m_record_size;
+	bool                              m_open;     // the file size was looked at
+	bool                              m_has_header;
+	bool                              m_header_dirty;
+	std::vector<BYTE>                 m_header;
+	UINT32                            m_count;    // records, appended ones included
+	UINT32                            m_on_disk;  // records in the file
+	std::vector<std::unique_ptr<BYTE[]>> m_pages; // NULL if not read yet
+	UINT32                            m_page_reads;
+};
+
+
+// Flushes all ledgers, before the files are saved
+void FlushLedgers();
+
+// Resets all ledgers, when the files are replaced by the ones of a saved game
+void ResetLedgers();
+
+#endif
@@ -0,0 +1,142 @@
+#include "gtest/gtest.h"
+
+#include "Ledger.h"
+#include "DirFs.h"
+#include "FileMan.h"
+
+#include <string.h>
+
+
+#define TEST_HEADER_SIZE	4
+#define TEST_RECORD_SIZE	14
+#define TEST_RECORDS	100000
+
+
+static void MakeRecord(UINT32 const i, BYTE rec[TEST_RECORD_SIZE])
+{
+	for (UINT32 k = 0; k != TEST_RECORD_SIZE; ++k) rec[k] = BYTE(i * 31 + k * 7 + (i >> 8));
+	memcpy(rec, &i, sizeof(i));
+}
+
+
+static bool IsRecord(BYTE const* const rec, UINT32 const i)
+{
+	BYTE expected[TEST_RECORD_SIZE];
+	MakeRecord(i, expected);
+	return memcmp(rec, expected, TEST_RECORD_SIZE) == 0;
+}
+
+
+TEST(LedgerTest, appendsFlushesAndReadsBackPages)
+{
+	RustPointer<TempDir> tempDir(TempDir_create());
+	ASSERT_NE(tempDir.get(), nullptr);
+	RustPointer<char> tempPath(TempDir_path(tempDir.get()));
+	ASSERT_NE(tempPath.get(), nullptr);
+	DirFs dir(tempPath.get());
+	auto getDir = [&dir]() { return &dir; };
+
+	{
+		Ledger l(getDir, "ledger.dat", TEST_HEADER_SIZE, TEST_RECORD_SIZE);
+		EXPECT_EQ(l.Count(), 0u);
+		EXPECT_EQ(l.Header(), nullptr);
+
+		BYTE rec[TEST_RECORD_SIZE];
+		for (UINT32 i = 0; i != TEST_RECORDS; ++i)
+		{
+			MakeRecord(i, rec);
+			l.Append(rec);
+		}
+		EXPECT_EQ(l.Count(), UINT32(TEST_RECORDS));
+		EXPECT_TRUE(IsRecord(l.Record(0), 0));
+		EXPECT_TRUE(IsRecord(l.Record(TEST_RECORDS - 1), TEST_RECORDS - 1));
+
+		// Nothing is written before the flush
+		EXPECT_FALSE(dir.exists("ledger.dat"));
+		l.Flush();
+		EXPECT_EQ(l.PageReads(), 0u);
+	}
+
+	{
+		AutoSGPFile f(dir.openForReading("ledger.dat"));
+		EXPECT_EQ(f->size(), UINT32(TEST_HEADER_SIZE + TEST_RECORDS * TEST_RECORD_SIZE));
+	}
+
+	Ledger l(getDir, "ledger.dat", TEST_HEADER_SIZE, TEST_RECORD_SIZE);
+	ASSERT_EQ(l.Count(), UINT32(TEST_RECORDS));
+	ASSERT_NE(l.Header(), nullptr);
+	EXPECT_EQ(l.PageReads(), 0u);
+
+	// Any record is read without the ones before it
+	EXPECT_TRUE(IsRecord(l.Record(77777), 77777));
+	EXPECT_EQ(l.PageReads(), 1u);
+	EXPECT_TRUE(IsRecord(l.Record(77777 / LEDGER_PAGE_RECORDS * LEDGER_PAGE_RECORDS), 77777 / LEDGER_PAGE_RECORDS * LEDGER_PAGE_RECORDS));
+	EXPECT_EQ(l.PageReads(), 1u);
+
+	// Every page is read once, however often its records are looked at
+	for (UINT32 pass = 0; pass != 2; ++pass)
+	{
+		for (UINT32 i = TEST_RECORDS; i-- != 0;)
+		{
+			ASSERT_TRUE(IsRecord(l.Record(i), i)) << i;
+		}
+	}
+	UINT32 const pages = (TEST_RECORDS + LEDGER_PAGE_RECORDS - 1) / LEDGER_PAGE_RECORDS;
+	EXPECT_EQ(l.PageReads(), pages);
+
+	// Appending continues the partially filled last page
+	BYTE rec[TEST_RECORD_SIZE];
+	MakeRecord(TEST_RECORDS, rec);
+	l.Append(rec);
+	l.Flush();
+
+	Ledger l2(getDir, "ledger.dat", TEST_HEADER_SIZE, TEST_RECORD_SIZE);
+	ASSERT_EQ(l2.Count(), UINT32(TEST_RECORDS + 1));
+	EXPECT_TRUE(IsRecord(l2.Record(TEST_RECORDS), TEST_RECORDS));
+	EXPECT_TRUE(IsRecord(l2.Record(TEST_RECORDS - 1), TEST_RECORDS - 1));
+}
+
+
+TEST(LedgerTest, keepsHeaderAndForgetsOnReset)
+{
+	RustPointer<TempDir> tempDir(TempDir_create());
+	ASSERT_NE(tempDir.get(), nullptr);
+	RustPointer<char> tempPath(TempDir_path(tempDir.get()));
+	ASSERT_NE(tempPath.get(), nullptr);
+	DirFs dir(tempPath.get());
+	auto getDir = [&dir]() { return &dir; };
+
+	Ledger l(getDir, "header.dat", TEST_HEADER_SIZE, TEST_RECORD_SIZE);
+	BYTE const header[TEST_HEADER_SIZE] = { 1, 2, 3, 4 };
+	l.SetHeader(header);
+	ASSERT_NE(l.Header(), nullptr);
+	EXPECT_EQ(memcmp(l.Header(), header, TEST_HEADER_SIZE), 0);
+	EXPECT_EQ(l.Count(), 0u);
+
+	// Only the header is written without records
+	l.Flush();
+	{
+		AutoSGPFile f(dir.openForReading("header.dat"));
+		EXPECT_EQ(f->size(), UINT32(TEST_HEADER_SIZE));
+	}
+
+	BYTE rec[TEST_RECORD_SIZE];
+	MakeRecord(5, rec);
+	l.Append(rec);
+	BYTE const header2[TEST_HEADER_SIZE] = { 9, 8, 7, 6 };
+	l.SetHeader(header2);
+	FlushLedgers();
+
+	Ledger l2(getDir, "header.dat", TEST_HEADER_SIZE, TEST_RECORD_SIZE);
+	ASSERT_EQ(l2.Count(), 1u);
+	EXPECT_TRUE(IsRecord(l2.Record(0), 5));
+	ASSERT_NE(l2.Header(), nullptr);
+	EXPECT_EQ(memcmp(l2.Header(), header2, TEST_HEADER_SIZE), 0);
+
+	// Replace the file behind the ledgers' back, like loading a game does
+	dir.deleteFile("header.dat");
+	ResetLedgers();
+	EXPECT_EQ(l.Count(), 0u);
+	EXPECT_EQ(l.Header(), nullptr);
+	EXPECT_EQ(l2.Count(), 0u);
+}
@@ -44,6 +44,7 @@
 #include "JAScreens.h"
 #include "Keys.h"
 #include "Laptop.h"
+#include "Ledger.h"
 #include "Lighting.h"
 #include "LightEffects.h"
 #include "Loading_Screen.h"
@@ -390,6 +391,9 @@ BOOLEAN SaveGame(const ST::string& saveName, const ST::string& gameDesc)
 
 		SaveSoldierStructure(f);
 
+		// The laptop files have to be complete before they are copied
+		FlushLedgers();
+
 		SaveFilesToSavedGame(FINANCES_DATA_FILE, f);
 
 		SaveFilesToSavedGame(HISTORY_DATA_FILE, f);
@@ -691,6 +695,7 @@ void LoadSavedGame(const ST::string &saveName)
 
 	ST::string savegameFilename = GetSaveGamePath(saveName);
 	AutoSGPFile f(GCM->saveGameFiles()->openForReading(savegameFilename));
+	f->bufferReads();
 
 	SAVED_GAME_HEADER SaveGameHeader;
 	bool stracLinuxFormat;
@@ -784,6 +789,7 @@ void LoadSavedGame(const ST::string &saveName)
 	LoadSoldierStructure(f, version, stracLinuxFormat);
 
 	BAR(1, "Finances Data File...");
+	ResetLedgers();
 	LoadFilesFromSavedGame(FINANCES_DATA_FILE, f);
 
 	BAR(1, "History File...");
@@ -77,6 +77,7 @@
 #include "VSurface.h"
 #include <algorithm>
 #include <iterator>
+#include <vector>
 #include <string_theory/format>
 #include <string_theory/string>
 struct PopUpBox;
@@ -240,6 +241,22 @@ BOOLEAN gfReEvaluateEveryonesNothingToDo = FALSE;
 // a list of which sectors have characters
 static BOOLEAN fSectorsWithSoldiers[MAP_WORLD_X * MAP_WORLD_Y][4];
 
+// the team grouped by sector, rebuilt for every hourly update of the assignments
+struct AssignmentSector
+{
+	INT16 x;
+	INT16 y;
+	INT8  z;
+	SOLDIERTYPE* const* first;
+	SOLDIERTYPE* const* last;
+
+	SOLDIERTYPE* const* begin() const { return first; }
+	SOLDIERTYPE* const* end()   const { return last;  }
+};
+
+static std::vector<SOLDIERTYPE*>     gAssignmentRoster;
+static std::vector<AssignmentSector> gAssignmentSectors;
+
 
 void InitSectorsWithSoldiersList( void )
 {
@@ -261,6 +278,43 @@ void BuildSectorsWithSoldiersList( void )
 }
 
 
+static UINT32 AssignmentSectorKey(SOLDIERTYPE const& s)
+{
+	return (s.sSectorX * MAP_WORLD_Y + s.sSectorY) * 4 + s.bSectorZ;
+}
+
+
+/* Sorts the team by sector once, so the per sector passes only visit the
+ * soldiers actually there instead of walking the whole team for every
+ * occupied sector.  Sectors come in x, y, z order and soldiers keep their team
+ * order within a sector, which is the order the full team walks had. */
+static void BuildAssignmentRoster()
+{
+	gAssignmentRoster.clear();
+	gAssignmentSectors.clear();
+	FOR_EACH_IN_TEAM(s, OUR_TEAM)
+	{
+		gAssignmentRoster.push_back(s);
+	}
+	std::stable_sort(gAssignmentRoster.begin(), gAssignmentRoster.end(),
+		[](SOLDIERTYPE const* const a, SOLDIERTYPE const* const b)
+		{
+			return AssignmentSectorKey(*a) < AssignmentSectorKey(*b);
+		});
+
+	SOLDIERTYPE* const* const end = gAssignmentRoster.data() + gAssignmentRoster.size();
+	for (SOLDIERTYPE* const* i = gAssignmentRoster.data(); i != end;)
+	{
+		SOLDIERTYPE const& s   = **i;
+		UINT32 const       key = AssignmentSectorKey(s);
+		SOLDIERTYPE* const* last = i;
+		while (last != end && AssignmentSectorKey(**last) == key) ++last;
+		gAssignmentSectors.push_back(AssignmentSector{ s.sSectorX, s.sSectorY, s.bSectorZ, i, last });
+		i = last;
+	}
+}
+
+
 void ChangeSoldiersAssignment( SOLDIERTYPE *pSoldier, INT8 bAssignment )
 {
 	// This is the most basic assignment-setting function.  It must be called before setting any subsidiary
@@ -896,19 +950,17 @@ bool IsCharacterInTransit(SOLDIERTYPE const& s)
 
 
 static void CheckForAndHandleHospitalPatients(void);
-static void HandleDoctorsInSector(INT16 x, INT16 y, INT8 z);
+static void HandleDoctorsInSector(AssignmentSector const&);
 static void HandleNaturalHealing(void);
-static void HandleRepairmenInSector(INT16 sX, INT16 sY, INT8 bZ);
+static void HandleRepairmenInSector(AssignmentSector const&);
 static void HandleRestFatigueAndSleepStatus();
-static void HandleTrainingInSector(INT16 sMapX, INT16 sMapY, INT8 bZ);
+static void HandleTrainingInSector(AssignmentSector const&);
 static void ReportTrainersTraineesWithoutPartners(void);
 static void UpdatePatientsWhoAreDoneHealing();
 
 
 void UpdateAssignments()
 {
-	INT8 sX,sY, bZ;
-
 	// init sectors with soldiers list
 	InitSectorsWithSoldiersList( );
 
@@ -932,27 +984,18 @@ void UpdateAssignments()
 	// check for mercs tired enough go to sleep, and wake up well-rested mercs
 	HandleRestFatigueAndSleepStatus( );
 
-	// run through sectors and handle each type in sector
-	for(sX = 0 ; sX < MAP_WORLD_X; sX++ )
+	// run through sectors with soldiers and handle each type in sector
+	BuildAssignmentRoster();
+	for (AssignmentSector const& sector : gAssignmentSectors)
 	{
-		for( sY =0; sY < MAP_WORLD_X; sY++ )
-		{
-			for( bZ = 0; bZ < 4; bZ++)
-			{
-				// is there anyone in this sector?
-				if (fSectorsWithSoldiers[sX + sY * MAP_WORLD_X][bZ])
-				{
-					// handle any doctors
-					HandleDoctorsInSector( sX, sY, bZ );
+		// handle any doctors
+		HandleDoctorsInSector(sector);
 
-					// handle any repairmen
-					HandleRepairmenInSector( sX, sY, bZ );
+		// handle any repairmen
+		HandleRepairmenInSector(sector);
 
-					// handle any training
-					HandleTrainingInSector( sX, sY, bZ );
-				}
-			}
-		}
+		// handle any training
+		HandleTrainingInSector(sector);
 	}
 
 	// check to see if anyone is done healing?
@@ -1170,17 +1213,14 @@ static void HealCharacters(SOLDIERTYPE* pDoctor);
 
 
 // handle doctor in this sector
-static void HandleDoctorsInSector(INT16 const x, INT16 const y, INT8 const z)
+static void HandleDoctorsInSector(AssignmentSector const& sector)
 {
 	// will handle doctor/patient relationship in sector
 
 	// go through list of characters, find all doctors in sector
-	FOR_EACH_IN_TEAM(i, OUR_TEAM)
+	for (SOLDIERTYPE* const i : sector)
 	{
 		SOLDIERTYPE& s = *i;
-		if (s.sSectorX != x)         continue;
-		if (s.sSectorY != y)         continue;
-		if (s.bSectorZ != z)         continue;
 		if (s.bAssignment != DOCTOR) continue;
 		if (s.fMercAsleep)           continue;
 		MakeSureMedKitIsInHand(&s);
@@ -1579,14 +1619,11 @@ static void HandleRepairBySoldier(SOLDIERTYPE&);
 
 
 // handle any repair man in sector
-static void HandleRepairmenInSector(INT16 const x, INT16 const y, INT8 const z)
+static void HandleRepairmenInSector(AssignmentSector const& sector)
 {
-	FOR_EACH_IN_TEAM(i, OUR_TEAM)
+	for (SOLDIERTYPE* const i : sector)
 	{
 		SOLDIERTYPE& s = *i;
-		if (s.sSectorX    != x)      continue;
-		if (s.sSectorY    != y)      continue;
-		if (s.bSectorZ    != z)      continue;
 		if (s.bAssignment != REPAIR) continue;
 		if (s.fMercAsleep)           continue;
 
@@ -1851,7 +1888,7 @@ static void HandleRepairBySoldier(SOLDIERTYPE& s)
 		StatChange(s, DEXTAMT,   repair_pts_used / 2, FROM_SUCCESS);
 
 		// check if kit damaged/depleted
-		if (Random(100) < repair_pts_used * 5) // CJC: added a x5 as this wasn't going down anywhere fast enough
+		if (Random(100, RANDOM_STRATEGIC) < repair_pts_used * 5) // CJC: added a x5 as this wasn't going down anywhere fast enough
 		{
 			// kit item damaged/depleted, burn up points of toolkit..which is in right hand
 			UseKitPoints(s.inv[HANDPOS], 1, s);
@@ -1986,13 +2023,14 @@ static BOOLEAN TrainTownInSector(SOLDIERTYPE* pTrainer, INT16 sMapX, INT16 sMapY
 
 
 // ONCE PER HOUR, will handle ALL kinds of training (self, teaching, and town) in this sector
-static void HandleTrainingInSector(const INT16 sMapX, const INT16 sMapY, const INT8 bZ)
+static void HandleTrainingInSector(AssignmentSector const& sector)
 {
-	UINT8 ubStat;
+	const INT16 sMapX = sector.x;
+	const INT16 sMapY = sector.y;
+	const INT8  bZ    = sector.z;
 	BOOLEAN fAtGunRange = FALSE;
 	INT16 sTotalTrainingPts = 0;
 	INT16 sTrainingPtsDueToInstructor = 0;
-	INT16 sBestTrainingPts;
 	INT16 sTownTrainingPts;
 	TOWN_TRAINER_TYPE TownTrainer[ MAX_CHARACTER_COUNT ];
 	UINT8 ubTownTrainers;
@@ -2022,87 +2060,78 @@ static void HandleTrainingInSector(const INT16 sMapX, const INT16 sMapY, const I
 	// init trainer list
 	const SOLDIERTYPE* pStatTrainerList[NUM_TRAINABLE_STATS]; // can't have more "best" trainers than trainable stats
 	std::fill(std::begin(pStatTrainerList), std::end(pStatTrainerList), nullptr);
+	INT16 sBestTrainingPts[NUM_TRAINABLE_STATS];
+	std::fill(std::begin(sBestTrainingPts), std::end(sBestTrainingPts), -1);
 
 	// build list of teammate trainers in this sector.
 
 	// Only the trainer with the HIGHEST training ability in each stat is effective.  This is mainly to avoid having to
 	// sort them from highest to lowest if some form of trainer degradation formula was to be used for multiple trainers.
 
-	// for each trainable stat
-	for (ubStat = 0; ubStat < NUM_TRAINABLE_STATS; ubStat++)
+	// search sector for active instructors, keeping the best one for each stat
+	for (const SOLDIERTYPE* const pTrainer : sector)
 	{
-		sBestTrainingPts = -1;
-
-		// search team for active instructors in this sector
-		CFOR_EACH_IN_TEAM(pTrainer, OUR_TEAM)
+		// if he's training teammates
+		if (pTrainer->bAssignment == TRAIN_TEAMMATE &&
+				EnoughTimeOnAssignment(*pTrainer)       &&
+				!pTrainer->fMercAsleep)
 		{
-			if (pTrainer->sSectorX == sMapX && pTrainer->sSectorY == sMapY && pTrainer->bSectorZ == bZ)
-			{
-				// if he's training teammates in this stat
-				if (pTrainer->bAssignment == TRAIN_TEAMMATE &&
-						pTrainer->bTrainStat  == ubStat         &&
-						EnoughTimeOnAssignment(*pTrainer)       &&
-						!pTrainer->fMercAsleep)
-				{
-					sTrainingPtsDueToInstructor = GetBonusTrainingPtsDueToInstructor( pTrainer, NULL, ubStat, fAtGunRange, &usMaxPts );
+			const INT8 bStat = pTrainer->bTrainStat;
+			if (bStat < 0 || bStat >= NUM_TRAINABLE_STATS) continue;
 
-					// if he's the best trainer so far for this stat
-					if (sTrainingPtsDueToInstructor > sBestTrainingPts)
-					{
-						// then remember him as that, and the points he scored
-						pStatTrainerList[ ubStat ] = pTrainer;
-						sBestTrainingPts = sTrainingPtsDueToInstructor;
-					}
-				}
+			sTrainingPtsDueToInstructor = GetBonusTrainingPtsDueToInstructor( pTrainer, NULL, bStat, fAtGunRange, &usMaxPts );
+
+			// if he's the best trainer so far for this stat
+			if (sTrainingPtsDueToInstructor > sBestTrainingPts[bStat])
+			{
+				// then remember him as that, and the points he scored
+				pStatTrainerList[bStat] = pTrainer;
+				sBestTrainingPts[bStat] = sTrainingPtsDueToInstructor;
 			}
 		}
 	}
 
 
-	// now search team for active self-trainers in this sector
-	FOR_EACH_IN_TEAM(pStudent, OUR_TEAM)
+	// now search sector for active self-trainers
+	for (SOLDIERTYPE* const pStudent : sector)
 	{
-		// see if this merc is active and in the same sector
-		if (pStudent->sSectorX == sMapX && pStudent->sSectorY == sMapY && pStudent->bSectorZ == bZ)
+		// if he's training himself (alone, or by others), then he's a student
+		if ( ( pStudent -> bAssignment == TRAIN_SELF ) || ( pStudent -> bAssignment == TRAIN_BY_OTHER ) )
 		{
-			// if he's training himself (alone, or by others), then he's a student
-			if ( ( pStudent -> bAssignment == TRAIN_SELF ) || ( pStudent -> bAssignment == TRAIN_BY_OTHER ) )
+			if (EnoughTimeOnAssignment(*pStudent) && !pStudent->fMercAsleep)
 			{
-				if (EnoughTimeOnAssignment(*pStudent) && !pStudent->fMercAsleep)
+				// figure out how much the grunt can learn in one training period
+				sTotalTrainingPts = GetSoldierTrainingPts( pStudent, pStudent -> bTrainStat, fAtGunRange, &usMaxPts );
+
+				// if he's getting help
+				if ( pStudent -> bAssignment == TRAIN_BY_OTHER )
 				{
-					// figure out how much the grunt can learn in one training period
-					sTotalTrainingPts = GetSoldierTrainingPts( pStudent, pStudent -> bTrainStat, fAtGunRange, &usMaxPts );
+					// grab the pointer to the (potential) trainer for this stat
+					const SOLDIERTYPE* const pTrainer = pStatTrainerList[pStudent->bTrainStat];
 
-					// if he's getting help
-					if ( pStudent -> bAssignment == TRAIN_BY_OTHER )
+					// if this stat HAS a trainer in sector at all
+					if (pTrainer != NULL)
 					{
-						// grab the pointer to the (potential) trainer for this stat
-						const SOLDIERTYPE* const pTrainer = pStatTrainerList[pStudent->bTrainStat];
-
-						// if this stat HAS a trainer in sector at all
-						if (pTrainer != NULL)
-						{
 /* Assignment distance limits removed.  Sep/11/98.  ARM
-							// if this sector either ISN'T currently loaded, or it is but the trainer is close enough to the student
-							if ( ( sMapX != gWorldSectorX ) || ( sMapY != gWorldSectorY ) || ( pStudent -> bSectorZ != gbWorldSectorZ ) ||
-									PythSpacesAway(pStudent->sGridNo, pTrainer->sGridNo) < MAX_DISTANCE_FOR_TRAINING &&
-									EnoughTimeOnAssignment(*pTrainer))
+						// if this sector either ISN'T currently loaded, or it is but the trainer is close enough to the student
+						if ( ( sMapX != gWorldSectorX ) || ( sMapY != gWorldSectorY ) || ( pStudent -> bSectorZ != gbWorldSectorZ ) ||
+								PythSpacesAway(pStudent->sGridNo, pTrainer->sGridNo) < MAX_DISTANCE_FOR_TRAINING &&
+								EnoughTimeOnAssignment(*pTrainer))
 */
-							// NB this EnoughTimeOnAssignment() call is redundent since it is called up above
-							//if (EnoughTimeOnAssignment(*pTrainer))
-							{
-								// valid trainer is available, this gives the student a large training bonus!
-								sTrainingPtsDueToInstructor = GetBonusTrainingPtsDueToInstructor( pTrainer, pStudent, pStudent -> bTrainStat, fAtGunRange, &usMaxPts );
+						// NB this EnoughTimeOnAssignment() call is redundent since it is called up above
+						//if (EnoughTimeOnAssignment(*pTrainer))
+						{
+							// valid trainer is available, this gives the student a large training bonus!
+							sTrainingPtsDueToInstructor = GetBonusTrainingPtsDueToInstructor( pTrainer, pStudent, pStudent -> bTrainStat, fAtGunRange, &usMaxPts );
 
-								// add the bonus to what merc can learn on his own
-								sTotalTrainingPts += sTrainingPtsDueToInstructor;
-							}
+							// add the bonus to what merc can learn on his own
+							sTotalTrainingPts += sTrainingPtsDueToInstructor;
 						}
 					}
-
-					// now finally train the grunt
-					TrainSoldierWithPts( pStudent, sTotalTrainingPts );
 				}
+
+				// now finally train the grunt
+				TrainSoldierWithPts( pStudent, sTotalTrainingPts );
 			}
 		}
 	}
@@ -2115,24 +2144,21 @@ static void HandleTrainingInSector(const INT16 sMapX, const INT16 sMapY, const I
 		ubTownTrainers = 0;
 
 		// build list of all the town trainers in this sector and their training pts
-		FOR_EACH_IN_TEAM(pTrainer, OUR_TEAM)
+		for (SOLDIERTYPE* const pTrainer : sector)
 		{
-			if (pTrainer->sSectorX == sMapX && pTrainer->sSectorY == sMapY && pTrainer->bSectorZ == bZ)
+			if (pTrainer->bAssignment == TRAIN_TOWN &&
+					EnoughTimeOnAssignment(*pTrainer)   &&
+					!pTrainer->fMercAsleep)
 			{
-				if (pTrainer->bAssignment == TRAIN_TOWN &&
-						EnoughTimeOnAssignment(*pTrainer)   &&
-						!pTrainer->fMercAsleep)
-				{
-					sTownTrainingPts = GetTownTrainPtsForCharacter( pTrainer, &usMaxPts );
+				sTownTrainingPts = GetTownTrainPtsForCharacter( pTrainer, &usMaxPts );
 
-					// if he's actually worth anything
-					if( sTownTrainingPts > 0 )
-					{
-						// remember this guy as a town trainer
-						TownTrainer[ubTownTrainers].sTrainingPts = sTownTrainingPts;
-						TownTrainer[ubTownTrainers].pSoldier = pTrainer;
-						ubTownTrainers++;
-					}
+				// if he's actually worth anything
+				if( sTownTrainingPts > 0 )
+				{
+					// remember this guy as a town trainer
+					TownTrainer[ubTownTrainers].sTrainingPts = sTownTrainingPts;
+					TownTrainer[ubTownTrainers].pSoldier = pTrainer;
+					ubTownTrainers++;
 				}
 			}
 		}
@@ -4303,7 +4329,7 @@ static void BeginRemoveMercFromContract(SOLDIERTYPE* const s)
 		/* This will cause him give us lame excuses for a while until he gets over
 		 * it.  3-6 days (but the first 1-2 days of that are spent "returning" home)
 		 */
-		gMercProfiles[s->ubProfile].ubDaysOfMoraleHangover = 3 + Random(4);
+		gMercProfiles[s->ubProfile].ubDaysOfMoraleHangover = 3 + Random(4, RANDOM_STRATEGIC);
 
 		// if it's an AIM merc, word of this gets back to AIM...  Bad rep.
 		if (s->ubWhatKindOfMercAmI == MERC_TYPE__AIM_MERC)
@@ -5457,10 +5483,7 @@ static void RepositionMouseRegions(void)
 	for (UINT32 i = 0; i < GetNumberOfLinesOfTextInBox(ghAssignmentBox); ++i)
 	{
 		MOUSE_REGION* const r = &gAssignmentMenuRegion[i];
-		r->RegionTopLeftX     += sDeltaX;
-		r->RegionTopLeftY     += sDeltaY;
-		r->RegionBottomRightX += sDeltaX;
-		r->RegionBottomRightY += sDeltaY;
+		r->SetArea(r->RegionTopLeftX + sDeltaX, r->RegionTopLeftY + sDeltaY, r->RegionBottomRightX + sDeltaX, r->RegionBottomRightY + sDeltaY);
 	}
 
 	gfPausedTacticalRenderFlags = TRUE;
@@ -7113,3 +7136,202 @@ static BOOLEAN UnjamGunsOnSoldier(SOLDIERTYPE* pOwnerSoldier, SOLDIERTYPE* pRepa
 
 	return ( fAnyGunsWereUnjammed );
 }
+
+
+#ifdef WITH_UNITTESTS
+#include "gtest/gtest.h"
+
+TEST(Assignments, rosterVisitsSoldiersLikeTheSectorLoop)
+{
+	TacticalTeamType const saved_team = gTacticalStatus.Team[OUR_TEAM];
+	std::vector<SOLDIERTYPE> const saved_soldiers(Menptr, Menptr + 12);
+
+	gTacticalStatus.Team[OUR_TEAM].bFirstID = 0;
+	gTacticalStatus.Team[OUR_TEAM].bLastID  = 11;
+	for (UINT8 i = 0; i != 12; ++i)
+	{
+		SOLDIERTYPE& s = Menptr[i];
+		s = SOLDIERTYPE{};
+		s.bActive  = i % 5 != 3;
+		s.sSectorX = 1 + (i * 7) % 3;
+		s.sSectorY = 16 - (i * 5) % 4;
+		s.bSectorZ = i % 2 == 0 ? 0 : (i / 2) % 3;
+	}
+
+	// The order the hourly update visited the soldiers in before the roster
+	std::vector<SOLDIERTYPE*> expected;
+	for (INT16 x = 0; x < MAP_WORLD_X; ++x)
+	{
+		for (INT16 y = 0; y < MAP_WORLD_X; ++y)
+		{
+			for (INT8 z = 0; z < 4; ++z)
+			{
+				FOR_EACH_IN_TEAM(s, OUR_TEAM)
+				{
+					if (s->sSectorX == x && s->sSectorY == y && s->bSectorZ == z) expected.push_back(s);
+				}
+			}
+		}
+	}
+
+	BuildAssignmentRoster();
+	std::vector<SOLDIERTYPE*> visited;
+	for (AssignmentSector const& sector : gAssignmentSectors)
+	{
+		EXPECT_NE(sector.begin(), sector.end());
+		for (SOLDIERTYPE* const s : sector)
+		{
+			EXPECT_EQ(s->sSectorX, sector.x);
+			EXPECT_EQ(s->sSectorY, sector.y);
+			EXPECT_EQ(s->bSectorZ, sector.z);
+			visited.push_back(s);
+		}
+	}
+	EXPECT_EQ(visited, expected);
+
+	gAssignmentRoster.clear();
+	gAssignmentSectors.clear();
+	std::copy(saved_soldiers.begin(), saved_soldiers.end(), Menptr);
+	gTacticalStatus.Team[OUR_TEAM] = saved_team;
+}
+
+
+// The hourly training pass, run through every occupied sector like before the roster
+static void HandleTrainingBySectorLoop()
+{
+	InitSectorsWithSoldiersList();
+	BuildSectorsWithSoldiersList();
+	for (INT16 x = 0; x < MAP_WORLD_X; ++x)
+	{
+		for (INT16 y = 0; y < MAP_WORLD_X; ++y)
+		{
+			for (INT8 z = 0; z < 4; ++z)
+			{
+				if (!fSectorsWithSoldiers[x + y * MAP_WORLD_X][z]) continue;
+
+				std::vector<SOLDIERTYPE*> here;
+				FOR_EACH_IN_TEAM(s, OUR_TEAM)
+				{
+					if (s->sSectorX == x && s->sSectorY == y && s->bSectorZ == z) here.push_back(s);
+				}
+				HandleTrainingInSector(AssignmentSector{ x, y, z, here.data(), here.data() + here.size() });
+			}
+		}
+	}
+}
+
+
+static void HandleTrainingByRoster()
+{
+	BuildAssignmentRoster();
+	for (AssignmentSector const& sector : gAssignmentSectors)
+	{
+		HandleTrainingInSector(sector);
+	}
+}
+
+
+TEST(Assignments, rosterTrainingReplaysTheSectorLoop)
+{
+	static UINT8 const N_SOLDIERS = 12;
+	static ProfileID const FIRST_PROFILE = 1;
+	static INT16 const SECTOR_XS[] = { 3, 9, 12 };
+
+	TacticalTeamType const saved_team = gTacticalStatus.Team[OUR_TEAM];
+	std::vector<SOLDIERTYPE> const saved_soldiers(Menptr, Menptr + N_SOLDIERS);
+	std::vector<MERCPROFILESTRUCT> const saved_profiles(gMercProfiles + FIRST_PROFILE, gMercProfiles + FIRST_PROFILE + N_SOLDIERS);
+	std::vector<StrategicMapElement> const saved_map(std::begin(StrategicMap), std::end(StrategicMap));
+
+	gTacticalStatus.Team[OUR_TEAM].bFirstID = 0;
+	gTacticalStatus.Team[OUR_TEAM].bLastID  = N_SOLDIERS - 1;
+
+	// Town sectors, so the militia check needs no content
+	for (INT16 const x : SECTOR_XS)
+	{
+		StrategicMapElement& e = StrategicMap[CALCULATE_STRATEGIC_INDEX(x, 5)];
+		e.bNameId          = 1;
+		e.fEnemyControlled = FALSE;
+	}
+
+	INT8 const assignments[] = { TRAIN_TEAMMATE, TRAIN_BY_OTHER, TRAIN_SELF, TRAIN_BY_OTHER };
+	INT8 const stats[]       = { STRENGTH, MARKSMANSHIP, MEDICAL };
+	for (UINT8 i = 0; i != N_SOLDIERS; ++i)
+	{
+		ProfileID const    pid = FIRST_PROFILE + i;
+		MERCPROFILESTRUCT& p   = gMercProfiles[pid];
+		p.bEvolution   = NORMAL_EVOLUTION;
+		p.bExpLevel    = 3;
+		p.bWisdom      = 60 + i;
+		p.bStrength    = p.bMarksmanship = p.bMedical = 40 + 3 * i;
+		p.bSkillTrait  = i % 4 == 0 ? TEACHING : NO_SKILLTRAIT;
+		p.bSkillTrait2 = NO_SKILLTRAIT;
+		p.sStrengthGain = p.sMarksmanshipGain = p.sMedicalGain = p.sExpLevelGain = 0;
+		for (UINT8 j = 0; j != N_SOLDIERS; ++j) p.bMercOpinion[FIRST_PROFILE + j] = (i * 7 + j * 3) % 11 - 5;
+
+		// Below OKLIFE the gains stay in the profile instead of raising the stats, which would queue dialogue
+		SOLDIERTYPE& s = Menptr[i];
+		s = SOLDIERTYPE{};
+		s.ubID          = i;
+		s.bActive       = TRUE;
+		s.bTeam         = OUR_TEAM;
+		s.ubProfile     = pid;
+		s.bLife         = CONSCIOUSNESS + 2;
+		s.bLifeMax      = 80;
+		s.bBreathMax    = 100;
+		s.bExpLevel     = p.bExpLevel;
+		s.bWisdom       = p.bWisdom;
+		s.bLeadership   = 50;
+		s.bStrength     = p.bStrength;
+		s.bMarksmanship = p.bMarksmanship;
+		s.bMedical      = p.bMedical;
+		s.sSectorX      = SECTOR_XS[i % 3];
+		s.sSectorY      = 5;
+		s.bSectorZ      = i == 7 ? 1 : 0;
+		s.bAssignment   = assignments[i % 4];
+		s.bTrainStat    = stats[i * 5 % 3];
+		s.fMercAsleep   = i == 10;
+		s.uiLastAssignmentChangeMin = GetWorldTotalMin() - (i == 4 ? 10 : 60);
+	}
+	std::vector<SOLDIERTYPE>       const start_soldiers(Menptr, Menptr + N_SOLDIERS);
+	std::vector<MERCPROFILESTRUCT> const start_profiles(gMercProfiles + FIRST_PROFILE, gMercProfiles + FIRST_PROFILE + N_SOLDIERS);
+
+	// Replays some hours, moving a soldier between them, and records the profile gains
+	auto const replay = [&](void (*const handle_training)())
+	{
+		std::copy(start_soldiers.begin(), start_soldiers.end(), Menptr);
+		std::copy(start_profiles.begin(), start_profiles.end(), gMercProfiles + FIRST_PROFILE);
+		SeedRandom(2024);
+
+		std::vector<INT16> gains;
+		for (UINT8 hour = 0; hour != 8; ++hour)
+		{
+			handle_training();
+			SOLDIERTYPE& moved = Menptr[hour % N_SOLDIERS];
+			if (moved.bSectorZ == 0) moved.sSectorX = SECTOR_XS[(hour + 1) % 3];
+
+			for (UINT8 i = 0; i != N_SOLDIERS; ++i)
+			{
+				MERCPROFILESTRUCT const& p = gMercProfiles[FIRST_PROFILE + i];
+				gains.push_back(p.sStrengthGain);
+				gains.push_back(p.sMarksmanshipGain);
+				gains.push_back(p.sMedicalGain);
+			}
+		}
+		gains.push_back((INT16)guiPreRandomIndex);
+		return gains;
+	};
+
+	std::vector<INT16> const by_sector_loop = replay(HandleTrainingBySectorLoop);
+	std::vector<INT16> const by_roster      = replay(HandleTrainingByRoster);
+	EXPECT_EQ(by_roster, by_sector_loop);
+	EXPECT_TRUE(std::any_of(by_roster.begin(), by_roster.end() - 1, [](INT16 const g) { return g != 0; }));
+
+	gAssignmentRoster.clear();
+	gAssignmentSectors.clear();
+	std::copy(saved_map.begin(), saved_map.end(), StrategicMap);
+	std::copy(saved_profiles.begin(), saved_profiles.end(), gMercProfiles + FIRST_PROFILE);
+	std::copy(saved_soldiers.begin(), saved_soldiers.end(), Menptr);
+	gTacticalStatus.Team[OUR_TEAM] = saved_team;
+}
+
+#endif
@@ -1,4 +1,6 @@
 #include "Auto_Resolve.h"
+#include "Auto_Resolve_Rules.h"
+#include "Auto_Resolve_Sim.h"
 #include "Campaign.h"
 #include "ContentManager.h"
 #include "Creature_Spreading.h"
@@ -25,6 +27,7 @@
 #include "Morale.h"
 #include "Music_Control.h"
 #include "Overhead.h"
+#include "policy/GamePolicy.h"
 #include "Player_Command.h"
 #include "PreBattle_Interface.h"
 #include "Queen_Command.h"
@@ -50,6 +53,7 @@
 #include "VObject_Blitters.h"
 #include "VSurface.h"
 #include "WeaponModels.h"
+#include "Weapons.h"
 #include "WordWrap.h"
 #include <stdexcept>
 #include <string_theory/format>
@@ -61,6 +65,9 @@ struct BUTTON_PICS;
 
 //#define INVULNERABILITY
 
+//Number of simulated battles behind the logged odds
+#define AUTORESOLVE_PREDICTION_RUNS 200
+
 BOOLEAN gfTransferTacticalOppositionToAutoResolve = FALSE;
 
 //button images
@@ -159,54 +166,13 @@ struct AUTORESOLVE_STRUCT
 	BOOLEAN fMoraleEventsHandled;
 	BOOLEAN fCaptureNotPermittedDueToEPCs;
 
-	MOUSE_REGION AutoResolveRegion;
-};
-
-//Classifies the type of soldier the soldier cell is
-#define CELL_MERC		0x00000001
-#define CELL_MILITIA		0x00000002
-#define CELL_ELITE		0x00000004
-#define CELL_TROOP		0x00000008
-#define CELL_ADMIN		0x00000010
-#define CELL_AF_CREATURE	0x00000020
-#define CELL_AM_CREATURE	0x00000040
-#define CELL_YF_CREATURE	0x00000080
-#define CELL_YM_CREATURE	0x00000100
-//The team leader is the one with the highest leadership.
-//There can only be one teamleader per side (mercs/civs and enemies)
-#define CELL_TEAMLEADER		0x00000200
-//Combat flags
-#define CELL_FIREDATTARGET	0x00000400
-#define CELL_DODGEDATTACK	0x00000800
-#define CELL_HITBYATTACKER	0x00001000
-#define CELL_HITLASTFRAME	0x00002000
-//Cell statii
-#define CELL_SHOWRETREATTEXT	0x00004000
-#define CELL_RETREATING		0x00008000
-#define CELL_RETREATED		0x00010000
-#define CELL_DIRTY		0x00020000
-#define CELL_PROCESSED		0x00040000
-#define CELL_ASSIGNED		0x00080000
-#define CELL_EPC		0x00100000
-#define CELL_ROBOT		0x00200000
-
-//Combined flags
-#define CELL_PLAYER		( CELL_MERC | CELL_MILITIA )
-#define CELL_ENEMY		( CELL_ELITE | CELL_TROOP | CELL_ADMIN )
-#define CELL_CREATURE		( CELL_AF_CREATURE | CELL_AM_CREATURE | CELL_YF_CREATURE | CELL_YM_CREATURE )
-#define CELL_FEMALECREATURE	( CELL_AF_CREATURE | CELL_YF_CREATURE )
-#define CELL_MALECREATURE	( CELL_AM_CREATURE | CELL_YM_CREATURE )
-#define CELL_YOUNGCREATURE	( CELL_YF_CREATURE | CELL_YM_CREATURE )
-#define CELL_INVOLVEDINCOMBAT	( CELL_FIREDATTARGET | CELL_DODGEDATTACK | CELL_HITBYATTACKER )
+	//State of ProcessBattleFrame() kept while it yields to the screen
+	BOOLEAN fContinueBattleFrame;
+	INT32 iTimeSlice;
+	UINT32 uiSlice;
+	AutoResolveTurnOrder order;
 
-enum
-{
-	BATTLE_IN_PROGRESS,
-	BATTLE_VICTORY,
-	BATTLE_DEFEAT,
-	BATTLE_RETREAT,
-	BATTLE_SURRENDERED,
-	BATTLE_CAPTURED
+	MOUSE_REGION AutoResolveRegion;
 };
 
 //panel pieces
@@ -464,6 +430,7 @@ static void CalculateSoldierCells(BOOLEAN fReset);
 static void CreateAutoResolveInterface(void);
 static void DetermineTeamLeader(BOOLEAN fFriendlyTeam);
 static void HandleAutoResolveInput(void);
+static void LogAutoResolvePrediction(void);
 static void ProcessBattleFrame(void);
 static void RemoveAutoResolveInterface(bool delete_for_good);
 
@@ -490,6 +457,7 @@ ScreenID AutoResolveScreenHandle()
 		DetermineTeamLeader( TRUE ); //friendly team
 		DetermineTeamLeader( FALSE ); //enemy team
 		CalculateAttackValues();
+		LogAutoResolvePrediction();
 		DoTransitionFromPreBattleInterfaceToAutoResolve();
 		gpAR->fRenderAutoResolve = TRUE;
 	}
@@ -2615,14 +2583,317 @@ static void DetermineTeamLeader(BOOLEAN fFriendlyTeam)
 }
 
 
-static void ResetNextAttackCounter(SOLDIERCELL* pCell)
+static BOOLEAN FireAShot(SOLDIERCELL* pAttacker);
+static BOOLEAN AttackerHasKnife(SOLDIERCELL* attacker);
+static BOOLEAN TargetHasLoadedGun(SOLDIERTYPE* pSoldier);
+
+
+//Divides the damage of bullets hitting creatures of this body type
+static UINT8 AutoResolveDamageDivisor(UINT8 const ubBodyType)
+{
+	switch( ubBodyType )
+	{
+		case YAF_MONSTER:
+		case YAM_MONSTER:
+			return 4;
+		case ADULTFEMALEMONSTER:
+		case AM_MONSTER:
+			return 6;
+		case QUEENMONSTER:
+			return 8;
+		default:
+			return 1;
+	}
+}
+
+
+//The auto resolve screen as the battle of Auto_Resolve_Rules.h.  The rolls are
+//pregenerated numbers, and whatever happens shows on the soldiers and their
+//profiles, and is heard.
+struct ScreenBattle
 {
-	pCell->usNextAttack = MIN( 1000 - pCell->usAttack, 800 );
-	pCell->usNextAttack = (UINT16)(1000 + pCell->usNextAttack * 5 + PreRandom( 2000 - pCell->usAttack ) );
-	if( pCell->uiFlags & CELL_CREATURE )
+	UINT32 Roll(UINT32 const range) { return PreRandom(range); }
+
+	INT32 GroupSize(UINT8 const group)
+	{
+		switch (group)
+		{
+			case AR_GROUP_MERCS: return gpAR->ubMercs;
+			case AR_GROUP_CIVS:  return gpAR->ubCivs;
+			default:             return gpAR->ubEnemies;
+		}
+	}
+
+	SOLDIERCELL& GroupCell(UINT8 const group, INT32 const index)
+	{
+		switch (group)
+		{
+			case AR_GROUP_MERCS: return gpMercs[index];
+			case AR_GROUP_CIVS:  return gpCivs[index];
+			default:             return gpEnemies[index];
+		}
+	}
+
+	SOLDIERCELL* RobotCell() { return gpAR->pRobotCell; }
+	BOOLEAN RobotControlled() { return gpAR->pRobotCell->pSoldier->robot_remote_holder != NULL; }
+
+	void UpdateRobotController()
+	{
+		if( gpAR->pRobotCell )
+		{
+			UpdateRobotControllerGivenRobot( gpAR->pRobotCell->pSoldier );
+		}
+	}
+
+	INT8 Life(SOLDIERCELL const& c) { return c.pSoldier->bLife; }
+	INT8 LifeMax(SOLDIERCELL const& c) { return c.pSoldier->bLifeMax; }
+
+	void SetLife(SOLDIERCELL& c, INT8 const life)
+	{
+		#ifdef INVULNERABILITY
+		if( !life )
+		{
+			RefreshMerc( c.pSoldier );
+			return;
+		}
+		#endif
+		c.pSoldier->bLife = life;
+	}
+
+	UINT16& SideAttack(BOOLEAN const player) { return player ? gpAR->usPlayerAttack : gpAR->usEnemyAttack; }
+	UINT16& SideDefence(BOOLEAN const player) { return player ? gpAR->usPlayerDefence : gpAR->usEnemyDefence; }
+	UINT8& AliveMercs() { return gpAR->ubAliveMercs; }
+	UINT8& AliveCivs() { return gpAR->ubAliveCivs; }
+	UINT8& AliveEnemies() { return gpAR->ubAliveEnemies; }
+
+	BOOLEAN FireAShot(SOLDIERCELL& attacker) { return ::FireAShot(&attacker); }
+	BOOLEAN AttackerHasKnife(SOLDIERCELL& attacker) { return ::AttackerHasKnife(&attacker); }
+	void AttacksWithClaws(SOLDIERCELL& attacker) { attacker.bWeaponSlot = HANDPOS; }
+	BOOLEAN TargetHasLoadedGun(SOLDIERCELL const& target) { return ::TargetHasLoadedGun(target.pSoldier); }
+
+	INT32 BulletImpact(SOLDIERCELL& attacker, SOLDIERCELL& target, UINT8 const ubLocation, UINT8 const ubAccuracy)
+	{
+		UINT8 const ubImpact = GCM->getWeapon(attacker.pSoldier->inv[attacker.bWeaponSlot].usItem)->ubImpact;
+		return ::BulletImpact( attacker.pSoldier, target.pSoldier, ubLocation, ubImpact, ubAccuracy, NULL );
+	}
+
+	INT32 HTHImpact(SOLDIERCELL& attacker, SOLDIERCELL& target, UINT8 const ubAccuracy, BOOLEAN const fBlade)
+	{
+		//Determine attacking weapon.
+		attacker.pSoldier->usAttackingWeapon = 0;
+		if( attacker.bWeaponSlot != -1 )
+		{
+			OBJECTTYPE const& o = attacker.pSoldier->inv[ attacker.bWeaponSlot ];
+			if( GCM->getItem(o.usItem)->isWeapon() )
+				attacker.pSoldier->usAttackingWeapon = o.usItem;
+		}
+		return ::HTHImpact(attacker.pSoldier, target.pSoldier, ubAccuracy, fBlade);
+	}
+
+	UINT8 DamageDivisor(SOLDIERCELL const& c) { return AutoResolveDamageDivisor(c.pSoldier->ubBodyType); }
+
+	void BlowDodged(SOLDIERCELL& target, BOOLEAN const fKnife, BOOLEAN const fClaw)
+	{
+		if( fKnife )
+			PlayAutoResolveSample(MISS_KNIFE, 50, 1, MIDDLEPAN);
+		else if( fClaw )
+		{
+			if( Chance( 50, RANDOM_COSMETIC ) )
+			{
+				PlayAutoResolveSample(ACR_SWIPE, 50, 1, MIDDLEPAN);
+			}
+			else
+			{
+				PlayAutoResolveSample(ACR_LUNGE, 50, 1, MIDDLEPAN);
+			}
+		}
+		else
+			PlayAutoResolveSample(SoundRange<SWOOSH_1, SWOOSH_6>(), 50, 1, MIDDLEPAN);
+		if (target.uiFlags & CELL_MERC && target.pSoldier->bLife >= OKLIFE)
+			// AGILITY GAIN: Target "dodged" an attack
+			StatChange(*target.pSoldier, AGILAMT, 5, FROM_SUCCESS);
+	}
+
+	void BlowLands(SOLDIERCELL&, SOLDIERCELL&)
+	{
+		PlayAutoResolveSample(SoundRange<BULLET_IMPACT_1, BULLET_IMPACT_3>(), 50, 1, MIDDLEPAN);
+	}
+
+	void MeleeWound(SOLDIERCELL& attacker, SOLDIERCELL& target, INT32 const iImpact, INT32 const iNewLife)
+	{
+		if( attacker.uiFlags & CELL_MERC )
+		{ //Attacker is a player, so increment the number of shots that hit.
+			gMercProfiles[ attacker.pSoldier->ubProfile ].usShotsHit++;
+			// MARKSMANSHIP GAIN: Attacker's shot hits
+			StatChange(*attacker.pSoldier, MARKAMT, 6, FROM_SUCCESS); // in addition to 3 for taking a shot
+		}
+		if( target.uiFlags & CELL_MERC )
+		{ //Target is a player, so increment the times he has been wounded.
+			gMercProfiles[ target.pSoldier->ubProfile ].usTimesWounded++;
+			// EXPERIENCE GAIN: Took some damage
+			StatChange(*target.pSoldier, EXPERAMT, 5 * (iImpact / 10), FROM_SUCCESS);
+		}
+		if( target.pSoldier->bLife >= CONSCIOUSNESS || target.uiFlags & CELL_CREATURE )
+		{
+			if( gpAR->fSound )
+				DoMercBattleSound(target.pSoldier, BATTLE_SOUND_HIT1);
+		}
+		if( !(target.uiFlags & CELL_CREATURE) && iNewLife < OKLIFE && target.pSoldier->bLife >= OKLIFE )
+		{ //the hit caused the merc to fall.  Play the falling sound
+			PlayAutoResolveSample(FALL_1, 50, 1, MIDDLEPAN);
+		}
+		if( iNewLife <= 0 )
+		{ //soldier has been killed
+			if( attacker.uiFlags & CELL_MERC )
+			{ //Player killed the enemy soldier -- update his stats as well as any assisters.
+				gMercProfiles[ attacker.pSoldier->ubProfile ].usKills++;
+				gStrategicStatus.usPlayerKills++;
+			}
+			else if( attacker.uiFlags & CELL_MILITIA )
+			{
+				attacker.pSoldier->ubMilitiaKills += 2;
+			}
+			if( target.uiFlags & CELL_MERC && gpAR->fSound )
+			{
+				PlayAutoResolveSample(DOORCR_1, HIGHVOLUME, 1, MIDDLEPAN);
+				PlayAutoResolveSample(HEADCR_1, HIGHVOLUME, 1, MIDDLEPAN);
+			}
+		}
+	}
+
+	void BulletMissed(SOLDIERCELL& target)
+	{ //bullet missed -- play a ricochet sound.
+		if (target.uiFlags & CELL_MERC && target.pSoldier->bLife >= OKLIFE)
+			// AGILITY GAIN: Target "dodged" an attack
+			StatChange(*target.pSoldier, AGILAMT, 5, FROM_SUCCESS);
+		PlayAutoResolveSample(SoundRange<MISS_1, MISS_8>(), 50, 1, MIDDLEPAN);
+	}
+
+	void BulletWound(SOLDIERCELL& target, INT32 const index, INT32 const iNewLife)
+	{
+		SOLDIERCELL* const pAttacker = target.pAttacker[ index ];
+		if( pAttacker->uiFlags & CELL_MERC )
+		{ //Attacker is a player, so increment the number of shots that hit.
+			gMercProfiles[ pAttacker->pSoldier->ubProfile ].usShotsHit++;
+			// MARKSMANSHIP GAIN: Attacker's shot hits
+			StatChange(*pAttacker->pSoldier, MARKAMT, 6, FROM_SUCCESS); // in addition to 3 for taking a shot
+		}
+		if( target.uiFlags & CELL_MERC && target.usHitDamage[ index ] )
+		{ //Target is a player, so increment the times he has been wounded.
+			gMercProfiles[ target.pSoldier->ubProfile ].usTimesWounded++;
+			// EXPERIENCE GAIN: Took some damage
+			StatChange(*target.pSoldier, EXPERAMT, 5 * (target.usHitDamage[index] / 10), FROM_SUCCESS);
+		}
+
+		//bullet hit -- play an impact sound and a merc hit sound
+		PlayAutoResolveSample(SoundRange<BULLET_IMPACT_1, BULLET_IMPACT_3>(), 50, 1, MIDDLEPAN);
+
+		if( target.pSoldier->bLife >= CONSCIOUSNESS )
+		{
+			if( gpAR->fSound )
+				DoMercBattleSound(target.pSoldier, BATTLE_SOUND_HIT1);
+		}
+		if( iNewLife < OKLIFE && target.pSoldier->bLife >= OKLIFE )
+		{ //the hit caused the merc to fall.  Play the falling sound
+			PlayAutoResolveSample(FALL_1, 50, 1, MIDDLEPAN);
+		}
+		if( iNewLife > 0 )
+			return;
+
+		//soldier has been killed
+		if( pAttacker->uiFlags & CELL_PLAYER )
+		{ //Player killed the enemy soldier -- update his stats as well as any assisters.
+			SOLDIERCELL *pKiller;
+			SOLDIERCELL *pAssister1, *pAssister2;
+			pKiller = pAttacker;
+			pAssister1 = target.pAttacker[ index < 2 ? index + 1 : 0 ];
+			pAssister2 = target.pAttacker[ index > 0 ? index - 1 : 2 ];
+			if( pKiller == pAssister1 )
+				pAssister1 = NULL;
+			if( pKiller == pAssister2 )
+				pAssister2 = NULL;
+			if( pAssister1 == pAssister2 )
+				pAssister2 = NULL;
+			if( pKiller->uiFlags & CELL_MERC )
+			{
+				gMercProfiles[ pKiller->pSoldier->ubProfile ].usKills++;
+				gStrategicStatus.usPlayerKills++;
+				// EXPERIENCE CLASS GAIN:  Earned a kill
+				StatChange(*pKiller->pSoldier, EXPERAMT, 10 * target.pSoldier->bLevel, FROM_SUCCESS);
+				HandleMoraleEvent( pKiller->pSoldier, MORALE_KILLED_ENEMY, gpAR->ubSectorX, gpAR->ubSectorY, 0  );
+			}
+			else if( pKiller->uiFlags & CELL_MILITIA )
+				pKiller->pSoldier->ubMilitiaKills += 2;
+			if( pAssister1 )
+			{
+				if( pAssister1->uiFlags & CELL_MERC )
+				{
+					gMercProfiles[ pAssister1->pSoldier->ubProfile ].usAssists++;
+					// EXPERIENCE CLASS GAIN:  Earned an assist
+					StatChange(*pAssister1->pSoldier, EXPERAMT, 5 * target.pSoldier->bLevel, FROM_SUCCESS);
+				}
+				else if( pAssister1->uiFlags & CELL_MILITIA )
+					pAssister1->pSoldier->ubMilitiaKills++;
+			}
+			else if( pAssister2 )
+			{
+				if( pAssister2->uiFlags & CELL_MERC )
+				{
+					gMercProfiles[ pAssister2->pSoldier->ubProfile ].usAssists++;
+					// EXPERIENCE CLASS GAIN:  Earned an assist
+					StatChange(*pAssister2->pSoldier, EXPERAMT, 5 * target.pSoldier->bLevel, FROM_SUCCESS);
+				}
+				else if( pAssister2->uiFlags & CELL_MILITIA )
+					pAssister2->pSoldier->ubMilitiaKills++;
+			}
+		}
+		if( target.uiFlags & CELL_MERC && gpAR->fSound )
+		{
+			PlayAutoResolveSample(DOORCR_1, HIGHVOLUME, 1, MIDDLEPAN);
+			PlayAutoResolveSample(HEADCR_1, HIGHVOLUME, 1, MIDDLEPAN);
+		}
+		if( iNewLife < -60 && !(target.uiFlags & CELL_CREATURE) )
+		{ //High damage death
+			if( gpAR->fSound )
+			{
+				if( PreRandom( 3 ) )
+					PlayAutoResolveSample(BODY_SPLAT_1, 50, 1, MIDDLEPAN);
+				else
+					PlayAutoResolveSample(HEADSPLAT_1, 50, 1, MIDDLEPAN);
+			}
+		}
+		else
+		{ //Normal death
+			if( gpAR->fSound )
+			{
+				DoMercBattleSound( target.pSoldier, BATTLE_SOUND_DIE1 );
+			}
+		}
+	}
+
+	void Bleeds(SOLDIERCELL& target, INT32 const iDamage)
+	{
+		SOLDIERTYPE& s = *target.pSoldier;
+		if( s.bLifeMax - s.bBleeding - iDamage >= s.bLife )
+			s.bBleeding += (INT8)iDamage;
+		else
+			s.bBleeding = (INT8)(s.bLifeMax - s.bLife);
+	}
+
+	void Killed(SOLDIERCELL&) { gpAR->fRenderAutoResolve = TRUE; }
+	void DeathCry(SOLDIERCELL& c) { DoMercBattleSound( c.pSoldier, BATTLE_SOUND_DIE1 ); }
+
+	void SmellsPrey(SOLDIERCELL&)
 	{
-		pCell->usNextAttack = pCell->usNextAttack * 8 / 10;
+		PlayAutoResolveSample(SoundRange<ACR_SMELL_THREAT, ACR_SMELL_PREY>(), 50, 1, MIDDLEPAN);
 	}
+};
+
+
+static void ResetNextAttackCounter(SOLDIERCELL* pCell)
+{
+	ScreenBattle b;
+	ResetAutoResolveAttackCounter( b, *pCell );
 }
 
 
@@ -2803,6 +3074,141 @@ static void CalculateAttackValues(void)
 }
 
 
+static UINT8 WeaponImpact(UINT16 const item)
+{
+	return GCM->getItem(item)->isWeapon() ? GCM->getWeapon(item)->ubImpact : 0;
+}
+
+
+//Copies a soldier cell into the standalone battle model, with what the
+//ScreenBattle reads from the soldier during the battle.
+static AutoResolveCombatant MakeAutoResolveCombatant(SOLDIERCELL const& cell)
+{
+	SOLDIERTYPE const& s = *cell.pSoldier;
+	AutoResolveCombatant c{};
+	c.uiFlags          = cell.uiFlags;
+	c.usAttack         = cell.usAttack;
+	c.usDefence        = cell.usDefence;
+	c.usNextAttack     = cell.usNextAttack;
+	c.bLife            = s.bLife;
+	c.bLifeMax         = s.bLifeMax;
+	c.bBleeding        = s.bBleeding;
+	c.bStrength        = s.bStrength;
+	c.bExpLevel        = EffectiveExpLevel(&s);
+	c.sGridNo          = s.sGridNo;
+	c.sDamage          = s.sDamage;
+	c.fRobotController = cell.uiFlags & CELL_MERC && ControllingRobot(&s);
+	c.ubDamageDivisor  = AutoResolveDamageDivisor(s.ubBodyType);
+
+	//as BulletImpact() finds it
+	c.ubAmmoType = GCM->getItem(s.usAttackingWeapon)->getItemClass() == IC_THROWING_KNIFE ?
+		AMMO_KNIFE : s.inv[s.ubAttackingHand].ubGunAmmoType;
+
+	for (INT8 i = 0; i < NUM_INV_SLOTS; i++)
+	{
+		OBJECTTYPE const& o = s.inv[i];
+		if( GCM->getItem(o.usItem)->getItemClass() != IC_GUN )
+			continue;
+		if( c.fHasGun )
+		{
+			if( o.ubGunShotsLeft ) c.fSpareLoadedGun = true;
+			continue;
+		}
+		c.fHasGun        = true;
+		c.ubGunImpact    = WeaponImpact(o.usItem);
+		c.ubGunShotsLeft = o.ubGunShotsLeft;
+		INT8 const ammo = FindAmmoToReload(&s, i, NO_SLOT);
+		if( ammo != NO_SLOT )
+		{
+			OBJECTTYPE const& clips = s.inv[ammo];
+			c.ubClips = MIN(clips.ubNumberOfObjects, AR_MAX_CLIPS);
+			for (UINT8 j = 0; j < c.ubClips; j++)
+				c.ubClipShots[j] = clips.ubShotsLeft[j];
+		}
+	}
+	if( cell.uiFlags & CELL_MALECREATURE )
+	{ //spits
+		c.ubGunImpact = WeaponImpact(s.inv[SECONDHANDPOS].usItem);
+	}
+
+	INT8 const blade = cell.uiFlags & CELL_FEMALECREATURE ? HANDPOS : FindObjClass(&s, IC_BLADE);
+	if( blade != NO_SLOT )
+	{
+		c.fHasBlade     = true;
+		c.ubBladeImpact = WeaponImpact(s.inv[blade].usItem);
+	}
+	if( HAS_SKILL_TRAIT(&s, MARTIALARTS) )
+	{
+		c.ubMartialArtsBonus = gbSkillTraitBonus[MARTIALARTS] * NUM_SKILL_TRAITS(&s, MARTIALARTS);
+	}
+	c.ubHandToHandBonus = 3 * gbSkillTraitBonus[HANDTOHAND] * NUM_SKILL_TRAITS(&s, HANDTOHAND);
+
+	static const struct { INT8 bSlot; UINT8 ubArmour; } armour[] =
+	{
+		{ HELMETPOS, AR_ARMOUR_HELMET   },
+		{ VESTPOS,   AR_ARMOUR_VEST     },
+		{ LEGPOS,    AR_ARMOUR_LEGGINGS }
+	};
+	for (auto const& a : armour)
+	{
+		OBJECTTYPE const& o = s.inv[a.bSlot];
+		if( o.usItem == NOTHING )
+			continue;
+		c.Armour[a.ubArmour].ubType  = GCM->getItem(o.usItem)->getClassIndex();
+		c.Armour[a.ubArmour].bStatus = o.bStatus[0];
+		if( a.bSlot != VESTPOS )
+			continue;
+		INT8 const plates = FindAttachment(&o, CERAMIC_PLATES);
+		if( plates != -1 )
+		{
+			c.Armour[AR_ARMOUR_PLATES].ubType  = GCM->getItem(o.usAttachItem[plates])->getClassIndex();
+			c.Armour[AR_ARMOUR_PLATES].bStatus = o.bAttachStatus[plates];
+		}
+	}
+	return c;
+}
+
+
+static BOOLEAN IsPlayerCapturePermitted(void);
+
+
+//Plays the battle out in the background a number of times and logs the odds.
+//None of this affects the battle that is about to be fought.  The odds are not
+//shown on the screen.
+static void LogAutoResolvePrediction(void)
+{
+	if( !LogIsEnabled(LogLevel::Debug) )
+		return;
+
+	AutoResolveBattle battle;
+	battle.fUnlimitedAmmo        = gpAR->fUnlimitedAmmo;
+	battle.fCapturePermitted     = gubEnemyEncounterCode != CREATURE_ATTACK_CODE && IsPlayerCapturePermitted();
+	battle.fHeadDamageMultiplier = gamepolicy(critical_damage_head_multiplier);
+	battle.fLegsDamageMultiplier = gamepolicy(critical_damage_legs_multiplier);
+	if( gpAR->pRobotCell )
+	{
+		SOLDIERTYPE const* const holder = gpAR->pRobotCell->pSoldier->robot_remote_holder;
+		battle.fRobotControlled     = holder != NULL;
+		battle.fRobotControllerAway = holder != NULL;
+		FOR_EACH_AR_MERC(i)
+		{
+			if (i->pSoldier == holder) battle.fRobotControllerAway = false;
+		}
+	}
+	FOR_EACH_AR_MERC(i)
+		battle.combatants.push_back(MakeAutoResolveCombatant(*i));
+	FOR_EACH_AR_CIV(i)
+		battle.combatants.push_back(MakeAutoResolveCombatant(*i));
+	FOR_EACH_AR_ENEMY(i)
+		battle.combatants.push_back(MakeAutoResolveCombatant(*i));
+
+	AutoResolveOdds const odds = PredictAutoResolveBattle(battle, AUTORESOLVE_PREDICTION_RUNS, GetJA2Clock());
+	STLOGD("Auto resolve prediction ({} runs): {.1f}% victory, {.1f}% captured, {.1f} player and {.1f} enemy casualties expected",
+		odds.uiRuns, odds.dWinProbability * 100, odds.dCaptureProbability * 100,
+		odds.dExpectedPlayerCasualties, odds.dExpectedEnemyCasualties);
+}
+
+
 static void DrawDebugText(SOLDIERCELL* pCell)
 {
 	INT32 xp, yp;
@@ -2851,84 +3257,13 @@ static void DrawDebugText(SOLDIERCELL* pCell)
 }
 
 
-static BOOLEAN IsBattleOver(void);
+static BOOLEAN FireAShot(SOLDIERCELL* pAttacker)
+{
+	OBJECTTYPE *pItem;
+	SOLDIERTYPE *pSoldier;
+	INT32 i;
 
-
-static SOLDIERCELL* ChooseTarget(SOLDIERCELL* pAttacker)
-{
-	INT32 iAvailableTargets;
-	INT32 index;
-	INT32 iRandom = -1;
-	SOLDIERCELL *pTarget = NULL;
-	UINT16 usSavedDefence;
-	//Determine what team we are attacking
-	if( pAttacker->uiFlags & (CELL_ENEMY | CELL_CREATURE) )
-	{ //enemy team attacking a player
-		iAvailableTargets = gpAR->ubMercs + gpAR->ubCivs;
-		index = 0;
-		usSavedDefence = gpAR->usPlayerDefence;
-		while( iAvailableTargets )
-		{
-			pTarget = ( index < gpAR->ubMercs ) ? &gpMercs[ index ] : &gpCivs[ index - gpAR->ubMercs ];
-			if( !pTarget->pSoldier->bLife || pTarget->uiFlags & CELL_RETREATED )
-			{
-				index++;
-				iAvailableTargets--;
-				continue;
-			}
-			iRandom = PreRandom( gpAR->usPlayerDefence );
-			gpAR->usPlayerDefence -= pTarget->usDefence;
-			if( iRandom < pTarget->usDefence )
-			{
-				gpAR->usPlayerDefence = usSavedDefence;
-				return pTarget;
-			}
-			index++;
-			iAvailableTargets--;
-		}
-		if( !IsBattleOver() )
-		{
-			SLOGA("Please send PRIOR save and screenshot of this message. iAvailableTargets %d, index %d, iRandom %d, defence %d. ",
-				iAvailableTargets, index, iRandom, gpAR->usPlayerDefence);
-		}
-	}
-	else
-	{ //player team attacking an enemy
-		iAvailableTargets = gpAR->ubEnemies;
-		index = 0;
-		usSavedDefence = gpAR->usEnemyDefence;
-		while( iAvailableTargets )
-		{
-			pTarget = &gpEnemies[ index ];
-			if( !pTarget->pSoldier->bLife )
-			{
-				index++;
-				iAvailableTargets--;
-				continue;
-			}
-			iRandom = PreRandom( gpAR->usEnemyDefence );
-			gpAR->usEnemyDefence -= pTarget->usDefence;
-			if( iRandom < pTarget->usDefence )
-			{
-				gpAR->usEnemyDefence = usSavedDefence;
-				return pTarget;
-			}
-			index++;
-			iAvailableTargets--;
-		}
-	}
-	SLOGA("Error in ChooseTarget logic for choosing enemy target." );
-	return NULL;
-}
-
-
-static BOOLEAN FireAShot(SOLDIERCELL* pAttacker)
-{
-	OBJECTTYPE *pItem;
-	SOLDIERTYPE *pSoldier;
-	INT32 i;
-
-	pSoldier = pAttacker->pSoldier;
+	pSoldier = pAttacker->pSoldier;
 
 	if( pAttacker->uiFlags & CELL_MALECREATURE )
 	{
@@ -3003,510 +3338,39 @@ static BOOLEAN TargetHasLoadedGun(SOLDIERTYPE* pSoldier)
 }
 
 
-static void AttackTarget(SOLDIERCELL* pAttacker, SOLDIERCELL* pTarget)
+static BOOLEAN IsBattleOver(void)
 {
-	UINT16 usAttack;
-	UINT16 usDefence;
-	UINT8 ubImpact;
-	UINT8 ubLocation;
-	UINT8 ubAccuracy;
-	INT32 iRandom;
-	INT32 iImpact;
-	INT32 iNewLife;
-	BOOLEAN fMelee = FALSE;
-	BOOLEAN fKnife = FALSE;
-	BOOLEAN fClaw = FALSE;
-	INT8	bAttackIndex = -1;
-
-	pAttacker->uiFlags |= CELL_FIREDATTARGET | CELL_DIRTY;
-	if( pAttacker->usAttack < 950 )
-		usAttack = (UINT16)(pAttacker->usAttack + PreRandom(1000 - pAttacker->usAttack ));
-	else
-		usAttack = (UINT16)(950 + PreRandom( 50 ));
-	if( pTarget->uiFlags & CELL_RETREATING && !(pAttacker->uiFlags & CELL_FEMALECREATURE) )
-	{ //Attacking a retreating merc is harder.  Modify the attack value to 70% of it's value.
-		//This allows retreaters to have a better chance of escaping.
-		usAttack = usAttack * 7 / 10;
-	}
-	if( pTarget->usDefence < 950 )
-		usDefence = (UINT16)(pTarget->usDefence + PreRandom(1000 - pTarget->usDefence ));
-	else
-		usDefence = (UINT16)(950 + PreRandom( 50 ));
-	if( pAttacker->uiFlags & CELL_FEMALECREATURE )
-	{
-		pAttacker->bWeaponSlot = HANDPOS;
-		fMelee = TRUE;
-		fClaw = TRUE;
-	}
-	else if( !FireAShot( pAttacker ) )
-	{ //Maybe look for a weapon, such as a knife or grenade?
-		fMelee = TRUE;
-		fKnife = AttackerHasKnife( pAttacker );
-		if( TargetHasLoadedGun( pTarget->pSoldier ) )
-		{ //Penalty to attack with melee weapons against target with loaded gun.
-			if( !(pAttacker->uiFlags & CELL_CREATURE ) )
-			{ //except for creatures
-				if( fKnife )
-					usAttack = usAttack * 6 / 10;
-				else
-					usAttack = usAttack * 4 / 10;
-			}
-		}
-	}
-	//Set up a random delay for the hit or miss.
-	if( !fMelee )
-	{
-		if( !pTarget->usNextHit[0] )
-		{
-			bAttackIndex = 0;
-		}
-		else if( !pTarget->usNextHit[1] )
-		{
-			bAttackIndex = 1;
-		}
-		else if( !pTarget->usNextHit[2] )
-		{
-			bAttackIndex = 2;
-		}
-		if ( bAttackIndex != -1 )
-		{
-			pTarget->usNextHit[ bAttackIndex ] = (UINT16)( 50 + PreRandom( 400 ) );
-			pTarget->pAttacker[ bAttackIndex ] = pAttacker;
-		}
-	}
-	if( usAttack < usDefence )
-	{
-		if( pTarget->pSoldier->bLife >= OKLIFE || !PreRandom( 5 ) )
-		{	//Attacker misses -- use up a round of ammo.  If target is unconcious, then 80% chance of hitting.
-			pTarget->uiFlags |= CELL_DODGEDATTACK | CELL_DIRTY;
-			if( fMelee )
-			{
-				if( fKnife )
-					PlayAutoResolveSample(MISS_KNIFE, 50, 1, MIDDLEPAN);
-				else if( fClaw )
-				{
-					if( Chance( 50 ) )
-					{
-						PlayAutoResolveSample(ACR_SWIPE, 50, 1, MIDDLEPAN);
-					}
-					else
-					{
-						PlayAutoResolveSample(ACR_LUNGE, 50, 1, MIDDLEPAN);
-					}
-				}
-				else
-					PlayAutoResolveSample(SoundRange<SWOOSH_1, SWOOSH_6>(), 50, 1, MIDDLEPAN);
-				if (pTarget->uiFlags & CELL_MERC && pTarget->pSoldier->bLife >= OKLIFE)
-					// AGILITY GAIN: Target "dodged" an attack
-					StatChange(*pTarget->pSoldier, AGILAMT, 5, FROM_SUCCESS);
-			}
-			return;
-		}
-	}
-	//Attacker hits
-	if( !fMelee )
-	{
-		ubImpact = GCM->getWeapon(pAttacker->pSoldier->inv[pAttacker->bWeaponSlot].usItem)->ubImpact;
-		iRandom = PreRandom( 100 );
-		if( iRandom < 15 )
-			ubLocation = AIM_SHOT_HEAD;
-		else if( iRandom < 30 )
-			ubLocation = AIM_SHOT_LEGS;
-		else
-			ubLocation = AIM_SHOT_TORSO;
-		ubAccuracy = (UINT8)((usAttack - usDefence + PreRandom( usDefence - pTarget->usDefence ) )/10);
-		iImpact = BulletImpact( pAttacker->pSoldier, pTarget->pSoldier, ubLocation, ubImpact, ubAccuracy, NULL );
-
-		if ( bAttackIndex == -1 )
-		{
-			// tack damage on to end of last hit
-			pTarget->usHitDamage[2] += (UINT16) iImpact;
-		}
-		else
-		{
-			pTarget->usHitDamage[ bAttackIndex ] = (UINT16) iImpact;
-		}
-
-	}
-	else
+	if( gpAR->ubBattleStatus != BATTLE_IN_PROGRESS )
+		return TRUE;
+	ScreenBattle b;
+	gpAR->ubBattleStatus = AutoResolveBattleStatus(b);
+	switch( gpAR->ubBattleStatus )
 	{
-		OBJECTTYPE *pItem;
-		PlayAutoResolveSample(SoundRange<BULLET_IMPACT_1, BULLET_IMPACT_3>(), 50, 1, MIDDLEPAN);
-		if( !pTarget->pSoldier->bLife )
-		{ //Soldier already dead (can't kill him again!)
-			return;
-		}
-
-		ubAccuracy = (UINT8)((usAttack - usDefence + PreRandom( usDefence - pTarget->usDefence ) )/10);
-
-		//Determine attacking weapon.
-		pAttacker->pSoldier->usAttackingWeapon = 0;
-		if( pAttacker->bWeaponSlot != -1 )
-		{
-			pItem = &pAttacker->pSoldier->inv[ pAttacker->bWeaponSlot ];
-			if( GCM->getItem(pItem->usItem)->isWeapon() )
-				pAttacker->pSoldier->usAttackingWeapon = pAttacker->pSoldier->inv[ pAttacker->bWeaponSlot ].usItem;
-		}
-
-		iImpact = HTHImpact(pAttacker->pSoldier, pTarget->pSoldier, ubAccuracy, fKnife | fClaw);
-
-		iNewLife = pTarget->pSoldier->bLife - iImpact;
-
-		if( pAttacker->uiFlags & CELL_MERC )
-		{ //Attacker is a player, so increment the number of shots that hit.
-			gMercProfiles[ pAttacker->pSoldier->ubProfile ].usShotsHit++;
-			// MARKSMANSHIP GAIN: Attacker's shot hits
-			StatChange(*pAttacker->pSoldier, MARKAMT, 6, FROM_SUCCESS); // in addition to 3 for taking a shot
-		}
-		if( pTarget->uiFlags & CELL_MERC )
-		{ //Target is a player, so increment the times he has been wounded.
-			gMercProfiles[ pTarget->pSoldier->ubProfile ].usTimesWounded++;
-			// EXPERIENCE GAIN: Took some damage
-			StatChange(*pTarget->pSoldier, EXPERAMT, 5 * (iImpact / 10), FROM_SUCCESS);
-		}
-		if( pTarget->pSoldier->bLife >= CONSCIOUSNESS || pTarget->uiFlags & CELL_CREATURE )
-		{
-			if( gpAR->fSound )
-				DoMercBattleSound(pTarget->pSoldier, BATTLE_SOUND_HIT1);
-		}
-		if( !(pTarget->uiFlags & CELL_CREATURE) && iNewLife < OKLIFE && pTarget->pSoldier->bLife >= OKLIFE )
-		{ //the hit caused the merc to fall.  Play the falling sound
-			PlayAutoResolveSample(FALL_1, 50, 1, MIDDLEPAN);
-			pTarget->uiFlags &= ~CELL_RETREATING;
-		}
-		if( iNewLife <= 0 )
-		{ //soldier has been killed
-			if( pAttacker->uiFlags & CELL_MERC )
-			{ //Player killed the enemy soldier -- update his stats as well as any assisters.
-				gMercProfiles[ pAttacker->pSoldier->ubProfile ].usKills++;
-				gStrategicStatus.usPlayerKills++;
-			}
-			else if( pAttacker->uiFlags & CELL_MILITIA )
-			{
-				pAttacker->pSoldier->ubMilitiaKills += 2;
-			}
-			if( pTarget->uiFlags & CELL_MERC && gpAR->fSound )
-			{
-				PlayAutoResolveSample(DOORCR_1, HIGHVOLUME, 1, MIDDLEPAN);
-				PlayAutoResolveSample(HEADCR_1, HIGHVOLUME, 1, MIDDLEPAN);
-			}
-		}
-		//Adjust the soldiers stats based on the damage.
-		pTarget->pSoldier->bLife = (INT8)MAX( iNewLife, 0 );
-		if( pTarget->uiFlags & CELL_MERC && gpAR->pRobotCell)
-		{
-			UpdateRobotControllerGivenRobot( gpAR->pRobotCell->pSoldier );
-		}
-		if( fKnife || fClaw )
-		{
-			if( pTarget->pSoldier->bLifeMax - pTarget->pSoldier->bBleeding - iImpact >= pTarget->pSoldier->bLife )
-				pTarget->pSoldier->bBleeding += (INT8)iImpact;
-			else
-				pTarget->pSoldier->bBleeding = (INT8)(pTarget->pSoldier->bLifeMax - pTarget->pSoldier->bLife);
-		}
-		if( !pTarget->pSoldier->bLife )
-		{
-			gpAR->fRenderAutoResolve = TRUE;
-			#ifdef INVULNERABILITY
-			if( 1 )
-				RefreshMerc( pTarget->pSoldier );
-			else
-			#endif
-			if( pTarget->uiFlags & CELL_MERC )
-			{
-				gpAR->usPlayerAttack -= pTarget->usAttack;
-				gpAR->usPlayerDefence -= pTarget->usDefence;
-				gpAR->ubAliveMercs--;
-				pTarget->usAttack = 0;
-				pTarget->usDefence = 0;
-			}
-			else if( pTarget->uiFlags & CELL_MILITIA )
-			{
-				gpAR->usPlayerAttack -= pTarget->usAttack;
-				gpAR->usPlayerDefence -= pTarget->usDefence;
-				gpAR->ubAliveCivs--;
-				pTarget->usAttack = 0;
-				pTarget->usDefence = 0;
-			}
-			else if( pTarget->uiFlags & (CELL_ENEMY|CELL_CREATURE) )
-			{
-				gpAR->usEnemyAttack -= pTarget->usAttack;
-				gpAR->usEnemyDefence -= pTarget->usDefence;
-				gpAR->ubAliveEnemies--;
-				pTarget->usAttack = 0;
-				pTarget->usDefence = 0;
-			}
-		}
-		pTarget->uiFlags |= CELL_HITBYATTACKER | CELL_DIRTY;
-	}
-}
-
+		case BATTLE_IN_PROGRESS:
+			return FALSE;
 
-static void TargetHitCallback(SOLDIERCELL* pTarget, INT32 index)
-{
-	INT32 iNewLife;
-	SOLDIERCELL *pAttacker;
-	if( !pTarget->pSoldier->bLife )
-	{ //Soldier already dead (can't kill him again!)
-		return;
-	}
-	pAttacker = pTarget->pAttacker[ index ];
+		case BATTLE_RETREAT:
+			// wake everyone up
+			WakeUpAllMercsInSectorUnderAttack( );
 
-	//creatures get damage reduction bonuses
-	switch( pTarget->pSoldier->ubBodyType )
-	{
-		case LARVAE_MONSTER:
-		case INFANT_MONSTER:
+			RetreatAllInvolvedPlayerGroups( );
 			break;
-		case YAF_MONSTER:
-		case YAM_MONSTER:
-			pTarget->usHitDamage[index] = (pTarget->usHitDamage[index] + 2) / 4;
-			break;
-		case ADULTFEMALEMONSTER:
-		case AM_MONSTER:
-			pTarget->usHitDamage[index] = (pTarget->usHitDamage[index] + 3) / 6;
-			break;
-		case QUEENMONSTER:
-			pTarget->usHitDamage[index] = (pTarget->usHitDamage[index] + 4) / 8;
-			break;
-	}
-
-	iNewLife = pTarget->pSoldier->bLife - pTarget->usHitDamage[index];
-	if( !pTarget->usHitDamage[index] )
-	{ //bullet missed -- play a ricochet sound.
-		if (pTarget->uiFlags & CELL_MERC && pTarget->pSoldier->bLife >= OKLIFE)
-			// AGILITY GAIN: Target "dodged" an attack
-			StatChange(*pTarget->pSoldier, AGILAMT, 5, FROM_SUCCESS);
-		PlayAutoResolveSample(SoundRange<MISS_1, MISS_8>(), 50, 1, MIDDLEPAN);
-		return;
-	}
 
-	if( pAttacker->uiFlags & CELL_MERC )
-	{ //Attacker is a player, so increment the number of shots that hit.
-		gMercProfiles[ pAttacker->pSoldier->ubProfile ].usShotsHit++;
-		// MARKSMANSHIP GAIN: Attacker's shot hits
-		StatChange(*pAttacker->pSoldier, MARKAMT, 6, FROM_SUCCESS); // in addition to 3 for taking a shot
-	}
-	if( pTarget->uiFlags & CELL_MERC && pTarget->usHitDamage[ index ] )
-	{ //Target is a player, so increment the times he has been wounded.
-		gMercProfiles[ pTarget->pSoldier->ubProfile ].usTimesWounded++;
-		// EXPERIENCE GAIN: Took some damage
-		StatChange(*pTarget->pSoldier, EXPERAMT, 5 * (pTarget->usHitDamage[index] / 10), FROM_SUCCESS);
-	}
-
-	//bullet hit -- play an impact sound and a merc hit sound
-	PlayAutoResolveSample(SoundRange<BULLET_IMPACT_1, BULLET_IMPACT_3>(), 50, 1, MIDDLEPAN);
-
-	if( pTarget->pSoldier->bLife >= CONSCIOUSNESS )
-	{
-		if( gpAR->fSound )
-			DoMercBattleSound(pTarget->pSoldier, BATTLE_SOUND_HIT1);
-	}
-	if( iNewLife < OKLIFE && pTarget->pSoldier->bLife >= OKLIFE )
-	{ //the hit caused the merc to fall.  Play the falling sound
-		PlayAutoResolveSample(FALL_1, 50, 1, MIDDLEPAN);
-		pTarget->uiFlags &= ~CELL_RETREATING;
-	}
-	if( iNewLife <= 0 )
-	{ //soldier has been killed
-		if( pTarget->pAttacker[ index ]->uiFlags & CELL_PLAYER )
-		{ //Player killed the enemy soldier -- update his stats as well as any assisters.
-			SOLDIERCELL *pKiller;
-			SOLDIERCELL *pAssister1, *pAssister2;
-			pKiller = pTarget->pAttacker[ index ];
-			pAssister1 = pTarget->pAttacker[ index < 2 ? index + 1 : 0 ];
-			pAssister2 = pTarget->pAttacker[ index > 0 ? index - 1 : 2 ];
-			if( pKiller == pAssister1 )
-				pAssister1 = NULL;
-			if( pKiller == pAssister2 )
-				pAssister2 = NULL;
-			if( pAssister1 == pAssister2 )
-				pAssister2 = NULL;
-			if( pKiller )
-			{
-				if( pKiller->uiFlags & CELL_MERC )
-				{
-					gMercProfiles[ pKiller->pSoldier->ubProfile ].usKills++;
-					gStrategicStatus.usPlayerKills++;
-					// EXPERIENCE CLASS GAIN:  Earned a kill
-					StatChange(*pKiller->pSoldier, EXPERAMT, 10 * pTarget->pSoldier->bLevel, FROM_SUCCESS);
-					HandleMoraleEvent( pKiller->pSoldier, MORALE_KILLED_ENEMY, gpAR->ubSectorX, gpAR->ubSectorY, 0  );
-				}
-				else if( pKiller->uiFlags & CELL_MILITIA )
-					pKiller->pSoldier->ubMilitiaKills += 2;
-			}
-			if( pAssister1 )
+		case BATTLE_DEFEAT:
+			FOR_EACH_AR_ENEMY(i)
 			{
-				if( pAssister1->uiFlags & CELL_MERC )
+				if (i->pSoldier->bLife == 0) continue;
+				if (gubEnemyEncounterCode != CREATURE_ATTACK_CODE)
 				{
-					gMercProfiles[ pAssister1->pSoldier->ubProfile ].usAssists++;
-					// EXPERIENCE CLASS GAIN:  Earned an assist
-					StatChange(*pAssister1->pSoldier, EXPERAMT, 5 * pTarget->pSoldier->bLevel, FROM_SUCCESS);
+					DoMercBattleSound(i->pSoldier, BATTLE_SOUND_LAUGH1);
 				}
-				else if( pAssister1->uiFlags & CELL_MILITIA )
-					pAssister1->pSoldier->ubMilitiaKills++;
-			}
-			else if( pAssister2 )
-			{
-				if( pAssister2->uiFlags & CELL_MERC )
+				else
 				{
-					gMercProfiles[ pAssister2->pSoldier->ubProfile ].usAssists++;
-					// EXPERIENCE CLASS GAIN:  Earned an assist
-					StatChange(*pAssister2->pSoldier, EXPERAMT, 5 * pTarget->pSoldier->bLevel, FROM_SUCCESS);
+					PlayJA2Sample(ACR_EATFLESH, 50, 1, MIDDLEPAN);
 				}
-				else if( pAssister2->uiFlags & CELL_MILITIA )
-					pAssister2->pSoldier->ubMilitiaKills++;
-			}
-		}
-		if( pTarget->uiFlags & CELL_MERC && gpAR->fSound )
-		{
-			PlayAutoResolveSample(DOORCR_1, HIGHVOLUME, 1, MIDDLEPAN);
-			PlayAutoResolveSample(HEADCR_1, HIGHVOLUME, 1, MIDDLEPAN);
-		}
-		if( iNewLife < -60 && !(pTarget->uiFlags & CELL_CREATURE) )
-		{ //High damage death
-			if( gpAR->fSound )
-			{
-				if( PreRandom( 3 ) )
-					PlayAutoResolveSample(BODY_SPLAT_1, 50, 1, MIDDLEPAN);
-				else
-					PlayAutoResolveSample(HEADSPLAT_1, 50, 1, MIDDLEPAN);
-			}
-		}
-		else
-		{ //Normal death
-			if( gpAR->fSound )
-			{
-				DoMercBattleSound( pTarget->pSoldier, BATTLE_SOUND_DIE1 );
-			}
-		}
-		#ifdef INVULNERABILITY
-			RefreshMerc( pTarget->pSoldier );
-			return;
-		#endif
-	}
-	//Adjust the soldiers stats based on the damage.
-	pTarget->pSoldier->bLife = (INT8)MAX( iNewLife, 0 );
-	if( pTarget->uiFlags & CELL_MERC && gpAR->pRobotCell)
-	{
-		UpdateRobotControllerGivenRobot( gpAR->pRobotCell->pSoldier );
-	}
-
-	if( pTarget->pSoldier->bLifeMax - pTarget->pSoldier->bBleeding - pTarget->usHitDamage[index] >= pTarget->pSoldier->bLife )
-		pTarget->pSoldier->bBleeding += (INT8)pTarget->usHitDamage[index];
-	else
-		pTarget->pSoldier->bBleeding = (INT8)(pTarget->pSoldier->bLifeMax - pTarget->pSoldier->bLife);
-	if( !pTarget->pSoldier->bLife )
-	{
-		gpAR->fRenderAutoResolve = TRUE;
-		if( pTarget->uiFlags & CELL_MERC )
-		{
-			gpAR->usPlayerAttack -= pTarget->usAttack;
-			gpAR->usPlayerDefence -= pTarget->usDefence;
-			gpAR->ubAliveMercs--;
-			pTarget->usAttack = 0;
-			pTarget->usDefence = 0;
-		}
-		else if( pTarget->uiFlags & CELL_MILITIA )
-		{
-			gpAR->usPlayerAttack -= pTarget->usAttack;
-			gpAR->usPlayerDefence -= pTarget->usDefence;
-			gpAR->ubAliveCivs--;
-			pTarget->usAttack = 0;
-			pTarget->usDefence = 0;
-		}
-		else if( pTarget->uiFlags & (CELL_ENEMY|CELL_CREATURE) )
-		{
-			gpAR->usEnemyAttack -= pTarget->usAttack;
-			gpAR->usEnemyDefence -= pTarget->usDefence;
-			gpAR->ubAliveEnemies--;
-			pTarget->usAttack = 0;
-			pTarget->usDefence = 0;
-		}
-	}
-	pTarget->uiFlags |= CELL_HITBYATTACKER | CELL_DIRTY;
-}
-
-
-static BOOLEAN IsBattleOver(void)
-{
-	INT32 iNumInvolvedMercs = 0;
-	INT32 iNumMercsRetreated = 0;
-	BOOLEAN fOnlyEPCsLeft = TRUE;
-	if( gpAR->ubBattleStatus != BATTLE_IN_PROGRESS )
-		return TRUE;
-	FOR_EACH_AR_MERC(i)
-	{
-		if (i->uiFlags & CELL_RETREATED)
-		{
-			++iNumMercsRetreated;
-		}
-		else if (i->pSoldier->bLife != 0 && !(i->uiFlags & CELL_EPC))
-		{
-			fOnlyEPCsLeft = FALSE;
-			iNumInvolvedMercs++;
-		}
-	}
-	if( gpAR->pRobotCell )
-	{ //Do special robot checks
-		SOLDIERTYPE *pRobot;
-		pRobot = gpAR->pRobotCell->pSoldier;
-		if (pRobot->robot_remote_holder == NULL)
-		{ //Robot can't fight anymore.
-			gpAR->usPlayerAttack -= gpAR->pRobotCell->usAttack;
-			gpAR->pRobotCell->usAttack = 0;
-			if( iNumInvolvedMercs == 1 && !gpAR->ubAliveCivs )
-			{ //Robot is the only one left in battle, so instantly kill him.
-				DoMercBattleSound( pRobot, BATTLE_SOUND_DIE1 );
-				pRobot->bLife = 0;
-				gpAR->ubAliveMercs--;
-				iNumInvolvedMercs = 0;
-			}
-		}
-	}
-	if( !gpAR->ubAliveCivs && !iNumInvolvedMercs && iNumMercsRetreated )
-	{ //RETREATED
-		gpAR->ubBattleStatus = BATTLE_RETREAT;
-
-		// wake everyone up
-		WakeUpAllMercsInSectorUnderAttack( );
-
-		RetreatAllInvolvedPlayerGroups( );
-	}
-	else if( !gpAR->ubAliveCivs && !iNumInvolvedMercs )
-	{ //DEFEAT
-		if( fOnlyEPCsLeft )
-		{ //Kill the EPCs.
-			FOR_EACH_AR_MERC(i)
-			{
-				if (!(i->uiFlags & CELL_EPC)) continue;
-				DoMercBattleSound(i->pSoldier, BATTLE_SOUND_DIE1);
-				i->pSoldier->bLife = 0;
-				gpAR->ubAliveMercs--;
-			}
-		}
-		FOR_EACH_AR_ENEMY(i)
-		{
-			if (i->pSoldier->bLife == 0) continue;
-			if (gubEnemyEncounterCode != CREATURE_ATTACK_CODE)
-			{
-				DoMercBattleSound(i->pSoldier, BATTLE_SOUND_LAUGH1);
-			}
-			else
-			{
-				PlayJA2Sample(ACR_EATFLESH, 50, 1, MIDDLEPAN);
+				break;
 			}
 			break;
-		}
-		gpAR->ubBattleStatus = BATTLE_DEFEAT;
-	}
-	else if( !gpAR->ubAliveEnemies )
-	{ //VICTORY
-		gpAR->ubBattleStatus = BATTLE_VICTORY;
-	}
-	else
-	{
-		return FALSE;
 	}
 	SetupDoneInterface();
 	return TRUE;
@@ -3519,13 +3383,9 @@ static BOOLEAN IsBattleOver(void)
 static void SetupSurrenderInterface(void);
 
 
-static BOOLEAN AttemptPlayerCapture(void)
+//Whether the rest of the game lets the enemies capture the mercs in this battle
+static BOOLEAN IsPlayerCapturePermitted(void)
 {
-	BOOLEAN fConcious;
-	INT32 iConciousEnemies;
-
-#ifndef TESTSURRENDER
-
 	//Only attempt capture if day is less than four.
 	if( GetWorldDay() < STARTDAY_ALLOW_PLAYER_CAPTURE_FOR_RESCUE && !gpAR->fAllowCapture )
 	{
@@ -3543,41 +3403,28 @@ static BOOLEAN AttemptPlayerCapture(void)
 	{ //EPCs make things much more difficult when considering capture.  Simply don't allow it.
 		return FALSE;
 	}
-	//Only attempt capture of mercs if there are 2 or 3 of them alive
-	if( gpAR->ubAliveCivs || gpAR->ubAliveMercs < 2 || gpAR->ubAliveMercs > 3 )
-	{
-		return FALSE;
-	}
-	//if the number of alive enemies doesn't double the number of alive mercs, don't offer surrender.
-	if( gpAR->ubAliveEnemies < gpAR->ubAliveMercs*2 )
-	{
-		return FALSE;
-	}
-	//make sure that these enemies are actually concious!
-	iConciousEnemies = 0;
-	FOR_EACH_AR_ENEMY(i)
-	{
-		if (i->pSoldier->bLife < OKLIFE) continue;
-		++iConciousEnemies;
-	}
-	if( iConciousEnemies < gpAR->ubAliveMercs * 2 )
+	return TRUE;
+}
+
+
+static BOOLEAN AttemptPlayerCapture(void)
+{
+#ifndef TESTSURRENDER
+
+	if( !IsPlayerCapturePermitted() )
 	{
 		return FALSE;
 	}
 
-	//So far, the conditions are right.  Now, we will determine if the the remaining players are
-	//wounded and/or unconcious.  If any are concious, we will prompt for a surrender, otherwise,
+	//If any of the mercs are concious, we will prompt for a surrender, otherwise,
 	//it is automatic.
-	fConcious = FALSE;
-	FOR_EACH_AR_MERC(i)
+	ScreenBattle b;
+	AutoResolveCapture const capture = AutoResolveCaptureState(b);
+	if( capture == AR_NO_CAPTURE )
 	{
-		//if any of the 2 or 3 mercs has more than 60% life, then return.
-		if (i->uiFlags & CELL_ROBOT) return FALSE;
-		SOLDIERTYPE const& s = *i->pSoldier;
-		if (s.bLife * 100 > s.bLifeMax * 60) return FALSE;
-		if (s.bLife >= OKLIFE) fConcious = TRUE;
+		return FALSE;
 	}
-	if( fConcious )
+	if( capture == AR_CAPTURE_CONSCIOUS )
 	{
 		if( PreRandom( 100 ) < 2 )
 		{
@@ -3684,29 +3531,18 @@ static void RejectSurrenderCallback(GUI_BUTTON* btn, INT32 reason)
 
 static void ProcessBattleFrame(void)
 {
-	INT32 iRandom;
-	SOLDIERCELL *pAttacker, *pTarget;
+	ScreenBattle b;
 	UINT32 uiDiff;
-	static INT32 iTimeSlice = 0;
-	static BOOLEAN fContinue = FALSE;
-	static UINT32 uiSlice = 0;
-	static INT32 iTotal = 0;
-	static INT32 iMercs = 0;
-	static INT32 iCivs = 0;
-	static INT32 iEnemies = 0;
-	static INT32 iMercsLeft = 0;
-	static INT32 iCivsLeft = 0;
-	static INT32 iEnemiesLeft = 0;
-	BOOLEAN found = FALSE;
-	INT32 iTime, iAttacksThisFrame;
-
-	pAttacker = NULL;
-	iAttacksThisFrame = 0;
+	INT32& iTimeSlice = gpAR->iTimeSlice;
+	UINT32& uiSlice = gpAR->uiSlice;
+	AutoResolveTurnOrder& order = gpAR->order;
+	INT32 iAttacksThisFrame;
 
-	if( fContinue )
+	iAttacksThisFrame = 0;
+	if( gpAR->fContinueBattleFrame )
 	{
 		gpAR->uiCurrTime = GetJA2Clock();
-		fContinue = FALSE;
+		gpAR->fContinueBattleFrame = FALSE;
 		goto CONTINUE_BATTLE;
 	}
 	//determine how much real-time has passed since the last frame
@@ -3735,152 +3571,35 @@ static void ProcessBattleFrame(void)
 
 	while( iTimeSlice > 0 )
 	{
-		uiSlice = MIN( iTimeSlice, 1000 );
+		uiSlice = MIN( iTimeSlice, AUTORESOLVE_MAX_SLICE );
 		if( gpAR->ubBattleStatus == BATTLE_IN_PROGRESS )
 			gpAR->uiTotalElapsedBattleTimeInMilliseconds += uiSlice;
 
 		//Now process each of the players
-		iTotal   = gpAR->ubMercs + gpAR->ubCivs + gpAR->ubEnemies + 1;
-		iMercs   = iMercsLeft   = gpAR->ubMercs;
-		iCivs    = iCivsLeft    = gpAR->ubCivs;
-		iEnemies = iEnemiesLeft = gpAR->ubEnemies;
-		FOR_EACH_AR_MERC(i)
-			i->uiFlags &= ~CELL_PROCESSED;
-		FOR_EACH_AR_CIV(i)
-			i->uiFlags &= ~CELL_PROCESSED;
-		FOR_EACH_AR_ENEMY(i)
-			i->uiFlags &= ~CELL_PROCESSED;
-		while( --iTotal )
+		StartAutoResolveTurns( b, order );
+		while( --order.iTotal )
 		{
-			INT32 cnt;
 			if( (iTimeSlice != 0x7fffffff && GetJA2Clock() > gpAR->uiCurrTime+17) ||
 				(!gpAR->fInstantFinish && iAttacksThisFrame > (gpAR->ubMercs+gpAR->ubCivs+gpAR->ubEnemies)/4) )
 			{ //We have spent too much time in here.  In order to maintain 60FPS, we will
 				//leave now, which will allow for updating of the graphics (and mouse cursor),
-				//and all of the necessary locals are saved via static variables.  It'll check
-				//the fContinue flag, and goto the CONTINUE_BATTLE label the next time this function
-				//is called.
-				fContinue = TRUE;
+				//and all of the necessary locals are saved in gpAR.  It'll check the
+				//fContinueBattleFrame flag, and goto the CONTINUE_BATTLE label the next time
+				//this function is called.
+				gpAR->fContinueBattleFrame = TRUE;
 				return;
 			}
 			CONTINUE_BATTLE:
 			if( IsBattleOver() || (gubEnemyEncounterCode != CREATURE_ATTACK_CODE && AttemptPlayerCapture()) )
 				return;
 
-			iRandom = PreRandom( iTotal );
-			found = FALSE;
-			if( iMercs && iRandom < iMercsLeft )
-			{
-				iMercsLeft--;
-				while( !found )
-				{
-					iRandom = PreRandom( iMercs );
-					pAttacker = &gpMercs[ iRandom ];
-					if( !(pAttacker->uiFlags & CELL_PROCESSED ) )
-					{
-						pAttacker->uiFlags |= CELL_PROCESSED;
-						found = TRUE;
-					}
-				}
-			}
-			else if( iCivs && iRandom < iMercsLeft + iCivsLeft )
-			{
-				iCivsLeft--;
-				while( !found )
-				{
-					iRandom = PreRandom( iCivs );
-					pAttacker = &gpCivs[ iRandom ];
-					if( !(pAttacker->uiFlags & CELL_PROCESSED ) )
-					{
-						pAttacker->uiFlags |= CELL_PROCESSED;
-						found = TRUE;
-					}
-				}
-			}
-			else if( iEnemies && iEnemiesLeft )
-			{
-				iEnemiesLeft--;
-				while( !found )
-				{
-					iRandom = PreRandom( iEnemies );
-					pAttacker = &gpEnemies[ iRandom ];
-					if( !(pAttacker->uiFlags & CELL_PROCESSED ) )
-					{
-						pAttacker->uiFlags |= CELL_PROCESSED;
-						found = TRUE;
-					}
-				}
-			}
-			else
-				SLOGA("Logic error in ProcessBattleFrame()" );
-			//Apply damage and play miss/hit sounds if delay between firing and hit has expired.
-			if( !(pAttacker->uiFlags & CELL_RETREATED ) )
-			{
-				for( cnt = 0; cnt < 3; cnt++ )
-				{ //Check if any incoming bullets have hit the target.
-					if( pAttacker->usNextHit[ cnt ] )
-					{
-						iTime = pAttacker->usNextHit[ cnt ];
-						iTime -= uiSlice;
-						if( iTime >= 0 )
-						{ //Bullet still on route.
-							pAttacker->usNextHit[ cnt ] = (UINT16)iTime;
-						}
-						else
-						{ //Bullet is going to hit/miss.
-							TargetHitCallback( pAttacker, cnt );
-							pAttacker->usNextHit[ cnt ] = 0;
-						}
-					}
-				}
-			}
-			if( pAttacker->pSoldier->bLife < OKLIFE || pAttacker->uiFlags & CELL_RETREATED )
-			{
-				if( !(pAttacker->uiFlags & CELL_CREATURE) || !pAttacker->pSoldier->bLife )
-					continue; //can't attack if you are unconcious or not around (Or a live creature)
-			}
-			iTime = pAttacker->usNextAttack;
-			iTime -= uiSlice;
-			if( iTime > 0 )
-			{
-				pAttacker->usNextAttack = (UINT16)iTime;
-				continue;
-			}
-			else
-			{
-				if( pAttacker->uiFlags & CELL_RETREATING )
-				{ //The merc has successfully retreated.  Remove the stats, and continue on.
-					if( pAttacker == gpAR->pRobotCell )
-					{
-						if (gpAR->pRobotCell->pSoldier->robot_remote_holder == NULL)
-						{
-							gpAR->pRobotCell->uiFlags &= ~CELL_RETREATING;
-							gpAR->pRobotCell->uiFlags |= CELL_DIRTY;
-							gpAR->pRobotCell->usNextAttack = 0xffff;
-							continue;
-						}
-					}
-					gpAR->usPlayerDefence -= pAttacker->usDefence;
-					pAttacker->usDefence = 0;
-					pAttacker->uiFlags |= CELL_RETREATED;
-					continue;
-				}
-				if( pAttacker->usAttack )
-				{
-					pTarget = ChooseTarget( pAttacker );
-					if( pAttacker->uiFlags & CELL_CREATURE && PreRandom( 100 ) < 7 )
-						PlayAutoResolveSample(SoundRange<ACR_SMELL_THREAT, ACR_SMELL_PREY>(), 50, 1, MIDDLEPAN);
-					else
-						AttackTarget( pAttacker, pTarget );
-					ResetNextAttackCounter( pAttacker );
-					pAttacker->usNextAttack += (UINT16)iTime; //tack on the remainder
-					iAttacksThisFrame++;
-				}
-			}
+			SOLDIERCELL* const pAttacker = NextAutoResolveAttacker( b, order );
+			if( pAttacker && AutoResolveTurn( b, *pAttacker, uiSlice ) )
+				iAttacksThisFrame++;
 		}
 		if( iTimeSlice != 0x7fffffff )//|| !gpAR->fInstantFinish )
 		{
-			iTimeSlice -= 1000;
+			iTimeSlice -= AUTORESOLVE_MAX_SLICE;
 		}
 	}
 }
@@ -0,0 +1,578 @@
+#ifndef __AUTO_RESOLVE_RULES_H
+#define __AUTO_RESOLVE_RULES_H
+
+#include "Overhead_Types.h"
+#include "Types.h"
+
+
+/* The rules of an auto resolve battle, shared by the auto resolve screen and
+ * AutoResolveSimulation. They are templates over the battle, which holds the
+ * cells and does whatever else comes with the outcome of a roll: the screen
+ * plays sounds and updates soldiers and profiles, the simulation does nothing.
+ *
+ * A cell has the CELL_ flags in uiFlags and the members usAttack, usDefence,
+ * usNextAttack, usNextHit[3], usHitDamage[3] and pAttacker[3]. The battle
+ * provides:
+ *
+ *   UINT32  Roll(UINT32 range)            number in [0, range), 0 if range is 0
+ *   INT32   GroupSize(UINT8 group)        number of cells in an AR_GROUP
+ *   Cell&   GroupCell(UINT8 group, INT32 index)
+ *   Cell*   RobotCell()                   NULL without the robot
+ *   BOOLEAN RobotControlled()
+ *   void    UpdateRobotController()       after a merc was wounded
+ *   INT8    Life(Cell const&)
+ *   INT8    LifeMax(Cell const&)
+ *   void    SetLife(Cell&, INT8 life)
+ *   UINT16& SideAttack(BOOLEAN player)
+ *   UINT16& SideDefence(BOOLEAN player)
+ *   UINT8&  AliveMercs()
+ *   UINT8&  AliveCivs()
+ *   UINT8&  AliveEnemies()
+ *   BOOLEAN FireAShot(Cell& attacker)     FALSE if out of ammo or unarmed
+ *   BOOLEAN AttackerHasKnife(Cell& attacker)
+ *   void    AttacksWithClaws(Cell& attacker)
+ *   BOOLEAN TargetHasLoadedGun(Cell const& target)
+ *   INT32   BulletImpact(Cell& attacker, Cell& target, UINT8 location, UINT8 accuracy)
+ *   INT32   HTHImpact(Cell& attacker, Cell& target, UINT8 accuracy, BOOLEAN blade)
+ *   UINT8   DamageDivisor(Cell const&)    divides the damage of bullets, creatures shrug off some
+ *   void    BlowDodged(Cell& target, BOOLEAN knife, BOOLEAN claw)
+ *   void    BlowLands(Cell& attacker, Cell& target)
+ *   void    MeleeWound(Cell& attacker, Cell& target, INT32 damage, INT32 new_life)
+ *   void    BulletMissed(Cell& target)
+ *   void    BulletWound(Cell& target, INT32 index, INT32 new_life)
+ *   void    Bleeds(Cell& target, INT32 damage)
+ *   void    Killed(Cell& target)
+ *   void    DeathCry(Cell&)
+ *   void    SmellsPrey(Cell& creature)
+ *
+ * The wound and miss functions are called before the life of the target
+ * changes. */
+
+
+//Classifies the type of soldier the soldier cell is
+#define CELL_MERC		0x00000001
+#define CELL_MILITIA		0x00000002
+#define CELL_ELITE		0x00000004
+#define CELL_TROOP		0x00000008
+#define CELL_ADMIN		0x00000010
+#define CELL_AF_CREATURE	0x00000020
+#define CELL_AM_CREATURE	0x00000040
+#define CELL_YF_CREATURE	0x00000080
+#define CELL_YM_CREATURE	0x00000100
+//The team leader is the one with the highest leadership.
+//There can only be one teamleader per side (mercs/civs and enemies)
+#define CELL_TEAMLEADER		0x00000200
+//Combat flags
+#define CELL_FIREDATTARGET	0x00000400
+#define CELL_DODGEDATTACK	0x00000800
+#define CELL_HITBYATTACKER	0x00001000
+#define CELL_HITLASTFRAME	0x00002000
+//Cell statii
+#define CELL_SHOWRETREATTEXT	0x00004000
+#define CELL_RETREATING		0x00008000
+#define CELL_RETREATED		0x00010000
+#define CELL_DIRTY		0x00020000
+#define CELL_PROCESSED		0x00040000
+#define CELL_ASSIGNED		0x00080000
+#define CELL_EPC		0x00100000
+#define CELL_ROBOT		0x00200000
+
+//Combined flags
+#define CELL_PLAYER		( CELL_MERC | CELL_MILITIA )
+#define CELL_ENEMY		( CELL_ELITE | CELL_TROOP | CELL_ADMIN )
+#define CELL_CREATURE		( CELL_AF_CREATURE | CELL_AM_CREATURE | CELL_YF_CREATURE | CELL_YM_CREATURE )
+#define CELL_FEMALECREATURE	( CELL_AF_CREATURE | CELL_YF_CREATURE )
+#define CELL_MALECREATURE	( CELL_AM_CREATURE | CELL_YM_CREATURE )
+#define CELL_YOUNGCREATURE	( CELL_YF_CREATURE | CELL_YM_CREATURE )
+#define CELL_INVOLVEDINCOMBAT	( CELL_FIREDATTARGET | CELL_DODGEDATTACK | CELL_HITBYATTACKER )
+
+//Longest stretch of battle time handled in one go, which is what finishing the
+//battle instantly uses throughout
+#define AUTORESOLVE_MAX_SLICE 1000
+
+enum
+{
+	BATTLE_IN_PROGRESS,
+	BATTLE_VICTORY,
+	BATTLE_DEFEAT,
+	BATTLE_RETREAT,
+	BATTLE_SURRENDERED,
+	BATTLE_CAPTURED
+};
+
+//The cells of a battle, in the order they take their turns in
+enum
+{
+	AR_GROUP_MERCS,
+	AR_GROUP_CIVS,
+	AR_GROUP_ENEMIES,
+	NUM_AR_GROUPS
+};
+
+enum AutoResolveCapture
+{
+	AR_NO_CAPTURE,
+	AR_CAPTURE_CONSCIOUS,   // the player is offered to surrender
+	AR_CAPTURE_UNCONSCIOUS  // the mercs are captured without asking
+};
+
+
+//Who is left to take a turn in the current time slice
+struct AutoResolveTurnOrder
+{
+	INT32 iTotal;
+	INT32 iCount[NUM_AR_GROUPS];
+	INT32 iLeft[NUM_AR_GROUPS];
+};
+
+
+template<typename Battle> void StartAutoResolveTurns(Battle& b, AutoResolveTurnOrder& o)
+{
+	o.iTotal = 1;
+	for (UINT8 g = 0; g != NUM_AR_GROUPS; ++g)
+	{
+		o.iCount[g] = o.iLeft[g] = b.GroupSize(g);
+		o.iTotal += o.iCount[g];
+		for (INT32 i = 0; i != o.iCount[g]; ++i)
+		{
+			b.GroupCell(g, i).uiFlags &= ~CELL_PROCESSED;
+		}
+	}
+}
+
+
+//Picks who takes the next turn.  Call after decrementing o.iTotal, while it is
+//not 0.
+template<typename Battle> auto NextAutoResolveAttacker(Battle& b, AutoResolveTurnOrder& o) -> decltype(&b.GroupCell(0, 0))
+{
+	INT32 const iRandom = b.Roll(o.iTotal);
+	UINT8 group;
+	if( o.iCount[AR_GROUP_MERCS] && iRandom < o.iLeft[AR_GROUP_MERCS] )
+		group = AR_GROUP_MERCS;
+	else if( o.iCount[AR_GROUP_CIVS] && iRandom < o.iLeft[AR_GROUP_MERCS] + o.iLeft[AR_GROUP_CIVS] )
+		group = AR_GROUP_CIVS;
+	else if( o.iCount[AR_GROUP_ENEMIES] && o.iLeft[AR_GROUP_ENEMIES] )
+		group = AR_GROUP_ENEMIES;
+	else
+	{
+		SLOGA("Logic error in ProcessBattleFrame()" );
+		return NULL;
+	}
+
+	o.iLeft[group]--;
+	for (;;)
+	{
+		auto& cell = b.GroupCell(group, b.Roll(o.iCount[group]));
+		if( !(cell.uiFlags & CELL_PROCESSED) )
+		{
+			cell.uiFlags |= CELL_PROCESSED;
+			return &cell;
+		}
+	}
+}
+
+
+template<typename Battle, typename Cell> void ResetAutoResolveAttackCounter(Battle& b, Cell& cell)
+{
+	cell.usNextAttack = MIN( 1000 - cell.usAttack, 800 );
+	cell.usNextAttack = (UINT16)(1000 + cell.usNextAttack * 5 + b.Roll( 2000 - cell.usAttack ) );
+	if( cell.uiFlags & CELL_CREATURE )
+	{
+		cell.usNextAttack = cell.usNextAttack * 8 / 10;
+	}
+}
+
+
+//Picks a target from the other side, with a chance by its share of the defence
+//of its side.
+template<typename Battle, typename Cell> Cell* ChooseAutoResolveTarget(Battle& b, Cell const& attacker)
+{
+	BOOLEAN const fPlayerTargets = (attacker.uiFlags & (CELL_ENEMY | CELL_CREATURE)) != 0;
+	UINT16 usDefence = b.SideDefence(fPlayerTargets);
+	static UINT8 const player_groups[] = { AR_GROUP_MERCS, AR_GROUP_CIVS };
+	static UINT8 const enemy_groups[]  = { AR_GROUP_ENEMIES };
+	UINT8 const* const groups   = fPlayerTargets ? player_groups : enemy_groups;
+	UINT8 const        n_groups = fPlayerTargets ? 2 : 1;
+	for (UINT8 g = 0; g != n_groups; ++g)
+	{
+		for (INT32 i = 0; i != b.GroupSize(groups[g]); ++i)
+		{
+			Cell& target = b.GroupCell(groups[g], i);
+			if( !b.Life(target) || target.uiFlags & CELL_RETREATED )
+				continue;
+			INT32 const iRandom = b.Roll( usDefence );
+			usDefence -= target.usDefence;
+			if( iRandom < target.usDefence )
+				return &target;
+		}
+	}
+	SLOGA("Error in ChooseTarget logic for choosing %s target.", fPlayerTargets ? "player" : "enemy");
+	return NULL;
+}
+
+
+//Takes the cell out of the fight
+template<typename Battle, typename Cell> void AutoResolveKill(Battle& b, Cell& target)
+{
+	b.Killed(target);
+	BOOLEAN const fPlayer = (target.uiFlags & CELL_PLAYER) != 0;
+	b.SideAttack(fPlayer)  -= target.usAttack;
+	b.SideDefence(fPlayer) -= target.usDefence;
+	if( target.uiFlags & CELL_MERC )
+		b.AliveMercs()--;
+	else if( target.uiFlags & CELL_MILITIA )
+		b.AliveCivs()--;
+	else
+		b.AliveEnemies()--;
+	target.usAttack = 0;
+	target.usDefence = 0;
+}
+
+
+template<typename Battle, typename Cell> void AutoResolveAttack(Battle& b, Cell& attacker, Cell& target)
+{
+	UINT16 usAttack;
+	UINT16 usDefence;
+	UINT8 ubLocation;
+	UINT8 ubAccuracy;
+	INT32 iRandom;
+	INT32 iImpact;
+	INT32 iNewLife;
+	BOOLEAN fMelee = FALSE;
+	BOOLEAN fKnife = FALSE;
+	BOOLEAN fClaw = FALSE;
+	INT8	bAttackIndex = -1;
+
+	attacker.uiFlags |= CELL_FIREDATTARGET | CELL_DIRTY;
+	if( attacker.usAttack < 950 )
+		usAttack = (UINT16)(attacker.usAttack + b.Roll(1000 - attacker.usAttack ));
+	else
+		usAttack = (UINT16)(950 + b.Roll( 50 ));
+	if( target.uiFlags & CELL_RETREATING && !(attacker.uiFlags & CELL_FEMALECREATURE) )
+	{ //Attacking a retreating merc is harder.  Modify the attack value to 70% of it's value.
+		//This allows retreaters to have a better chance of escaping.
+		usAttack = usAttack * 7 / 10;
+	}
+	if( target.usDefence < 950 )
+		usDefence = (UINT16)(target.usDefence + b.Roll(1000 - target.usDefence ));
+	else
+		usDefence = (UINT16)(950 + b.Roll( 50 ));
+	if( attacker.uiFlags & CELL_FEMALECREATURE )
+	{
+		b.AttacksWithClaws( attacker );
+		fMelee = TRUE;
+		fClaw = TRUE;
+	}
+	else if( !b.FireAShot( attacker ) )
+	{ //Maybe look for a weapon, such as a knife or grenade?
+		fMelee = TRUE;
+		fKnife = b.AttackerHasKnife( attacker );
+		if( b.TargetHasLoadedGun( target ) )
+		{ //Penalty to attack with melee weapons against target with loaded gun.
+			if( !(attacker.uiFlags & CELL_CREATURE ) )
+			{ //except for creatures
+				if( fKnife )
+					usAttack = usAttack * 6 / 10;
+				else
+					usAttack = usAttack * 4 / 10;
+			}
+		}
+	}
+	//Set up a random delay for the hit or miss.
+	if( !fMelee )
+	{
+		if( !target.usNextHit[0] )
+		{
+			bAttackIndex = 0;
+		}
+		else if( !target.usNextHit[1] )
+		{
+			bAttackIndex = 1;
+		}
+		else if( !target.usNextHit[2] )
+		{
+			bAttackIndex = 2;
+		}
+		if ( bAttackIndex != -1 )
+		{
+			target.usNextHit[ bAttackIndex ] = (UINT16)( 50 + b.Roll( 400 ) );
+			target.pAttacker[ bAttackIndex ] = &attacker;
+		}
+	}
+	if( usAttack < usDefence )
+	{
+		if( b.Life(target) >= OKLIFE || !b.Roll( 5 ) )
+		{	//Attacker misses -- use up a round of ammo.  If target is unconcious, then 80% chance of hitting.
+			target.uiFlags |= CELL_DODGEDATTACK | CELL_DIRTY;
+			if( fMelee )
+				b.BlowDodged( target, fKnife, fClaw );
+			return;
+		}
+	}
+	//Attacker hits
+	if( !fMelee )
+	{
+		iRandom = b.Roll( 100 );
+		if( iRandom < 15 )
+			ubLocation = AIM_SHOT_HEAD;
+		else if( iRandom < 30 )
+			ubLocation = AIM_SHOT_LEGS;
+		else
+			ubLocation = AIM_SHOT_TORSO;
+		ubAccuracy = (UINT8)((usAttack - usDefence + b.Roll( usDefence - target.usDefence ) )/10);
+		iImpact = b.BulletImpact( attacker, target, ubLocation, ubAccuracy );
+
+		if ( bAttackIndex == -1 )
+		{
+			// tack damage on to end of last hit
+			target.usHitDamage[2] += (UINT16) iImpact;
+		}
+		else
+		{
+			target.usHitDamage[ bAttackIndex ] = (UINT16) iImpact;
+		}
+		return;
+	}
+
+	b.BlowLands( attacker, target );
+	if( !b.Life(target) )
+	{ //Soldier already dead (can't kill him again!)
+		return;
+	}
+
+	ubAccuracy = (UINT8)((usAttack - usDefence + b.Roll( usDefence - target.usDefence ) )/10);
+	iImpact = b.HTHImpact( attacker, target, ubAccuracy, fKnife | fClaw );
+
+	iNewLife = b.Life(target) - iImpact;
+	b.MeleeWound( attacker, target, iImpact, iNewLife );
+	if( !(target.uiFlags & CELL_CREATURE) && iNewLife < OKLIFE && b.Life(target) >= OKLIFE )
+	{ //the hit caused the merc to fall.
+		target.uiFlags &= ~CELL_RETREATING;
+	}
+	//Adjust the soldiers stats based on the damage.
+	b.SetLife( target, (INT8)MAX( iNewLife, 0 ) );
+	if( target.uiFlags & CELL_MERC )
+	{
+		b.UpdateRobotController();
+	}
+	if( fKnife || fClaw )
+	{
+		b.Bleeds( target, iImpact );
+	}
+	if( !b.Life(target) )
+	{
+		AutoResolveKill( b, target );
+	}
+	target.uiFlags |= CELL_HITBYATTACKER | CELL_DIRTY;
+}
+
+
+//A bullet fired by AutoResolveAttack() arrives
+template<typename Battle, typename Cell> void AutoResolveBulletArrives(Battle& b, Cell& target, INT32 const index)
+{
+	if( !b.Life(target) )
+	{ //Soldier already dead (can't kill him again!)
+		return;
+	}
+
+	//creatures get damage reduction bonuses
+	UINT8 const ubDivisor = b.DamageDivisor(target);
+	target.usHitDamage[index] = (target.usHitDamage[index] + ubDivisor / 2) / ubDivisor;
+
+	INT32 const iNewLife = b.Life(target) - target.usHitDamage[index];
+	if( !target.usHitDamage[index] )
+	{
+		b.BulletMissed( target );
+		return;
+	}
+
+	b.BulletWound( target, index, iNewLife );
+	if( iNewLife < OKLIFE && b.Life(target) >= OKLIFE )
+	{ //the hit caused the merc to fall.
+		target.uiFlags &= ~CELL_RETREATING;
+	}
+	//Adjust the soldiers stats based on the damage.
+	b.SetLife( target, (INT8)MAX( iNewLife, 0 ) );
+	if( target.uiFlags & CELL_MERC )
+	{
+		b.UpdateRobotController();
+	}
+	b.Bleeds( target, target.usHitDamage[index] );
+	if( !b.Life(target) )
+	{
+		AutoResolveKill( b, target );
+	}
+	target.uiFlags |= CELL_HITBYATTACKER | CELL_DIRTY;
+}
+
+
+//The turn of one cell in a time slice of uiSlice milliseconds: bullets fired at
+//it arrive, and it retreats or attacks when its time has come.  Returns whether
+//it attacked.
+template<typename Battle, typename Cell> BOOLEAN AutoResolveTurn(Battle& b, Cell& attacker, UINT32 const uiSlice)
+{
+	INT32 iTime;
+	//Apply damage and play miss/hit sounds if delay between firing and hit has expired.
+	if( !(attacker.uiFlags & CELL_RETREATED ) )
+	{
+		for (INT32 cnt = 0; cnt < 3; cnt++)
+		{ //Check if any incoming bullets have hit the target.
+			if( attacker.usNextHit[ cnt ] )
+			{
+				iTime = attacker.usNextHit[ cnt ];
+				iTime -= uiSlice;
+				if( iTime >= 0 )
+				{ //Bullet still on route.
+					attacker.usNextHit[ cnt ] = (UINT16)iTime;
+				}
+				else
+				{ //Bullet is going to hit/miss.
+					AutoResolveBulletArrives( b, attacker, cnt );
+					attacker.usNextHit[ cnt ] = 0;
+				}
+			}
+		}
+	}
+	if( b.Life(attacker) < OKLIFE || attacker.uiFlags & CELL_RETREATED )
+	{
+		if( !(attacker.uiFlags & CELL_CREATURE) || !b.Life(attacker) )
+			return FALSE; //can't attack if you are unconcious or not around (Or a live creature)
+	}
+	iTime = attacker.usNextAttack;
+	iTime -= uiSlice;
+	if( iTime > 0 )
+	{
+		attacker.usNextAttack = (UINT16)iTime;
+		return FALSE;
+	}
+	if( attacker.uiFlags & CELL_RETREATING )
+	{ //The merc has successfully retreated.  Remove the stats, and continue on.
+		if( &attacker == b.RobotCell() && !b.RobotControlled() )
+		{
+			attacker.uiFlags &= ~CELL_RETREATING;
+			attacker.uiFlags |= CELL_DIRTY;
+			attacker.usNextAttack = 0xffff;
+			return FALSE;
+		}
+		b.SideDefence(TRUE) -= attacker.usDefence;
+		attacker.usDefence = 0;
+		attacker.uiFlags |= CELL_RETREATED;
+		return FALSE;
+	}
+	if( !attacker.usAttack )
+		return FALSE;
+
+	Cell* const pTarget = ChooseAutoResolveTarget( b, attacker );
+	if( attacker.uiFlags & CELL_CREATURE && b.Roll( 100 ) < 7 )
+		b.SmellsPrey( attacker );
+	else if( pTarget )
+		AutoResolveAttack( b, attacker, *pTarget );
+	ResetAutoResolveAttackCounter( b, attacker );
+	attacker.usNextAttack += (UINT16)iTime; //tack on the remainder
+	return TRUE;
+}
+
+
+//Ends the battle when one side is out of fighters, or the mercs all retreated.
+//The robot cannot fight without its controller, and is lost if it is the last
+//one standing.  So are the EPCs when no fighter is left.
+template<typename Battle> UINT8 AutoResolveBattleStatus(Battle& b)
+{
+	INT32 iNumInvolvedMercs = 0;
+	INT32 iNumMercsRetreated = 0;
+	BOOLEAN fOnlyEPCsLeft = TRUE;
+	for (INT32 i = 0; i != b.GroupSize(AR_GROUP_MERCS); ++i)
+	{
+		auto const& c = b.GroupCell(AR_GROUP_MERCS, i);
+		if (c.uiFlags & CELL_RETREATED)
+		{
+			++iNumMercsRetreated;
+		}
+		else if (b.Life(c) != 0 && !(c.uiFlags & CELL_EPC))
+		{
+			fOnlyEPCsLeft = FALSE;
+			iNumInvolvedMercs++;
+		}
+	}
+	auto* const pRobot = b.RobotCell();
+	if( pRobot && !b.RobotControlled() )
+	{ //Robot can't fight anymore.
+		b.SideAttack(TRUE) -= pRobot->usAttack;
+		pRobot->usAttack = 0;
+		if( iNumInvolvedMercs == 1 && !b.AliveCivs() )
+		{ //Robot is the only one left in battle, so instantly kill him.
+			b.DeathCry( *pRobot );
+			b.SetLife( *pRobot, 0 );
+			b.AliveMercs()--;
+			iNumInvolvedMercs = 0;
+		}
+	}
+	if( !b.AliveCivs() && !iNumInvolvedMercs && iNumMercsRetreated )
+	{
+		return BATTLE_RETREAT;
+	}
+	if( !b.AliveCivs() && !iNumInvolvedMercs )
+	{
+		if( fOnlyEPCsLeft )
+		{ //Kill the EPCs.
+			for (INT32 i = 0; i != b.GroupSize(AR_GROUP_MERCS); ++i)
+			{
+				auto& c = b.GroupCell(AR_GROUP_MERCS, i);
+				if (!(c.uiFlags & CELL_EPC)) continue;
+				b.DeathCry( c );
+				b.SetLife( c, 0 );
+				b.AliveMercs()--;
+			}
+		}
+		return BATTLE_DEFEAT;
+	}
+	if( !b.AliveEnemies() )
+	{
+		return BATTLE_VICTORY;
+	}
+	return BATTLE_IN_PROGRESS;
+}
+
+
+//Whether the enemies capture the mercs, where the rest of the game allows it.
+//They only do when 2 or 3 badly wounded mercs face at least twice as many
+//conscious enemies.
+template<typename Battle> AutoResolveCapture AutoResolveCaptureState(Battle& b)
+{
+	//Only attempt capture of mercs if there are 2 or 3 of them alive
+	if( b.AliveCivs() || b.AliveMercs() < 2 || b.AliveMercs() > 3 )
+	{
+		return AR_NO_CAPTURE;
+	}
+	//if the number of alive enemies doesn't double the number of alive mercs, don't offer surrender.
+	if( b.AliveEnemies() < b.AliveMercs() * 2 )
+	{
+		return AR_NO_CAPTURE;
+	}
+	//make sure that these enemies are actually concious!
+	INT32 iConciousEnemies = 0;
+	for (INT32 i = 0; i != b.GroupSize(AR_GROUP_ENEMIES); ++i)
+	{
+		if (b.Life(b.GroupCell(AR_GROUP_ENEMIES, i)) < OKLIFE) continue;
+		++iConciousEnemies;
+	}
+	if( iConciousEnemies < b.AliveMercs() * 2 )
+	{
+		return AR_NO_CAPTURE;
+	}
+
+	//So far, the conditions are right.  Now, we will determine if the the remaining players are
+	//wounded and/or unconcious.
+	BOOLEAN fConcious = FALSE;
+	for (INT32 i = 0; i != b.GroupSize(AR_GROUP_MERCS); ++i)
+	{
+		//if any of the 2 or 3 mercs has more than 60% life, then return.
+		auto const& c = b.GroupCell(AR_GROUP_MERCS, i);
+		if (c.uiFlags & CELL_ROBOT) return AR_NO_CAPTURE;
+		if (b.Life(c) * 100 > b.LifeMax(c) * 60) return AR_NO_CAPTURE;
+		if (b.Life(c) >= OKLIFE) fConcious = TRUE;
+	}
+	return fConcious ? AR_CAPTURE_CONSCIOUS : AR_CAPTURE_UNCONSCIOUS;
+}
+
+#endif
@@ -0,0 +1,450 @@
+#include "Auto_Resolve_Sim.h"
+#include "Auto_Resolve_Rules.h"
+#include "Isometric_Utils.h"
+#include "ThreadPool.h"
+#include "Weapons.h"
+
+#include <future>
+#include <math.h>
+
+
+// Give up on battles nobody can win, like two sides without weapons
+#define AR_SIM_MAX_MILLISECONDS (6 * 60 * 60 * 1000)
+
+
+AutoResolveSimulation::AutoResolveSimulation(AutoResolveBattle const& battle, uint64_t const seed) :
+	m_battle(battle),
+	m_robot(NULL),
+	m_robotControlled(battle.fRobotControlled),
+	m_random(seed)
+{
+	m_attack[0]  = m_attack[1]  = 0;
+	m_defence[0] = m_defence[1] = 0;
+	m_alive[0] = m_alive[1] = m_alive[2] = 0;
+
+	m_cells.reserve(battle.combatants.size());
+	for (AutoResolveCombatant const& c : battle.combatants)
+	{
+		Cell cell{};
+		cell.uiFlags      = c.uiFlags;
+		cell.usAttack     = c.usAttack;
+		cell.usDefence    = c.usDefence;
+		cell.usNextAttack = c.usNextAttack;
+		cell.c            = c;
+		m_cells.push_back(cell);
+	}
+
+	for (Cell& cell : m_cells)
+	{
+		UINT8 const group =
+			cell.uiFlags & CELL_MERC    ? AR_GROUP_MERCS :
+			cell.uiFlags & CELL_MILITIA ? AR_GROUP_CIVS  :
+			AR_GROUP_ENEMIES;
+		m_groups[group].push_back(&cell);
+		if (cell.uiFlags & CELL_ROBOT) m_robot = &cell;
+
+		BOOLEAN const player = (cell.uiFlags & CELL_PLAYER) != 0;
+		SideAttack(player)  += cell.usAttack;
+		SideDefence(player) += cell.usDefence;
+		++m_alive[group];
+	}
+}
+
+
+void AutoResolveSimulation::UpdateRobotController()
+{
+	// Like UpdateRobotControllerGivenRobot()
+	m_robotControlled = m_battle.fRobotControllerAway;
+	for (Cell const* const cell : m_groups[AR_GROUP_MERCS])
+	{
+		if (cell->c.fRobotController && cell->c.bLife >= OKLIFE) m_robotControlled = true;
+	}
+}
+
+
+BOOLEAN AutoResolveSimulation::FireAShot(Cell& attacker)
+{
+	AutoResolveCombatant& c = attacker.c;
+	if (attacker.uiFlags & CELL_MALECREATURE) return TRUE; // spit never runs out
+	if (!c.fHasGun) return FALSE;
+	if (m_battle.fUnlimitedAmmo) return TRUE;
+	if (!c.ubGunShotsLeft && c.ubClips)
+	{ // AutoReload()
+		c.ubGunShotsLeft = c.ubClipShots[0];
+		--c.ubClips;
+		for (UINT8 i = 0; i != c.ubClips; ++i) c.ubClipShots[i] = c.ubClipShots[i + 1];
+	}
+	if (!c.ubGunShotsLeft) return FALSE;
+	--c.ubGunShotsLeft;
+	return TRUE;
+}
+
+
+BOOLEAN AutoResolveSimulation::TargetHasLoadedGun(Cell const& target) const
+{
+	AutoResolveCombatant const& c = target.c;
+	if (c.fSpareLoadedGun) return TRUE;
+	return c.fHasGun && (m_battle.fUnlimitedAmmo || c.ubGunShotsLeft);
+}
+
+
+// TotalArmourProtection() with the armour of the snapshot
+INT32 AutoResolveSimulation::ArmourProtection(Cell& target, UINT8 const location, INT32 const impact, UINT8 const ammo_type)
+{
+	AutoResolveArmour* const armour = target.c.Armour;
+	UINT8 slot;
+	switch (location)
+	{
+		case AIM_SHOT_HEAD: slot = AR_ARMOUR_HELMET;   break;
+		case AIM_SHOT_LEGS: slot = AR_ARMOUR_LEGGINGS; break;
+		default:            slot = AR_ARMOUR_VEST;     break;
+	}
+	if (!armour[slot].bStatus) return 0;
+
+	BOOLEAN const robot = (target.uiFlags & CELL_ROBOT) != 0;
+	INT32 protection = 0;
+	if (slot == AR_ARMOUR_VEST && armour[AR_ARMOUR_PLATES].bStatus)
+	{ // bullet got through jacket; apply ceramic plate armour
+		AutoResolveArmour& plates = armour[AR_ARMOUR_PLATES];
+		UINT32 const weak_spot = robot ? 0 : Roll(100) + 1;
+		protection += ::ArmourProtection(plates.ubType, &plates.bStatus, impact, ammo_type, robot, weak_spot);
+		if (plates.bStatus < USABLE) plates.bStatus = 0; // destroy plates!
+	}
+
+	// if the plate didn't stop the bullet...
+	if (impact > protection)
+	{
+		AutoResolveArmour& piece = armour[slot];
+		UINT32 const weak_spot = robot ? 0 : Roll(100) + 1;
+		protection += ::ArmourProtection(piece.ubType, &piece.bStatus, impact, ammo_type, robot, weak_spot);
+		if (piece.bStatus < USABLE) piece.bStatus = 0;
+	}
+	return protection;
+}
+
+
+// BulletImpact() without what only happens in tactical combat
+INT32 AutoResolveSimulation::BulletImpact(Cell& attacker, Cell& target, UINT8 const location, UINT8 const accuracy)
+{
+	UINT8 const ammo_type = attacker.c.ubAmmoType;
+
+	INT32 const fluke = Roll(51) - 25;
+	INT32 const bonus = accuracy / 2;
+	INT32 orig_impact = attacker.c.ubGunImpact * (100 + fluke + bonus) / 100;
+	if (orig_impact < 1) orig_impact = 1;
+
+	if (ammo_type == AMMO_HE || ammo_type == AMMO_HEAT)
+	{
+		orig_impact = AMMO_DAMAGE_ADJUSTMENT_HE(orig_impact);
+	}
+
+	INT32 impact = orig_impact - ArmourProtection(target, location, orig_impact, ammo_type);
+
+	// calc minimum damage
+	if (ammo_type == AMMO_HP || ammo_type == AMMO_SLEEP_DART)
+	{
+		if (impact < 0) impact = 0;
+	}
+	else if (impact < (orig_impact + 5) / 10)
+	{
+		impact = (orig_impact + 5) / 10;
+	}
+
+	if (impact <= 0) return impact;
+	if (ammo_type == AMMO_SLEEP_DART && accuracy > 20) return impact;
+	if (ammo_type == AMMO_HP) impact = AMMO_DAMAGE_ADJUSTMENT_HP(impact);
+
+	INT32 impact_for_crits = impact;
+	switch (location)
+	{
+		case AIM_SHOT_HEAD:
+			impact_for_crits = (INT32)floorf(m_battle.fHeadDamageMultiplier * (float)impact);
+			impact           = impact_for_crits;
+			break;
+		case AIM_SHOT_LEGS:
+			impact_for_crits = (INT32)floorf(m_battle.fLegsDamageMultiplier * (float)impact);
+			impact           = (INT32)floorf(m_battle.fLegsDamageMultiplier * (float)impact_for_crits);
+			break;
+	}
+
+	// instant kills
+	if (PythSpacesAway(attacker.c.sGridNo, target.c.sGridNo) > MAX_DISTANCE_FOR_MESSY_DEATH) return impact;
+	INT8 const life = target.c.bLife;
+	switch (location)
+	{
+		case AIM_SHOT_HEAD:
+			if (impact_for_crits > MIN_DAMAGE_FOR_INSTANT_KILL && impact_for_crits < life)
+			{
+				impact = life + Roll(10);
+			}
+			break;
+		case AIM_SHOT_TORSO:
+			if (impact > MIN_DAMAGE_FOR_INSTANT_KILL && impact < life)
+			{
+				impact = life + Roll(10);
+			}
+			else if (impact + target.c.sDamage > MIN_DAMAGE_FOR_BLOWN_AWAY + MIN_DAMAGE_FOR_INSTANT_KILL)
+			{
+				impact = life + Roll(10);
+			}
+			break;
+	}
+	return impact;
+}
+
+
+// HTHImpact() with the numbers of the snapshot
+INT32 AutoResolveSimulation::HTHImpact(Cell& attacker, Cell& target, UINT8 const accuracy, BOOLEAN const blade)
+{
+	AutoResolveCombatant const& a = attacker.c;
+
+	// EffectiveStrength()
+	INT8 const bandaged = a.bLifeMax - a.bLife - a.bBleeding;
+	INT32 strength = a.bStrength / 2 + (a.bStrength / 2) * (a.bLife + bandaged / 2) / a.bLifeMax;
+	strength = MAX(strength, 2);
+
+	BOOLEAN const robot = (target.uiFlags & CELL_ROBOT) != 0;
+	INT32 impact = a.bExpLevel / 2;
+	if (blade)
+	{
+		impact += strength / 20 + a.ubBladeImpact;
+		if (robot) impact /= 4;
+	}
+	else
+	{
+		impact += strength / 5 + 5;
+		if (robot) impact = 0;
+	}
+
+	INT32 const fluke = Roll(51) - 25;
+	INT32 const bonus = accuracy / 2;
+	impact = impact * (100 + fluke + bonus) / 100;
+
+	if (!blade)
+	{
+		impact = impact * (100 + a.ubMartialArtsBonus) / 100;
+		impact = impact * (100 + a.ubHandToHandBonus) / 100;
+	}
+	return impact;
+}
+
+
+void AutoResolveSimulation::Bleeds(Cell& target, INT32 const damage)
+{
+	AutoResolveCombatant& c = target.c;
+	if (c.bLifeMax - c.bBleeding - damage >= c.bLife)
+		c.bBleeding += (INT8)damage;
+	else
+		c.bBleeding = (INT8)(c.bLifeMax - c.bLife);
+}
+
+
+AutoResolveOutcome AutoResolveSimulation::Run()
+{
+	AutoResolveOutcome o{};
+	for (;;)
+	{
+		AutoResolveTurnOrder order;
+		StartAutoResolveTurns(*this, order);
+		while (--order.iTotal)
+		{
+			o.ubBattleStatus = AutoResolveBattleStatus(*this);
+			if (o.ubBattleStatus == BATTLE_IN_PROGRESS && m_battle.fCapturePermitted)
+			{ // The screen keeps trying until the enemies take the mercs
+				switch (AutoResolveCaptureState(*this))
+				{
+					case AR_CAPTURE_CONSCIOUS:   o.ubBattleStatus = BATTLE_SURRENDERED; break;
+					case AR_CAPTURE_UNCONSCIOUS: o.ubBattleStatus = BATTLE_CAPTURED;    break;
+					default: break;
+				}
+			}
+			if (o.ubBattleStatus != BATTLE_IN_PROGRESS ||
+				o.uiElapsedMilliseconds > AR_SIM_MAX_MILLISECONDS)
+			{
+				for (Cell const& cell : m_cells)
+				{
+					if (cell.c.bLife != 0) continue;
+					if (cell.uiFlags & CELL_PLAYER)
+						++o.ubPlayerCasualties;
+					else
+						++o.ubEnemyCasualties;
+				}
+				return o;
+			}
+
+			Cell* const attacker = NextAutoResolveAttacker(*this, order);
+			if (attacker) AutoResolveTurn(*this, *attacker, AUTORESOLVE_MAX_SLICE);
+		}
+		o.uiElapsedMilliseconds += AUTORESOLVE_MAX_SLICE;
+	}
+}
+
+
+static ThreadPool& AutoResolveSimPool()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+
+AutoResolveOdds PredictAutoResolveBattle(AutoResolveBattle const& battle, UINT32 const runs, UINT32 const seed, UINT32 n_threads)
+{
+	struct Totals
+	{
+		UINT32 wins;
+		UINT32 captures;
+		UINT32 player_casualties;
+		UINT32 enemy_casualties;
+	};
+
+	ThreadPool& pool = AutoResolveSimPool();
+	if (n_threads == 0 || n_threads > pool.size()) n_threads = (UINT32)pool.size();
+	n_threads = MIN(n_threads, runs);
+
+	std::vector<std::future<Totals>> tasks;
+	tasks.reserve(n_threads);
+	for (UINT32 task = 0; task != n_threads; ++task)
+	{
+		tasks.push_back(pool.enqueue([&battle, runs, seed, task, n_threads]()
+		{
+			Totals t{};
+			for (UINT32 run = task; run < runs; run += n_threads)
+			{
+				AutoResolveOutcome const o = AutoResolveSimulation(battle, uint64_t(seed) << 32 | run).Run();
+				switch (o.ubBattleStatus)
+				{
+					case BATTLE_VICTORY:     ++t.wins;     break;
+					case BATTLE_SURRENDERED:
+					case BATTLE_CAPTURED:    ++t.captures; break;
+				}
+				t.player_casualties += o.ubPlayerCasualties;
+				t.enemy_casualties  += o.ubEnemyCasualties;
+			}
+			return t;
+		}));
+	}
+
+	Totals sum{};
+	for (std::future<Totals>& f : tasks)
+	{
+		Totals const t = f.get();
+		sum.wins              += t.wins;
+		sum.captures          += t.captures;
+		sum.player_casualties += t.player_casualties;
+		sum.enemy_casualties  += t.enemy_casualties;
+	}
+
+	AutoResolveOdds odds{};
+	odds.uiRuns = runs;
+	if (runs != 0)
+	{
+		odds.dWinProbability           = (double)sum.wins              / runs;
+		odds.dCaptureProbability       = (double)sum.captures          / runs;
+		odds.dExpectedPlayerCasualties = (double)sum.player_casualties / runs;
+		odds.dExpectedEnemyCasualties  = (double)sum.enemy_casualties  / runs;
+	}
+	return odds;
+}
+
+
+#ifdef WITH_UNITTESTS
+#include "gtest/gtest.h"
+
+static AutoResolveCombatant TestCombatant(UINT32 const flags, UINT16 const attack, UINT16 const defence)
+{
+	AutoResolveCombatant c{};
+	c.uiFlags         = flags;
+	c.usAttack        = attack;
+	c.usDefence       = defence;
+	c.usNextAttack    = 500;
+	c.bLife           = 60;
+	c.bLifeMax        = 60;
+	c.bStrength       = 70;
+	c.bExpLevel       = 3;
+	c.sGridNo         = NOWHERE;
+	c.fHasGun         = true;
+	c.ubGunImpact     = 25;
+	c.ubGunShotsLeft  = 30;
+	c.ubClips         = 2;
+	c.ubClipShots[0]  = 30;
+	c.ubClipShots[1]  = 30;
+	c.ubDamageDivisor = 1;
+	return c;
+}
+
+static AutoResolveBattle TestBattle(UINT8 const mercs, UINT16 const merc_strength, UINT8 const enemies, UINT16 const enemy_strength)
+{
+	AutoResolveBattle b;
+	for (UINT8 i = 0; i != mercs; ++i)
+		b.combatants.push_back(TestCombatant(CELL_MERC, merc_strength, merc_strength));
+	for (UINT8 i = 0; i != enemies; ++i)
+		b.combatants.push_back(TestCombatant(CELL_TROOP, enemy_strength, enemy_strength));
+	return b;
+}
+
+TEST(AutoResolveSim, deterministicForSeed)
+{
+	AutoResolveBattle const b = TestBattle(4, 600, 5, 500);
+
+	AutoResolveOutcome const o1 = AutoResolveSimulation(b, 42).Run();
+	AutoResolveOutcome const o2 = AutoResolveSimulation(b, 42).Run();
+	EXPECT_EQ(o1.ubBattleStatus,        o2.ubBattleStatus);
+	EXPECT_EQ(o1.ubPlayerCasualties,    o2.ubPlayerCasualties);
+	EXPECT_EQ(o1.ubEnemyCasualties,     o2.ubEnemyCasualties);
+	EXPECT_EQ(o1.uiElapsedMilliseconds, o2.uiElapsedMilliseconds);
+	EXPECT_TRUE(o1.ubBattleStatus == BATTLE_VICTORY ? o1.ubEnemyCasualties == 5 : o1.ubPlayerCasualties == 4);
+}
+
+TEST(AutoResolveSim, oddsFollowStrength)
+{
+	AutoResolveOdds const s = PredictAutoResolveBattle(TestBattle(8, 800, 3, 300), 200, 1);
+	AutoResolveOdds const w = PredictAutoResolveBattle(TestBattle(2, 300, 8, 800), 200, 1);
+	EXPECT_EQ(s.uiRuns, 200u);
+	EXPECT_GT(s.dWinProbability, 0.9);
+	EXPECT_LT(w.dWinProbability, 0.1);
+	EXPECT_LT(s.dExpectedPlayerCasualties, w.dExpectedPlayerCasualties);
+}
+
+TEST(AutoResolveSim, sameOddsOnAnyNumberOfThreads)
+{
+	AutoResolveBattle const b = TestBattle(5, 550, 6, 500);
+	AutoResolveOdds const one  = PredictAutoResolveBattle(b, 300, 7, 1);
+	AutoResolveOdds const many = PredictAutoResolveBattle(b, 300, 7, 4);
+	EXPECT_EQ(one.dWinProbability,           many.dWinProbability);
+	EXPECT_EQ(one.dCaptureProbability,       many.dCaptureProbability);
+	EXPECT_EQ(one.dExpectedPlayerCasualties, many.dExpectedPlayerCasualties);
+	EXPECT_EQ(one.dExpectedEnemyCasualties,  many.dExpectedEnemyCasualties);
+}
+
+TEST(AutoResolveSim, armourWearsDown)
+{
+	AutoResolveBattle b = TestBattle(1, 600, 1, 600);
+	AutoResolveCombatant& merc = b.combatants[0];
+	merc.Armour[AR_ARMOUR_VEST]   = { 3, 100 };  // Kevlar jacket
+	merc.Armour[AR_ARMOUR_PLATES] = { 22, 100 }; // Ceramic plates
+
+	AutoResolveSimulation sim(b, 3);
+	AutoResolveSimulation::Cell& attacker = sim.GroupCell(AR_GROUP_ENEMIES, 0);
+	AutoResolveSimulation::Cell& target   = sim.GroupCell(AR_GROUP_MERCS,   0);
+	INT32 const impact = sim.BulletImpact(attacker, target, AIM_SHOT_TORSO, 0);
+	EXPECT_GE(impact, 0);
+	EXPECT_LT(target.c.Armour[AR_ARMOUR_PLATES].bStatus, 100);
+	EXPECT_EQ(target.c.Armour[AR_ARMOUR_HELMET].bStatus, 0);
+}
+
+TEST(AutoResolveSim, capturedWhenBadlyWounded)
+{
+	AutoResolveBattle b = TestBattle(2, 500, 6, 500);
+	b.combatants[0].bLife = 20;
+	b.combatants[1].bLife = 5;
+	b.fCapturePermitted = true;
+	EXPECT_EQ(AutoResolveSimulation(b, 1).Run().ubBattleStatus, BATTLE_SURRENDERED);
+
+	b.combatants[0].bLife = 5;
+	EXPECT_EQ(AutoResolveSimulation(b, 1).Run().ubBattleStatus, BATTLE_CAPTURED);
+
+	b.fCapturePermitted = false;
+	EXPECT_NE(AutoResolveSimulation(b, 1).Run().ubBattleStatus, BATTLE_CAPTURED);
+}
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef __AUTO_RESOLVE_SIM_H
+#define __AUTO_RESOLVE_SIM_H
+
+#include "Item_Types.h"
+#include "Random.h"
+#include "Types.h"
+
+#include <vector>
+
+
+/* Headless auto resolve battle. It plays by the rules in Auto_Resolve_Rules.h
+ * like the auto resolve screen, but works on a snapshot of plain values, so
+ * it has no side effects on soldiers, profiles or the random number streams
+ * and can run to completion instantly on any thread.
+ *
+ * What the screen reads from the soldiers during the battle is snapshotted
+ * when it starts: the first gun and its magazines, a blade, the worn armour
+ * and what goes into EffectiveStrength(). Where the screen goes by more of
+ * the soldier, the simulation keeps it simple: only the first gun fires,
+ * reloads keep the ammo type and the drunk level does not change. A surrender
+ * offer counts as the player surrendering. */
+
+#define AR_MAX_CLIPS MAX_OBJECTS_PER_SLOT
+
+enum AutoResolveArmourSlot
+{
+	AR_ARMOUR_HELMET,
+	AR_ARMOUR_VEST,
+	AR_ARMOUR_PLATES, // attached to the vest
+	AR_ARMOUR_LEGGINGS,
+	NUM_AR_ARMOUR
+};
+
+struct AutoResolveArmour
+{
+	UINT8 ubType;   // index into Armour[]
+	INT8  bStatus;  // 0 if not worn
+};
+
+struct AutoResolveCombatant
+{
+	UINT32 uiFlags;            // CELL_ flags of the auto resolve cell
+	UINT16 usAttack;           // as calculated for the auto resolve cells
+	UINT16 usDefence;
+	UINT16 usNextAttack;       // delay until the first attack
+	INT8   bLife;
+	INT8   bLifeMax;
+	INT8   bBleeding;
+	INT8   bStrength;
+	INT8   bExpLevel;          // EffectiveExpLevel()
+	INT16  sGridNo;            // for the instant kills of BulletImpact()
+	INT16  sDamage;
+	bool   fRobotController;   // controls the robot while conscious
+	bool   fHasGun;
+	bool   fSpareLoadedGun;    // a loaded gun other than the first one
+	UINT8  ubGunImpact;
+	UINT8  ubAmmoType;         // as BulletImpact() finds it
+	UINT8  ubGunShotsLeft;
+	UINT8  ubClips;            // magazines to reload the gun with
+	UINT8  ubClipShots[AR_MAX_CLIPS];
+	bool   fHasBlade;          // knife, or claws of a female creature
+	UINT8  ubBladeImpact;
+	UINT8  ubMartialArtsBonus; // percent
+	UINT8  ubHandToHandBonus;  // percent
+	UINT8  ubDamageDivisor;    // creatures shrug off bullet damage
+	AutoResolveArmour Armour[NUM_AR_ARMOUR];
+};
+
+struct AutoResolveBattle
+{
+	// Mercs first, then militia, then enemies, as the screen orders the cells
+	std::vector<AutoResolveCombatant> combatants;
+	bool  fUnlimitedAmmo        = false;
+	bool  fCapturePermitted     = false; // the rest of the game allows the mercs to be captured
+	bool  fRobotControlled      = false;
+	bool  fRobotControllerAway  = false; // a merc outside the battle controls the robot
+	float fHeadDamageMultiplier = 1.5f;
+	float fLegsDamageMultiplier = 0.5f;
+};
+
+struct AutoResolveOutcome
+{
+	UINT8  ubBattleStatus;     // BATTLE_ of Auto_Resolve_Rules.h
+	UINT8  ubPlayerCasualties;
+	UINT8  ubEnemyCasualties;
+	UINT32 uiElapsedMilliseconds;
+};
+
+struct AutoResolveOdds
+{
+	UINT32 uiRuns;
+	double dWinProbability;
+	double dCaptureProbability;
+	double dExpectedPlayerCasualties;
+	double dExpectedEnemyCasualties;
+};
+
+
+class AutoResolveSimulation
+{
+public:
+	AutoResolveSimulation(AutoResolveBattle const&, uint64_t seed);
+	// Holds the battle by reference and points into its own cells
+	AutoResolveSimulation(AutoResolveSimulation const&) = delete;
+	AutoResolveSimulation& operator=(AutoResolveSimulation const&) = delete;
+
+	// Runs the battle until it is decided
+	AutoResolveOutcome Run();
+
+	struct Cell
+	{
+		UINT32 uiFlags;
+		UINT16 usAttack, usDefence;
+		UINT16 usNextAttack;
+		UINT16 usNextHit[3];
+		UINT16 usHitDamage[3];
+		Cell*  pAttacker[3];
+		AutoResolveCombatant c;
+	};
+
+	// The battle as the rules see it
+	UINT32  Roll(UINT32 range) { return Random(range, m_random); }
+	INT32   GroupSize(UINT8 group) const { return (INT32)m_groups[group].size(); }
+	Cell&   GroupCell(UINT8 group, INT32 index) { return *m_groups[group][index]; }
+	Cell*   RobotCell() { return m_robot; }
+	BOOLEAN RobotControlled() const { return m_robotControlled; }
+	void    UpdateRobotController();
+	INT8    Life(Cell const& cell) const { return cell.c.bLife; }
+	INT8    LifeMax(Cell const& cell) const { return cell.c.bLifeMax; }
+	void    SetLife(Cell& cell, INT8 const life) { cell.c.bLife = life; }
+	UINT16& SideAttack(BOOLEAN const player) { return m_attack[player ? 1 : 0]; }
+	UINT16& SideDefence(BOOLEAN const player) { return m_defence[player ? 1 : 0]; }
+	UINT8&  AliveMercs() { return m_alive[0]; }
+	UINT8&  AliveCivs() { return m_alive[1]; }
+	UINT8&  AliveEnemies() { return m_alive[2]; }
+	BOOLEAN FireAShot(Cell& attacker);
+	BOOLEAN AttackerHasKnife(Cell& attacker) { return attacker.c.fHasBlade; }
+	void    AttacksWithClaws(Cell&) {}
+	BOOLEAN TargetHasLoadedGun(Cell const& target) const;
+	INT32   BulletImpact(Cell& attacker, Cell& target, UINT8 location, UINT8 accuracy);
+	INT32   HTHImpact(Cell& attacker, Cell& target, UINT8 accuracy, BOOLEAN blade);
+	UINT8   DamageDivisor(Cell const& cell) const { return cell.c.ubDamageDivisor; }
+	void    BlowDodged(Cell&, BOOLEAN, BOOLEAN) {}
+	void    BlowLands(Cell&, Cell&) {}
+	void    MeleeWound(Cell&, Cell&, INT32, INT32) {}
+	void    BulletMissed(Cell&) {}
+	void    BulletWound(Cell&, INT32, INT32) {}
+	void    Bleeds(Cell& target, INT32 damage);
+	void    Killed(Cell&) {}
+	void    DeathCry(Cell&) {}
+	void    SmellsPrey(Cell&) {}
+
+private:
+	INT32 ArmourProtection(Cell& target, UINT8 location, INT32 impact, UINT8 ammo_type);
+
+	AutoResolveBattle const& m_battle;
+	std::vector<Cell>        m_cells;
+	std::vector<Cell*>       m_groups[3];
+	Cell*                    m_robot;
+	bool                     m_robotControlled;
+	RandomEngine             m_random;
+	UINT16                   m_attack[2];  // enemies first
+	UINT16                   m_defence[2];
+	UINT8                    m_alive[3];
+};
+
+
+/* Runs the battle the given number of times on up to n_threads worker threads
+ * (0 for as many as there are workers) and aggregates the outcomes. Run i is
+ * seeded from seed and i, so the odds only depend on the seed. */
+AutoResolveOdds PredictAutoResolveBattle(AutoResolveBattle const&, UINT32 runs, UINT32 seed, UINT32 n_threads = 0);
+
+#endif
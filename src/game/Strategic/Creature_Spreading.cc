@@ -235,7 +235,7 @@ void InitCreatureQuest()
 	}
 
 	//Choose one of the infectible mines randomly
-	iRandom = Random( iNumMinesInfestible );
+	iRandom = Random( iNumMinesInfestible, RANDOM_STRATEGIC );
 	ubChosenMineId = ubMinesInfestible[iRandom];
 
 	//Now, choose a start location for the queen.
@@ -308,7 +308,7 @@ static BOOLEAN PlaceNewCreature(CREATURE_DIRECTIVE* node, INT32 iDistance)
 		//we have reached the distance limitation for the spreading.  We will determine if
 		//the area is populated enough to spread further.  The minimum population must be 4 before
 		//spreading is even considered.
-		if( node->pLevel->ubNumCreatures*10 - 10 <= (INT32)Random( 60 ) )
+		if( node->pLevel->ubNumCreatures*10 - 10 <= (INT32)Random( 60, RANDOM_STRATEGIC ) )
 		{
 			// x<=1 100%
 			// x==2  83%
@@ -384,7 +384,7 @@ static BOOLEAN PlaceNewCreature(CREATURE_DIRECTIVE* node, INT32 iDistance)
 			//the ratio of current population to the max population.
 			iChanceToPopulate = 100 - node->pLevel->ubNumCreatures * 100 / iMaxPopulation;
 
-			if( !node->pLevel->ubNumCreatures || (iChanceToPopulate > (INT32)Random( 100 )
+			if( !node->pLevel->ubNumCreatures || (iChanceToPopulate > (INT32)Random( 100, RANDOM_STRATEGIC )
 					&& iMaxPopulation > node->pLevel->ubNumCreatures) )
 			{
 				AddCreatureToNode( node );
@@ -413,13 +413,13 @@ void SpreadCreatures()
 	switch( gGameOptions.ubDifficultyLevel )
 	{
 		case DIF_LEVEL_EASY:
-			usNewCreatures = (UINT16)(EASY_QUEEN_REPRODUCTION_BASE + Random( 1 + EASY_QUEEN_REPRODUCTION_BONUS ));
+			usNewCreatures = (UINT16)(EASY_QUEEN_REPRODUCTION_BASE + Random( 1 + EASY_QUEEN_REPRODUCTION_BONUS, RANDOM_STRATEGIC ));
 			break;
 		case DIF_LEVEL_MEDIUM:
-			usNewCreatures = (UINT16)(NORMAL_QUEEN_REPRODUCTION_BASE + Random( 1 + NORMAL_QUEEN_REPRODUCTION_BONUS ));
+			usNewCreatures = (UINT16)(NORMAL_QUEEN_REPRODUCTION_BASE + Random( 1 + NORMAL_QUEEN_REPRODUCTION_BONUS, RANDOM_STRATEGIC ));
 			break;
 		case DIF_LEVEL_HARD:
-			usNewCreatures = (UINT16)(HARD_QUEEN_REPRODUCTION_BASE + Random( 1 + HARD_QUEEN_REPRODUCTION_BONUS ));
+			usNewCreatures = (UINT16)(HARD_QUEEN_REPRODUCTION_BASE + Random( 1 + HARD_QUEEN_REPRODUCTION_BONUS, RANDOM_STRATEGIC ));
 			break;
 	}
 
@@ -458,7 +458,11 @@ static void AddCreaturesToBattle(UINT8 n_young_males, UINT8 n_young_females, UIN
 	bodies.insert(bodies.end(), n_young_females, YAF_MONSTER);
 	bodies.insert(bodies.end(), n_adult_males, AM_MONSTER);
 	bodies.insert(bodies.end(), n_adult_females, ADULTFEMALEMONSTER);
-	std::shuffle(bodies.begin(), bodies.end(), gRandomEngine);
+	// Fisher-Yates on our own stream, std::shuffle may draw differently per library
+	for (size_t i = bodies.size(); i > 1; --i)
+	{
+		std::swap(bodies[i - 1], bodies[Random((UINT32)i, RANDOM_STRATEGIC)]);
+	}
 
 	UINT8 slot = 0;
 	for (SoldierBodyType const body : bodies)
@@ -531,7 +535,7 @@ void CreatureAttackTown(UINT8 ubSectorID, BOOLEAN fSpecificSector)
 
 	if( gfWorldLoaded && gTacticalStatus.fEnemyInSector )
 	{ //Battle currently in progress, repost the event
-		AddStrategicEvent( EVENT_CREATURE_ATTACK, GetWorldTotalMin() + Random( 10 ), ubSectorID );
+		AddStrategicEvent( EVENT_CREATURE_ATTACK, GetWorldTotalMin() + Random( 10, RANDOM_STRATEGIC ), ubSectorID );
 		return;
 	}
 
@@ -745,7 +749,7 @@ void DetermineCreatureTownComposition(UINT8 ubNumCreatures,
 	i = ubNumCreatures;
 	while( i-- )
 	{
-		iRandom = Random( 100 );
+		iRandom = Random( 100, RANDOM_STRATEGIC );
 		if( iRandom < ubYoungMalePercentage )
 			(*pubNumYoungMales)++;
 		else if( iRandom < ubYoungFemalePercentage )
@@ -917,7 +921,7 @@ BOOLEAN PrepareCreaturesForBattle()
 	i = ubNumCreatures;
 	while( i-- )
 	{
-		iRandom = Random( 100 );
+		iRandom = Random( 100, RANDOM_STRATEGIC );
 		if( iRandom < ubLarvaePercentage )
 			ubNumLarvae++;
 		else if( iRandom < ubInfantPercentage )
@@ -60,6 +60,9 @@ static MOUSE_REGION gClockScreenMaskMouseRegion;
 
 #define SECONDS_PER_COMPRESSION 1 // 1/2 minute passes every 1 second of real time
 
+// real milliseconds per frame spent skipping from event to event under super compression
+#define SUPER_COMPRESSION_FRAME_BUDGET 15
+
 #define CLOCK_X      (g_ui.get_CLOCK_X())
 #define CLOCK_Y      (g_ui.get_CLOCK_Y())
 #define CLOCK_HEIGHT  13
@@ -84,7 +87,7 @@ UINT32         guiDay;
 UINT32         guiHour;
 UINT32         guiMin;
 ST::string     gswzWorldTimeStr;
-INT32          giTimeCompressSpeeds[ NUM_TIME_COMPRESS_SPEEDS ] = { 0, 1, 5 * 60, 30 * 60, 60 * 60 };
+INT32          giTimeCompressSpeeds[ NUM_TIME_COMPRESS_SPEEDS ] = { 0, 1, 5 * 60, 30 * 60, 60 * 60, 6 * 60 * 60 };
 static UINT16  usPausedActualWidth;
 static UINT16  usPausedActualHeight;
 UINT32         guiTimeOfLastEventQuery = 0;
@@ -371,8 +374,8 @@ BOOLEAN IsTimeCompressionOn( void )
 
 void IncreaseGameTimeCompressionRate( )
 {
-	// if not already at maximum time compression rate
-	if( giTimeCompressMode < TIME_COMPRESS_60MINS )
+	// if not already at maximum time compression rate (super compression is only available in mapscreen)
+	if( giTimeCompressMode < ( guiCurrentScreen == MAP_SCREEN ? TIME_SUPER_COMPRESS : TIME_COMPRESS_60MINS ) )
 	{
 		// check that we can
 		if ( !AllowedToTimeCompress( ) )
@@ -472,6 +475,11 @@ static void SetClockResolutionToCompressMode(INT32 iCompressMode)
 	{
 		SetClockResolutionPerSecond( 0 );
 	}
+	else if ( iCompressMode == TIME_SUPER_COMPRESS )
+	{
+		// super compression isn't paced by the resolution, it skips from event to event every frame
+		SetClockResolutionPerSecond( 1 );
+	}
 	else
 	{
 		SetClockResolutionPerSecond( (UINT8) MAX( 1, (UINT8)(guiGameSecondsPerRealSecond / 60) ) );
@@ -604,6 +612,31 @@ static void SetClockResolutionPerSecond(UINT8 ubNumTimesPerSecond)
 static void CreateDestroyScreenMaskForPauseGame(void);
 
 
+/* Under super compression the clock doesn't need to move in small steps: group
+ * arrivals, the hourly and quarter hourly updates and everything else that can
+ * happen while time is compressed are in the event list.  So jump straight to
+ * the next event, or the next full hour if that comes first, as often as fits
+ * into the frame, and stop as soon as something interrupts the compression. */
+static void SkipGameTimeToNextEvents(void)
+{
+	UINT32 const uiStart = GetJA2Clock();
+	gfTimeInterrupt = FALSE;
+	do
+	{
+		UINT32 uiTarget = ( guiGameClock / NUM_SEC_IN_HOUR + 1 ) * NUM_SEC_IN_HOUR;
+		if( gpEventList && gpEventList->uiTimeStamp < uiTarget )
+		{
+			uiTarget = MAX( gpEventList->uiTimeStamp, guiGameClock + 1 );
+		}
+		WarpGameTime( uiTarget - guiGameClock, WARPTIME_PROCESS_EVENTS_NORMALLY );
+	}
+	while( gfTimeCompressionOn && giTimeCompressMode == TIME_SUPER_COMPRESS &&
+		!gfGamePaused && !gfTimeInterrupt && !gfTimeInterruptPause &&
+		!( gTacticalStatus.uiFlags & INCOMBAT ) &&
+		GetJA2Clock() - uiStart < SUPER_COMPRESSION_FRAME_BUDGET );
+}
+
+
 //There are two factors that influence the flow of time in the game.
 //-Speed:  The speed is the amount of game time passes per real second of time.  The higher this
 //         value, the faster the game time flows.
@@ -648,6 +681,14 @@ void UpdateClock()
 	if(gTacticalStatus.uiFlags & INCOMBAT)
 		return; //time is currently stopped!
 
+	if( giTimeCompressMode == TIME_SUPER_COMPRESS && gfTimeCompressionOn )
+	{
+		SkipGameTimeToNextEvents( );
+		uiLastSecondTime = GetJA2Clock( );
+		guiTimesThisSecondProcessed = uiLastTimeProcessed = 0;
+		return;
+	}
+
 
 	uiNewTime = GetJA2Clock();
 
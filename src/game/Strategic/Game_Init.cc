@@ -247,7 +247,7 @@ void InitNewGame()
 		// random day between min and max days, inclusive
 		UINT8 ubMin = gamepolicy(merc_online_min_days);
 		UINT8 ubMax = gamepolicy(merc_online_max_days);
-		UINT32 const days_time_merc_site_available = Random(ubMax - ubMin + 1) + ubMin;
+		UINT32 const days_time_merc_site_available = Random(ubMax - ubMin + 1, RANDOM_STRATEGIC) + ubMin;
 		if (days_time_merc_site_available == 0)
 		{
 			// M.E.R.C. is already online
@@ -231,7 +231,7 @@ static void HourlyLarryUpdate(void)
 		{
 			if ( pSoldier->ubProfile == LARRY_NORMAL )
 			{
-				gMercProfiles[ LARRY_NORMAL ].bNPCData += (INT8) Random( usTemptation );
+				gMercProfiles[ LARRY_NORMAL ].bNPCData += (INT8) Random( usTemptation, RANDOM_STRATEGIC );
 				if ( gMercProfiles[ LARRY_NORMAL ].bNPCData >= LARRY_FALLS_OFF_WAGON )
 				{
 					if ( fBar )
@@ -262,7 +262,7 @@ static void HourlyLarryUpdate(void)
 				// NB store all drunkenness info in LARRY_NORMAL profile (to use same values)
 				// so long as he keeps consuming, keep number above level at which he cracked
 				gMercProfiles[ LARRY_NORMAL ].bNPCData = __max( gMercProfiles[ LARRY_NORMAL ].bNPCData, LARRY_FALLS_OFF_WAGON );
-				gMercProfiles[ LARRY_NORMAL ].bNPCData += (INT8) Random( usTemptation );
+				gMercProfiles[ LARRY_NORMAL ].bNPCData += (INT8) Random( usTemptation, RANDOM_STRATEGIC );
 				// allow value to keep going up to 24 (about 2 days since we subtract Random( 2 ) when he has no access )
 				gMercProfiles[ LARRY_NORMAL ].bNPCData = __min( gMercProfiles[ LARRY_NORMAL ].bNPCData, 24 );
 				if ( fBar )
@@ -289,7 +289,7 @@ static void HourlyLarryUpdate(void)
 		}
 		else if ( pSoldier->ubProfile == LARRY_DRUNK )
 		{
-			gMercProfiles[ LARRY_NORMAL ].bNPCData -= (INT8) Random( 2 );
+			gMercProfiles[ LARRY_NORMAL ].bNPCData -= (INT8) Random( 2, RANDOM_STRATEGIC );
 			if ( gMercProfiles[ LARRY_NORMAL ].bNPCData <= 0 )
 			{
 				// goes sober!
@@ -316,7 +316,7 @@ static void HourlyCheckIfSlayAloneSoHeCanLeave(void)
 	if (pSoldier->bLife == 0) return;
 	if( PlayerMercsInSector( (UINT8)pSoldier->sSectorX, (UINT8)pSoldier->sSectorY, pSoldier->bSectorZ ) == 1 )
 	{
-		if( Chance( 15 ) )
+		if( Chance( 15, RANDOM_STRATEGIC ) )
 		{
 			pSoldier->ubLeaveHistoryCode = HISTORY_SLAY_MYSTERIOUSLY_LEFT;
 			MakeCharacterDialogueEventContractEndingNoAskEquip(*pSoldier);
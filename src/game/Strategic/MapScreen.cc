@@ -59,6 +59,7 @@
 #include "Soldier_Macros.h"
 #include "Squads.h"
 #include "StrategicMap_Secrets.h"
+#include "Strategic_AI.h"
 #include "Strategic_Movement_Costs.h"
 #include "Strategic_Pathing.h"
 #include "Strategic_Town_Loyalty.h"
@@ -103,6 +104,7 @@ struct PopUpBox;
 #define DELAY_PER_FLASH_FOR_DEPARTING_PERSONNEL 500
 #define GLOW_DELAY 70
 #define ASSIGNMENT_DONE_FLASH_TIME 500
+#define MAP_REDRAW_INTERVAL_WHILE_COMPRESSING 100 // while time is compressed, redraw the map at most this often
 
 #define MINS_TO_FLASH_CONTRACT_TIME (4 * 60)
 
@@ -1423,7 +1425,7 @@ try
 
 
 		// if the current time compression mode is something legal in mapscreen, keep it
-		if ( ( giTimeCompressMode >= TIME_COMPRESS_5MINS ) && ( giTimeCompressMode <= TIME_COMPRESS_60MINS ) )
+		if ( ( giTimeCompressMode >= TIME_COMPRESS_5MINS ) && ( giTimeCompressMode <= TIME_SUPER_COMPRESS ) )
 		{
 			// leave the current time compression mode set, but DO stop it
 			StopTimeCompression();
@@ -2975,6 +2977,14 @@ static void HandleModCtrl(UINT const key)
 		}
 		break;
 
+		case 'e':
+			if (CHEATER_CHEAT_LEVEL())
+			{ // Toggle the strategic AI influence overlay
+				gfShowStrategicInfluence ^= 1;
+				fMapPanelDirty = TRUE;
+			}
+			break;
+
 		case 'l':
 			// go to LOAD screen
 			gfSaveGame = FALSE;
@@ -5146,6 +5156,20 @@ void RenderMapRegionBackground( void )
 		return;
 	}
 
+	// while time is compressed the map is dirtied almost every frame, so only
+	// redraw it at a fixed rate and leave it dirty until then
+	static UINT32 uiLastCompressedRedraw = 0;
+	if (IsTimeBeingCompressed())
+	{
+		UINT32 const now = GetJA2Clock();
+		if (now - uiLastCompressedRedraw < MAP_REDRAW_INTERVAL_WHILE_COMPRESSING)
+		{
+			gfMapPanelWasRedrawn = FALSE;
+			return;
+		}
+		uiLastCompressedRedraw = now;
+	}
+
 	// don't bother if showing sector inventory instead of the map!!!
 	if( !fShowMapInventoryPool )
 	{
@@ -6306,20 +6330,19 @@ static bool AnyMercsLeavingRealSoon()
 
 void HandlePreloadOfMapGraphics(void)
 {
-	guiSleepIcon                = AddVideoObjectFromFile(INTERFACEDIR "/sleepicon.sti");
-	guiCHARINFO                 = AddVideoObjectFromFile(INTERFACEDIR "/charinfo.sti");
-	guiCHARLIST                 = AddVideoObjectFromFile(INTERFACEDIR "/newgoldpiece3.sti");
-
-	guiMAPINV                   = AddVideoObjectFromFile(INTERFACEDIR "/mapinv.sti");
-
-	// the upper left corner piece icons
-	guiULICONS                  = AddVideoObjectFromFile(INTERFACEDIR "/top_left_corner_icons.sti");
+	AddVideoObjectsFromFiles({
+		{ &guiSleepIcon,    INTERFACEDIR "/sleepicon.sti" },
+		{ &guiCHARINFO,     INTERFACEDIR "/charinfo.sti" },
+		{ &guiCHARLIST,     INTERFACEDIR "/newgoldpiece3.sti" },
+		{ &guiMAPINV,       INTERFACEDIR "/mapinv.sti" },
+		// the upper left corner piece icons
+		{ &guiULICONS,      INTERFACEDIR "/top_left_corner_icons.sti" },
+		//Kris:  Added this because I need to blink the icons button.
+		{ &guiNewMailIcons, INTERFACEDIR "/newemail.sti" },
+	});
 
 	HandleLoadOfMapBottomGraphics( );
 
-	//Kris:  Added this because I need to blink the icons button.
-	guiNewMailIcons             = AddVideoObjectFromFile(INTERFACEDIR "/newemail.sti");
-
 	// graphic for pool inventory
 	LoadInventoryPoolGraphic( );
 
@@ -7656,7 +7679,7 @@ static void RandomAwakeSelectedMercConfirmsStrategicMove(void)
 
 	if ( ubNumMercs > 0 )
 	{
-		ubChosenMerc = (UINT8)Random( ubNumMercs );
+		ubChosenMerc = (UINT8)Random( ubNumMercs, RANDOM_STRATEGIC );
 
 		// select that merc so that when he speaks we're showing his portrait and not someone else
 		ChangeSelectedInfoChar( ubSelectedMercIndex[ ubChosenMerc ], FALSE );
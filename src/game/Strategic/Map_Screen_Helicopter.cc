@@ -232,7 +232,7 @@ BOOLEAN HandleHeliEnteringSector( INT16 sX, INT16 sY )
 					// stop time compression and inform player that there are enemies in the sector below
 					StopTimeCompression();
 
-					if( Random( 2 ) )
+					if( Random( 2, RANDOM_STRATEGIC ) )
 					{
 						HeliCharacterDialogue(ENEMIES_SPOTTED_EN_ROUTE_IN_FRIENDLY_SECTOR_A);
 					}
@@ -1422,7 +1422,7 @@ void RandomMercInGroupSaysQuote(GROUP const& g, UINT16 const quote_num)
 
 	if (n_mercs > 0)
 	{
-		SOLDIERTYPE& chosen = *mercs_in_group[Random(n_mercs)];
+		SOLDIERTYPE& chosen = *mercs_in_group[Random(n_mercs, RANDOM_STRATEGIC)];
 		TacticalCharacterDialogue(&chosen, quote_num);
 	}
 }
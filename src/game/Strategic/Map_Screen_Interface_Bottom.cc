@@ -797,7 +797,7 @@ static void EnableDisableTimeCompressButtons(void)
 
 		// disable MORE if we're not paused and time compression is at maximum
 		// only disable MORE if we're not paused and time compression is at maximum
-		EnableButton(guiMapBottomTimeButtons[MAP_TIME_COMPRESS_MORE], !IsTimeCompressionOn() || giTimeCompressMode != TIME_COMPRESS_60MINS);
+		EnableButton(guiMapBottomTimeButtons[MAP_TIME_COMPRESS_MORE], !IsTimeCompressionOn() || giTimeCompressMode != TIME_SUPER_COMPRESS);
 	}
 }
 
@@ -35,6 +35,7 @@
 #include "Squads.h"
 #include "StrategicMap_Secrets.h"
 #include "StrategicMapSecretModel.h"
+#include "Strategic_AI.h"
 #include "Strategic_Mines.h"
 #include "Strategic_Movement.h"
 #include "Strategic_Pathing.h"
@@ -51,6 +52,7 @@
 #include "VObject.h"
 #include "VObject_Blitters.h"
 #include "VSurface.h"
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
 #include <string_theory/format>
@@ -490,6 +492,7 @@ static void HandleLowerLevelMapBlit(void);
 static void ShadeMapElem(INT16 sMapX, INT16 sMapY, INT32 iColor);
 static void ShowItemsOnMap(void);
 static void ShowSAMSitesOnStrategicMap();
+static void ShowStrategicInfluenceOnMap();
 static void ShowTeamAndVehicles();
 static void ShowTownText(void);
 
@@ -609,6 +612,8 @@ void DrawMap(void)
 
 	if (fShowItemsFlag) ShowItemsOnMap();
 
+	if (gfShowStrategicInfluence && !iCurrentMapSectorZ) ShowStrategicInfluenceOnMap();
+
 	DisplayLevelString();
 }
 
@@ -2817,31 +2822,49 @@ static void DropAPersonInASector(UINT8 const type, UINT8 const sector)
 void LoadMapScreenInterfaceMapGraphics()
 {
 	guiBIGMAP                      = AddVideoSurfaceFromFile(INTERFACEDIR "/b_map.pcx");
-	guiBULLSEYE                    = AddVideoObjectFromFile(INTERFACEDIR "/bullseye.sti");
-	guiSAMICON                     = AddVideoObjectFromFile(INTERFACEDIR "/sam.sti");
-	guiCHARBETWEENSECTORICONS      = AddVideoObjectFromFile(INTERFACEDIR "/merc_between_sector_icons.sti");
-	guiCHARBETWEENSECTORICONSCLOSE = AddVideoObjectFromFile(INTERFACEDIR "/merc_mvt_green_arrows.sti");
-	guiCHARICONS                   = AddVideoObjectFromFile(INTERFACEDIR "/boxes.sti");
-	guiHelicopterIcon              = AddVideoObjectFromFile(INTERFACEDIR "/helicop.sti");
-	guiMAPCURSORS                  = AddVideoObjectFromFile(INTERFACEDIR "/mapcursr.sti");
-	guiMINEICON                    = AddVideoObjectFromFile(INTERFACEDIR "/mine.sti");
-	guiMapBorderHeliSectors        = AddVideoObjectFromFile(INTERFACEDIR "/pos2.sti");
-	guiMilitia                     = AddVideoObjectFromFile(INTERFACEDIR "/militia.sti");
-	guiMilitiaMaps                 = AddVideoObjectFromFile(INTERFACEDIR "/militiamaps.sti");
-	guiMilitiaSectorHighLight      = AddVideoObjectFromFile(INTERFACEDIR "/militiamapsectoroutline2.sti");
-	guiMilitiaSectorOutline        = AddVideoObjectFromFile(INTERFACEDIR "/militiamapsectoroutline.sti");
-	guiSubLevel1                   = AddVideoObjectFromFile(INTERFACEDIR "/mine_1.sti");
-	guiSubLevel2                   = AddVideoObjectFromFile(INTERFACEDIR "/mine_2.sti");
-	guiSubLevel3                   = AddVideoObjectFromFile(INTERFACEDIR "/mine_3.sti");
 
+	std::vector<VideoObjectFile> files = {
+		{ &guiBULLSEYE,                    INTERFACEDIR "/bullseye.sti" },
+		{ &guiSAMICON,                     INTERFACEDIR "/sam.sti" },
+		{ &guiCHARBETWEENSECTORICONS,      INTERFACEDIR "/merc_between_sector_icons.sti" },
+		{ &guiCHARBETWEENSECTORICONSCLOSE, INTERFACEDIR "/merc_mvt_green_arrows.sti" },
+		{ &guiCHARICONS,                   INTERFACEDIR "/boxes.sti" },
+		{ &guiHelicopterIcon,              INTERFACEDIR "/helicop.sti" },
+		{ &guiMAPCURSORS,                  INTERFACEDIR "/mapcursr.sti" },
+		{ &guiMINEICON,                    INTERFACEDIR "/mine.sti" },
+		{ &guiMapBorderHeliSectors,        INTERFACEDIR "/pos2.sti" },
+		{ &guiMilitia,                     INTERFACEDIR "/militia.sti" },
+		{ &guiMilitiaMaps,                 INTERFACEDIR "/militiamaps.sti" },
+		{ &guiMilitiaSectorHighLight,      INTERFACEDIR "/militiamapsectoroutline2.sti" },
+		{ &guiMilitiaSectorOutline,        INTERFACEDIR "/militiamapsectoroutline.sti" },
+		{ &guiSubLevel1,                   INTERFACEDIR "/mine_1.sti" },
+		{ &guiSubLevel2,                   INTERFACEDIR "/mine_2.sti" },
+		{ &guiSubLevel3,                   INTERFACEDIR "/mine_3.sti" },
+	};
+
+	// The icons are only entered into gSecretSiteIcons once all files loaded
+	std::vector<ST::string> secret_paths;
 	for (auto s : GCM->getMapSecrets())
 	{
 		const ST::string& path = s->secretMapIcon;
-		if (!path.empty() && gSecretSiteIcons.find(path) == gSecretSiteIcons.end())
+		if (!path.empty() && gSecretSiteIcons.find(path) == gSecretSiteIcons.end() &&
+			std::find(secret_paths.begin(), secret_paths.end(), path) == secret_paths.end())
 		{
-			gSecretSiteIcons[path] = AddVideoObjectFromFile(path.c_str());
+			secret_paths.push_back(path);
 		}
 	}
+	std::vector<SGPVObject*> secret_icons(secret_paths.size());
+	for (size_t i = 0; i != secret_paths.size(); ++i)
+	{
+		files.push_back({ &secret_icons[i], secret_paths[i] });
+	}
+
+	AddVideoObjectsFromFiles(files);
+
+	for (size_t i = 0; i != secret_paths.size(); ++i)
+	{
+		gSecretSiteIcons[secret_paths[i]] = secret_icons[i];
+	}
 }
 
 
@@ -3923,6 +3946,45 @@ static void ShowItemsOnMap(void)
 }
 
 
+/* Debug view of what the strategic AI weighs in each sector: the player's
+ * defence points (militia by level, mercs count 5) above the number of
+ * enemies. */
+static void ShowStrategicInfluenceOnMap()
+{
+	ClipBlitsToMapViewRegion();
+	SetFontDestBuffer(guiSAVEBUFFER, MapScreenRect.iLeft + 2, MapScreenRect.iTop, MapScreenRect.iRight, MapScreenRect.iBottom);
+	SetFont(MAP_FONT);
+	SetFontBackground(FONT_MCOLOR_BLACK);
+
+	for (INT16 x = 1; x < MAP_WORLD_X - 1; ++x)
+	{
+		for (INT16 y = 1; y < MAP_WORLD_Y - 1; ++y)
+		{
+			SECTOR_INFLUENCE const influence = GetSectorInfluence(SECTOR(x, y));
+			UINT16 const player_points = influence.usMilitiaPoints + influence.ubPlayerMercs * 5;
+			if (player_points == 0 && influence.ubEnemies == 0) continue;
+
+			INT16       usXPos;
+			INT16       usYPos;
+			INT16 const sXCorner = MAP_VIEW_START_X + x * MAP_GRID_X;
+			INT16 const sYCorner = MAP_VIEW_START_Y + y * MAP_GRID_Y;
+
+			ST::string player = ST::format("{}", player_points);
+			FindFontCenterCoordinates(sXCorner, sYCorner, MAP_GRID_X, MAP_GRID_Y / 2, player, MAP_FONT, &usXPos, &usYPos);
+			SetFontForeground(FONT_MCOLOR_LTGREEN);
+			GDirtyPrint(usXPos, usYPos, player);
+
+			ST::string enemies = ST::format("{}", influence.ubEnemies);
+			FindFontCenterCoordinates(sXCorner, sYCorner + MAP_GRID_Y / 2, MAP_GRID_X, MAP_GRID_Y / 2, enemies, MAP_FONT, &usXPos, &usYPos);
+			SetFontForeground(FONT_MCOLOR_LTRED);
+			GDirtyPrint(usXPos, usYPos, enemies);
+		}
+	}
+
+	RestoreClipRegionToFullScreen();
+}
+
+
 static void DrawMapBoxIcon(HVOBJECT const vo, UINT16 const icon, INT16 const sec_x, INT16 const sec_y, UINT8 const icon_pos)
 {
 	/* Don't show any more icons than will fit into one sector, to keep them from
@@ -736,12 +736,12 @@ void HandleFlowersMeanwhileScene( INT8 bTimeCode )
 	if ( bTimeCode == 0 )
 	{
 		// 20-24 hours later
-		uiTime = GetWorldTotalMin() + 60 * ( 20 + Random( 5 ) );
+		uiTime = GetWorldTotalMin() + 60 * ( 20 + Random( 5, RANDOM_STRATEGIC ) );
 	}
 	else
 	{
 		// 2-4 days later
-		uiTime = GetWorldTotalMin() + 60 * ( 24 + Random( 48 ) );
+		uiTime = GetWorldTotalMin() + 60 * ( 24 + Random( 48, RANDOM_STRATEGIC ) );
 	}
 
 	ScheduleMeanwhileEvent(3, 16, 0, FLOWERS, QUEEN, uiTime);
@@ -763,7 +763,7 @@ void HandleKillChopperMeanwhileScene( void )
 		return;
 	}
 
-	UINT32 const uiTime = GetWorldTotalMin() + 55 + Random(10);
+	UINT32 const uiTime = GetWorldTotalMin() + 55 + Random(10, RANDOM_STRATEGIC);
 	ScheduleMeanwhileEvent(3, 16, 0, KILL_CHOPPER, QUEEN, uiTime);
 }
 
@@ -467,7 +467,7 @@ static void HandleSoldierLeavingWithLowMorale(SOLDIERTYPE* pSoldier)
 	{
 		// this will cause him give us lame excuses for a while until he gets over it
 		// 3-6 days (but the first 1-2 days of that are spent "returning" home)
-		gMercProfiles[ pSoldier->ubProfile ].ubDaysOfMoraleHangover = (UINT8) (3 + Random(4));
+		gMercProfiles[ pSoldier->ubProfile ].ubDaysOfMoraleHangover = (UINT8) (3 + Random(4, RANDOM_STRATEGIC));
 	}
 }
 
@@ -478,7 +478,7 @@ static void HandleSoldierLeavingForAnotherContract(SOLDIERTYPE& s)
 	// Merc goes to work elsewhere
 	MERCPROFILESTRUCT& p = GetProfile(s.ubProfile);
 	p.bMercStatus            = MERC_WORKING_ELSEWHERE;
-	p.uiDayBecomesAvailable += 1 + Random(6 + s.bExpLevel / 2); // 1-(6 to 11) days
+	p.uiDayBecomesAvailable += 1 + Random(6 + s.bExpLevel / 2, RANDOM_STRATEGIC); // 1-(6 to 11) days
 }
 
 
@@ -547,7 +547,7 @@ void CheckIfMercGetsAnotherContract(SOLDIERTYPE& s)
 	if (full_days_remaining >= 3) return;
 
 	UINT32 const chance = (3 - full_days_remaining) * s.bExpLevel;
-	if (Chance(chance)) s.fSignedAnotherContract = TRUE;
+	if (Chance(chance, RANDOM_STRATEGIC)) s.fSignedAnotherContract = TRUE;
 }
 
 
@@ -674,7 +674,7 @@ void StrategicRemoveMerc(SOLDIERTYPE& s)
 		p.bMercStatus = MERC_RETURNING_HOME;
 
 		// specify how long the merc will continue to be unavailable
-		p.uiDayBecomesAvailable = 1 + Random(2); // 1-2 days
+		p.uiDayBecomesAvailable = 1 + Random(2, RANDOM_STRATEGIC); // 1-2 days
 
 		HandleSoldierLeavingWithLowMorale(&s);
 		HandleSoldierLeavingForAnotherContract(s);
@@ -913,7 +913,7 @@ void FindOutIfAnyMercAboutToLeaveIsGonnaRenew(void)
 
 	if (n_mercs != 0)
 	{
-		SOLDIERTYPE* const chosen = potential_mercs[Random(n_mercs)];
+		SOLDIERTYPE* const chosen = potential_mercs[Random(n_mercs, RANDOM_STRATEGIC)];
 		HandleImportantMercQuoteLocked(chosen, QUOTE_CONTRACTS_OVER);
 		AddReasonToWaitingListQueue(CONTRACT_EXPIRE_WARNING_REASON);
 		AddDisplayBoxToWaitingQueue();
@@ -378,7 +378,7 @@ void InitPreBattleInterface(GROUP* const battle_group, bool const persistent_pbi
 					//Don't consider ambushes until the player has reached 25% (normal) progress
 					if (gfHighPotentialForAmbush)
 					{
-						if (Chance(90)) gubEnemyEncounterCode = ENEMY_AMBUSH_CODE;
+						if (Chance(90, RANDOM_STRATEGIC)) gubEnemyEncounterCode = ENEMY_AMBUSH_CODE;
 					}
 					else
 					{
@@ -80,11 +80,9 @@ UINT8 NumHostilesInSector( INT16 sSectorX, INT16 sSectorY, INT16 sSectorZ )
 		ubNumHostiles = (UINT8)(pSector->ubNumAdmins + pSector->ubNumTroops + pSector->ubNumElites + pSector->ubNumCreatures);
 
 		//Count mobile enemies
-		CFOR_EACH_ENEMY_GROUP(pGroup)
+		CFOR_EACH_ENEMY_GROUP_IN_SECTOR(pGroup, sSectorX, sSectorY)
 		{
-			if (!pGroup->fVehicle             &&
-					pGroup->ubSectorX == sSectorX &&
-					pGroup->ubSectorY == sSectorY)
+			if (!pGroup->fVehicle)
 			{
 				ubNumHostiles += pGroup->ubGroupSize;
 			}
@@ -120,11 +118,9 @@ UINT8 NumEnemiesInAnySector( INT16 sSectorX, INT16 sSectorY, INT16 sSectorZ )
 		ubNumEnemies = (UINT8)(pSector->ubNumAdmins + pSector->ubNumTroops + pSector->ubNumElites);
 
 		//Count mobile enemies
-		CFOR_EACH_ENEMY_GROUP(pGroup)
+		CFOR_EACH_ENEMY_GROUP_IN_SECTOR(pGroup, sSectorX, sSectorY)
 		{
-			if (!pGroup->fVehicle             &&
-					pGroup->ubSectorX == sSectorX &&
-					pGroup->ubSectorY == sSectorY)
+			if (!pGroup->fVehicle)
 			{
 				ubNumEnemies += pGroup->ubGroupSize;
 			}
@@ -143,11 +139,9 @@ UINT8 NumEnemiesInSector( INT16 sSectorX, INT16 sSectorY )
 	pSector = &SectorInfo[ SECTOR( sSectorX, sSectorY ) ];
 	ubNumTroops = (UINT8)(pSector->ubNumAdmins + pSector->ubNumTroops + pSector->ubNumElites);
 
-	CFOR_EACH_ENEMY_GROUP(pGroup)
+	CFOR_EACH_ENEMY_GROUP_IN_SECTOR(pGroup, sSectorX, sSectorY)
 	{
-		if (!pGroup->fVehicle             &&
-				pGroup->ubSectorX == sSectorX &&
-				pGroup->ubSectorY == sSectorY)
+		if (!pGroup->fVehicle)
 		{
 			ubNumTroops += pGroup->ubGroupSize;
 		}
@@ -185,11 +179,9 @@ UINT8 NumMobileEnemiesInSector( INT16 sSectorX, INT16 sSectorY )
 	Assert( sSectorY >= 1 && sSectorY <= 16 );
 
 	ubNumTroops = 0;
-	CFOR_EACH_ENEMY_GROUP(pGroup)
+	CFOR_EACH_ENEMY_GROUP_IN_SECTOR(pGroup, sSectorX, sSectorY)
 	{
-		if (!pGroup->fVehicle             &&
-				pGroup->ubSectorX == sSectorX &&
-				pGroup->ubSectorY == sSectorY)
+		if (!pGroup->fVehicle)
 		{
 			ubNumTroops += pGroup->ubGroupSize;
 		}
@@ -213,11 +205,9 @@ static void GetNumberOfMobileEnemiesInSector(INT16 sSectorX, INT16 sSectorY, UIN
 
 	//Now count the number of mobile groups in the sector.
 	*pubNumTroops = *pubNumElites = *pubNumAdmins = 0;
-	CFOR_EACH_ENEMY_GROUP(pGroup)
+	CFOR_EACH_ENEMY_GROUP_IN_SECTOR(pGroup, sSectorX, sSectorY)
 	{
-		if (!pGroup->fVehicle             &&
-				pGroup->ubSectorX == sSectorX &&
-				pGroup->ubSectorY == sSectorY)
+		if (!pGroup->fVehicle)
 		{
 			*pubNumTroops += pGroup->pEnemyGroup->ubNumTroops;
 			*pubNumElites += pGroup->pEnemyGroup->ubNumElites;
@@ -306,12 +296,10 @@ void EndTacticalBattleForEnemy()
 	gfProfiledEnemyAdded = FALSE;
 
 	// Clear enemies in battle for all mobile groups in the sector
-	CFOR_EACH_ENEMY_GROUP(i)
+	CFOR_EACH_ENEMY_GROUP_IN_SECTOR(i, x, y)
 	{
 		GROUP const& g = *i;
-		if (g.fVehicle)       continue;
-		if (g.ubSectorX != x) continue;
-		if (g.ubSectorY != y) continue;
+		if (g.fVehicle) continue;
 		// XXX test for z missing?
 		ENEMYGROUP& eg = *g.pEnemyGroup;
 		eg.ubTroopsInBattle = 0;
@@ -525,13 +513,11 @@ void PrepareEnemyForSectorBattle()
 	 * their respective groups if in a mobile group, but only for the ones that
 	 * were assigned from the */
 	n_slots = 32 - n_stationary_enemies;
-	CFOR_EACH_ENEMY_GROUP(g)
+	CFOR_EACH_ENEMY_GROUP_IN_SECTOR(g, x, y)
 	{
 		if (n_slots == 0) break;
 
 		if (g->fVehicle) continue;
-		if (g->ubSectorX   != x) continue;
-		if (g->ubSectorY   != y) continue;
 		if (gbWorldSectorZ != 0) continue;
 
 		INT32 n        = g->ubGroupSize;
@@ -968,15 +954,13 @@ void AddPossiblePendingEnemiesToBattle()
 	}
 
 	UINT8 n_slots = NumFreeEnemySlots();
-	CFOR_EACH_ENEMY_GROUP(i)
+	CFOR_EACH_ENEMY_GROUP_IN_SECTOR(i, gWorldSectorX, gWorldSectorY)
 	{
 		if (n_slots == 0) break;
 
 		GROUP const& g = *i;
-		if (g.fVehicle)                   continue;
-		if (g.ubSectorX != gWorldSectorX) continue;
-		if (g.ubSectorY != gWorldSectorY) continue;
-		if (gbWorldSectorZ != 0)          continue;
+		if (g.fVehicle)          continue;
+		if (gbWorldSectorZ != 0) continue;
 		// This enemy group is currently in the sector.
 		ENEMYGROUP& eg          = *g.pEnemyGroup;
 		UINT8       n_elites    = 0;
@@ -1067,7 +1051,7 @@ static void AddEnemiesToBattle(GROUP const& g, UINT8 const strategic_insertion_c
 	ChooseMapEdgepoints(&edgepoint_info, strategic_insertion_code, n_total);
 	while (n_total != 0)
 	{
-		UINT32       const roll = Random(n_total--);
+		UINT32       const roll = Random(n_total--, RANDOM_STRATEGIC);
 		SoldierClass const sc   =
 			roll < n_elites            ? --n_elites, SOLDIER_CLASS_ELITE :
 			roll < n_elites + n_troops ? --n_troops, SOLDIER_CLASS_ARMY  :
@@ -1317,7 +1301,7 @@ void EnemyCapturesPlayerSoldier( SOLDIERTYPE *pSoldier )
 	}
 	else if ( pSoldier->bLife >= 45 )
 	{
-		pSoldier->bLife += (INT8)(10 - Random( 21 ) );
+		pSoldier->bLife += (INT8)(10 - Random( 21, RANDOM_STRATEGIC ) );
 	}
 
 	// make him quite exhausted when found
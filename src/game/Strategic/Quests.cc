@@ -48,7 +48,7 @@ void SetFactTrue(Fact const usFact)
 	if (usFact == FACT_ESTONI_REFUELLING_POSSIBLE && !CheckFact(usFact, 0))
 	{
 		// give him some gas...
-		GuaranteeAtLeastXItemsOfIndex( ARMS_DEALER_JAKE, GAS_CAN, ( UINT8 ) ( 4 + Random( 3 ) ) );
+		GuaranteeAtLeastXItemsOfIndex( ARMS_DEALER_JAKE, GAS_CAN, ( UINT8 ) ( 4 + Random( 3, RANDOM_STRATEGIC ) ) );
 	}
 
 	gubFact[usFact] = TRUE;
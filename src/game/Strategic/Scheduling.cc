@@ -733,7 +733,7 @@ static void PostSchedule(SOLDIERTYPE* pSoldier)
 
 			if( pSchedule->usTime[ i ] == 0xffff )
 			{
-				pSchedule->usTime[ i ] = (UINT16)( (21*60) + Random( (3*60) )); //9PM - 11:59PM
+				pSchedule->usTime[ i ] = (UINT16)( (21*60) + Random( (3*60), RANDOM_STRATEGIC )); //9PM - 11:59PM
 
 				if ( ScheduleHasMorningNonSleepEntries( pSchedule ) )
 				{
@@ -906,11 +906,11 @@ static void PostDefaultSchedule(SOLDIERTYPE* pSoldier)
 	}
 	//Have the default schedule enter between 7AM and 8AM
 	gpScheduleList->ubAction[0] = SCHEDULE_ACTION_ENTERSECTOR;
-	gpScheduleList->usTime[0] = (UINT16)(420 + Random( 61 ));
+	gpScheduleList->usTime[0] = (UINT16)(420 + Random( 61, RANDOM_STRATEGIC ));
 	gpScheduleList->usData1[0] = pSoldier->sInitialGridNo;
 	//Have the default schedule leave between 6PM and 8PM
 	gpScheduleList->ubAction[1] = SCHEDULE_ACTION_LEAVESECTOR;
-	gpScheduleList->usTime[1] = (UINT16)(1080 + Random( 121 ));
+	gpScheduleList->usTime[1] = (UINT16)(1080 + Random( 121, RANDOM_STRATEGIC ));
 	gpScheduleList->usFlags |= SCHEDULE_FLAGS_TEMPORARY;
 
 	if( gubScheduleID == 255 )
@@ -434,7 +434,7 @@ static void HandleRPCDescriptionOfSector(INT16 const x, INT16 const y, INT16 con
 		SetSectorFlag(x, y, z, SF_HAVE_USED_GUIDE_QUOTE);
 
 		ts.fCountingDownForGuideDescription = TRUE;
-		ts.bGuideDescriptionCountDown       = 4 + Random(5); // 4 to 8 tactical turns
+		ts.bGuideDescriptionCountDown       = 4 + Random(5, RANDOM_STRATEGIC); // 4 to 8 tactical turns
 		ts.ubGuideDescriptionToUse          = i->quote;
 		ts.bGuideDescriptionSectorX         = x;
 		ts.bGuideDescriptionSectorY         = y;
@@ -568,7 +568,7 @@ void SetCurrentWorldSector(INT16 const x, INT16 const y, INT8 const z)
 		gTacticalStatus.fDontAddNewCrows                   = FALSE;
 
 		// Adjust delay for tense quote
-		gTacticalStatus.sCreatureTenseQuoteDelay = 10 + Random(20);
+		gTacticalStatus.sCreatureTenseQuoteDelay = 10 + Random(20, RANDOM_STRATEGIC);
 
 		INT16 sWarpWorldX;
 		INT16 sWarpWorldY;
@@ -583,7 +583,7 @@ void SetCurrentWorldSector(INT16 const x, INT16 const y, INT8 const z)
 			gTacticalStatus.uiFlags &= ~IN_CREATURE_LAIR;
 		}
 
-		gTacticalStatus.ubNumCrowsPossible = 5 + Random(5);
+		gTacticalStatus.ubNumCrowsPossible = 5 + Random(5, RANDOM_STRATEGIC);
 	}
 }
 
@@ -748,7 +748,7 @@ void HandleQuestCodeOnSectorEntry( INT16 sNewSectorX, INT16 sNewSectorY, INT8 bN
 
 					do
 					{
-						ubMiner = (UINT8) Random( RANDOM_HEAD_MINERS );
+						ubMiner = (UINT8) Random( RANDOM_HEAD_MINERS, RANDOM_STRATEGIC );
 					}
 					while( ubRandomMiner[ ubMiner ] == 0 );
 
@@ -799,7 +799,7 @@ void HandleQuestCodeOnSectorEntry( INT16 sNewSectorX, INT16 sNewSectorY, INT8 bN
 	if (gubQuest[QUEST_KINGPIN_MONEY] == QUESTINPROGRESS &&
 			CheckFact(FACT_KINGPIN_CAN_SEND_ASSASSINS, 0)    &&
 			GetTownIdForSector(sector) != BLANK_SECTOR       &&
-			Random(10 + GetNumberOfMilitiaInSector(sNewSectorX, sNewSectorY, bNewSectorZ)) < 3)
+			Random(10 + GetNumberOfMilitiaInSector(sNewSectorX, sNewSectorY, bNewSectorZ), RANDOM_STRATEGIC) < 3)
 	{
 		DecideOnAssassin();
 	}
@@ -36,6 +36,7 @@
 #include "StrategicAIPolicy.h"
 #include "StrategicMap.h"
 #include "Town_Militia.h"
+#include <bitset>
 #include <vector>
 
 #define SAI_VERSION		29
@@ -144,6 +145,7 @@ UINT8 *gubPatrolReinforcementsDenied = NULL;
 
 //Unsaved vars
 BOOLEAN gfDisplayStrategicAILogs = FALSE;
+BOOLEAN gfShowStrategicInfluence = FALSE;
 
 extern INT16 sWorldSectorLocationOfFirstBattle;
 
@@ -206,19 +208,85 @@ static INT32 ReinforcementsAvailable(INT32 iGarrisonID)
 }
 
 
-static BOOLEAN PlayerForceTooStrong(UINT8 ubSectorID, UINT16 usOffensePoints, UINT16* pusDefencePoints)
+static UINT8             gubSectorDefenceCacheDepth = 0;
+static std::bitset<256>  gSectorDefenceCached;
+static SECTOR_DEFENCE    gSectorDefenceCache[256];
+
+/* While an instance lives, GetSectorDefence() answers from a cache. The
+ * strategic AI neither moves player groups nor militia while it makes a
+ * decision, so each sector is weighed once per decision instead of once per
+ * garrison it is compared with. Instances nest. */
+class SectorDefenceCache
 {
-	SECTORINFO *pSector;
-	UINT8 ubSectorX, ubSectorY;
+	public:
+		SectorDefenceCache() { ++gubSectorDefenceCacheDepth; }
 
-	ubSectorX = (UINT8)SECTORX( ubSectorID );
-	ubSectorY = (UINT8)SECTORY( ubSectorID );
-	pSector = &SectorInfo[ ubSectorID ];
+		~SectorDefenceCache()
+		{
+			if (--gubSectorDefenceCacheDepth == 0) gSectorDefenceCached.reset();
+		}
+
+		SectorDefenceCache(SectorDefenceCache const&) = delete;
+		SectorDefenceCache& operator=(SectorDefenceCache const&) = delete;
+};
+
+
+SECTOR_DEFENCE GetSectorDefence(UINT8 const ubSectorID)
+{
+	bool const caching = gubSectorDefenceCacheDepth != 0;
+	if (caching && gSectorDefenceCached[ubSectorID]) return gSectorDefenceCache[ubSectorID];
+
+	SECTORINFO const& si = SectorInfo[ubSectorID];
+
+	SECTOR_DEFENCE defence;
+	defence.ubPlayerMercs   = PlayerMercsInSector(SECTORX(ubSectorID), SECTORY(ubSectorID), 0);
+	defence.ubMilitia       =
+		si.ubNumberOfCivsAtLevel[GREEN_MILITIA] +
+		si.ubNumberOfCivsAtLevel[REGULAR_MILITIA] +
+		si.ubNumberOfCivsAtLevel[ELITE_MILITIA];
+	defence.usMilitiaPoints =
+		si.ubNumberOfCivsAtLevel[GREEN_MILITIA]   * 1 +
+		si.ubNumberOfCivsAtLevel[REGULAR_MILITIA] * 2 +
+		si.ubNumberOfCivsAtLevel[ELITE_MILITIA]   * 3;
+
+	if (caching)
+	{
+		gSectorDefenceCache[ubSectorID]  = defence;
+		gSectorDefenceCached[ubSectorID] = true;
+	}
+	return defence;
+}
+
+
+SECTOR_INFLUENCE GetSectorInfluence(UINT8 const ubSectorID)
+{
+	SECTOR_INFLUENCE influence;
+	static_cast<SECTOR_DEFENCE&>(influence) = GetSectorDefence(ubSectorID);
+	influence.ubEnemies = NumEnemiesInSector(SECTORX(ubSectorID), SECTORY(ubSectorID));
+	return influence;
+}
+
+
+// Returns the garrison stationed in the sector or NO_GARRISON
+static INT32 GarrisonInSector(UINT8 const ubSectorID)
+{
+	UINT8 const id = SectorInfo[ubSectorID].ubGarrisonID;
+	if (id < gGarrisonGroup.size() && gGarrisonGroup[id].ubSectorID == ubSectorID) return id;
+
+	// The sector table doesn't know the garrison, search for it
+	for (size_t i = 0; i < gGarrisonGroup.size(); i++)
+	{
+		if (gGarrisonGroup[i].ubSectorID == ubSectorID) return i;
+	}
+	return NO_GARRISON;
+}
+
+
+static BOOLEAN PlayerForceTooStrong(UINT8 ubSectorID, UINT16 usOffensePoints, UINT16* pusDefencePoints)
+{
+	SECTOR_DEFENCE const defence = GetSectorDefence(ubSectorID);
 
-	*pusDefencePoints = pSector->ubNumberOfCivsAtLevel[ GREEN_MILITIA ]		* 1 +
-											pSector->ubNumberOfCivsAtLevel[ REGULAR_MILITIA ] * 2 +
-											pSector->ubNumberOfCivsAtLevel[ ELITE_MILITIA ]		* 3 +
-											PlayerMercsInSector( ubSectorX, ubSectorY, 0 )		* 5;
+	*pusDefencePoints = defence.usMilitiaPoints + defence.ubPlayerMercs * 5;
 	if( *pusDefencePoints > usOffensePoints )
 	{
 		return TRUE;
@@ -232,16 +300,12 @@ static void SendReinforcementsForGarrison(INT32 iDstGarrisonID, UINT16 usDefence
 
 static void RequestAttackOnSector(UINT8 ubSectorID, UINT16 usDefencePoints)
 {
-	UINT32 i;
-	for( i = 0; i < gGarrisonGroup.size(); i++ )
+	INT32 const i = GarrisonInSector(ubSectorID);
+	if( i != NO_GARRISON && !gGarrisonGroup[ i ].ubPendingGroupID )
 	{
-		if( gGarrisonGroup[ i ].ubSectorID == ubSectorID && !gGarrisonGroup[ i ].ubPendingGroupID )
-		{
-			SLOGD("An attack has been requested in sector %c%d.",
-					SECTORY( ubSectorID ) + 'A' - 1, SECTORX( ubSectorID ) );
-			SendReinforcementsForGarrison( i, usDefencePoints, NULL );
-			return;
-		}
+		SLOGD("An attack has been requested in sector %c%d.",
+				SECTORY( ubSectorID ) + 'A' - 1, SECTORX( ubSectorID ) );
+		SendReinforcementsForGarrison( i, usDefencePoints, NULL );
 	}
 }
 
@@ -341,7 +405,7 @@ void InitStrategicAI()
 	giArmyAlertnessDecay  = saipolicy_by_diff(enemy_starting_alert_decay);
 	gubMinEnemyGroupSize  = saipolicy_by_diff(min_enemy_group_size);
 	gubHoursGracePeriod   = saipolicy_by_diff(grace_period_in_hours);
-	evaluate_time        += saipolicy_by_diff(time_evaluate_in_minutes) + Random(saipolicy_by_diff(time_evaluate_variance));
+	evaluate_time        += saipolicy_by_diff(time_evaluate_in_minutes) + Random(saipolicy_by_diff(time_evaluate_variance), RANDOM_STRATEGIC);
 	
 	AddStrategicEvent(EVENT_EVALUATE_QUEEN_SITUATION, evaluate_time, 0);
 
@@ -429,7 +493,7 @@ void InitStrategicAI()
 		{
 			case ROADBLOCK:
 				si.uiFlags |= SF_ENEMY_AMBUSH_LOCATION;
-				start_pop   = Chance(20) ? ac.bDesiredPopulation : 0;
+				start_pop   = Chance(20, RANDOM_STRATEGIC) ? ac.bDesiredPopulation : 0;
 				break;
 
 			case SANMONA_SMALL:
@@ -445,7 +509,7 @@ void InitStrategicAI()
 				if (start_pop != MAX_STRATEGIC_TEAM_SIZE)
 				{
 					// then vary it a bit (+/- 25%)
-					start_pop = start_pop * (100 + Random(51) - 25) / 100;
+					start_pop = start_pop * (100 + Random(51, RANDOM_STRATEGIC) - 25) / 100;
 				}
 
 				start_pop = MAX(gubMinEnemyGroupSize, MIN(MAX_STRATEGIC_TEAM_SIZE, start_pop));
@@ -457,7 +521,7 @@ void InitStrategicAI()
 			}
 			else for (INT32 cnt = start_pop; cnt != 0; --cnt)
 			{ // For each soldier randomly determine the type.
-				INT32 const roll = Random(100);
+				INT32 const roll = Random(100, RANDOM_STRATEGIC);
 				if (roll < elite_chance)
 				{
 					++si.ubNumElites;
@@ -519,14 +583,14 @@ void InitStrategicAI()
 
 		/* Post an event which allows them to check adjacent sectors periodically.
 		 * Spread them out so that they process at different times. */
-		AddPeriodStrategicEventWithOffset(EVENT_CHECK_ENEMY_CONTROLLED_SECTOR, 140 - 20 * difficulty + Random(4), 475 + i, gg.ubSectorID);
+		AddPeriodStrategicEventWithOffset(EVENT_CHECK_ENEMY_CONTROLLED_SECTOR, 140 - 20 * difficulty + Random(4, RANDOM_STRATEGIC), 475 + i, gg.ubSectorID);
 	}
 
 	// Initialize each of the patrol groups
 	for (size_t i = 0; i != gPatrolGroup.size(); ++i)
 	{
 		PATROL_GROUP& pg = gPatrolGroup[i];
-		UINT8 n_troops = pg.bSize + Random(3) - 1;
+		UINT8 n_troops = pg.bSize + Random(3, RANDOM_STRATEGIC) - 1;
 		n_troops = MAX(gubMinEnemyGroupSize, MIN(MAX_STRATEGIC_TEAM_SIZE, n_troops));
 		/* Note on adding patrol groups: The patrol group can't actually start on
 		 * the first waypoint, so we set it to the second way point for
@@ -815,7 +879,7 @@ static BOOLEAN AttemptToNoticeEmptySectorSucceeds(void)
 	}
 	if( DayTime() )
 	{ //Day time chances are normal
-		if( Chance( giArmyAlertness ) )
+		if( Chance( giArmyAlertness, RANDOM_STRATEGIC ) )
 		{
 			giArmyAlertness -= giArmyAlertnessDecay;
 			//Minimum alertness should always be at least 0.
@@ -826,14 +890,14 @@ static BOOLEAN AttemptToNoticeEmptySectorSucceeds(void)
 		return FALSE;
 	}
 	//Night time chances are one third of normal.
-	if( Chance( giArmyAlertness/3 ) )
+	if( Chance( giArmyAlertness/3, RANDOM_STRATEGIC ) )
 	{
 		giArmyAlertness -= giArmyAlertnessDecay;
 		//Minimum alertness should always be at least 0.
 		giArmyAlertness = MAX( 0, giArmyAlertness );
 		return TRUE;
 	}
-	if( Chance( 33 ) )
+	if( Chance( 33, RANDOM_STRATEGIC ) )
 	{
 		giArmyAlertness++;
 	}
@@ -853,7 +917,7 @@ static BOOLEAN AttemptToNoticeAdjacentGroupSucceeds(void)
 	}
 	if( DayTime() )
 	{ //Day time chances are normal
-		if( Chance( giArmyAlertness ) )
+		if( Chance( giArmyAlertness, RANDOM_STRATEGIC ) )
 		{
 			giArmyAlertness -= giArmyAlertnessDecay;
 			//Minimum alertness should always be at least 0.
@@ -864,14 +928,14 @@ static BOOLEAN AttemptToNoticeAdjacentGroupSucceeds(void)
 		return FALSE;
 	}
 	//Night time chances are one third of normal.
-	if( Chance( giArmyAlertness/3 ) )
+	if( Chance( giArmyAlertness/3, RANDOM_STRATEGIC ) )
 	{
 		giArmyAlertness -= giArmyAlertnessDecay;
 		//Minimum alertness should always be at least 0.
 		giArmyAlertness = MAX( 0, giArmyAlertness );
 		return TRUE;
 	}
-	if( Chance( 33 ) )
+	if( Chance( 33, RANDOM_STRATEGIC ) )
 	{
 		giArmyAlertness++;
 	}
@@ -950,18 +1014,14 @@ static void HandleEmptySectorNoticedByGarrison(UINT8 ubGarrisonSectorID, UINT8 u
 
 static BOOLEAN ReinforcementsApproved(INT32 iGarrisonID, UINT16* pusDefencePoints)
 {
-	SECTORINFO *pSector;
 	UINT16 usOffensePoints;
 	UINT8 ubSectorX, ubSectorY;
 
-	pSector = &SectorInfo[ gGarrisonGroup[ iGarrisonID ].ubSectorID ];
 	ubSectorX = (UINT8)SECTORX( gGarrisonGroup[ iGarrisonID ].ubSectorID );
 	ubSectorY = (UINT8)SECTORY( gGarrisonGroup[ iGarrisonID ].ubSectorID );
 
-	*pusDefencePoints = pSector->ubNumberOfCivsAtLevel[ GREEN_MILITIA ]		* 1 +
-										pSector->ubNumberOfCivsAtLevel[ REGULAR_MILITIA ] * 2 +
-										pSector->ubNumberOfCivsAtLevel[ ELITE_MILITIA ]		* 3 +
-										PlayerMercsInSector( ubSectorX, ubSectorY, 0 )		* 4;
+	SECTOR_DEFENCE const defence = GetSectorDefence(gGarrisonGroup[iGarrisonID].ubSectorID);
+	*pusDefencePoints = defence.usMilitiaPoints + defence.ubPlayerMercs * 4;
 	usOffensePoints = gArmyComp[ gGarrisonGroup[ iGarrisonID ].ubComposition ].bAdminPercentage * 2 +
 										gArmyComp[ gGarrisonGroup[ iGarrisonID ].ubComposition ].bTroopPercentage * 3 +
 										gArmyComp[ gGarrisonGroup[ iGarrisonID ].ubComposition ].bElitePercentage * 4 +
@@ -1353,7 +1413,7 @@ void CheckEnemyControlledSector( UINT8 ubSectorID )
 					{
 						if( pGroup->pEnemyGroup->ubPendingReinforcements > 4 )
 						{
-							UINT8 ubNum = (UINT8)(3 + Random( 3 ));
+							UINT8 ubNum = (UINT8)(3 + Random( 3, RANDOM_STRATEGIC ));
 							pGroup->pEnemyGroup->ubNumTroops += ubNum;
 							pGroup->ubGroupSize += ubNum;
 							pGroup->pEnemyGroup->ubPendingReinforcements -= ubNum;
@@ -1562,14 +1622,8 @@ static void RecalculateGarrisonWeight(INT32 iGarrisonID)
 
 void RecalculateSectorWeight( UINT8 ubSectorID )
 {
-	for( size_t i = 0; i < gGarrisonGroup.size(); i++ )
-	{
-		if( gGarrisonGroup[ i ].ubSectorID == ubSectorID )
-		{
-			RecalculateGarrisonWeight( i );
-			return;
-		}
-	}
+	INT32 const i = GarrisonInSector(ubSectorID);
+	if (i != NO_GARRISON) RecalculateGarrisonWeight(i);
 }
 
 
@@ -1646,7 +1700,7 @@ static INT32 ChooseSuitableGarrisonToProvideReinforcements(INT32 iDstGarrisonID,
 	}
 
 	//The Alma case either wasn't applicable or failed to have the right reinforcements.  Do a general weighted search.
-	iRandom = Random( giReinforcementPoints );
+	iRandom = Random( giReinforcementPoints, RANDOM_STRATEGIC );
 	for( uiSrcGarrisonID = 0; uiSrcGarrisonID < uiGarrisonArraySize; uiSrcGarrisonID++ )
 	{ //go through the garrisons
 		RecalculateGarrisonWeight( uiSrcGarrisonID );
@@ -1666,10 +1720,9 @@ static INT32 ChooseSuitableGarrisonToProvideReinforcements(INT32 iDstGarrisonID,
 	}
 
 	//So far we have failed on all accounts.  Now, simply process all the garrisons, and return the first garrison that can
-	//provide the reinforcements.
+	//provide the reinforcements.  The weights are still current from the weighted search.
 	for( uiSrcGarrisonID = 0; uiSrcGarrisonID < uiGarrisonArraySize; uiSrcGarrisonID++ )
 	{ //go through the garrisons
-		RecalculateGarrisonWeight( uiSrcGarrisonID );
 		iWeight = -gGarrisonGroup[ uiSrcGarrisonID ].bWeight;
 		if( iWeight > 0 && GarrisonCanProvideMinimumReinforcements( uiSrcGarrisonID ) )
 		{ //if group is able to provide reinforcements.
@@ -1682,10 +1735,9 @@ static INT32 ChooseSuitableGarrisonToProvideReinforcements(INT32 iDstGarrisonID,
 	}
 
 	//Well, if we get this far, the queen must be low on troops.  Send whatever we can.
-	iRandom = Random( giReinforcementPoints );
+	iRandom = Random( giReinforcementPoints, RANDOM_STRATEGIC );
 	for( uiSrcGarrisonID = 0; uiSrcGarrisonID < uiGarrisonArraySize; uiSrcGarrisonID++ )
 	{ //go through the garrisons
-		RecalculateGarrisonWeight( uiSrcGarrisonID );
 		iWeight = -gGarrisonGroup[ uiSrcGarrisonID ].bWeight;
 		if( iWeight > 0 && GarrisonCanProvideMinimumReinforcements( uiSrcGarrisonID ) )
 		{ //if group is able to provide reinforcements.
@@ -1712,6 +1764,7 @@ static void SendReinforcementsForGarrison(INT32 iDstGarrisonID, UINT16 usDefence
 	UINT8 ubNumExtraReinforcements;
 	UINT8 ubGroupSize;
 	BOOLEAN fLimitMaxTroopsAllowable = FALSE;
+	SectorDefenceCache const cache;
 
 	//Determine how many units the garrison needs.
 	iReinforcementsRequested = GarrisonReinforcementsRequested( iDstGarrisonID, &ubNumExtraReinforcements );
@@ -1753,7 +1806,7 @@ static void SendReinforcementsForGarrison(INT32 iDstGarrisonID, UINT16 usDefence
 		MoveSAIGroupToSector( pOptionalGroup, gGarrisonGroup[ iDstGarrisonID ].ubSectorID, STAGE, REINFORCEMENTS );
 		return;
 	}
-	iRandom = Random( giReinforcementPoints + giReinforcementPool );
+	iRandom = Random( giReinforcementPoints + giReinforcementPool, RANDOM_STRATEGIC );
 	if( iRandom < giReinforcementPool )
 	{ //use the pool and send the requested amount from SECTOR P3 (queen's palace)
 		QUEEN_POOL:
@@ -1789,7 +1842,7 @@ static void SendReinforcementsForGarrison(INT32 iDstGarrisonID, UINT16 usDefence
 		if( ubNumExtraReinforcements && fLimitMaxTroopsAllowable && iReinforcementsApproved == iMaxReinforcementsAllowed )
 		{
 			iChance = (iReinforcementsApproved + ubNumExtraReinforcements) * 100 / usDefencePoints;
-			if( !Chance( iChance ) )
+			if( !Chance( iChance, RANDOM_STRATEGIC ) )
 			{
 				return;
 			}
@@ -1860,7 +1913,7 @@ static void SendReinforcementsForGarrison(INT32 iDstGarrisonID, UINT16 usDefence
 			if( iReinforcementsApproved + ubNumExtraReinforcements == iMaxReinforcementsAllowed && usDefencePoints )
 			{
 				iChance = (iReinforcementsApproved + ubNumExtraReinforcements) * 100 / usDefencePoints;
-				if( !Chance( iChance ) )
+				if( !Chance( iChance, RANDOM_STRATEGIC ) )
 				{
 					return;
 				}
@@ -1905,6 +1958,7 @@ static void SendReinforcementsForPatrol(INT32 iPatrolID, GROUP** pOptionalGroup)
 	UINT32 uiSrcGarrisonID;
 	INT32 iReinforcementsAvailable, iReinforcementsRequested, iReinforcementsApproved;
 	UINT8 ubSrcSectorX, ubSrcSectorY;
+	SectorDefenceCache const cache;
 
 	PATROL_GROUP* const pg = &gPatrolGroup[iPatrolID];
 
@@ -1930,7 +1984,7 @@ static void SendReinforcementsForPatrol(INT32 iPatrolID, GROUP** pOptionalGroup)
 		MoveSAIGroupToSector(pOptionalGroup, pg->ubSectorID[1], EVASIVE, REINFORCEMENTS);
 		return;
 	}
-	iRandom = Random( giReinforcementPoints + giReinforcementPool );
+	iRandom = Random( giReinforcementPoints + giReinforcementPool, RANDOM_STRATEGIC );
 	if( iRandom < giReinforcementPool )
 	{ //use the pool and send the requested amount from SECTOR P3 (queen's palace)
 		iReinforcementsApproved = MIN( iReinforcementsRequested, giReinforcementPool );
@@ -2011,8 +2065,8 @@ void EvaluateQueenSituation()
 	// The more work to do there is (request points the queen's army is asking for), the more often she will make decisions
 	// This can increase the decision intervals by up to 500 extra minutes (> 8 hrs)
 	uiOffset = MAX( 100 - giRequestPoints, 0);
-	uiOffset = uiOffset + Random( uiOffset * 4 );
-	uiOffset += saipolicy_by_diff(time_evaluate_in_minutes) + Random(saipolicy_by_diff(time_evaluate_variance));
+	uiOffset = uiOffset + Random( uiOffset * 4, RANDOM_STRATEGIC );
+	uiOffset += saipolicy_by_diff(time_evaluate_in_minutes) + Random(saipolicy_by_diff(time_evaluate_variance), RANDOM_STRATEGIC);
 
 	if( !giReinforcementPool )
 	{ //Queen has run out of reinforcements.  Simulate recruiting and training new troops
@@ -2044,7 +2098,7 @@ void EvaluateQueenSituation()
 
 	//now randomly choose who gets the reinforcements.
 	// giRequestPoints is the combined sum of all the individual weights of all garrisons and patrols requesting reinforcements
-	iRandom = Random( giRequestPoints );
+	iRandom = Random( giRequestPoints, RANDOM_STRATEGIC );
 
 	//go through garrisons first
 	for (size_t i = 0; i < gGarrisonGroup.size(); i++)
@@ -2496,7 +2550,7 @@ void LoadStrategicAI(HWFILE const hFile)
 					if( iStartPop != MAX_STRATEGIC_TEAM_SIZE )
 					{
 						// then vary it a bit (+/- 25%)
-						iStartPop = iStartPop * ( 100 + ( Random ( 51 ) - 25 ) ) / 100;
+						iStartPop = iStartPop * ( 100 + ( Random ( 51, RANDOM_STRATEGIC ) - 25 ) ) / 100;
 					}
 
 					iStartPop = MAX( gubMinEnemyGroupSize, MIN( MAX_STRATEGIC_TEAM_SIZE, iStartPop ) );
@@ -2509,7 +2563,7 @@ void LoadStrategicAI(HWFILE const hFile)
 					else while( cnt-- )
 					{ //for each person, randomly determine the types of each soldier.
 						{
-							iRandom = Random( 100 );
+							iRandom = Random( 100, RANDOM_STRATEGIC );
 							if( iRandom < iEliteChance )
 							{
 								pSector->ubNumElites++;
@@ -2798,7 +2852,7 @@ void ExecuteStrategicAIAction( UINT16 usActionCode, INT16 sSectorX, INT16 sSecto
 					gArmyComp[ gGarrisonGroup[ i ].ubComposition ].bPriority = 65;
 					gArmyComp[ gGarrisonGroup[ i ].ubComposition ].bTroopPercentage = 100;
 					gArmyComp[ gGarrisonGroup[ i ].ubComposition ].bDesiredPopulation = 5;
-					RequestHighPriorityGarrisonReinforcements( i, (UINT8)(2 + Random( 4 )) ); //send 2-5 soldiers now.
+					RequestHighPriorityGarrisonReinforcements( i, (UINT8)(2 + Random( 4, RANDOM_STRATEGIC )) ); //send 2-5 soldiers now.
 					break;
 				}
 			}
@@ -2808,11 +2862,11 @@ void ExecuteStrategicAIAction( UINT16 usActionCode, INT16 sSectorX, INT16 sSecto
 			//Send 6, 9, or 12 troops (based on difficulty) one of the Drassen sectors.  If nobody is there when they arrive,
 			//those troops will get reassigned.
 
-			if( Chance( 50 ) )
+			if( Chance( 50, RANDOM_STRATEGIC ) )
 			{
 				ubSectorID = SEC_D13;
 			}
-			else if( Chance( 60 ) )
+			else if( Chance( 60, RANDOM_STRATEGIC ) )
 			{
 				ubSectorID = SEC_B13;
 			}
@@ -2972,7 +3026,7 @@ void StrategicHandleQueenLosingControlOfSector( INT16 sSectorX, INT16 sSectorY,
 		}
 		else
 		{ //convert hours to seconds and subtract up to half of it randomly "seconds - (hours*3600 / 2)"
-			pSector->uiTimeLastPlayerLiberated = GetWorldTotalSeconds() - Random( gubHoursGracePeriod * 1800 );
+			pSector->uiTimeLastPlayerLiberated = GetWorldTotalSeconds() - Random( gubHoursGracePeriod * 1800, RANDOM_STRATEGIC );
 		}
 		if( gGarrisonGroup[ pSector->ubGarrisonID ].ubPendingGroupID )
 		{
@@ -3210,7 +3264,6 @@ static BOOLEAN GarrisonCanProvideMinimumReinforcements(INT32 iGarrisonID)
 	INT32 iAvailable;
 	INT32 iDesired;
 	SECTORINFO *pSector;
-	UINT8 ubSectorX, ubSectorY;
 
 	pSector = &SectorInfo[ gGarrisonGroup[ iGarrisonID ].ubSectorID ];
 
@@ -3221,9 +3274,8 @@ static BOOLEAN GarrisonCanProvideMinimumReinforcements(INT32 iGarrisonID)
 	{
 		//Do a more expensive check first to determine if there is a player presence here (combat in progress)
 		//If so, do not provide reinforcements from here.
-		ubSectorX = (UINT8)SECTORX( gGarrisonGroup[ iGarrisonID ].ubSectorID );
-		ubSectorY = (UINT8)SECTORY( gGarrisonGroup[ iGarrisonID ].ubSectorID );
-		if( PlayerMercsInSector( ubSectorX, ubSectorY, 0 ) || CountAllMilitiaInSector( ubSectorX, ubSectorY ) )
+		SECTOR_DEFENCE const defence = GetSectorDefence(gGarrisonGroup[iGarrisonID].ubSectorID);
+		if( defence.ubPlayerMercs || defence.ubMilitia )
 		{
 			return FALSE;
 		}
@@ -3416,7 +3468,7 @@ static void UpgradeAdminsToTroops()
 		{
 			/* Chance to upgrade at each check is random and is dependent on the
 			 * garrison's priority. */
-			if (!Chance(priority)) continue;
+			if (!Chance(priority, RANDOM_STRATEGIC)) continue;
 			--sector.ubNumAdmins;
 			++sector.ubNumTroops;
 		}
@@ -3456,7 +3508,7 @@ static void UpgradeAdminsToTroops()
 		{
 			/* Chance to upgrade at each check is random and is dependent on the
 			 * group's priority. */
-			if (!Chance(priority)) continue;
+			if (!Chance(priority, RANDOM_STRATEGIC)) continue;
 			--eg.ubNumAdmins;
 			++eg.ubNumTroops;
 		}
@@ -3541,6 +3593,7 @@ static void ReassignAIGroup(GROUP** pGroup)
 	UINT16 usDefencePoints;
 	size_t uiReloopLastIndex = -1;
 	UINT8 ubSectorID;
+	SectorDefenceCache const cache;
 
 	ubSectorID = (UINT8)SECTOR( (*pGroup)->ubSectorX, (*pGroup)->ubSectorY );
 
@@ -3560,7 +3613,7 @@ static void ReassignAIGroup(GROUP** pGroup)
 
 	//now randomly choose who gets the reinforcements.
 	// giRequestPoints is the combined sum of all the individual weights of all garrisons and patrols requesting reinforcements
-	iRandom = Random( giRequestPoints );
+	iRandom = Random( giRequestPoints, RANDOM_STRATEGIC );
 
 	//go through garrisons first and begin considering where the random value dictates.  If that garrison doesn't require
 	//reinforcements, it'll continue on considering all subsequent garrisons till the end of the array.  If it fails at that
@@ -3726,7 +3779,7 @@ static void CalcNumTroopsBasedOnComposition(UINT8* pubNumTroops, UINT8* pubNumEl
 	//Due to low roundoff, it is highly possible that we will be short one soldier.
 	while( *pubNumTroops + *pubNumElites < ubTotal )
 	{
-		if( Chance( gArmyComp[ iCompositionID ].bTroopPercentage ) )
+		if( Chance( gArmyComp[ iCompositionID ].bTroopPercentage, RANDOM_STRATEGIC ) )
 		{
 			(*pubNumTroops)++;
 		}
@@ -3946,7 +3999,7 @@ static void ReinitializeUnvisitedGarrisons(void)
 			}
 			else while( cnt-- )
 			{ //for each person, randomly determine the types of each soldier.
-				if( Chance( uiEliteChance ) )
+				if( Chance( uiEliteChance, RANDOM_STRATEGIC ) )
 				{
 					pSector->ubNumElites++;
 				}
@@ -3970,4 +4023,40 @@ TEST(StrategicAI, asserts)
 	EXPECT_EQ(sizeof(GARRISON_GROUP), 14u);
 }
 
+TEST(StrategicAI, sectorDefenceIsCachedForOneDecision)
+{
+	UINT8      const sector = SEC_D13;
+	SECTORINFO const saved  = SectorInfo[sector];
+	UINT8*     const militia = SectorInfo[sector].ubNumberOfCivsAtLevel;
+	militia[GREEN_MILITIA]   = 2;
+	militia[REGULAR_MILITIA] = 1;
+	militia[ELITE_MILITIA]   = 0;
+
+	{
+		SectorDefenceCache const cache;
+		SECTOR_DEFENCE const before = GetSectorDefence(sector);
+		EXPECT_EQ(before.ubMilitia, 3);
+		EXPECT_EQ(before.usMilitiaPoints, 4);
+
+		militia[ELITE_MILITIA] = 4;
+		{
+			SectorDefenceCache const nested;
+			EXPECT_EQ(GetSectorDefence(sector).ubMilitia, 3);
+		}
+		// Leaving the nested decision keeps the cache of the outer one
+		EXPECT_EQ(GetSectorDefence(sector).ubMilitia, 3);
+	}
+
+	// Outside of a decision the sector is weighed again
+	SECTOR_DEFENCE const after = GetSectorDefence(sector);
+	EXPECT_EQ(after.ubMilitia, 7);
+	EXPECT_EQ(after.usMilitiaPoints, 16);
+	{
+		SectorDefenceCache const cache;
+		EXPECT_EQ(GetSectorDefence(sector).ubMilitia, 7);
+	}
+
+	SectorInfo[sector] = saved;
+}
+
 #endif
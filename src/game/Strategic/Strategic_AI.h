@@ -39,6 +39,29 @@ void RecalculateGroupWeight(GROUP const&);
 
 BOOLEAN OkayForEnemyToMoveThroughSector( UINT8 ubSectorID );
 
+/* The forces the strategic AI weighs for a surface sector. It is read from the
+ * sector tables and the per sector group index, which are kept up to date as
+ * groups move and battles resolve. While the strategic AI makes a decision,
+ * GetSectorDefence() weighs each sector once and then answers from a cache. */
+struct SECTOR_DEFENCE
+{
+	UINT8  ubPlayerMercs;   // alive mercs and robots, not counting groups between sectors
+	UINT8  ubMilitia;
+	UINT16 usMilitiaPoints; // green 1, regular 2, elite 3
+};
+
+struct SECTOR_INFLUENCE : SECTOR_DEFENCE
+{
+	UINT8  ubEnemies;       // stationary and mobile
+};
+
+// Only the player side, for callers which don't need the enemy count
+SECTOR_DEFENCE GetSectorDefence(UINT8 ubSectorID);
+SECTOR_INFLUENCE GetSectorInfluence(UINT8 ubSectorID);
+
+// Debug overlay of GetSectorInfluence() in the map screen
+extern BOOLEAN gfShowStrategicInfluence;
+
 void StrategicHandleQueenLosingControlOfSector( INT16 sSectorX, INT16 sSectorY, INT16 sSectorZ );
 
 void WakeUpQueen(void);
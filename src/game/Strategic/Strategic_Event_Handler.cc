@@ -76,7 +76,7 @@ void BobbyRayPurchaseEventCallback(const UINT8 ubOrderID)
 	if (CheckFact(FACT_NEXT_PACKAGE_CAN_BE_LOST, 0))
 	{
 		SetFactFalse(FACT_NEXT_PACKAGE_CAN_BE_LOST);
-		if (Random(100) < 50)
+		if (Random(100, RANDOM_STRATEGIC) < 50)
 		{
 			// lose the whole shipment!
 			shipment->fActive = FALSE;
@@ -146,7 +146,7 @@ void BobbyRayPurchaseEventCallback(const UINT8 ubOrderID)
 	{
 		++ubShipmentsSinceNoBribes;
 		// this chance might seem high but it's only applied at most to every second item
-		uiChanceOfTheft = 12 + Random(4 * ubShipmentsSinceNoBribes);
+		uiChanceOfTheft = 12 + Random(4 * ubShipmentsSinceNoBribes, RANDOM_STRATEGIC);
 	}
 
 	UINT32  uiCount               = 0;
@@ -182,7 +182,7 @@ void BobbyRayPurchaseEventCallback(const UINT8 ubOrderID)
 			if (fSectorLoaded)
 			{
 				// add ubItemsPurchased to the chance of theft so the chance increases when there are more items of a kind being ordered
-				if (!fPablosStoleLastItem && uiChanceOfTheft > 0 && Random(100) < uiChanceOfTheft + ubItemsPurchased)
+				if (!fPablosStoleLastItem && uiChanceOfTheft > 0 && Random(100, RANDOM_STRATEGIC) < uiChanceOfTheft + ubItemsPurchased)
 				{
 					++uiStolenCount;
 					fPablosStoleSomething = TRUE;
@@ -195,7 +195,7 @@ void BobbyRayPurchaseEventCallback(const UINT8 ubOrderID)
 					if (usStandardMapPos == LOST_SHIPMENT_GRIDNO)
 					{
 						// damage the item a random amount!
-						const INT8 status = (70 + Random(11)) * (INT32)Object.bStatus[0] / 100;
+						const INT8 status = (70 + Random(11, RANDOM_STRATEGIC)) * (INT32)Object.bStatus[0] / 100;
 						Object.bStatus[0] = MAX(1, status);
 						AddItemToPool(usStandardMapPos, &Object, INVISIBLE, 0, 0, 0);
 					}
@@ -208,7 +208,7 @@ void BobbyRayPurchaseEventCallback(const UINT8 ubOrderID)
 			}
 			else
 			{
-				if (j > 1 && !fPablosStoleLastItem && uiChanceOfTheft > 0 && Random(100) < uiChanceOfTheft + j)
+				if (j > 1 && !fPablosStoleLastItem && uiChanceOfTheft > 0 && Random(100, RANDOM_STRATEGIC) < uiChanceOfTheft + j)
 				{
 					pStolenObject[uiStolenCount] = Object;
 					++uiStolenCount;
@@ -224,7 +224,7 @@ void BobbyRayPurchaseEventCallback(const UINT8 ubOrderID)
 					if (usStandardMapPos == LOST_SHIPMENT_GRIDNO)
 					{
 						// damage the item a random amount!
-						const INT8 status = (70 + Random(11)) * (INT32)Object.bStatus[0] / 100;
+						const INT8 status = (70 + Random(11, RANDOM_STRATEGIC)) * (INT32)Object.bStatus[0] / 100;
 						Object.bStatus[0] = MAX(1, status);
 						pObject[uiCount++] = Object;
 					}
@@ -373,29 +373,29 @@ static void HandleDelayedItemsArrival(UINT32 uiReason)
 
 		for (ubLoop = 0; ubLoop < 2; ubLoop++)
 		{
-			switch( Random( 10 ) )
+			switch( Random( 10, RANDOM_STRATEGIC ) )
 			{
 				case 0:
 					// 1 in 10 chance of a badly damaged gas mask
-					CreateItem( GASMASK, (INT8) (20 + Random( 10 )), &Object );
+					CreateItem( GASMASK, (INT8) (20 + Random( 10, RANDOM_STRATEGIC )), &Object );
 					break;
 				case 1:
 				case 2:
 					// 2 in 10 chance of a battered Desert Eagle
-					CreateItem( DESERTEAGLE, (INT8) (40 + Random( 10 )), &Object );
+					CreateItem( DESERTEAGLE, (INT8) (40 + Random( 10, RANDOM_STRATEGIC )), &Object );
 					break;
 				case 3:
 				case 4:
 				case 5:
 					// 3 in 10 chance of a stun grenade
-					CreateItem( STUN_GRENADE, (INT8) (70 + Random( 10 )), &Object );
+					CreateItem( STUN_GRENADE, (INT8) (70 + Random( 10, RANDOM_STRATEGIC )), &Object );
 					break;
 				case 6:
 				case 7:
 				case 8:
 				case 9:
 					// 4 in 10 chance of two 38s!
-					CreateItems( SW38, (INT8) (90 + Random( 10 )), 2, &Object );
+					CreateItems( SW38, (INT8) (90 + Random( 10, RANDOM_STRATEGIC )), 2, &Object );
 					break;
 			}
 			if ( ( gWorldSectorX == shippingDest->deliverySectorX) && ( gWorldSectorY == shippingDest->deliverySectorY) && ( gbWorldSectorZ == shippingDest->deliverySectorZ ) )
@@ -470,7 +470,7 @@ static void SetPabloToUnbribed(void)
 
 static void HandlePossiblyDamagedPackage(void)
 {
-	if (Random( 100 ) < 70)
+	if (Random( 100, RANDOM_STRATEGIC ) < 70)
 	{
 		SetFactTrue( FACT_PACKAGE_DAMAGED );
 		HandleDelayedItemsArrival( FACT_PACKAGE_DAMAGED );
@@ -535,7 +535,7 @@ void CheckForKingpinsMoneyMissing( BOOLEAN fFirstCheck )
 	if ( fKingpinWillDiscover )
 	{
 		// set event for next day to check for real
-		AddFutureDayStrategicEvent( EVENT_SET_BY_NPC_SYSTEM, Random( 120 ), FACT_KINGPIN_KNOWS_MONEY_GONE, 1 );
+		AddFutureDayStrategicEvent( EVENT_SET_BY_NPC_SYSTEM, Random( 120, RANDOM_STRATEGIC ), FACT_KINGPIN_KNOWS_MONEY_GONE, 1 );
 
 		// the sector is unloaded NOW so set Kingpin's balance and remove the cash
 		gMercProfiles[ KINGPIN ].iBalance = - (30000 - (INT32) uiTotalCash);
@@ -552,7 +552,7 @@ void CheckForKingpinsMoneyMissing( BOOLEAN fFirstCheck )
 
 		// set event 2 days from now that if the player has not given Kingpin his money back,
 		// he sends email to the player
-		AddFutureDayStrategicEvent( EVENT_SET_BY_NPC_SYSTEM, Random( 120 ), FACT_KINGPIN_KNOWS_MONEY_GONE, 2 );
+		AddFutureDayStrategicEvent( EVENT_SET_BY_NPC_SYSTEM, Random( 120, RANDOM_STRATEGIC ), FACT_KINGPIN_KNOWS_MONEY_GONE, 2 );
 	}
 
 }
@@ -600,7 +600,7 @@ void HandleNPCSystemEvent( UINT32 uiEvent )
 						AddEmail( KING_PIN_LETTER, KING_PIN_LETTER_LENGTH, KING_PIN, GetWorldTotalMin() );
 						StartQuest( QUEST_KINGPIN_MONEY, 5, MAP_ROW_D );
 						// add event to send terrorists two days from now
-						AddFutureDayStrategicEvent( EVENT_SET_BY_NPC_SYSTEM, Random( 120 ), FACT_KINGPIN_KNOWS_MONEY_GONE, 2 );
+						AddFutureDayStrategicEvent( EVENT_SET_BY_NPC_SYSTEM, Random( 120, RANDOM_STRATEGIC ), FACT_KINGPIN_KNOWS_MONEY_GONE, 2 );
 					}
 					else if ( gubQuest[ QUEST_KINGPIN_MONEY ] == QUESTINPROGRESS )
 					{
@@ -726,9 +726,9 @@ void HandleEarlyMorningEvents( void )
 		p.ubMiscFlags2 &= (~PROFILE_MISC_FLAG2_BANDAGED_TODAY);
 	}
 	// reset Father Walker's drunkenness level!
-	gMercProfiles[ FATHER ].bNPCData = (INT8) Random( 4 );
+	gMercProfiles[ FATHER ].bNPCData = (INT8) Random( 4, RANDOM_STRATEGIC );
 	// set Walker's location
-	if ( Random( 2 ) )
+	if ( Random( 2, RANDOM_STRATEGIC ) )
 	{
 		// move the father to the other sector, provided neither are loaded
 		if ( ! ( ( gWorldSectorX == 13) && ( ( gWorldSectorY == MAP_ROW_C) || gWorldSectorY == MAP_ROW_D ) && ( gbWorldSectorZ == 0 ) ) )
@@ -750,7 +750,7 @@ void HandleEarlyMorningEvents( void )
 	if( gMercProfiles[ TONY ].ubLastDateSpokenTo > 0 && !( gWorldSectorX == 5 && gWorldSectorY == MAP_ROW_C && gbWorldSectorZ == 0 ) )
 	{
 		// San Mona C5 is not loaded so make Tony possibly not available
-		if (Random( 4 ))
+		if (Random( 4, RANDOM_STRATEGIC ))
 		{
 			// Tony IS available
 			SetFactFalse( FACT_TONY_NOT_AVAILABLE );
@@ -197,7 +197,7 @@ void MercDailyUpdate()
 			if (SoldierHasWorseEquipmentThanUsedTo(s))
 			{
 				// Randomly anytime between 6:00, and 10:00
-				AddSameDayStrategicEvent(EVENT_MERC_COMPLAIN_EQUIPMENT, 360 + Random(1080), s->ubProfile);
+				AddSameDayStrategicEvent(EVENT_MERC_COMPLAIN_EQUIPMENT, 360 + Random(1080, RANDOM_STRATEGIC), s->ubProfile);
 			}
 
 			// increment days served by this grunt
@@ -353,10 +353,10 @@ void MercDailyUpdate()
 					}
 				}
 
-				if (Random(100) < uiChance)
+				if (Random(100, RANDOM_STRATEGIC) < uiChance)
 				{
 					p.bMercStatus = MERC_WORKING_ELSEWHERE;
-					p.uiDayBecomesAvailable = 1 + Random(6 + (p.bExpLevel / 2)); // 1-(6 to 11) days
+					p.uiDayBecomesAvailable = 1 + Random(6 + (p.bExpLevel / 2), RANDOM_STRATEGIC); // 1-(6 to 11) days
 				}
 			}
 		}
@@ -108,7 +108,7 @@ void InitializeMines( void )
 		// pick a producing mine at random and increase its production
 		do
 		{
-			ubMineIndex = ( UINT8 ) Random(minesData.size());
+			ubMineIndex = ( UINT8 ) Random(minesData.size(), RANDOM_STRATEGIC);
 		} while (gMineStatus[ubMineIndex].fEmpty);
 
 		// increase mine production by 20% of the base (minimum) rate
@@ -121,7 +121,7 @@ void InitializeMines( void )
 	// choose which mine will run out of production.  This will never be the Alma mine or an empty mine (San Mona)...
 	do
 	{
-		ubDepletedMineIndex = ( UINT8 ) Random(minesData.size());
+		ubDepletedMineIndex = ( UINT8 ) Random(minesData.size(), RANDOM_STRATEGIC);
 		// Try next one if this mine can't run out for quest-related reasons (see Ian)
 	} while (gMineStatus[ubDepletedMineIndex].fEmpty || minesData[ubDepletedMineIndex]->noDepletion);
 
@@ -91,6 +91,16 @@ static GROUP* gpGroupPrompting = NULL;
 
 static UINT32 uniqueIDMask[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
 
+/* Registry of the groups in gpGroupList, indexed by group ID. Besides the ID
+ * lookup it files every group under its current sector, so per sector queries
+ * don't have to walk the whole list. The sector buckets are kept in list
+ * order, which is the order of the registration sequence numbers. */
+static GROUP*              gGroupByID[256];
+static UINT32              guiGroupSequence[256];
+static INT16               gsGroupIndexedSector[256]; // -1 if not filed
+static UINT32              guiNextGroupSequence = 0;
+static std::vector<GROUP*> gGroupsInSector[256];
+
 
 static GROUP* gpInitPrebattleGroup = NULL;
 
@@ -101,6 +111,73 @@ static BOOLEAN gfWaitingForInput = FALSE;
 static UINT8 AddGroupToList(GROUP* pGroup);
 
 
+static INT16 GroupSectorIndex(GROUP const& g)
+{
+	if (g.ubSectorX < 1 || 16 < g.ubSectorX) return -1;
+	if (g.ubSectorY < 1 || 16 < g.ubSectorY) return -1;
+	return SECTOR(g.ubSectorX, g.ubSectorY);
+}
+
+
+static void FileGroupInSector(GROUP& g)
+{
+	INT16 const sector = GroupSectorIndex(g);
+	gsGroupIndexedSector[g.ubGroupID] = sector;
+	if (sector < 0) return;
+
+	std::vector<GROUP*>& bucket = gGroupsInSector[sector];
+	UINT32 const         seq    = guiGroupSequence[g.ubGroupID];
+	auto const pos = std::find_if(bucket.begin(), bucket.end(),
+		[seq](GROUP const* other) { return guiGroupSequence[other->ubGroupID] > seq; });
+	bucket.insert(pos, &g);
+}
+
+
+static void UnfileGroup(GROUP const& g)
+{
+	INT16 const sector = gsGroupIndexedSector[g.ubGroupID];
+	if (sector < 0) return;
+
+	std::vector<GROUP*>& bucket = gGroupsInSector[sector];
+	bucket.erase(std::find(bucket.begin(), bucket.end(), &g));
+	gsGroupIndexedSector[g.ubGroupID] = -1;
+}
+
+
+static void RegisterGroup(GROUP& g)
+{
+	Assert(!gGroupByID[g.ubGroupID]);
+	gGroupByID[g.ubGroupID]       = &g;
+	guiGroupSequence[g.ubGroupID] = guiNextGroupSequence++;
+	FileGroupInSector(g);
+}
+
+
+static void UnregisterGroup(GROUP const& g)
+{
+	if (gGroupByID[g.ubGroupID] != &g) return;
+	UnfileGroup(g);
+	gGroupByID[g.ubGroupID] = NULL;
+}
+
+
+void UpdateGroupSectorIndex(GROUP& g)
+{
+	if (gGroupByID[g.ubGroupID] != &g) return; // not in the list
+	if (gsGroupIndexedSector[g.ubGroupID] == GroupSectorIndex(g)) return;
+	UnfileGroup(g);
+	FileGroupInSector(g);
+}
+
+
+std::vector<GROUP*> const& GetGroupsInSector(UINT8 const x, UINT8 const y)
+{
+	static std::vector<GROUP*> const no_groups;
+	if (x < 1 || 16 < x || y < 1 || 16 < y) return no_groups;
+	return gGroupsInSector[SECTOR(x, y)];
+}
+
+
 //Player grouping functions
 //.........................
 //Creates a new player group, returning the unique ID of that group.  This is the first
@@ -173,6 +250,7 @@ void AddPlayerToGroup(GROUP& g, SOLDIERTYPE& s)
 		g.ubSectorX   = s.sSectorX;
 		g.ubSectorY   = s.sSectorY;
 		g.ubSectorZ   = s.bSectorZ;
+		UpdateGroupSectorIndex(g);
 	}
 	else
 	{
@@ -261,6 +339,7 @@ BOOLEAN GroupReversingDirectionsBetweenSectors( GROUP *pGroup, UINT8 ubSectorX,
 	pGroup->ubNextY = pGroup->ubSectorY;
 	pGroup->ubSectorX = pGroup->ubPrevX;
 	pGroup->ubSectorY = pGroup->ubPrevY;
+	UpdateGroupSectorIndex(*pGroup);
 
 	if( pGroup->fPlayer )
 	{
@@ -512,13 +591,9 @@ GROUP* CreateNewEnemyGroupDepartingFromSector( UINT32 uiSector, UINT8 ubNumAdmin
 
 //INTERNAL LIST MANIPULATION FUNCTIONS
 
-//When adding any new group to the list, this is what must be done:
-//1)  Find the first unused ID (unique)
-//2)  Assign that ID to the new group
-//3)  Insert the group at the end of the list.
-static UINT8 AddGroupToList(GROUP* const g)
+// Finds the first unused ID and marks it as used
+static UINT8 ClaimUniqueGroupID()
 {
-	// First, find a unique ID
 	for (UINT8 id = 0; ++id;)
 	{
 		const UINT32 index = id / 32;
@@ -526,21 +601,32 @@ static UINT8 AddGroupToList(GROUP* const g)
 		const UINT32 mask  = 1 << bit;
 		if (uniqueIDMask[index] & mask) continue;
 
-		// Found a free id
-		g->ubGroupID         = id;
 		uniqueIDMask[index] |= mask;
-
-		// Append group to list
-		GROUP** i = &gpGroupList;
-		while (*i != NULL) i = &(*i)->next;
-		*i = g;
-
 		return id;
 	}
 	throw std::runtime_error("Out of group IDs");
 }
 
 
+//When adding any new group to the list, this is what must be done:
+//1)  Find the first unused ID (unique)
+//2)  Assign that ID to the new group
+//3)  Insert the group at the end of the list.
+static UINT8 AddGroupToList(GROUP* const g)
+{
+	const UINT8 id = ClaimUniqueGroupID();
+	g->ubGroupID = id;
+
+	// Append group to list
+	GROUP** i = &gpGroupList;
+	while (*i != NULL) i = &(*i)->next;
+	*i = g;
+	RegisterGroup(*g);
+
+	return id;
+}
+
+
 /* Destroys the waypoint list, detaches group from list, then deallocated the
  * memory for the group */
 static void RemoveGroupFromList(GROUP* const g)
@@ -551,6 +637,7 @@ static void RemoveGroupFromList(GROUP* const g)
 
 		// Found the group, so now remove it.
 		*i = g->next;
+		UnregisterGroup(*g);
 
 		// Clear the unique group ID
 		const UINT32 index = g->ubGroupID / 32;
@@ -568,12 +655,7 @@ static void RemoveGroupFromList(GROUP* const g)
 
 GROUP* GetGroup( UINT8 ubGroupID )
 {
-	FOR_EACH_GROUP(curr)
-	{
-		if( curr->ubGroupID == ubGroupID )
-			return curr;
-	}
-	return NULL;
+	return gGroupByID[ubGroupID];
 }
 
 
@@ -663,7 +745,7 @@ static void PrepareForPreBattleInterface(GROUP* pPlayerDialogGroup, GROUP* pInit
 				gfCantRetreatInPBI = TRUE;
 			}
 
-			SOLDIERTYPE* const chosen = mercs_in_group[Random(ubNumMercs)];
+			SOLDIERTYPE* const chosen = mercs_in_group[Random(ubNumMercs, RANDOM_STRATEGIC)];
 			gpTacticalTraversalChosenSoldier = chosen;
 
 			if( !gfTacticalTraversal )
@@ -690,7 +772,7 @@ static void PrepareForPreBattleInterface(GROUP* pPlayerDialogGroup, GROUP* pInit
 			gfCantRetreatInPBI = TRUE;
 		}
 
-		SOLDIERTYPE* const chosen = mercs_in_group[Random(ubNumMercs)];
+		SOLDIERTYPE* const chosen = mercs_in_group[Random(ubNumMercs, RANDOM_STRATEGIC)];
 		HandleImportantPBIQuote(*chosen, pInitiatingBattleGroup);
 		InterruptTime();
 		PauseGame();
@@ -1056,7 +1138,7 @@ static void AddCorpsesToBloodcatLair(INT16 sSectorX, INT16 sSectorY)
 	Corpse.PantsPal = "GREENPANTS";
 
 
-	Corpse.bDirection = (INT8)Random(8);
+	Corpse.bDirection = (INT8)Random(8, RANDOM_STRATEGIC);
 
 	// Set time of death
 	// Make sure they will be rotting!
@@ -1152,7 +1234,7 @@ void GroupArrivedAtSector(GROUP& g, BOOLEAN const check_for_battle, BOOLEAN cons
 		}
 		else
 		{
-			g.uiArrivalTime += Random(3) + 3;
+			g.uiArrivalTime += Random(3, RANDOM_STRATEGIC) + 3;
 		}
 
 		if (!AddStrategicEvent(EVENT_GROUP_ARRIVAL, g.uiArrivalTime, g.ubGroupID))
@@ -1172,6 +1254,7 @@ void GroupArrivedAtSector(GROUP& g, BOOLEAN const check_for_battle, BOOLEAN cons
 	g.ubSectorY = y;
 	g.ubNextX   = 0;
 	g.ubNextY   = 0;
+	UpdateGroupSectorIndex(g);
 
 	if (g.fPlayer)
 	{
@@ -1548,6 +1631,7 @@ static void PrepareGroupsForSimultaneousArrival()
 	first_group.ubNextY         = first_group.ubSectorY;
 	first_group.ubSectorX       = first_group.ubPrevX;
 	first_group.ubSectorY       = first_group.ubPrevY;
+	UpdateGroupSectorIndex(first_group);
 	first_group.setArrivalTime(latest_arrival_time);
 	first_group.fBetweenSectors = TRUE;
 
@@ -1663,7 +1747,7 @@ static void DelayEnemyGroupsIfPathsCross(GROUP& player_group)
 		/* NOTE: This can cause the arrival time to be > GetWorldTotalMin() +
 		 * TraverseTime, so keep that in mind if you have any code that uses these 3
 		 * values to figure out how far along its route a group is! */
-		g.setArrivalTime(player_group.uiArrivalTime + 1 + Random(10));
+		g.setArrivalTime(player_group.uiArrivalTime + 1 + Random(10, RANDOM_STRATEGIC));
 		if (!AddStrategicEvent(EVENT_GROUP_ARRIVAL, g.uiArrivalTime, g.ubGroupID))
 			SLOGA("Failed to add movement event.");
 	}
@@ -1737,10 +1821,10 @@ static void InitiateGroupMovementToNextSector(GROUP* pGroup)
 			//they are going to be sleeping for.
 			if( GetWorldHour() >= 21 || GetWorldHour() <= 4 )
 			{ //It is definitely night time.
-				if( Chance( 67 ) )
+				if( Chance( 67, RANDOM_STRATEGIC ) )
 				{ //2 in 3 chance of going to sleep.
 					pGroup->uiTraverseTime = GetSectorMvtTimeForGroup( ubSector, ubDirection, pGroup );
-					uiSleepMinutes = 360 + Random( 121 ); //6-8 hours sleep
+					uiSleepMinutes = 360 + Random( 121, RANDOM_STRATEGIC ); //6-8 hours sleep
 					fCalcRegularTime = FALSE;
 				}
 			}
@@ -1790,7 +1874,7 @@ static void InitiateGroupMovementToNextSector(GROUP* pGroup)
 	if( gfRandomizingPatrolGroup )
 	{ //We're initializing the patrol group, so randomize the enemy groups to have extremely quick and varying
 		//arrival times so that their initial positions aren't easily determined.
-		pGroup->uiTraverseTime = 1 + Random( pGroup->uiTraverseTime - 1 );
+		pGroup->uiTraverseTime = 1 + Random( pGroup->uiTraverseTime - 1, RANDOM_STRATEGIC );
 		pGroup->setArrivalTime(GetWorldTotalMin() + pGroup->uiTraverseTime);
 	}
 
@@ -1930,6 +2014,7 @@ void SetGroupSectorValue(INT16 const x, INT16 const y, INT16 const z, GROUP& g)
 	g.ubNextY         = y;
 	g.ubSectorZ       = z;
 	g.fBetweenSectors = FALSE;
+	UpdateGroupSectorIndex(g);
 
 	// Set next sectors same as current
 	g.ubOriginalSector = SECTOR(x, y);
@@ -1960,6 +2045,7 @@ void SetEnemyGroupSector(GROUP& g, UINT8 const sector_id)
 	g.ubSectorY = g.ubNextY = SECTORY(sector_id);
 	g.ubSectorZ = 0;
 	g.fBetweenSectors = FALSE;
+	UpdateGroupSectorIndex(g);
 }
 
 
@@ -2250,10 +2336,10 @@ INT32 GetSectorMvtTimeForGroup(UINT8 const ubSector, UINT8 const direction, GROU
 UINT8 PlayerMercsInSector(UINT8 const x, UINT8 const y, UINT8 const z)
 {
 	UINT8 n_mercs = 0;
-	CFOR_EACH_PLAYER_GROUP(g)
+	CFOR_EACH_PLAYER_GROUP_IN_SECTOR(g, x, y)
 	{
 		if (g->fBetweenSectors) continue;
-		if (g->ubSectorX != x || g->ubSectorY != y || g->ubSectorZ != z) continue;
+		if (g->ubSectorZ != z)  continue;
 		/* We have a group, make sure that it isn't a group containing only dead
 		 * members. */
 		CFOR_EACH_PLAYER_IN_GROUP(p, g)
@@ -2272,10 +2358,10 @@ UINT8 PlayerMercsInSector(UINT8 const x, UINT8 const y, UINT8 const z)
 UINT8 PlayerGroupsInSector(UINT8 const x, UINT8 const y, UINT8 const z)
 {
 	UINT8 n_groups = 0;
-	CFOR_EACH_PLAYER_GROUP(g)
+	CFOR_EACH_PLAYER_GROUP_IN_SECTOR(g, x, y)
 	{
 		if (g->fBetweenSectors) continue;
-		if (g->ubSectorX != x || g->ubSectorY != y || g->ubSectorZ != z) continue;
+		if (g->ubSectorZ != z)  continue;
 		/* We have a group, make sure that it isn't a group containing only dead
 		 * members. */
 		CFOR_EACH_PLAYER_IN_GROUP(p, g)
@@ -2438,6 +2524,7 @@ void MoveAllGroupsInCurrentSectorToSector(UINT8 const x, UINT8 const y, UINT8 co
 		g->ubSectorX = x;
 		g->ubSectorY = y;
 		g->ubSectorZ = z;
+		UpdateGroupSectorIndex(*g);
 		CFOR_EACH_PLAYER_IN_GROUP(p, g)
 		{
 			p->pSoldier->sSectorX        = x;
@@ -2592,7 +2679,28 @@ void LoadStrategicMovementGroupsFromSavedGameFile(HWFILE const f)
 		const UINT32 index = g->ubGroupID / 32;
 		const UINT32 bit   = g->ubGroupID % 32;
 		const UINT32 mask  = 1 << bit;
-		uniqueIDMask[index] += mask;
+		uniqueIDMask[index] |= mask;
+	}
+
+	/* The same bug could give two groups the same ID. The first one keeps it, as
+	 * GetGroup() found that one first when it scanned the list, and the others
+	 * get unused IDs, so every group is registered and filed under its sector. */
+	FOR_EACH_GROUP(g)
+	{
+		if (gGroupByID[g->ubGroupID])
+		{
+			const UINT8 id = ClaimUniqueGroupID();
+			SLOGW("strategic group ID %d is used more than once, renumbering to %d", g->ubGroupID, id);
+			g->ubGroupID = id;
+			if (g->fPlayer)
+			{
+				for (PLAYERGROUP* p = g->pPlayerList; p; p = p->next)
+				{
+					if (p->pSoldier) p->pSoldier->ubGroupID = id;
+				}
+			}
+		}
+		RegisterGroup(*g);
 	}
 
 	// Skip over saved unique id mask
@@ -2861,14 +2969,9 @@ void RetreatGroupToPreviousSector(GROUP& g)
 
 GROUP* FindEnemyMovementGroupInSector(const UINT8 ubSectorX, const UINT8 ubSectorY)
 {
-	FOR_EACH_ENEMY_GROUP(g)
+	FOR_EACH_ENEMY_GROUP_IN_SECTOR(g, ubSectorX, ubSectorY)
 	{
-		if (g->ubSectorX == ubSectorX &&
-				g->ubSectorY == ubSectorY &&
-				g->ubSectorZ == 0)
-		{
-			return g;
-		}
+		if (g->ubSectorZ == 0) return g;
 	}
 	return NULL;
 }
@@ -2876,14 +2979,12 @@ GROUP* FindEnemyMovementGroupInSector(const UINT8 ubSectorX, const UINT8 ubSecto
 
 GROUP* FindPlayerMovementGroupInSector(const UINT8 x, const UINT8 y)
 {
-	FOR_EACH_PLAYER_GROUP(i)
+	FOR_EACH_PLAYER_GROUP_IN_SECTOR(i, x, y)
 	{
 		GROUP& g = *i;
 		// NOTE: These checks must always match the INVOLVED group checks in PBI!!!
 		if (g.ubGroupSize != 0 &&
 			!g.fBetweenSectors &&
-			g.ubSectorX   == x &&
-			g.ubSectorY   == y &&
 			g.ubSectorZ   == 0 &&
 			!GroupHasInTransitDeadOrPOWMercs(g) &&
 			(!IsGroupTheHelicopterGroup(g) || !fHelicopterIsAirBorne))
@@ -3267,7 +3368,7 @@ void RandomizePatrolGroupLocation( GROUP *pGroup )
 	ubTotalWaypoints = (UINT8)((ubMaxWaypointID) * 2);
 
 	//pick the waypoint they start at
-	ubChosen = (UINT8)Random( ubTotalWaypoints );
+	ubChosen = (UINT8)Random( ubTotalWaypoints, RANDOM_STRATEGIC );
 
 	if( ubChosen >= ubMaxWaypointID )
 	{ //They chose a waypoint going in the reverse direction, so translate it
@@ -3361,7 +3462,7 @@ static BOOLEAN TestForBloodcatAmbush(GROUP const* const pGroup)
 		if( gfAutoAmbush || PreChance( ubChance ) )
 		{
 			//randomly choose from 5-8, 7-10, 9-12 bloodcats based on easy, normal, and hard, respectively
-			bDifficultyMaxCats = (INT8)( Random( 4 ) + gGameOptions.ubDifficultyLevel*2 + 3 );
+			bDifficultyMaxCats = (INT8)( Random( 4, RANDOM_STRATEGIC ) + gGameOptions.ubDifficultyLevel*2 + 3 );
 
 			//maximum of 3 bloodcats or 1 for every 6%, 5%, 4% progress based on easy, normal, and hard, respectively
 			bProgressMaxCats = (INT8)MAX( CurrentPlayerProgressPercentage() / (7 - gGameOptions.ubDifficultyLevel), 3 );
@@ -3504,6 +3605,7 @@ static void CancelEmptyPersistentGroupMovement(GROUP& g)
 	g.ubSectorY       = 0;
 	g.ubNextX         = 0;
 	g.ubNextY         = 0;
+	UpdateGroupSectorIndex(g);
 }
 
 
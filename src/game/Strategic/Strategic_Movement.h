@@ -4,6 +4,8 @@
 #include "Debug.h"
 #include "Types.h"
 
+#include <vector>
+
 struct SOLDIERTYPE;
 
 
@@ -144,6 +146,28 @@ extern GROUP *gpGroupList;
 		if (iter##__next = iter->next, FALSE) {} else                                    \
 
 
+/* The groups whose current sector is x, y (any z), in list order. The vector
+ * is owned by the group registry and changes whenever a group is added,
+ * removed or moved, so don't do that while iterating it. */
+std::vector<GROUP*> const& GetGroupsInSector(UINT8 x, UINT8 y);
+
+#define BASE_FOR_EACH_ENEMY_GROUP_IN_SECTOR(type, iter, x, y) \
+	for (type iter : GetGroupsInSector((x), (y)))              \
+		if (iter->fPlayer) continue; else
+#define FOR_EACH_ENEMY_GROUP_IN_SECTOR(iter, x, y)  BASE_FOR_EACH_ENEMY_GROUP_IN_SECTOR(      GROUP*, iter, x, y)
+#define CFOR_EACH_ENEMY_GROUP_IN_SECTOR(iter, x, y) BASE_FOR_EACH_ENEMY_GROUP_IN_SECTOR(const GROUP*, iter, x, y)
+
+#define BASE_FOR_EACH_PLAYER_GROUP_IN_SECTOR(type, iter, x, y) \
+	for (type iter : GetGroupsInSector((x), (y)))               \
+		if (!iter->fPlayer) continue; else
+#define FOR_EACH_PLAYER_GROUP_IN_SECTOR(iter, x, y)  BASE_FOR_EACH_PLAYER_GROUP_IN_SECTOR(      GROUP*, iter, x, y)
+#define CFOR_EACH_PLAYER_GROUP_IN_SECTOR(iter, x, y) BASE_FOR_EACH_PLAYER_GROUP_IN_SECTOR(const GROUP*, iter, x, y)
+
+/* Must be called after changing ubSectorX or ubSectorY of a group in the list,
+ * so it is filed under its new sector. */
+void UpdateGroupSectorIndex(GROUP&);
+
+
 #define CFOR_EACH_PLAYER_IN_GROUP(iter, group) \
 	for (PLAYERGROUP const* iter = (Assert((group)->fPlayer), (group)->pPlayerList); iter; iter = iter->next)
 
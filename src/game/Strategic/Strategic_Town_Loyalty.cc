@@ -488,7 +488,7 @@ void HandleMurderOfCivilian(const SOLDIERTYPE* const pSoldier)
 		}
 
 		// check whether player is falsely accused
-		if( Random(100) < uiChanceFalseAccusal )
+		if( Random(100, RANDOM_STRATEGIC) < uiChanceFalseAccusal )
 		{
 			// blame player whether or not he did it - set killer team as our team
 			bKillerTeam = OUR_TEAM;
@@ -646,7 +646,7 @@ void RemoveRandomItemsInSector(INT16 const sSectorX, INT16 const sSectorY, INT16
 			if (!wi.fExists)                          continue;
 			if (wi.bVisible != VISIBLE)               continue;
 			if (!(wi.usFlags & WORLD_ITEM_REACHABLE)) continue;
-			if (Random(100) >= ubChance)               continue;
+			if (Random(100, RANDOM_STRATEGIC) >= ubChance)               continue;
 
 			// remove
 			somethingWasStolen = true;
@@ -667,7 +667,7 @@ void RemoveRandomItemsInSector(INT16 const sSectorX, INT16 const sSectorY, INT16
 		{
 			// note, can't do reachable test here because we'd have to do a path call
 			if (wi.bVisible != VISIBLE) continue;
-			if (Random(100) >= ubChance) continue;
+			if (Random(100, RANDOM_STRATEGIC) >= ubChance) continue;
 
 			SLOGD("%s stolen in %s!", ItemNames[wi.o.usItem].c_str(), wSectorName.c_str());
 			RemoveItemFromPool(wi);
@@ -271,7 +271,7 @@ UINT8 CheckOneMilitiaForPromotion(INT16 const x, INT16 const y, UINT8 &current_r
 		case GREEN_MILITIA:
 			// 2 kill points minimum, 25% chance per kill point
 			if (kill_points < 2)           break;
-			if (!Chance(25 * kill_points)) break;
+			if (!Chance(25 * kill_points, RANDOM_STRATEGIC)) break;
 			StrategicPromoteMilitiaInSector(x, y, GREEN_MILITIA, 1);
 			++n_promotions;
 			// Attempt another level up
@@ -280,7 +280,7 @@ UINT8 CheckOneMilitiaForPromotion(INT16 const x, INT16 const y, UINT8 &current_r
 		case REGULAR_MILITIA:
 			// 5 kill points minimum, 10% chance per kill point
 			if (kill_points < 5)           break;
-			if (!Chance(10 * kill_points)) break;
+			if (!Chance(10 * kill_points, RANDOM_STRATEGIC)) break;
 			StrategicPromoteMilitiaInSector(x, y, REGULAR_MILITIA, 1);
 			++n_promotions;
 			break;
@@ -321,7 +321,7 @@ static void HandleMilitiaDefections(INT16 sMapX, INT16 sMapY)
 			}
 
 			// roll the bones; should I stay or should I go now?  (for you music fans out there)
-			if (Random(100) < uiChanceToDefect)
+			if (Random(100, RANDOM_STRATEGIC) < uiChanceToDefect)
 			{
 				//B'bye!  (for you SNL fans out there)
 				StrategicRemoveMilitiaFromSector(sMapX, sMapY, ubRank, 1);
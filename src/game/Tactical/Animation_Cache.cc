@@ -6,6 +6,9 @@
 #include "MemMan.h"
 #include "Overhead.h"
 #include "Types.h"
+
+#include <algorithm>
+#include <chrono>
 #include <climits>
 
 #define EMPTY_CACHE_ENTRY 65000
@@ -61,6 +64,13 @@ void GetCachedAnimationSurface(UINT16 const usSoldierID, AnimationSurfaceCacheTy
 	INT16  sMostHits = INT16_MAX;
 	UINT16 usCurrentAnimSurface;
 
+	// Learn which surfaces follow each other, so the next ones can be prefetched
+	UINT16 const usPreviousAnimSurface = GetMan(usSoldierID).usAnimSurface;
+	if (usPreviousAnimSurface != usSurfaceIndex)
+	{
+		GetAnimSurfaceCache().Transition(usPreviousAnimSurface, usSurfaceIndex);
+	}
+
 	// Check to see if surface exists already
 	for ( cnt = 0; cnt < pAnimCache->ubCacheSize; cnt++ )
 	{
@@ -163,3 +173,153 @@ void UnLoadCachedAnimationSurfaces( UINT16 usSoldierID, AnimationSurfaceCacheTyp
 	}
 
 }
+
+
+static const UINT16 NO_SURFACE = 0xFFFF;
+
+
+AnimSurfaceCache::AnimSurfaceCache(UINT16 const n_surfaces, UINT32 const budget, Decoder decode, Evictor evict) :
+	m_entries(n_surfaces),
+	m_idle_bytes(0),
+	m_budget(budget),
+	m_decode(std::move(decode)),
+	m_evict(std::move(evict)),
+	m_stats(),
+	m_pool(1)
+{
+	for (Entry& e : m_entries)
+	{
+		e.size = 0;
+		e.idle = false;
+		std::fill(std::begin(e.successors), std::end(e.successors), NO_SURFACE);
+	}
+}
+
+
+void AnimSurfaceCache::Hit(UINT16 const surface)
+{
+	++m_stats.uiHits;
+
+	Entry& e = m_entries[surface];
+	if (!e.idle) return;
+	m_idle.erase(e.idle_pos);
+	m_idle_bytes -= e.size;
+	e.idle = false;
+}
+
+
+AutoSGPImage AnimSurfaceCache::Acquire(UINT16 const surface)
+{
+	Entry& e = m_entries[surface];
+	if (e.pending.valid())
+	{
+		std::future<AutoSGPImage> pending = std::move(e.pending);
+		m_pending.erase(std::find(m_pending.begin(), m_pending.end(), surface));
+
+		bool const ready = pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		try
+		{
+			AutoSGPImage image(pending.get());
+			++(ready ? m_stats.uiHits : m_stats.uiStalls);
+			return image;
+		}
+		catch (...)
+		{
+			// Decode again below, so a failure is reported to the caller
+		}
+	}
+
+	++m_stats.uiMisses;
+	return AutoSGPImage(m_decode(surface));
+}
+
+
+void AnimSurfaceCache::Resident(UINT16 const surface, UINT32 const size)
+{
+	m_entries[surface].size = size;
+}
+
+
+void AnimSurfaceCache::Release(UINT16 const surface)
+{
+	Entry& e = m_entries[surface];
+	if (e.size == 0)
+	{
+		// Not loaded through the cache, so there is nothing to account it to
+		m_evict(surface);
+		return;
+	}
+
+	if (e.idle) return;
+	e.idle     = true;
+	e.idle_pos = m_idle.insert(m_idle.end(), surface);
+	m_idle_bytes += e.size;
+	Trim(m_budget);
+}
+
+
+void AnimSurfaceCache::Transition(UINT16 const from, UINT16 const to)
+{
+	if (to >= m_entries.size()) return;
+
+	if (from < m_entries.size())
+	{
+		// Most recent successor first
+		UINT16* const successors = m_entries[from].successors;
+		UINT16* const end        = successors + N_SUCCESSORS;
+		UINT16*       i          = std::find(successors, end, to);
+		if (i == end) --i;
+		std::copy_backward(successors, i, i + 1);
+		successors[0] = to;
+	}
+
+	for (UINT16 const next : m_entries[to].successors)
+	{
+		Prefetch(next);
+	}
+}
+
+
+void AnimSurfaceCache::Flush()
+{
+	Trim(0);
+	for (Entry& e : m_entries) e.size = 0;
+}
+
+
+void AnimSurfaceCache::Prefetch(UINT16 const surface)
+{
+	if (surface >= m_entries.size()) return;
+
+	Entry& e = m_entries[surface];
+	if (e.size != 0 || e.pending.valid()) return;
+
+	if (m_pending.size() == MAX_PENDING)
+	{
+		// Give up on the oldest prefetch, it has not been needed so far
+		m_entries[m_pending.front()].pending = std::future<AutoSGPImage>();
+		m_pending.pop_front();
+	}
+
+	Decoder const& decode = m_decode;
+	e.pending = m_pool.enqueue([decode, surface]() { return AutoSGPImage(decode(surface)); });
+	m_pending.push_back(surface);
+	++m_stats.uiPrefetches;
+}
+
+
+void AnimSurfaceCache::Trim(UINT32 const budget)
+{
+	while (m_idle_bytes > budget)
+	{
+		UINT16 const surface = m_idle.front();
+		m_idle.pop_front();
+
+		Entry& e = m_entries[surface];
+		m_idle_bytes -= e.size;
+		e.size = 0;
+		e.idle = false;
+		++m_stats.uiEvictions;
+		m_evict(surface);
+	}
+}
@@ -1,10 +1,21 @@
 #ifndef __ANIMATION_CACHE_H
 #define __ANIMATION_CACHE_H
 
+#include "HImage.h"
+#include "ThreadPool.h"
 #include "Types.h"
 
+#include <deque>
+#include <functional>
+#include <future>
+#include <list>
+#include <vector>
+
 #define DEFAULT_ANIM_CACHE_SIZE	3
 
+// Byte budget for animation surfaces that are loaded but not used by anybody
+#define DEFAULT_ANIM_SURFACE_BUDGET	(32 * 1024 * 1024)
+
 
 struct AnimationSurfaceCacheType
 {
@@ -18,4 +29,84 @@ void InitAnimationCache(UINT16 usSoldierID, AnimationSurfaceCacheType*);
 void DeleteAnimationCache( UINT16 usSoldierID, AnimationSurfaceCacheType *pAnimCache );
 void UnLoadCachedAnimationSurfaces( UINT16 usSoldierID, AnimationSurfaceCacheType *pAnimCache );
 
+
+/* Process-wide cache of animation surfaces, keyed by surface index.
+ *
+ * The per-soldier caches above only decide which surfaces a soldier holds a
+ * reference to. A surface whose last reference is released stays resident as
+ * idle until the idle surfaces exceed the byte budget; the least recently
+ * released ones are evicted first. Surfaces that usually follow the one a
+ * soldier switches to are decoded ahead on a worker thread. */
+class AnimSurfaceCache
+{
+public:
+	struct Stats
+	{
+		UINT32 uiHits;       // surface was resident or its prefetch was done
+		UINT32 uiMisses;     // surface had to be decoded on the spot
+		UINT32 uiStalls;     // surface was being prefetched and had to be waited for
+		UINT32 uiPrefetches;
+		UINT32 uiEvictions;
+	};
+
+	// Decodes the image of a surface, called on the worker thread
+	typedef std::function<SGPImage*(UINT16 surface)> Decoder;
+	// Frees a resident surface
+	typedef std::function<void(UINT16 surface)> Evictor;
+
+	AnimSurfaceCache(UINT16 n_surfaces, UINT32 budget, Decoder, Evictor);
+
+	// A resident surface is used again
+	void Hit(UINT16 surface);
+
+	/* Returns the decoded image of a surface that is not resident, taking it
+	 * from a prefetch if there is one. */
+	AutoSGPImage Acquire(UINT16 surface);
+
+	// The surface is resident now and takes up size bytes
+	void Resident(UINT16 surface, UINT32 size);
+
+	// The last reference to a resident surface was released
+	void Release(UINT16 surface);
+
+	// A soldier switched from one surface to another
+	void Transition(UINT16 from, UINT16 to);
+
+	// Evicts all idle surfaces and forgets about the others
+	void Flush();
+
+	Stats const& GetStats() const { return m_stats; }
+	void ResetStats() { m_stats = Stats{}; }
+
+	UINT32 IdleBytes() const { return m_idle_bytes; }
+
+private:
+	void Prefetch(UINT16 surface);
+	void Trim(UINT32 budget);
+
+	// Number of successors remembered per surface
+	static const size_t N_SUCCESSORS = 2;
+	// Limit on the prefetched images that have not been taken yet
+	static const size_t MAX_PENDING  = 4;
+
+	struct Entry
+	{
+		UINT32                      size; // 0 if not resident
+		bool                        idle;
+		std::list<UINT16>::iterator idle_pos;
+		std::future<AutoSGPImage>   pending;
+		UINT16                      successors[N_SUCCESSORS];
+	};
+
+	std::vector<Entry> m_entries;
+	std::list<UINT16>  m_idle; // least recently released first
+	UINT32             m_idle_bytes;
+	UINT32             m_budget;
+	std::deque<UINT16> m_pending; // oldest prefetch first
+	Decoder            m_decode;
+	Evictor            m_evict;
+	Stats              m_stats;
+	ThreadPool         m_pool; // last, so it is stopped before the entries go
+};
+
 #endif
@@ -0,0 +1,122 @@
+#include "gtest/gtest.h"
+
+#include "Animation_Cache.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+
+namespace
+{
+	struct FakeSurfaces
+	{
+		std::atomic<UINT32> decoded{0};
+		std::vector<UINT16> evicted;
+
+		AnimSurfaceCache::Decoder Decoder()
+		{
+			return [this](UINT16) { ++decoded; return new SGPImage(1, 1, 8); };
+		}
+
+		AnimSurfaceCache::Evictor Evictor()
+		{
+			return [this](UINT16 const s) { evicted.push_back(s); };
+		}
+	};
+}
+
+
+TEST(AnimSurfaceCacheTest, hitsAndMisses)
+{
+	FakeSurfaces f;
+	AnimSurfaceCache cache(8, 100, f.Decoder(), f.Evictor());
+
+	EXPECT_NE(cache.Acquire(1), nullptr);
+	cache.Resident(1, 10);
+	cache.Hit(1);
+
+	AnimSurfaceCache::Stats const& stats = cache.GetStats();
+	EXPECT_EQ(stats.uiMisses, 1u);
+	EXPECT_EQ(stats.uiHits, 1u);
+	EXPECT_EQ(stats.uiStalls, 0u);
+	EXPECT_EQ(f.decoded, 1u);
+}
+
+
+TEST(AnimSurfaceCacheTest, idleSurfacesStayWithinBudget)
+{
+	FakeSurfaces f;
+	AnimSurfaceCache cache(8, 100, f.Decoder(), f.Evictor());
+
+	for (UINT16 s = 0; s < 3; ++s)
+	{
+		cache.Acquire(s);
+		cache.Resident(s, 40);
+	}
+
+	// A released surface stays loaded while it fits
+	cache.Release(0);
+	cache.Release(1);
+	EXPECT_TRUE(f.evicted.empty());
+	EXPECT_EQ(cache.IdleBytes(), 80u);
+
+	// Using an idle surface again takes it off the idle list
+	cache.Hit(0);
+	EXPECT_EQ(cache.IdleBytes(), 40u);
+
+	// The least recently released surface goes first
+	cache.Release(2);
+	cache.Release(0);
+	ASSERT_EQ(f.evicted.size(), 1u);
+	EXPECT_EQ(f.evicted[0], 1);
+	EXPECT_EQ(cache.IdleBytes(), 80u);
+	EXPECT_EQ(cache.GetStats().uiEvictions, 1u);
+
+	cache.Flush();
+	EXPECT_EQ(f.evicted.size(), 3u);
+	EXPECT_EQ(cache.IdleBytes(), 0u);
+}
+
+
+TEST(AnimSurfaceCacheTest, prefetchesLearnedSuccessors)
+{
+	FakeSurfaces f;
+	AnimSurfaceCache cache(8, 100, f.Decoder(), f.Evictor());
+
+	// Nothing is known about surface 1 yet
+	cache.Transition(0, 1);
+	EXPECT_EQ(cache.GetStats().uiPrefetches, 0u);
+
+	// Switching to 0 again predicts 1
+	cache.Transition(2, 0);
+	EXPECT_EQ(cache.GetStats().uiPrefetches, 1u);
+
+	EXPECT_NE(cache.Acquire(1), nullptr);
+	AnimSurfaceCache::Stats const& stats = cache.GetStats();
+	EXPECT_EQ(stats.uiHits + stats.uiStalls, 1u);
+	EXPECT_EQ(stats.uiMisses, 0u);
+	EXPECT_EQ(f.decoded, 1u);
+}
+
+
+TEST(AnimSurfaceCacheTest, waitingForAPrefetchIsAStall)
+{
+	std::atomic<bool> go{false};
+	AnimSurfaceCache cache(8, 100,
+		[&go](UINT16) { while (!go) std::this_thread::yield(); return new SGPImage(1, 1, 8); },
+		[](UINT16) {});
+
+	cache.Transition(0, 1);
+	cache.Transition(2, 0);
+
+	std::thread release([&go]() {
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		go = true;
+	});
+	EXPECT_NE(cache.Acquire(1), nullptr);
+	release.join();
+
+	EXPECT_EQ(cache.GetStats().uiStalls, 1u);
+	EXPECT_EQ(cache.GetStats().uiHits, 0u);
+}
@@ -5,6 +5,7 @@
 #include "VObject.h"
 #include "WCheck.h"
 #include "Debug.h"
+#include "Animation_Cache.h"
 #include "Animation_Data.h"
 #include "Animation_Control.h"
 #include "Soldier_Control.h"
@@ -567,6 +568,7 @@ static void DeleteAnimationProfiles(void);
 
 void DeInitAnimationSystem()
 {
+	GetAnimSurfaceCache().Flush();
 	FOR_EACH(AnimationSurfaceType, i, gAnimSurfaceDatabase)
 	{
 		SGPVObject*& vo = i->hVideoObject;
@@ -635,6 +637,29 @@ STRUCTURE_FILE_REF* GetAnimationStructureRef(const SOLDIERTYPE* const s, const U
 }
 
 
+static SGPImage* DecodeAnimationSurface(UINT16 const usSurfaceIndex)
+{
+	return CreateImage(gAnimSurfaceDatabase[usSurfaceIndex].Filename, IMAGE_ALLDATA);
+}
+
+
+static void EvictAnimationSurface(UINT16 const usSurfaceIndex)
+{
+	SLOGD("Surface Database: Unloading Surface: %d", usSurfaceIndex);
+	SGPVObject*& vo = gAnimSurfaceDatabase[usSurfaceIndex].hVideoObject;
+	CHECKV(vo != NULL);
+	DeleteVideoObject(vo);
+	vo = NULL;
+}
+
+
+AnimSurfaceCache& GetAnimSurfaceCache()
+{
+	static AnimSurfaceCache cache(NUMANIMATIONSURFACETYPES, DEFAULT_ANIM_SURFACE_BUDGET, DecodeAnimationSurface, EvictAnimationSurface);
+	return cache;
+}
+
+
 // Surface mamagement functions
 void LoadAnimationSurface(UINT16 const usSoldierID, UINT16 const usSurfaceIndex, UINT16 const usAnimState)
 {
@@ -650,6 +675,7 @@ void LoadAnimationSurface(UINT16 const usSoldierID, UINT16 const usSurfaceIndex,
 	{
 		// just increment usage counter ( below )
 		SLOGD("Surface Database: Hit %d", usSurfaceIndex);
+		GetAnimSurfaceCache().Hit(usSurfaceIndex);
 	}
 	else
 	{
@@ -658,7 +684,7 @@ void LoadAnimationSurface(UINT16 const usSoldierID, UINT16 const usSurfaceIndex,
 			// Load into memory
 			SLOGD("Surface Database: Loading %d", usSurfaceIndex);
 
-			AutoSGPImage   hImage(CreateImage(a->Filename, IMAGE_ALLDATA));
+			AutoSGPImage   hImage(GetAnimSurfaceCache().Acquire(usSurfaceIndex));
 			AutoSGPVObject hVObject(AddVideoObjectFromHImage(hImage.get()));
 
 			// Get aux data
@@ -690,6 +716,7 @@ void LoadAnimationSurface(UINT16 const usSoldierID, UINT16 const usSurfaceIndex,
 
 			// Set video object index
 			a->hVideoObject = hVObject.release();
+			GetAnimSurfaceCache().Resident(usSurfaceIndex, hImage->uiSizePixData + hImage->usNumberOfObjects * sizeof(ETRLEObject));
 
 			// Determine if we have a problem with #frames + directions ( ie mismatch )
 			if (a->uiNumDirections * a->uiNumFramesPerDir != a->hVideoObject->SubregionCount())
@@ -739,14 +766,10 @@ void UnLoadAnimationSurface(const UINT16 usSoldierID, const UINT16 usSurfaceInde
 	Assert(*use_count >= 0);
 	if (*use_count < 0) *use_count = 0;
 
-	// Delete if count reched zero
+	// Hand it to the cache if count reched zero, it is deleted once the budget needs room
 	if (*use_count == 0)
 	{
-		SLOGD("Surface Database: Unloading Surface: %d", usSurfaceIndex);
-		SGPVObject** const vo = &a->hVideoObject;
-		CHECKV(*vo != NULL);
-		DeleteVideoObject(*vo);
-		*vo = NULL;
+		GetAnimSurfaceCache().Release(usSurfaceIndex);
 	}
 }
 
@@ -830,6 +853,8 @@ void ZeroAnimSurfaceCounts( )
 {
 	INT32 cnt;
 
+	GetAnimSurfaceCache().Flush();
+
 	for ( cnt = 0; cnt < NUMANIMATIONSURFACETYPES; cnt++ )
 	{
 		gAnimSurfaceDatabase[ cnt ].bUsageCount   = 0;
@@ -536,6 +536,10 @@ void LoadAnimationSurface(UINT16 usSoldierID, UINT16 usSurfaceIndex, UINT16 usAn
 void UnLoadAnimationSurface(UINT16 usSoldierID, UINT16 usSurfaceIndex);
 void ClearAnimationSurfacesUsageHistory( UINT16 usSoldierID );
 
+// The process-wide cache that animation surfaces are loaded through
+class AnimSurfaceCache;
+AnimSurfaceCache& GetAnimSurfaceCache();
+
 
 STRUCTURE_FILE_REF* GetAnimationStructureRef(const SOLDIERTYPE* s, UINT16 usSurfaceIndex, UINT16 usAnimState);
 
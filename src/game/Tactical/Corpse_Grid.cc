@@ -0,0 +1,44 @@
+#include "Corpse_Grid.h"
+
+#include <algorithm>
+#include <iterator>
+
+
+void CorpseGrid::GetBucket(INT16 const sGridNo, INT32* const col, INT32* const row)
+{
+	*col = MIN(MAX(sGridNo % WORLD_COLS, 0), WORLD_COLS - 1) / CORPSE_BUCKET_SIZE;
+	*row = MIN(MAX(sGridNo / WORLD_COLS, 0), WORLD_ROWS - 1) / CORPSE_BUCKET_SIZE;
+}
+
+
+void CorpseGrid::Add(UINT8 const id, INT16 const sGridNo)
+{
+	INT32 col;
+	INT32 row;
+	GetBucket(sGridNo, &col, &row);
+	m_gridno[id] = sGridNo;
+	m_next[id]   = m_head[row][col];
+	m_head[row][col] = id + 1;
+}
+
+
+void CorpseGrid::Remove(UINT8 const id)
+{
+	INT32 col;
+	INT32 row;
+	GetBucket(m_gridno[id], &col, &row);
+	for (UINT8* i = &m_head[row][col]; *i != 0; i = &m_next[*i - 1])
+	{
+		if (*i != id + 1) continue;
+		*i = m_next[id];
+		break;
+	}
+}
+
+
+void CorpseGrid::Clear()
+{
+	std::fill_n(&m_head[0][0], CORPSE_BUCKET_ROWS * CORPSE_BUCKET_COLS, 0);
+	std::fill(std::begin(m_next), std::end(m_next), 0);
+	std::fill(std::begin(m_gridno), std::end(m_gridno), NOWHERE);
+}
@@ -0,0 +1,113 @@
+#ifndef __CORPSE_GRID_H
+#define __CORPSE_GRID_H
+
+#include "Isometric_Utils.h"
+#include "Types.h"
+#include "WorldDef.h"
+
+// Tiles along each side of a bucket
+#define CORPSE_BUCKET_SIZE	8
+#define CORPSE_BUCKET_COLS	((WORLD_COLS + CORPSE_BUCKET_SIZE - 1) / CORPSE_BUCKET_SIZE)
+#define CORPSE_BUCKET_ROWS	((WORLD_ROWS + CORPSE_BUCKET_SIZE - 1) / CORPSE_BUCKET_SIZE)
+
+// Ids are stored + 1 in a UINT8, so 0 can end a list
+#define CORPSE_GRID_CAPACITY	255
+
+
+/* Corpses indexed by the map area they lie in, so queries about the
+ * surroundings of a gridno only look at the buckets around it. Each bucket is
+ * a list threaded through m_next, holding corpse id + 1, so 0 ends a list and
+ * the zeroed tables are empty. */
+class CorpseGrid
+{
+public:
+	CorpseGrid() { Clear(); }
+
+	void Add(UINT8 id, INT16 sGridNo);
+	void Remove(UINT8 id);
+	void Clear();
+
+	/* Calls visit with the id of each corpse in the buckets that overlap the
+	 * square of tiles within radius of sGridNo */
+	template<typename Visit> void ForEachNear(INT16 sGridNo, INT16 radius, Visit&& visit) const;
+
+	/* Returns the id of the corpse nearest to sGridNo, as
+	 * GetRangeInCellCoordsFromGridNoDiff() measures it, among those accept()
+	 * holds for, or -1 if there is none. Ties go to the lowest id, like a scan
+	 * of the corpse table would do. */
+	template<typename Accept> INT32 FindNearest(INT16 sGridNo, Accept&& accept) const;
+
+private:
+	static void GetBucket(INT16 sGridNo, INT32* col, INT32* row);
+
+	UINT8 m_head[CORPSE_BUCKET_ROWS][CORPSE_BUCKET_COLS];
+	UINT8 m_next[CORPSE_GRID_CAPACITY];
+	INT16 m_gridno[CORPSE_GRID_CAPACITY];
+};
+
+
+template<typename Visit> void CorpseGrid::ForEachNear(INT16 const sGridNo, INT16 const radius, Visit&& visit) const
+{
+	INT32 const x = sGridNo % WORLD_COLS;
+	INT32 const y = sGridNo / WORLD_COLS;
+	INT32 const left   = MAX(x - radius, 0)              / CORPSE_BUCKET_SIZE;
+	INT32 const right  = MIN(x + radius, WORLD_COLS - 1) / CORPSE_BUCKET_SIZE;
+	INT32 const top    = MAX(y - radius, 0)              / CORPSE_BUCKET_SIZE;
+	INT32 const bottom = MIN(y + radius, WORLD_ROWS - 1) / CORPSE_BUCKET_SIZE;
+	for (INT32 row = top; row <= bottom; ++row)
+	{
+		for (INT32 col = left; col <= right; ++col)
+		{
+			for (UINT8 i = m_head[row][col]; i != 0; i = m_next[i - 1])
+			{
+				visit((UINT8)(i - 1));
+			}
+		}
+	}
+}
+
+
+template<typename Accept> INT32 CorpseGrid::FindNearest(INT16 const sGridNo, Accept&& accept) const
+{
+	INT32 uiLowestRange = 999999;
+	INT32 iLowestID     = -1;
+
+	INT32 col;
+	INT32 row;
+	GetBucket(sGridNo, &col, &row);
+
+	// Look at rings of buckets around the one of sGridNo until no corpse in the
+	// next ring can be closer than the nearest found so far
+	for (INT32 ring = 0; ring < MAX(CORPSE_BUCKET_COLS, CORPSE_BUCKET_ROWS); ++ring)
+	{
+		if (ring > 0 && ((ring - 1) * CORPSE_BUCKET_SIZE + 1) * CELL_X_SIZE > uiLowestRange) break;
+
+		for (INT32 r = row - ring; r <= row + ring; ++r)
+		{
+			if (r < 0 || CORPSE_BUCKET_ROWS <= r) continue;
+			for (INT32 c = col - ring; c <= col + ring; ++c)
+			{
+				// Only the outline of the square, the inside was done before
+				if (r != row - ring && r != row + ring && c != col - ring) c = col + ring;
+				if (c < 0 || CORPSE_BUCKET_COLS <= c) continue;
+
+				for (UINT8 i = m_head[r][c]; i != 0; i = m_next[i - 1])
+				{
+					UINT8 const id = i - 1;
+					if (!accept(id)) continue;
+
+					INT32 const uiRange = GetRangeInCellCoordsFromGridNoDiff(sGridNo, m_gridno[id]);
+					if (uiRange < uiLowestRange || (uiRange == uiLowestRange && id < iLowestID))
+					{
+						uiLowestRange = uiRange;
+						iLowestID     = id;
+					}
+				}
+			}
+		}
+	}
+
+	return iLowestID;
+}
+
+#endif
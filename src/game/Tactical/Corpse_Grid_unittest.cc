@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+
+#include "Corpse_Grid.h"
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+	// Corpses of a layout, NOWHERE for an unused id
+	struct Layout
+	{
+		CorpseGrid         grid;
+		std::vector<INT16> gridno;
+
+		Layout(std::mt19937& rng, UINT8 const n) : gridno(n, NOWHERE)
+		{
+			std::uniform_int_distribution<INT32> tile(0, WORLD_MAX - 1);
+			for (UINT8 id = 0; id != n; ++id)
+			{
+				gridno[id] = (INT16)tile(rng);
+				grid.Add(id, gridno[id]);
+			}
+			// Leave some holes, as removed corpses do in the corpse table
+			for (UINT8 id = 0; id < n; id += 7)
+			{
+				grid.Remove(id);
+				gridno[id] = NOWHERE;
+			}
+		}
+
+		static bool Accept(UINT8 const id) { return id % 3 != 1; }
+
+		INT32 FindNearestByScan(INT16 const sGridNo) const
+		{
+			INT32 lowest_range = 999999;
+			INT32 lowest_id    = -1;
+			for (UINT8 id = 0; id != gridno.size(); ++id)
+			{
+				if (gridno[id] == NOWHERE || !Accept(id)) continue;
+				INT32 const range = GetRangeInCellCoordsFromGridNoDiff(sGridNo, gridno[id]);
+				if (range < lowest_range)
+				{
+					lowest_range = range;
+					lowest_id    = id;
+				}
+			}
+			return lowest_id;
+		}
+	};
+}
+
+
+TEST(CorpseGridTest, findNearestMatchesScan)
+{
+	std::mt19937 rng(4711);
+	std::uniform_int_distribution<INT32> tile(0, WORLD_MAX - 1);
+	INT16 const corners[] = { 0, WORLD_COLS - 1, WORLD_MAX - WORLD_COLS, WORLD_MAX - 1 };
+
+	for (UINT8 n : { 0, 1, 2, 5, 20, 100 })
+	{
+		for (int layout = 0; layout != 50; ++layout)
+		{
+			Layout const l(rng, n);
+			std::vector<INT16> queries(std::begin(corners), std::end(corners));
+			for (int i = 0; i != 20; ++i) queries.push_back((INT16)tile(rng));
+			// Right on a corpse and next to one
+			for (INT16 const g : l.gridno)
+			{
+				if (g == NOWHERE) continue;
+				queries.push_back(g);
+				queries.push_back(g + 1 < WORLD_MAX ? g + 1 : g - 1);
+				break;
+			}
+
+			for (INT16 const q : queries)
+			{
+				EXPECT_EQ(l.grid.FindNearest(q, Layout::Accept), l.FindNearestByScan(q))
+					<< n << " corpses, layout " << layout << ", gridno " << q;
+			}
+		}
+	}
+}
+
+
+TEST(CorpseGridTest, forEachNearVisitsCorpsesInRadius)
+{
+	std::mt19937 rng(815);
+	std::uniform_int_distribution<INT32> tile(0, WORLD_MAX - 1);
+	INT16 const radius = 5;
+
+	for (int layout = 0; layout != 50; ++layout)
+	{
+		Layout const l(rng, 100);
+		for (int i = 0; i != 20; ++i)
+		{
+			INT16 const q = (INT16)tile(rng);
+			std::vector<bool> visited(l.gridno.size(), false);
+			l.grid.ForEachNear(q, radius, [&](UINT8 const id) { visited[id] = true; });
+
+			for (UINT8 id = 0; id != l.gridno.size(); ++id)
+			{
+				if (l.gridno[id] == NOWHERE)
+				{
+					EXPECT_FALSE(visited[id]);
+					continue;
+				}
+				INT32 const dx = std::abs(l.gridno[id] % WORLD_COLS - q % WORLD_COLS);
+				INT32 const dy = std::abs(l.gridno[id] / WORLD_COLS - q / WORLD_COLS);
+				if (dx <= radius && dy <= radius)
+				{
+					EXPECT_TRUE(visited[id]) << "gridno " << q << ", corpse " << l.gridno[id];
+				}
+			}
+		}
+	}
+}
@@ -146,10 +146,10 @@ FACETYPE& InitFace(const ProfileID id, SOLDIERTYPE* const s, const UINT32 uiInit
 	f.soldier               = s;
 	f.ubCharacterNum        = id;
 	f.sEyeFrame             = 0;
-	f.uiEyeDelay            = 50 + Random(30);
+	f.uiEyeDelay            = 50 + Random(30, RANDOM_COSMETIC);
 
 	UINT32 blink_freq = p.uiBlinkFrequency;
-	blink_freq = (Random(2) ? blink_freq + Random(2000) : blink_freq - Random(2000));
+	blink_freq = (Random(2, RANDOM_COSMETIC) ? blink_freq + Random(2000, RANDOM_COSMETIC) : blink_freq - Random(2000, RANDOM_COSMETIC));
 	f.uiBlinkFrequency      = blink_freq;
 
 	f.uiExpressionFrequency = p.uiExpressionFrequency;
@@ -457,7 +457,7 @@ static void BlinkAutoFace(FACETYPE& f)
 			GetJA2Clock() - f.uiLastExpression > f.uiExpressionFrequency)
 		{
 			f.uiLastExpression = GetJA2Clock();
-			f.ubExpression     = (Random(2) == 0 ? ANGRY : SURPRISED);
+			f.ubExpression     = (Random(2, RANDOM_COSMETIC) == 0 ? ANGRY : SURPRISED);
 		}
 	}
 
@@ -1061,7 +1061,7 @@ static void NewMouth(FACETYPE& f)
 	UINT16       new_frame;
 	do
 	{
-		new_frame = Random(6);
+		new_frame = Random(6, RANDOM_COSMETIC);
 		if (new_frame > 3) new_frame = 0;
 	}
 	while (new_frame == old_frame);
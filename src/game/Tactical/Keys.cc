@@ -34,6 +34,7 @@
 #include "Game_Clock.h"
 #include "Handle_Doors.h"
 #include "Map_Screen_Interface.h"
+#include "Overhead_Map.h"
 #include "MemMan.h"
 #include "FileMan.h"
 
@@ -1028,8 +1029,9 @@ static void InternalUpdateDoorGraphicFromStatus(DOOR_STATUS const& d, bool const
 	STRUCTURE* const s = FindStructure(d.sGridNo, STRUCTURE_ANYDOOR);
 	if (!s) return;
 
-	STRUCTURE* const base = FindBaseStructure(s);
-	LEVELNODE* const node = FindLevelNodeBasedOnStructure(base);
+	STRUCTURE* const base         = FindBaseStructure(s);
+	LEVELNODE* const node         = FindLevelNodeBasedOnStructure(base);
+	GridNo     const base_grid_no = base->sGridNo;
 
 	// Get status we want to change to
 	bool const want_to_be_open = d.ubFlags & DOOR_PERCEIVED_OPEN;
@@ -1117,12 +1119,11 @@ static void InternalUpdateDoorGraphicFromStatus(DOOR_STATUS const& d, bool const
 		return;
 	}
 
-	{ GridNo const base_grid_no = base->sGridNo;
-		SwapStructureForPartner(base);
-		RecompileLocalMovementCosts(base_grid_no);
-	}
+	SwapStructureForPartner(base);
+	RecompileLocalMovementCosts(base_grid_no);
 
 dirty_end:
+	InvalidateOverheadTile(base_grid_no);
 	if (dirty)
 	{
 		InvalidateWorldRedundency();
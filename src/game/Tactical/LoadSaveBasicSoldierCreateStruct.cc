@@ -5,11 +5,8 @@
 #include "Soldier_Create.h"
 
 
-void ExtractBasicSoldierCreateStructFromFile(HWFILE const f, BASIC_SOLDIERCREATE_STRUCT& b)
+void ExtractBasicSoldierCreateStruct(const BYTE* const data, BASIC_SOLDIERCREATE_STRUCT& b)
 {
-	BYTE data[52];
-	f->read(data, sizeof(data));
-
 	DataReader d{data};
 	EXTR_BOOL(d, b.fDetailedPlacement)
 	EXTR_SKIP(d, 1)
@@ -30,7 +27,15 @@ void ExtractBasicSoldierCreateStructFromFile(HWFILE const f, BASIC_SOLDIERCREATE
 	EXTR_BOOL(d, b.fPriorityExistance)
 	EXTR_BOOL(d, b.fHasKeys)
 	EXTR_SKIP(d, 14)
-	Assert(d.getConsumed() == lengthof(data));
+	Assert(d.getConsumed() == BASIC_SOLDIERCREATE_STRUCT_SIZE);
+}
+
+
+void ExtractBasicSoldierCreateStructFromFile(HWFILE const f, BASIC_SOLDIERCREATE_STRUCT& b)
+{
+	BYTE data[BASIC_SOLDIERCREATE_STRUCT_SIZE];
+	f->read(data, sizeof(data));
+	ExtractBasicSoldierCreateStruct(data, b);
 }
 
 
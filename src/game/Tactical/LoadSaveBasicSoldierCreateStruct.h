@@ -3,7 +3,10 @@
 
 #include "JA2Types.h"
 
+#define BASIC_SOLDIERCREATE_STRUCT_SIZE (52) /**< Size of the structure in a map file */
 
+
+void ExtractBasicSoldierCreateStruct(const BYTE* data, BASIC_SOLDIERCREATE_STRUCT&);
 void ExtractBasicSoldierCreateStructFromFile(HWFILE, BASIC_SOLDIERCREATE_STRUCT&);
 void InjectBasicSoldierCreateStructIntoFile(HWFILE, BASIC_SOLDIERCREATE_STRUCT const&);
 
@@ -38,7 +38,7 @@ UINT16 CalcSoldierCreateCheckSum(const SOLDIERCREATE_STRUCT* const s)
 }
 
 
-static void ExtractSoldierCreate(const BYTE* const data, SOLDIERCREATE_STRUCT* const c, bool stracLinuxFormat)
+void ExtractSoldierCreate(const BYTE* const data, SOLDIERCREATE_STRUCT* const c, bool stracLinuxFormat)
 {
 	DataReader d{data};
 	EXTR_BOOL(d, c->fStatic)
@@ -102,11 +102,11 @@ static void ExtractSoldierCreate(const BYTE* const data, SOLDIERCREATE_STRUCT* c
 	EXTR_SKIP(d, 117)
 	if(stracLinuxFormat)
 	{
-		Assert(d.getConsumed() == 1060);
+		Assert(d.getConsumed() == SOLDIERCREATE_STRUCT_SIZE_STRAC);
 	}
 	else
 	{
-		Assert(d.getConsumed() == 1040);
+		Assert(d.getConsumed() == SOLDIERCREATE_STRUCT_SIZE);
 	}
 }
 
@@ -115,13 +115,13 @@ void ExtractSoldierCreateFromFile(HWFILE const f, SOLDIERCREATE_STRUCT* const c,
 {
 	if(stracLinuxFormat)
 	{
-		BYTE data[1060];
+		BYTE data[SOLDIERCREATE_STRUCT_SIZE_STRAC];
 		f->read(data, sizeof(data));
 		ExtractSoldierCreate(data, c, stracLinuxFormat);
 	}
 	else
 	{
-		BYTE data[1040];
+		BYTE data[SOLDIERCREATE_STRUCT_SIZE];
 		f->read(data, sizeof(data));
 		ExtractSoldierCreate(data, c, stracLinuxFormat);
 	}
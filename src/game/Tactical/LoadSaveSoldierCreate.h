@@ -4,8 +4,14 @@
 #include "Soldier_Create.h"
 
 
+#define SOLDIERCREATE_STRUCT_SIZE       (1040) /**< Size of the structure in vanilla format */
+#define SOLDIERCREATE_STRUCT_SIZE_STRAC (1060) /**< Size of the structure in stracciatella linux format */
+
+
 UINT16 CalcSoldierCreateCheckSum(const SOLDIERCREATE_STRUCT* const s);
 
+void ExtractSoldierCreate(const BYTE* data, SOLDIERCREATE_STRUCT*, bool stracLinuxFormat);
+
 void ExtractSoldierCreateFromFile(HWFILE, SOLDIERCREATE_STRUCT*, bool stracLinuxFormat);
 
 /**
@@ -60,6 +60,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <vector>
 
 #define WE_SEE_WHAT_MILITIA_SEES_AND_VICE_VERSA
 
@@ -1169,7 +1170,12 @@ void InitOpplistForDoorOpening( void )
 }
 
 
-void AllTeamsLookForAll(UINT8 ubAllowInterrupts)
+static bool SightCrossesTiles(SOLDIERTYPE const&, std::vector<INT16> const& tiles);
+
+
+/* Lets all soldiers look for all others. If tiles is given, only soldiers
+ * whose sight lines to someone cross one of the tiles look again. */
+static void TeamsLookForAll(UINT8 const ubAllowInterrupts, std::vector<INT16> const* const tiles)
 {
 	if( ( gTacticalStatus.uiFlags & LOADING_SAVED_GAME ) )
 	{
@@ -1195,6 +1201,7 @@ void AllTeamsLookForAll(UINT8 ubAllowInterrupts)
 	{
 		SOLDIERTYPE& s = **i;
 		if (s.sGridNo == NOWHERE) continue;
+		if (tiles && !SightCrossesTiles(s, *tiles)) continue;
 		if (s.bLife >= OKLIFE) HandleSight(s, SIGHT_LOOK); // no radio or interrupts yet
 	}
 
@@ -1230,6 +1237,54 @@ void AllTeamsLookForAll(UINT8 ubAllowInterrupts)
 }
 
 
+void AllTeamsLookForAll(UINT8 const ubAllowInterrupts)
+{
+	TeamsLookForAll(ubAllowInterrupts, NULL);
+}
+
+
+void AllTeamsLookThroughTiles(UINT8 const ubAllowInterrupts, std::vector<INT16> const& tiles)
+{
+	if (tiles.empty()) return;
+	TeamsLookForAll(ubAllowInterrupts, &tiles);
+}
+
+
+// Whether the tile lies within a tile of the line between a and b
+static bool TileNearLine(INT32 const ax, INT32 const ay, INT32 const bx, INT32 const by, INT16 const tile)
+{
+	INT32 const x = tile % WORLD_COLS;
+	INT32 const y = tile / WORLD_COLS;
+	if (x < MIN(ax, bx) - 1 || MAX(ax, bx) + 1 < x) return false;
+	if (y < MIN(ay, by) - 1 || MAX(ay, by) + 1 < y) return false;
+
+	INT32   const dx    = bx - ax;
+	INT32   const dy    = by - ay;
+	int64_t const cross = dx * (y - ay) - dy * (x - ax);
+	return cross * cross <= dx * dx + dy * dy;
+}
+
+
+static bool SightCrossesTiles(SOLDIERTYPE const& s, std::vector<INT16> const& tiles)
+{
+	INT32 const sx = s.sGridNo % WORLD_COLS;
+	INT32 const sy = s.sGridNo / WORLD_COLS;
+	FOR_EACH_MERC(i)
+	{
+		SOLDIERTYPE const& other = **i;
+		if (&other == &s || other.sGridNo == NOWHERE) continue;
+
+		INT32 const ox = other.sGridNo % WORLD_COLS;
+		INT32 const oy = other.sGridNo / WORLD_COLS;
+		for (INT16 const tile : tiles)
+		{
+			if (TileNearLine(sx, sy, ox, oy, tile)) return true;
+		}
+	}
+	return false;
+}
+
+
 static INT16 ManLooksForMan(SOLDIERTYPE* pSoldier, SOLDIERTYPE* pOpponent, UINT8 ubCaller);
 
 
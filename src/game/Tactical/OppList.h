@@ -3,6 +3,8 @@
 
 #include "Overhead_Types.h"
 
+#include <vector>
+
 
 // For RadioSightings() parameter about
 #define EVERYBODY						NULL
@@ -85,6 +87,9 @@ extern UINT8 gubBestToMakeSightingSize;
 INT16 AdjustMaxSightRangeForEnvEffects(INT8 bLightLevel, INT16 sDistVisible);
 void HandleSight(SOLDIERTYPE&, SightFlags);
 void AllTeamsLookForAll(UINT8 ubAllowInterrupts);
+/* Like AllTeamsLookForAll(), but only soldiers whose sight lines to someone
+ * cross one of the tiles look again, e.g. after smoke changed there */
+void AllTeamsLookThroughTiles(UINT8 ubAllowInterrupts, std::vector<INT16> const& tiles);
 void GloballyDecideWhoSeesWho(void);
 UINT16 GetClosestMerc( UINT16 usSoldierIndex );
 INT16 MaxDistanceVisible( void );
@@ -63,6 +63,7 @@
 #include "NPC.h"
 #include "StrategicMap.h"
 #include "Soldier_Functions.h"
+#include "Soldier_Index.h"
 #include "Auto_Bandage.h"
 #include "Game_Event_Hook.h"
 #include "Explosion_Control.h"
@@ -3266,12 +3267,15 @@ BOOLEAN IsLocationSittableExcludingPeople( INT32 iMapIndex, BOOLEAN fOnRoof )
 
 BOOLEAN TeamMemberNear(INT8 bTeam, INT16 sGridNo, INT32 iRange)
 {
+	SoldierSet const near_by = SoldiersInRadius(sGridNo, (INT16)MIN(iRange, WORLD_COLS));
+	if (near_by.none()) return FALSE;
+
 	CFOR_EACH_IN_TEAM(s, bTeam)
 	{
-		if (s->bInSector &&
+		if (near_by[s->ubID] &&
+			s->bInSector &&
 			s->bLife >= OKLIFE &&
-			!(s->uiStatusFlags & SOLDIER_GASSED) &&
-			PythSpacesAway(s->sGridNo,sGridNo) <= iRange)
+			!(s->uiStatusFlags & SOLDIER_GASSED))
 		{
 			return TRUE;
 		}
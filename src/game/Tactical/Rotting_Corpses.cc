@@ -11,6 +11,8 @@
 #include "Handle_Items.h"
 #include "WorldDef.h"
 #include "Rotting_Corpses.h"
+#include "Corpse_Grid.h"
+#include "Shade_Table_Cache.h"
 #include "Tile_Cache.h"
 #include "Isometric_Utils.h"
 #include "Animation_Control.h"
@@ -36,6 +38,7 @@
 #include "Soldier_Profile.h"
 #include "Soldier_Macros.h"
 #include "Keys.h"
+#include "Logger.h"
 #include "Render_Fun.h"
 #include "Strategic.h"
 #include "QArray.h"
@@ -48,6 +51,11 @@
 #include "GameInstance.h"
 #include "policy/GamePolicy.h"
 
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <utility>
+
 #define CORPSE_WARNING_MAX			5
 #define CORPSE_WARNING_DIST			5
 
@@ -364,6 +372,30 @@ static ROTTING_CORPSE* GetFreeRottingCorpse(void)
 }
 
 
+// Corpses by the map area they lie in
+static CorpseGrid gCorpseGrid;
+static_assert(MAX_ROTTING_CORPSES <= CORPSE_GRID_CAPACITY, "corpse ids do not fit the grid");
+
+// Corpses by profile of the dead and then corpse index
+static std::set<std::pair<UINT8, UINT8>> gCorpsesByProfile;
+
+
+static void IndexCorpse(ROTTING_CORPSE const* const c)
+{
+	UINT8 const id = (UINT8)(c - gRottingCorpse);
+	gCorpseGrid.Add(id, c->def.sGridNo);
+	gCorpsesByProfile.insert(std::make_pair(c->def.ubProfile, id));
+}
+
+
+static void UnindexCorpse(ROTTING_CORPSE const* const c)
+{
+	UINT8 const id = (UINT8)(c - gRottingCorpse);
+	gCorpseGrid.Remove(id);
+	gCorpsesByProfile.erase(std::make_pair(c->def.ubProfile, id));
+}
+
+
 UINT16 GetCorpseStructIndex(const ROTTING_CORPSE_DEFINITION* pCorpseDef, BOOLEAN fForImage)
 {
 	INT8 bDirection;
@@ -498,6 +530,7 @@ try
 
 	c->fActivated = TRUE;
 	ani->v.user.uiData = CORPSE2ID(c);
+	IndexCorpse(c);
 	c->def.ubAIWarningValue = CORPSE_WARNING_MAX;
 
 	SetRenderFlags(RENDER_FLAG_FULL);
@@ -537,18 +570,11 @@ try
 catch (...) { return 0; }
 
 
-static void FreeCorpsePalettes(ROTTING_CORPSE* pCorpse)
+static void FreeCorpsePalettes(ROTTING_CORPSE* const c)
 {
-	INT32 cnt;
-
-	for ( cnt = 0; cnt < NUM_CORPSE_SHADES; cnt++ )
-	{
-		if ( pCorpse->pShades[ cnt ] != NULL )
-		{
-			delete[] pCorpse->pShades[ cnt ];
-			pCorpse->pShades[ cnt ] = NULL;
-		}
-	}
+	ReleaseShadeTables(c->shade_tables);
+	c->shade_tables = NULL;
+	std::fill(std::begin(c->pShades), std::end(c->pShades), nullptr);
 }
 
 
@@ -557,6 +583,10 @@ static void RemoveCorpse(ROTTING_CORPSE* c);
 
 void RemoveCorpses( )
 {
+	ShadeTableCache::Stats const stats = GetShadeTableCacheStats();
+	SLOGD("Shade tables: %u sets for %u users, %u bytes saved by sharing",
+		stats.uiSets, stats.uiReferences, stats.uiBytesSaved);
+
 	FOR_EACH_ROTTING_CORPSE(c) RemoveCorpse(c);
 	giNumRottingCorpse = 0;
 }
@@ -568,6 +598,7 @@ static void RemoveCorpse(ROTTING_CORPSE* const c)
 	Assert(c->fActivated);
 
 	c->fActivated = FALSE;
+	UnindexCorpse(c);
 	DeleteAniTile(c->pAniTile);
 	FreeCorpsePalettes(c);
 }
@@ -580,29 +611,12 @@ static void CreateCorpsePalette(ROTTING_CORPSE* const c)
 		c->def.usFlags & ROTTING_CORPSE_USE_CAMO_PALETTE ? ANIMSDIR "/camo.COL" :
 		GetBodyTypePaletteSubstitution(0, c->def.ubBodyType);
 
-	const SGPPaletteEntry* pal;
-	SGPPaletteEntry        tmp_pal[256];
-	if (!substitution)
-	{
-		// Use palette from HVOBJECT, then use substitution for pants, etc
-		memcpy(tmp_pal, gpTileCache[c->pAniTile->sCachedTileID].pImagery->vo->Palette(), sizeof(tmp_pal));
-		SetPaletteReplacement(tmp_pal, c->def.HeadPal);
-		SetPaletteReplacement(tmp_pal, c->def.VestPal);
-		SetPaletteReplacement(tmp_pal, c->def.PantsPal);
-		SetPaletteReplacement(tmp_pal, c->def.SkinPal);
-		pal = tmp_pal;
-	}
-	else if (substitution[0] != '\0' && CreateSGPPaletteFromCOLFile(tmp_pal, substitution))
-	{
-		pal = tmp_pal;
-	}
-	else
-	{
-		// Use palette from hvobject
-		pal = gpTileCache[c->pAniTile->sCachedTileID].pImagery->vo->Palette();
-	}
-
-	CreateBiasedShadedPalettes(c->pShades, pal);
+	// Corpses of the same body and clothes share their shade tables
+	SGPPaletteEntry const* const base = gpTileCache[c->pAniTile->sCachedTileID].pImagery->vo->Palette();
+	ShadeTables*           const t    = AcquireShadeTables(base, substitution, c->def.HeadPal, c->def.VestPal, c->def.PantsPal, c->def.SkinPal);
+	ReleaseShadeTables(c->shade_tables);
+	c->shade_tables = t;
+	std::copy(std::begin(t->pShades), std::end(t->pShades), c->pShades);
 }
 
 
@@ -780,25 +794,12 @@ BOOLEAN TurnSoldierIntoCorpse(SOLDIERTYPE& s)
 
 INT16 FindNearestRottingCorpse( SOLDIERTYPE *pSoldier )
 {
-	INT32 uiLowestRange = 999999;
-	INT16 sLowestGridNo = NOWHERE;
-
-	// OK, loop through our current listing of bodies
-	CFOR_EACH_ROTTING_CORPSE(c)
+	// Check rotting state
+	INT32 const id = gCorpseGrid.FindNearest(pSoldier->sGridNo, [](UINT8 const id)
 	{
-		// Check rotting state
-		if (c->def.ubType == ROTTING_STAGE2)
-		{
-			const INT32 uiRange = GetRangeInCellCoordsFromGridNoDiff(pSoldier->sGridNo, c->def.sGridNo);
-			if (uiRange < uiLowestRange)
-			{
-				sLowestGridNo = c->def.sGridNo;
-				uiLowestRange = uiRange;
-			}
-		}
-	}
-
-	return( sLowestGridNo );
+		return gRottingCorpse[id].def.ubType == ROTTING_STAGE2;
+	});
+	return id == -1 ? NOWHERE : gRottingCorpse[id].def.sGridNo;
 }
 
 
@@ -1407,12 +1408,9 @@ void LookForAndMayCommentOnSeeingCorpse( SOLDIERTYPE *pSoldier, INT16 sGridNo, U
 
 INT16 GetGridNoOfCorpseGivenProfileID(const UINT8 ubProfileID)
 {
-	// Loop through all corpses....
-	CFOR_EACH_ROTTING_CORPSE(c)
-	{
-		if (c->def.ubProfile == ubProfileID) return c->def.sGridNo;
-	}
-	return NOWHERE;
+	auto const i = gCorpsesByProfile.lower_bound(std::make_pair(ubProfileID, (UINT8)0));
+	if (i == gCorpsesByProfile.end() || i->first != ubProfileID) return NOWHERE;
+	return gRottingCorpse[i->second].def.sGridNo;
 }
 
 
@@ -1428,14 +1426,15 @@ void DecayRottingCorpseAIWarnings(void)
 UINT8 GetNearestRottingCorpseAIWarning(const INT16 sGridNo)
 {
 	UINT8 ubHighestWarning = 0;
-	CFOR_EACH_ROTTING_CORPSE(c)
+	gCorpseGrid.ForEachNear(sGridNo, CORPSE_WARNING_DIST, [&](UINT8 const id)
 	{
-		if (c->def.ubAIWarningValue > 0 &&
-			PythSpacesAway(sGridNo, c->def.sGridNo) <= CORPSE_WARNING_DIST &&
-			c->def.ubAIWarningValue > ubHighestWarning)
+		ROTTING_CORPSE const& c = gRottingCorpse[id];
+		if (c.def.ubAIWarningValue > 0 &&
+			PythSpacesAway(sGridNo, c.def.sGridNo) <= CORPSE_WARNING_DIST &&
+			c.def.ubAIWarningValue > ubHighestWarning)
 		{
-			ubHighestWarning = c->def.ubAIWarningValue;
+			ubHighestWarning = c.def.ubAIWarningValue;
 		}
-	}
+	});
 	return ubHighestWarning;
 }
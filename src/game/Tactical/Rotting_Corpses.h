@@ -7,6 +7,8 @@
 
 #include <string_theory/string>
 
+struct ShadeTables;
+
 
 #define NUM_CORPSE_SHADES				17
 
@@ -119,6 +121,7 @@ struct ROTTING_CORPSE
 	ANITILE *pAniTile;
 
 	UINT16  *pShades[ NUM_CORPSE_SHADES ];
+	ShadeTables* shade_tables; // shared owner of pShades
 };
 
 
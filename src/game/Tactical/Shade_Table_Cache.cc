@@ -0,0 +1,248 @@
+#include "Shade_Table_Cache.h"
+
+#include "Debug.h"
+#include "Lighting.h"
+#include "Soldier_Control.h"
+#include "Utilities.h"
+
+#include <algorithm>
+#include <string.h>
+
+#define SHADE_TABLE_BYTES	(SHADE_TABLE_COUNT * 256 * sizeof(UINT16))
+
+
+bool ShadeTableKey::operator==(ShadeTableKey const& o) const
+{
+	return
+		has_substitution == o.has_substitution &&
+		light.r == o.light.r && light.g == o.light.g && light.b == o.light.b &&
+		substitution == o.substitution &&
+		head  == o.head  &&
+		vest  == o.vest  &&
+		pants == o.pants &&
+		skin  == o.skin  &&
+		memcmp(base, o.base, sizeof(base)) == 0;
+}
+
+
+ShadeTableCache::ShadeTableCache(UINT32 const max_idle, Builder build) :
+	m_max_idle(max_idle),
+	m_build(std::move(build)),
+	m_hits(0),
+	m_misses(0),
+	m_evictions(0)
+{
+}
+
+
+ShadeTableCache::~ShadeTableCache()
+{
+	while (!m_entries.empty()) Evict(m_entries.begin());
+}
+
+
+static UINT32 HashBytes(UINT32 h, void const* const data, size_t const size)
+{ // FNV-1a
+	UINT8 const* const b = static_cast<UINT8 const*>(data);
+	for (size_t i = 0; i != size; ++i) h = (h ^ b[i]) * 16777619U;
+	return h;
+}
+
+
+static UINT32 HashString(UINT32 const h, ST::string const& s)
+{
+	return HashBytes(h, s.c_str(), s.size() + 1);
+}
+
+
+UINT32 ShadeTableCache::Hash(ShadeTableKey const& k)
+{
+	UINT32 h = 2166136261U;
+	for (SGPPaletteEntry const& e : k.base)
+	{
+		UINT8 const rgb[] = { e.r, e.g, e.b };
+		h = HashBytes(h, rgb, sizeof(rgb));
+	}
+	UINT8 const light[] = { k.light.r, k.light.g, k.light.b, k.has_substitution };
+	h = HashBytes(h, light, sizeof(light));
+	h = HashString(h, k.substitution);
+	h = HashString(h, k.head);
+	h = HashString(h, k.vest);
+	h = HashString(h, k.pants);
+	h = HashString(h, k.skin);
+	return h;
+}
+
+
+ShadeTables* ShadeTableCache::Acquire(ShadeTableKey const& key, SGPPaletteEntry const* const pal)
+{
+	UINT32 const hash = Hash(key);
+	for (auto i = m_entries.begin(); i != m_entries.end(); ++i)
+	{
+		if (i->hash != hash || !(i->key == key)) continue;
+
+		if (i->refs++ == 0) m_idle.remove(i);
+		++m_hits;
+		return &i->tables;
+	}
+
+	++m_misses;
+	Entry e{};
+	e.key  = key;
+	e.hash = hash;
+	e.refs = 1;
+	m_build(key, pal, e.tables.pShades);
+	m_entries.push_back(std::move(e));
+	return &m_entries.back().tables;
+}
+
+
+void ShadeTableCache::Release(ShadeTables* const t)
+{
+	if (!t) return;
+
+	auto i = std::find_if(m_entries.begin(), m_entries.end(),
+		[t](Entry const& e) { return &e.tables == t; });
+	Assert(i != m_entries.end());
+	Assert(i->refs != 0);
+	if (--i->refs != 0) return;
+
+	m_idle.push_back(i);
+	Trim(m_max_idle);
+}
+
+
+void ShadeTableCache::Evict(std::list<Entry>::iterator const i)
+{
+	for (UINT16*& s : i->tables.pShades)
+	{
+		delete[] s;
+		s = NULL;
+	}
+	m_entries.erase(i);
+	++m_evictions;
+}
+
+
+void ShadeTableCache::Trim(UINT32 const max_idle)
+{
+	while (m_idle.size() > max_idle)
+	{
+		Evict(m_idle.front());
+		m_idle.pop_front();
+	}
+}
+
+
+void ShadeTableCache::Flush()
+{
+	Trim(0);
+}
+
+
+ShadeTableCache::Stats ShadeTableCache::GetStats() const
+{
+	Stats s{};
+	s.uiHits      = m_hits;
+	s.uiMisses    = m_misses;
+	s.uiEvictions = m_evictions;
+	for (Entry const& e : m_entries)
+	{
+		++s.uiSets;
+		s.uiReferences += e.refs;
+		if (e.refs > 1) s.uiBytesSaved += (e.refs - 1) * SHADE_TABLE_BYTES;
+	}
+	s.uiBytesInUse = s.uiSets * SHADE_TABLE_BYTES;
+	return s;
+}
+
+
+SGPPaletteEntry const* ComposeSubstitutedPalette(SGPPaletteEntry pal[256], SGPPaletteEntry const* const base, char const* const substitution, ST::string const& head, ST::string const& vest, ST::string const& pants, ST::string const& skin)
+{
+	if (!substitution)
+	{
+		if (!base)
+		{
+			std::fill_n(pal, 256, SGPPaletteEntry{});
+			return pal;
+		}
+
+		// Use palette from HVOBJECT, then use substitution for pants, etc
+		memcpy(pal, base, sizeof(*pal) * 256);
+		SetPaletteReplacement(pal, head);
+		SetPaletteReplacement(pal, vest);
+		SetPaletteReplacement(pal, pants);
+		SetPaletteReplacement(pal, skin);
+		return pal;
+	}
+	else if (substitution[0] != '\0' && CreateSGPPaletteFromCOLFile(pal, substitution))
+	{
+		return pal;
+	}
+	else
+	{
+		// Use palette from hvobject
+		return base;
+	}
+}
+
+
+static void BuildShadeTables(ShadeTableKey const& k, SGPPaletteEntry const* pal, UINT16* shades[SHADE_TABLE_COUNT])
+{
+	SGPPaletteEntry tmp_pal[256];
+	if (!pal)
+	{
+		pal = ComposeSubstitutedPalette(tmp_pal, k.base,
+			k.has_substitution ? k.substitution.c_str() : NULL,
+			k.head, k.vest, k.pants, k.skin);
+	}
+	// The key was made under the current light color, which biases the tables
+	CreateBiasedShadedPalettes(shades, pal);
+}
+
+
+static ShadeTableCache g_shade_tables(MAX_IDLE_SHADE_TABLES, BuildShadeTables);
+
+
+ShadeTables* AcquireShadeTables(SGPPaletteEntry const* const base, char const* substitution, ST::string const& head, ST::string const& vest, ST::string const& pants, ST::string const& skin, SGPPaletteEntry const* const pal)
+{
+	ShadeTableKey k;
+	if (base)
+	{
+		memcpy(k.base, base, sizeof(k.base));
+		k.has_substitution = substitution != NULL;
+	}
+	else
+	{
+		// Composes to the black base palette like an empty substitution would
+		std::fill_n(k.base, 256, SGPPaletteEntry{});
+		k.has_substitution = true;
+		substitution       = "";
+	}
+	if (k.has_substitution)
+	{
+		k.substitution = substitution;
+	}
+	else
+	{
+		// The replacements only apply without a substitution file
+		k.head  = head;
+		k.vest  = vest;
+		k.pants = pants;
+		k.skin  = skin;
+	}
+	k.light = g_light_color;
+	return g_shade_tables.Acquire(k, pal);
+}
+
+
+void ReleaseShadeTables(ShadeTables* const t)
+{
+	g_shade_tables.Release(t);
+}
+
+
+ShadeTableCache::Stats GetShadeTableCacheStats()
+{
+	return g_shade_tables.GetStats();
+}
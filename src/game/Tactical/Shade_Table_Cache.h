@@ -0,0 +1,118 @@
+#ifndef __SHADE_TABLE_CACHE_H
+#define __SHADE_TABLE_CACHE_H
+
+#include "Types.h"
+
+#include <functional>
+#include <list>
+#include <string_theory/string>
+
+// Number of shade tables CreateBiasedShadedPalettes() builds
+#define SHADE_TABLE_COUNT	16
+
+// Idle shade table sets kept around after their last reference is released
+#define MAX_IDLE_SHADE_TABLES	8
+
+
+/* Everything the biased shade tables of a soldier or corpse palette depend
+ * on. The base palette is stored by value, because the video object it comes
+ * from may be freed while the tables are still in use. */
+struct ShadeTableKey
+{
+	SGPPaletteEntry base[256];
+	bool            has_substitution;
+	ST::string      substitution; // body type palette file, may be empty
+	ST::string      head;
+	ST::string      vest;
+	ST::string      pants;
+	ST::string      skin;
+	SGPPaletteEntry light;
+
+	bool operator==(ShadeTableKey const&) const;
+};
+
+
+// One set of shade tables shared by all users with the same key
+struct ShadeTables
+{
+	UINT16* pShades[SHADE_TABLE_COUNT];
+};
+
+
+/* Refcounted cache of biased shade tables. After a battle most soldiers and
+ * corpses use one of a handful of palette combinations, so they share their
+ * shade tables instead of building a set each. A set whose last reference is
+ * released stays idle until more than max_idle sets are idle; the least
+ * recently released one is evicted first. */
+class ShadeTableCache
+{
+public:
+	struct Stats
+	{
+		UINT32 uiHits;
+		UINT32 uiMisses;
+		UINT32 uiEvictions;
+		UINT32 uiSets;        // sets that are built, idle ones included
+		UINT32 uiReferences;  // references to them
+		UINT32 uiBytesInUse;  // memory taken by the built sets
+		UINT32 uiBytesSaved;  // memory a set per reference would have taken on top
+	};
+
+	/* Builds the shade tables for a key. pal is the palette the key composes
+	 * to if the caller has it at hand, NULL otherwise. */
+	typedef std::function<void(ShadeTableKey const&, SGPPaletteEntry const* pal, UINT16* shades[SHADE_TABLE_COUNT])> Builder;
+
+	ShadeTableCache(UINT32 max_idle, Builder);
+	~ShadeTableCache();
+
+	// Returns the shade tables for the key, building them if there are none
+	ShadeTables* Acquire(ShadeTableKey const&, SGPPaletteEntry const* pal = NULL);
+
+	// Gives up a reference returned by Acquire(), NULL is ignored
+	void Release(ShadeTables*);
+
+	// Evicts all idle sets
+	void Flush();
+
+	Stats GetStats() const;
+
+private:
+	struct Entry
+	{
+		ShadeTables   tables;
+		ShadeTableKey key;
+		UINT32        hash;
+		UINT32        refs;
+	};
+
+	static UINT32 Hash(ShadeTableKey const&);
+	void Evict(std::list<Entry>::iterator);
+	void Trim(UINT32 max_idle);
+
+	std::list<Entry>                        m_entries;
+	std::list<std::list<Entry>::iterator>   m_idle; // least recently released first
+	UINT32                                  m_max_idle;
+	Builder                                 m_build;
+	UINT32                                  m_hits;
+	UINT32                                  m_misses;
+	UINT32                                  m_evictions;
+};
+
+
+/* Fills pal with a soldier or corpse palette: the palette of the body type
+ * substitution file if there is one, otherwise the base palette with the
+ * head, vest, pants and skin replacements applied. Returns the palette to use,
+ * which may be base itself. Without a substitution file base may be NULL,
+ * which stands for an all black palette without replacements. */
+SGPPaletteEntry const* ComposeSubstitutedPalette(SGPPaletteEntry pal[256], SGPPaletteEntry const* base, char const* substitution, ST::string const& head, ST::string const& vest, ST::string const& pants, ST::string const& skin);
+
+/* Returns the shared biased shade tables for a palette composed as by
+ * ComposeSubstitutedPalette() under the current light color. If the caller
+ * already composed the palette it can pass it as pal to save doing it again
+ * when the tables have to be built. */
+ShadeTables* AcquireShadeTables(SGPPaletteEntry const* base, char const* substitution, ST::string const& head, ST::string const& vest, ST::string const& pants, ST::string const& skin, SGPPaletteEntry const* pal = NULL);
+void ReleaseShadeTables(ShadeTables*);
+
+ShadeTableCache::Stats GetShadeTableCacheStats();
+
+#endif
@@ -0,0 +1,109 @@
+#include "gtest/gtest.h"
+
+#include "Shade_Table_Cache.h"
+
+#include <algorithm>
+
+
+namespace
+{
+	struct FakeBuilder
+	{
+		UINT32 built = 0;
+
+		ShadeTableCache::Builder Builder()
+		{
+			return [this](ShadeTableKey const&, SGPPaletteEntry const*, UINT16* shades[SHADE_TABLE_COUNT])
+			{
+				++built;
+				for (UINT32 i = 0; i != SHADE_TABLE_COUNT; ++i) shades[i] = new UINT16[256]{};
+			};
+		}
+	};
+
+	ShadeTableKey MakeKey(char const* const vest)
+	{
+		ShadeTableKey k;
+		std::fill_n(k.base, 256, SGPPaletteEntry{});
+		k.has_substitution = false;
+		k.vest  = vest;
+		k.light = SGPPaletteEntry{};
+		return k;
+	}
+}
+
+
+TEST(ShadeTableCacheTest, sharesTablesOfEqualKeys)
+{
+	FakeBuilder b;
+	ShadeTableCache cache(0, b.Builder());
+
+	ShadeTables* const a1 = cache.Acquire(MakeKey("BLUEVEST"));
+	ShadeTables* const a2 = cache.Acquire(MakeKey("BLUEVEST"));
+	ShadeTables* const a3 = cache.Acquire(MakeKey("BLUEVEST"));
+	ShadeTables* const c  = cache.Acquire(MakeKey("REDVEST"));
+	EXPECT_EQ(a1, a2);
+	EXPECT_EQ(a1, a3);
+	EXPECT_NE(a1, c);
+	EXPECT_EQ(a1->pShades[0], a2->pShades[0]);
+	EXPECT_EQ(b.built, 2u);
+
+	ShadeTableKey lit = MakeKey("BLUEVEST");
+	lit.light.r = 40;
+	EXPECT_NE(cache.Acquire(lit), a1);
+	EXPECT_EQ(b.built, 3u);
+
+	ShadeTableCache::Stats const s = cache.GetStats();
+	EXPECT_EQ(s.uiHits, 2u);
+	EXPECT_EQ(s.uiMisses, 3u);
+	EXPECT_EQ(s.uiSets, 3u);
+	EXPECT_EQ(s.uiReferences, 5u);
+	EXPECT_EQ(s.uiBytesInUse, 3 * SHADE_TABLE_COUNT * 256 * sizeof(UINT16));
+	EXPECT_EQ(s.uiBytesSaved, 2 * SHADE_TABLE_COUNT * 256 * sizeof(UINT16));
+}
+
+
+TEST(ShadeTableCacheTest, evictsWhenLastReferenceIsReleased)
+{
+	FakeBuilder b;
+	ShadeTableCache cache(0, b.Builder());
+
+	ShadeTables* const a1 = cache.Acquire(MakeKey("BLUEVEST"));
+	ShadeTables* const a2 = cache.Acquire(MakeKey("BLUEVEST"));
+	cache.Release(a1);
+	EXPECT_EQ(cache.GetStats().uiEvictions, 0u);
+	EXPECT_EQ(cache.GetStats().uiBytesSaved, 0u);
+	cache.Release(a2);
+	EXPECT_EQ(cache.GetStats().uiEvictions, 1u);
+	EXPECT_EQ(cache.GetStats().uiSets, 0u);
+
+	cache.Acquire(MakeKey("BLUEVEST"));
+	EXPECT_EQ(b.built, 2u);
+}
+
+
+TEST(ShadeTableCacheTest, keepsRecentlyReleasedSetsIdle)
+{
+	FakeBuilder b;
+	ShadeTableCache cache(1, b.Builder());
+
+	cache.Release(cache.Acquire(MakeKey("BLUEVEST")));
+	EXPECT_EQ(cache.GetStats().uiSets, 1u);
+
+	// An idle set is handed out again without being rebuilt
+	ShadeTables* const a = cache.Acquire(MakeKey("BLUEVEST"));
+	EXPECT_EQ(b.built, 1u);
+	EXPECT_EQ(cache.GetStats().uiHits, 1u);
+
+	// The least recently released set goes once there are too many idle ones
+	cache.Release(cache.Acquire(MakeKey("REDVEST")));
+	cache.Release(a);
+	EXPECT_EQ(cache.GetStats().uiEvictions, 1u);
+	cache.Acquire(MakeKey("BLUEVEST"));
+	EXPECT_EQ(b.built, 2u);
+	cache.Acquire(MakeKey("REDVEST"));
+	EXPECT_EQ(b.built, 3u);
+
+	cache.Flush();
+	EXPECT_EQ(cache.GetStats().uiSets, 2u);
+}
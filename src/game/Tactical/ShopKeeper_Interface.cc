@@ -570,11 +570,11 @@ static void EnterShopKeeperInterface(void)
 	SetCurrentTacticalPanelCurrentMerc(sel);
 	SetSMPanelCurrentMerc(sel);
 
-	// load the Main trade screen backgroiund image
-	guiMainTradeScreenImage = AddVideoObjectFromFile(INTERFACEDIR "/tradescreen.sti");
-
-	// load the Main trade screen background image
-	guiItemCrossOut = AddVideoObjectFromFile(INTERFACEDIR "/itemcrossout.sti");
+	AddVideoObjectsFromFiles({
+		// the Main trade screen background image
+		{ &guiMainTradeScreenImage, INTERFACEDIR "/tradescreen.sti" },
+		{ &guiItemCrossOut,         INTERFACEDIR "/itemcrossout.sti" },
+	});
 
 	//Create an array of all mercs (anywhere!) currently in the player's employ, and load their small faces
 	// This is to support showing of repair item owner's faces even when they're not in the sector, as long as they still work for player
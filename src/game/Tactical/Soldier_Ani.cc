@@ -37,6 +37,7 @@
 #include "Soldier_Add.h"
 #include "Soldier_Profile.h"
 #include "Soldier_Functions.h"
+#include "Soldier_Index.h"
 #include "Interface.h"
 #include "QArray.h"
 #include "Soldier_Macros.h"
@@ -902,6 +903,7 @@ BOOLEAN AdjustToNextAnimationFrame( SOLDIERTYPE *pSoldier )
 					// CODE: MOVE UP FROM CLIFF CLIMB
 					pSoldier->dHeightAdjustment += (float)2.1;
 					pSoldier->sHeightAdjustment = (INT16)pSoldier->dHeightAdjustment;
+					SoldierIndexUpdate(*pSoldier);
 					// Move over some...
 					//MoveMercFacingDirection( pSoldier , FALSE, (FLOAT)0.5 );
 					break;
@@ -918,6 +920,7 @@ BOOLEAN AdjustToNextAnimationFrame( SOLDIERTYPE *pSoldier )
 					// CODE: END CLIFF CLIMB
 					pSoldier->dHeightAdjustment = (float)0;
 					pSoldier->sHeightAdjustment = (INT16)pSoldier->dHeightAdjustment;
+					SoldierIndexUpdate(*pSoldier);
 
 					// Set new gridno
 				{
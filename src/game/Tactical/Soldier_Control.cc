@@ -54,6 +54,7 @@
 #include "Render_Fun.h"
 #include "Rotting_Corpses.h"
 #include "ScreenIDs.h"
+#include "Shade_Table_Cache.h"
 #include "SkillCheck.h"
 #include "Smell.h"
 #include "SmokeEffects.h"
@@ -61,6 +62,7 @@
 #include "Soldier_Ani.h"
 #include "Soldier_Find.h"
 #include "Soldier_Functions.h"
+#include "Soldier_Index.h"
 #include "Soldier_Macros.h"
 #include "Soldier_Profile.h"
 #include "Soldier_Tile.h"
@@ -85,7 +87,9 @@
 #include "Weapons.h"
 #include "WorldMan.h"
 #include "enums.h"
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <stdexcept>
 #include <string_theory/string>
 
@@ -674,10 +678,12 @@ void DeleteSoldier(SOLDIERTYPE& s)
 
 	DeleteSoldierFace(&s);
 
+	ReleaseShadeTables(s.shade_tables);
+	s.shade_tables = 0;
 	FOR_EACH(UINT16*, i, s.pShades)
 	{
 		if (*i == NULL) continue;
-		delete[] *i;
+		if (i - s.pShades >= SHADE_TABLE_COUNT) delete[] *i;
 		*i = NULL;
 	}
 
@@ -1820,6 +1826,7 @@ static void InternalRemoveSoldierFromGridNo(SOLDIERTYPE& s, BOOLEAN const force)
 	UnMarkMovementReserved(s);
 	HandleCrowShadowRemoveGridNo(s);
 	s.sGridNo = NOWHERE;
+	SoldierIndexUpdate(s);
 }
 
 
@@ -1853,6 +1860,8 @@ static void EVENT_InternalSetSoldierPosition(SOLDIERTYPE* pSoldier, GridNo pos,
 	HandleCrowShadowNewPosition( pSoldier );
 
 	SetSoldierGridNo(*pSoldier, pos, (flags & SSP_FORCE_DELETE) != 0);
+	// The graphic moves within the gridno, too
+	SoldierIndexUpdate(*pSoldier);
 
 	if ( !( pSoldier->uiStatusFlags & ( SOLDIER_DRIVER | SOLDIER_PASSENGER ) ) )
 	{
@@ -1895,6 +1904,7 @@ void SetSoldierHeight(SOLDIERTYPE* const s, FLOAT const new_height)
 {
 	s->dHeightAdjustment = new_height;
 	s->sHeightAdjustment = (INT16)new_height;
+	SoldierIndexUpdate(*s);
 
 	if (s->sHeightAdjustment > 0)
 	{
@@ -1945,6 +1955,7 @@ static void SetSoldierGridNo(SOLDIERTYPE& s, GridNo new_grid_no, BOOLEAN const f
 	}
 
 	s.sGridNo = new_grid_no;
+	SoldierIndexUpdate(s);
 
 	// Check if our new gridno is valid, if not do not set!
 	if (!GridNoOnVisibleWorldTile(new_grid_no)) return;
@@ -3504,12 +3515,14 @@ BOOLEAN EVENT_InternalGetNewSoldierPath( SOLDIERTYPE *pSoldier, UINT16 sDestGrid
 
 		sMercGridNo = pSoldier->sGridNo;
 		pSoldier->sGridNo = pSoldier->sDestination;
+		SoldierIndexUpdate(*pSoldier);
 
 		// Check if path is good before copying it into guy's path...
 		if ( FindBestPath( pSoldier, sDestGridNo, pSoldier->bLevel, pSoldier->usUIMovementMode, NO_COPYROUTE, fFlags ) == 0 )
 		{
 			// Set to old....
 			pSoldier->sGridNo = sMercGridNo;
+			SoldierIndexUpdate(*pSoldier);
 
 			return( FALSE );
 		}
@@ -3517,6 +3530,7 @@ BOOLEAN EVENT_InternalGetNewSoldierPath( SOLDIERTYPE *pSoldier, UINT16 sDestGrid
 		uiDist =  FindBestPath( pSoldier, sDestGridNo, pSoldier->bLevel, pSoldier->usUIMovementMode, COPYROUTE, fFlags );
 
 		pSoldier->sGridNo = sMercGridNo;
+		SoldierIndexUpdate(*pSoldier);
 		pSoldier->sFinalDestination = sDestGridNo;
 
 		if ( uiDist > 0 )
@@ -4684,40 +4698,30 @@ void CreateSoldierPalettes(SOLDIERTYPE& s)
 		throw std::runtime_error("Palette creation failed, soldier has invalid animation");
 	}
 
-	SGPPaletteEntry tmp_pal[256];
-	std::fill_n(tmp_pal, 256, SGPPaletteEntry{});
-
-	SGPPaletteEntry const*       pal;
+	SGPPaletteEntry const*       base;
 	char            const* const substitution = GetBodyTypePaletteSubstitution(&s, s.ubBodyType);
 	if (!substitution)
 	{
 		// ATE: here we want to use the breath cycle for the palette.....
 		UINT16 const palette_anim_surface = LoadSoldierAnimationSurface(s, STANDING);
-		if (palette_anim_surface != INVALID_ANIMATION_SURFACE)
-		{
-			// Use palette from HVOBJECT, then use substitution for pants, etc
-			memcpy(tmp_pal, gAnimSurfaceDatabase[palette_anim_surface].hVideoObject->Palette(), sizeof(*tmp_pal) * 256);
-
-			// Substitute based on head, etc
-			SetPaletteReplacement(tmp_pal, s.HeadPal);
-			SetPaletteReplacement(tmp_pal, s.VestPal);
-			SetPaletteReplacement(tmp_pal, s.PantsPal);
-			SetPaletteReplacement(tmp_pal, s.SkinPal);
-		}
-		pal = tmp_pal;
-	}
-	else if (substitution[0] != '\0' && CreateSGPPaletteFromCOLFile(tmp_pal, substitution))
-	{
-		pal = tmp_pal;
+		base = palette_anim_surface == INVALID_ANIMATION_SURFACE ? NULL :
+			gAnimSurfaceDatabase[palette_anim_surface].hVideoObject->Palette();
 	}
 	else
 	{
-		// Use palette from hvobject
-		pal = gAnimSurfaceDatabase[anim_surface].hVideoObject->Palette();
+		base = gAnimSurfaceDatabase[anim_surface].hVideoObject->Palette();
 	}
 
+	SGPPaletteEntry              tmp_pal[256];
+	SGPPaletteEntry const* const pal = ComposeSubstitutedPalette(tmp_pal, base, substitution, s.HeadPal, s.VestPal, s.PantsPal, s.SkinPal);
 
-	for (INT32 i = 0; i < NUM_SOLDIER_SHADES; ++i)
+	// The biased shades are shared with everybody who looks the same
+	ShadeTables* const shared = AcquireShadeTables(base, substitution, s.HeadPal, s.VestPal, s.PantsPal, s.SkinPal, pal);
+	ReleaseShadeTables(s.shade_tables);
+	s.shade_tables = shared;
+	std::copy(std::begin(shared->pShades), std::end(shared->pShades), s.pShades);
+
+	for (INT32 i = SHADE_TABLE_COUNT; i < NUM_SOLDIER_SHADES; ++i)
 	{
 		if (s.pShades[i])
 		{
@@ -4742,8 +4746,6 @@ void CreateSoldierPalettes(SOLDIERTYPE& s)
 	}
 
 
-	CreateBiasedShadedPalettes(s.pShades, pal);
-
 	s.effect_shade = Create16BPPPaletteShaded(pal, 100, 100, 100, TRUE);
 
 	// Build shades for glowing visible bad guy
@@ -7883,6 +7885,7 @@ static void SetSoldierLocatorOffsets(SOLDIERTYPE* const s)
 	s->sBoundingBoxHeight  = dims.usHeight;
 	s->sBoundingBoxOffsetX = dims.sOffsetX;
 	s->sBoundingBoxOffsetY = dims.sOffsetY;
+	SoldierIndexUpdate(*s);
 }
 
 
@@ -13,6 +13,8 @@
 
 #include <string_theory/string>
 
+struct ShadeTables;
+
 
 // ANDREW: these are defines for OKDestanation usage - please move to approprite file
 #define IGNOREPEOPLE					0
@@ -467,6 +469,7 @@ struct SOLDIERTYPE
 	ST::string SkinPal;
 
 	UINT16 *pShades[ NUM_SOLDIER_SHADES ]; // Shading tables
+	ShadeTables* shade_tables; // shared owner of the first SHADE_TABLE_COUNT shades
 	UINT16 *pGlowShades[ 20 ]; //
 	INT8 bMedical;
 	BOOLEAN fBeginFade;
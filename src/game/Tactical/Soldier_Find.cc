@@ -32,6 +32,7 @@
 #include "EditorMercs.h"
 #include "Soldier_Tile.h"
 #include "Soldier_Find.h"
+#include "Soldier_Index.h"
 #include "Vehicles.h"
 #include "GameSettings.h"
 #include "UI_Cursors.h"
@@ -141,12 +142,32 @@ SOLDIERTYPE* FindSoldier(GridNo const gridno, UINT32 flags)
 		gSoldierStack.fUseGridNo = FALSE;
 	}
 
+	/* Only soldiers on the gridno or with the mouse over their graphic can be
+	 * found, so skip everybody else early */
+	SoldierSet candidates;
+	if (gridno < 0 || WORLD_MAX <= gridno)
+	{
+		candidates.set();
+	}
+	else
+	{
+		candidates = SoldiersAtGridNo(gridno);
+		if (!(flags & FIND_SOLDIER_GRIDNO))
+		{
+			INT16 origin_x;
+			INT16 origin_y;
+			GetWorldScreenOrigin(&origin_x, &origin_y);
+			candidates |= SoldiersAtWorldScreenPos(gusMouseXPos - origin_x, gusMouseYPos - origin_y);
+		}
+	}
+
 	INT16        heighest_merc_screen_y = -32000;
 	SOLDIERTYPE* best_merc              = 0;
 	FOR_EACH_MERC(i)
 	{
 		SOLDIERTYPE& s = **i;
 
+		if (!candidates[s.ubID]) continue;
 		if (s.uiStatusFlags & SOLDIER_DEAD) continue;
 		if (s.bVisible == -1 && !(gTacticalStatus.uiFlags & SHOW_ALL_MERCS)) continue;
 
@@ -399,6 +420,34 @@ void GetSoldierTRUEScreenPos(const SOLDIERTYPE* const s, INT16* const psScreenX,
 }
 
 
+void GetSoldierWorldScreenRect(SOLDIERTYPE const& s, INT16* const left, INT16* const top, INT16* const right, INT16* const bottom)
+{
+	FLOAT dScreenX;
+	FLOAT dScreenY;
+	FloatFromCellToScreenCoordinates(s.dXPos, s.dYPos, &dScreenX, &dScreenY);
+
+	INT16 x = (INT16)dScreenX + s.sBoundingBoxOffsetX;
+	INT16 y = (INT16)dScreenY + s.sBoundingBoxOffsetY - s.sHeightAdjustment;
+	if (s.sGridNo != NOWHERE) y -= gpWorldLevelData[s.sGridNo].sHeight;
+
+	*left   = x;
+	*top    = y;
+	*right  = x + s.sBoundingBoxWidth;
+	*bottom = y + s.sBoundingBoxHeight;
+}
+
+
+void GetWorldScreenOrigin(INT16* const psScreenX, INT16* const psScreenY)
+{
+	FLOAT dCenterX;
+	FLOAT dCenterY;
+	FloatFromCellToScreenCoordinates(gsRenderCenterX, gsRenderCenterY, &dCenterX, &dCenterY);
+
+	*psScreenX = g_ui.m_tacticalMapCenterX - (INT16)dCenterX - gsRenderWorldOffsetX;
+	*psScreenY = g_ui.m_tacticalMapCenterY - (INT16)dCenterY - gsRenderWorldOffsetY + gsRenderHeight;
+}
+
+
 bool GridNoOnScreen(GridNo const gridno)
 {
 	INT16 world_x;
@@ -41,6 +41,13 @@ BOOLEAN SoldierOnScreen(const SOLDIERTYPE* s);
 BOOLEAN SoldierLocationRelativeToScreen(INT16 sGridNo, INT8* pbDirection, UINT32* puiScrollFlags);
 void GetSoldierScreenPos(const SOLDIERTYPE* pSoldier, INT16* psScreenX, INT16* psScreenY);
 void GetSoldierTRUEScreenPos(const SOLDIERTYPE* pSoldier, INT16* psScreenX, INT16* psScreenY);
+/* The screen rect FindSoldier() checks, but relative to the world instead of
+ * the view, so it does not change when the view scrolls. Add the position
+ * from GetWorldScreenOrigin() to get the view coordinates; they may be off by
+ * a pixel due to rounding. */
+void GetSoldierWorldScreenRect(SOLDIERTYPE const&, INT16* left, INT16* top, INT16* right, INT16* bottom);
+// Where the world screen position 0,0 lies in the view
+void GetWorldScreenOrigin(INT16* psScreenX, INT16* psScreenY);
 BOOLEAN IsPointInSoldierBoundingBox( SOLDIERTYPE *pSoldier, INT16 sX, INT16 sY );
 UINT16 FindRelativeSoldierPosition(const SOLDIERTYPE* pSoldier, INT16 sX, INT16 sY);
 
@@ -0,0 +1,209 @@
+#include "Soldier_Index.h"
+#include "Isometric_Utils.h"
+#include "Overhead.h"
+#include "Soldier_Control.h"
+#include "Soldier_Find.h"
+#include "WorldDef.h"
+
+#include <algorithm>
+#include <vector>
+
+
+#define SOLDIER_INDEX_BUCKET_SHIFT 3 // 8x8 tiles
+#define SOLDIER_INDEX_COLS         (WORLD_COLS >> SOLDIER_INDEX_BUCKET_SHIFT)
+#define SOLDIER_INDEX_ROWS         (WORLD_ROWS >> SOLDIER_INDEX_BUCKET_SHIFT)
+
+/* The screen grid covers the world screen coordinates of the whole map, plus
+ * room above it for tall graphics. Rects beyond it are filed in the border
+ * buckets, so they are still found. */
+#define SOLDIER_SCREEN_BUCKET_SHIFT 6 // 64x64 pixels
+#define SOLDIER_SCREEN_MIN_X        (-2 * WORLD_ROWS * CELL_Y_SIZE)
+#define SOLDIER_SCREEN_MIN_Y        (-512)
+#define SOLDIER_SCREEN_COLS         ((2 * (WORLD_COLS * CELL_X_SIZE + WORLD_ROWS * CELL_Y_SIZE) >> SOLDIER_SCREEN_BUCKET_SHIFT) + 1)
+#define SOLDIER_SCREEN_ROWS         ((WORLD_COLS * CELL_X_SIZE + WORLD_ROWS * CELL_Y_SIZE - SOLDIER_SCREEN_MIN_Y >> SOLDIER_SCREEN_BUCKET_SHIFT) + 1)
+
+
+struct SoldierScreenRect
+{
+	INT16 left;
+	INT16 top;
+	INT16 right;
+	INT16 bottom;
+};
+
+// The screen buckets a soldier is filed in, inclusive; empty if left > right
+struct SoldierScreenCells
+{
+	INT16 left;
+	INT16 top;
+	INT16 right;
+	INT16 bottom;
+
+	bool operator==(SoldierScreenCells const& o) const
+	{
+		return left == o.left && top == o.top && right == o.right && bottom == o.bottom;
+	}
+};
+
+
+static std::vector<SoldierID> g_soldier_buckets[SOLDIER_INDEX_COLS * SOLDIER_INDEX_ROWS];
+static std::vector<SoldierID> g_screen_buckets[SOLDIER_SCREEN_COLS * SOLDIER_SCREEN_ROWS];
+static GridNo                 g_indexed_gridno[TOTAL_SOLDIERS];
+static SoldierScreenRect      g_indexed_rect[TOTAL_SOLDIERS];
+static SoldierScreenCells     g_indexed_cells[TOTAL_SOLDIERS];
+static bool                   g_indexed_gridno_init = false;
+
+static SoldierScreenCells const NO_SCREEN_CELLS = { 1, 1, 0, 0 };
+
+
+static std::vector<SoldierID>& SoldierBucket(GridNo const gridno)
+{
+	INT16 const col = gridno % WORLD_COLS >> SOLDIER_INDEX_BUCKET_SHIFT;
+	INT16 const row = gridno / WORLD_COLS >> SOLDIER_INDEX_BUCKET_SHIFT;
+	return g_soldier_buckets[row * SOLDIER_INDEX_COLS + col];
+}
+
+
+static INT16 ScreenBucketCol(INT16 const x)
+{
+	return std::clamp<INT16>((x - SOLDIER_SCREEN_MIN_X) >> SOLDIER_SCREEN_BUCKET_SHIFT, 0, SOLDIER_SCREEN_COLS - 1);
+}
+
+
+static INT16 ScreenBucketRow(INT16 const y)
+{
+	return std::clamp<INT16>((y - SOLDIER_SCREEN_MIN_Y) >> SOLDIER_SCREEN_BUCKET_SHIFT, 0, SOLDIER_SCREEN_ROWS - 1);
+}
+
+
+static bool IsIndexableGridNo(GridNo const gridno)
+{
+	return 0 <= gridno && gridno < WORLD_MAX;
+}
+
+
+static void FileInScreenCells(SoldierID const id, SoldierScreenCells const& c, bool const add)
+{
+	for (INT16 row = c.top; row <= c.bottom; ++row)
+	{
+		for (INT16 col = c.left; col <= c.right; ++col)
+		{
+			std::vector<SoldierID>& b = g_screen_buckets[row * SOLDIER_SCREEN_COLS + col];
+			if (add)
+			{
+				b.push_back(id);
+			}
+			else
+			{
+				b.erase(std::find(b.begin(), b.end(), id));
+			}
+		}
+	}
+}
+
+
+void SoldierIndexUpdate(SOLDIERTYPE const& s)
+{
+	if (!g_indexed_gridno_init)
+	{
+		std::fill(std::begin(g_indexed_gridno), std::end(g_indexed_gridno), NOWHERE);
+		std::fill(std::begin(g_indexed_cells),  std::end(g_indexed_cells),  NO_SCREEN_CELLS);
+		g_indexed_gridno_init = true;
+	}
+
+	GridNo& indexed = g_indexed_gridno[s.ubID];
+	GridNo  const gridno  = IsIndexableGridNo(s.sGridNo) ? s.sGridNo : NOWHERE;
+	if (indexed != gridno)
+	{
+		if (indexed != NOWHERE)
+		{
+			std::vector<SoldierID>& b = SoldierBucket(indexed);
+			b.erase(std::find(b.begin(), b.end(), s.ubID));
+		}
+		if (gridno != NOWHERE) SoldierBucket(gridno).push_back(s.ubID);
+		indexed = gridno;
+	}
+
+	SoldierScreenRect&  rect  = g_indexed_rect[s.ubID];
+	SoldierScreenCells  cells = NO_SCREEN_CELLS;
+	if (gridno != NOWHERE)
+	{
+		GetSoldierWorldScreenRect(s, &rect.left, &rect.top, &rect.right, &rect.bottom);
+		cells.left   = ScreenBucketCol(rect.left   - 1);
+		cells.top    = ScreenBucketRow(rect.top    - 1);
+		cells.right  = ScreenBucketCol(rect.right  + 1);
+		cells.bottom = ScreenBucketRow(rect.bottom + 1);
+	}
+
+	SoldierScreenCells& indexed_cells = g_indexed_cells[s.ubID];
+	if (indexed_cells == cells) return;
+	FileInScreenCells(s.ubID, indexed_cells, false);
+	FileInScreenCells(s.ubID, cells,         true);
+	indexed_cells = cells;
+}
+
+
+/* Whether the soldier still stands where it is filed. Everything that moves a
+ * soldier, even temporarily to evaluate a position, updates the index, so
+ * this only drops soldiers which are gone. */
+static bool IsFiledAt(SOLDIERTYPE const& s, GridNo const gridno)
+{
+	return s.bActive && s.sGridNo == gridno;
+}
+
+
+SoldierSet SoldiersAtGridNo(GridNo const gridno)
+{
+	SoldierSet found;
+	if (!g_indexed_gridno_init || !IsIndexableGridNo(gridno)) return found;
+
+	for (SoldierID const id : SoldierBucket(gridno))
+	{
+		if (g_indexed_gridno[id] == gridno && IsFiledAt(GetMan(id), gridno)) found.set(id);
+	}
+	return found;
+}
+
+
+SoldierSet SoldiersInRadius(GridNo const gridno, INT16 const radius)
+{
+	SoldierSet found;
+	if (!g_indexed_gridno_init || !IsIndexableGridNo(gridno)) return found;
+
+	INT16 const col     = gridno % WORLD_COLS;
+	INT16 const row     = gridno / WORLD_COLS;
+	INT16 const min_col = std::max<INT16>(col - radius, 0);
+	INT16 const min_row = std::max<INT16>(row - radius, 0);
+	INT16 const max_col = std::min<INT16>(col + radius, WORLD_COLS - 1);
+	INT16 const max_row = std::min<INT16>(row + radius, WORLD_ROWS - 1);
+	for (INT16 r = min_row >> SOLDIER_INDEX_BUCKET_SHIFT; r <= max_row >> SOLDIER_INDEX_BUCKET_SHIFT; ++r)
+	{
+		for (INT16 c = min_col >> SOLDIER_INDEX_BUCKET_SHIFT; c <= max_col >> SOLDIER_INDEX_BUCKET_SHIFT; ++c)
+		{
+			for (SoldierID const id : g_soldier_buckets[r * SOLDIER_INDEX_COLS + c])
+			{
+				GridNo const g = g_indexed_gridno[id];
+				if (!IsFiledAt(GetMan(id), g)) continue;
+				if (PythSpacesAway(gridno, g) > radius) continue;
+				found.set(id);
+			}
+		}
+	}
+	return found;
+}
+
+
+SoldierSet SoldiersAtWorldScreenPos(INT16 const x, INT16 const y)
+{
+	SoldierSet found;
+	if (!g_indexed_gridno_init) return found;
+
+	for (SoldierID const id : g_screen_buckets[ScreenBucketRow(y) * SOLDIER_SCREEN_COLS + ScreenBucketCol(x)])
+	{
+		SoldierScreenRect const& r = g_indexed_rect[id];
+		if (x < r.left - 1 || r.right + 1 < x || y < r.top - 1 || r.bottom + 1 < y) continue;
+		if (!IsFiledAt(GetMan(id), g_indexed_gridno[id])) continue;
+		found.set(id);
+	}
+	return found;
+}
@@ -0,0 +1,31 @@
+#ifndef __SOLDIER_INDEX_H
+#define __SOLDIER_INDEX_H
+
+#include "JA2Types.h"
+#include "Overhead_Types.h"
+
+#include <bitset>
+
+
+/* Spatial hash of the soldiers placed in the world, bucketed by map area and
+ * by the area of the screen their graphic covers. Queries return the matching
+ * soldiers as a set of soldier IDs, so callers can keep iterating in their
+ * usual order and only look at the members. */
+typedef std::bitset<TOTAL_SOLDIERS> SoldierSet;
+
+/* Files the soldier under its current gridno and screen rect, or drops it if
+ * it has no gridno. Call it whenever sGridNo, the position, the height or the
+ * bounding box of a soldier changes, even if only temporarily. */
+void SoldierIndexUpdate(SOLDIERTYPE const&);
+
+// Soldiers standing on the gridno
+SoldierSet SoldiersAtGridNo(GridNo);
+
+// Soldiers standing at most radius tiles (see PythSpacesAway()) from the gridno
+SoldierSet SoldiersInRadius(GridNo, INT16 radius);
+
+/* Soldiers whose screen rect, see GetSoldierWorldScreenRect(), contains the
+ * world screen position give or take a pixel */
+SoldierSet SoldiersAtWorldScreenPos(INT16 x, INT16 y);
+
+#endif
@@ -0,0 +1,188 @@
+#include "gtest/gtest.h"
+
+#include "Soldier_Index.h"
+#include "Isometric_Utils.h"
+#include "Overhead.h"
+#include "Soldier_Control.h"
+#include "Soldier_Find.h"
+#include "WorldDef.h"
+
+#include <random>
+#include <vector>
+
+
+namespace
+{
+	// A world of random heights with random soldiers, restored afterwards
+	struct SoldierLayout
+	{
+		std::vector<SOLDIERTYPE> saved_soldiers;
+		MAP_ELEMENT*             saved_world;
+		std::vector<MAP_ELEMENT> world;
+
+		SoldierLayout(std::mt19937& rng, UINT8 const n) :
+			saved_soldiers(Menptr, Menptr + MAX_NUM_SOLDIERS),
+			saved_world(gpWorldLevelData),
+			world(WORLD_MAX)
+		{
+			std::uniform_int_distribution<INT32> height(0, 80);
+			for (MAP_ELEMENT& e : world) e.sHeight = (UINT8)height(rng);
+			gpWorldLevelData = world.data();
+
+			for (UINT8 id = 0; id != MAX_NUM_SOLDIERS; ++id)
+			{
+				SOLDIERTYPE& s = Menptr[id];
+				s = SOLDIERTYPE{};
+				s.ubID    = id;
+				s.sGridNo = NOWHERE;
+				if (id < n) Place(rng, s);
+				SoldierIndexUpdate(s);
+			}
+		}
+
+		~SoldierLayout()
+		{
+			for (UINT8 id = 0; id != MAX_NUM_SOLDIERS; ++id)
+			{
+				Menptr[id].sGridNo = NOWHERE;
+				SoldierIndexUpdate(Menptr[id]);
+			}
+			std::copy(saved_soldiers.begin(), saved_soldiers.end(), Menptr);
+			gpWorldLevelData = saved_world;
+		}
+
+		static void Place(std::mt19937& rng, SOLDIERTYPE& s)
+		{
+			std::uniform_int_distribution<INT32> tile(0, WORLD_MAX - 1);
+			std::uniform_int_distribution<INT32> size(1, 120);
+			std::uniform_int_distribution<INT32> offset(-100, 20);
+			s.bActive = rng() % 5 != 0;
+			s.sGridNo = (INT16)tile(rng);
+			ConvertGridNoToCenterCellXY(s.sGridNo, &s.sX, &s.sY);
+			s.dXPos = s.sX;
+			s.dYPos = s.sY;
+			s.sHeightAdjustment   = (INT16)(rng() % 3 == 0 ? 50 : 0);
+			s.sBoundingBoxWidth   = (INT16)size(rng);
+			s.sBoundingBoxHeight  = (INT16)size(rng);
+			s.sBoundingBoxOffsetX = (INT16)offset(rng);
+			s.sBoundingBoxOffsetY = (INT16)offset(rng);
+		}
+	};
+
+	SoldierSet SoldiersAtGridNoByScan(GridNo const gridno)
+	{
+		SoldierSet found;
+		CFOR_EACH_SOLDIER(s)
+		{
+			if (s->sGridNo == gridno) found.set(s->ubID);
+		}
+		return found;
+	}
+
+	SoldierSet SoldiersInRadiusByScan(GridNo const gridno, INT16 const radius)
+	{
+		SoldierSet found;
+		CFOR_EACH_SOLDIER(s)
+		{
+			if (s->sGridNo != NOWHERE && PythSpacesAway(gridno, s->sGridNo) <= radius) found.set(s->ubID);
+		}
+		return found;
+	}
+
+	// Soldiers whose screen rect contains the position, like FindSoldier() tests it
+	SoldierSet SoldiersAtWorldScreenPosByScan(INT16 const x, INT16 const y)
+	{
+		SoldierSet found;
+		CFOR_EACH_SOLDIER(s)
+		{
+			if (s->sGridNo == NOWHERE) continue;
+			INT16 left;
+			INT16 top;
+			INT16 right;
+			INT16 bottom;
+			GetSoldierWorldScreenRect(*s, &left, &top, &right, &bottom);
+			if (left <= x && x <= right && top <= y && y <= bottom) found.set(s->ubID);
+		}
+		return found;
+	}
+
+	// The index may return soldiers a pixel off the rect, but never miss one
+	void ExpectIndexMatchesScan(std::mt19937& rng)
+	{
+		std::uniform_int_distribution<INT32> tile(0, WORLD_MAX - 1);
+		for (int i = 0; i != 50; ++i)
+		{
+			INT16 const g = (INT16)tile(rng);
+			EXPECT_EQ(SoldiersAtGridNo(g), SoldiersAtGridNoByScan(g)) << "gridno " << g;
+			EXPECT_EQ(SoldiersInRadius(g, 5), SoldiersInRadiusByScan(g, 5)) << "gridno " << g;
+		}
+
+		CFOR_EACH_SOLDIER(s)
+		{
+			if (s->sGridNo == NOWHERE) continue;
+			EXPECT_TRUE(SoldiersAtGridNo(s->sGridNo)[s->ubID]);
+
+			// Probe the corners and the centre of the graphic
+			INT16 left;
+			INT16 top;
+			INT16 right;
+			INT16 bottom;
+			GetSoldierWorldScreenRect(*s, &left, &top, &right, &bottom);
+			INT16 const xs[] = { left, (INT16)((left + right) / 2), right };
+			INT16 const ys[] = { top,  (INT16)((top + bottom) / 2), bottom };
+			for (INT16 const x : xs)
+			{
+				for (INT16 const y : ys)
+				{
+					SoldierSet const expected = SoldiersAtWorldScreenPosByScan(x, y);
+					EXPECT_EQ(SoldiersAtWorldScreenPos(x, y) & expected, expected) << "pos " << x << "," << y;
+				}
+			}
+		}
+	}
+}
+
+
+TEST(SoldierIndexTest, matchesScanOfAllSoldiers)
+{
+	std::mt19937 rng(1999);
+	for (UINT8 n : { 0, 1, 10, 60, MAX_NUM_SOLDIERS })
+	{
+		SoldierLayout const l(rng, n);
+		ExpectIndexMatchesScan(rng);
+	}
+}
+
+
+TEST(SoldierIndexTest, followsMovesAndTemporaryMoves)
+{
+	std::mt19937 rng(4242);
+	SoldierLayout const l(rng, 40);
+
+	for (int round = 0; round != 10; ++round)
+	{
+		// Move some soldiers for good, others only to evaluate a spot like the AI
+		for (UINT8 id = 0; id < 40; id += 3)
+		{
+			SOLDIERTYPE& s = Menptr[id];
+			SOLDIERTYPE  const old = s;
+			SoldierLayout::Place(rng, s);
+			s.bActive = old.bActive;
+			SoldierIndexUpdate(s);
+			if (round % 2 == 0) continue;
+
+			ExpectIndexMatchesScan(rng);
+			s.sGridNo = old.sGridNo;
+			s.dXPos   = old.dXPos;
+			s.dYPos   = old.dYPos;
+			SoldierIndexUpdate(s);
+		}
+		ExpectIndexMatchesScan(rng);
+
+		// Soldiers leaving the world
+		SOLDIERTYPE& gone = Menptr[round];
+		gone.sGridNo = NOWHERE;
+		SoldierIndexUpdate(gone);
+		ExpectIndexMatchesScan(rng);
+	}
+}
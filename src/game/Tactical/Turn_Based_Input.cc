@@ -91,6 +91,7 @@
 #include "Game_Init.h"
 
 #include "Logger.h"
+#include "ScriptingExtensions.h"
 #include "ContentManager.h"
 #include "GameInstance.h"
 #include "Soldier.h"
@@ -118,6 +119,7 @@ static void QueryTBMiddleButton(UIEventKind*);
 
 static void GroupAutoReload();
 static void SwitchHeadGear(bool dayGear);
+static void LogScriptingHookStats();
 
 void HandleTBReload( void );
 void HandleTBSwapHands( void );
@@ -1695,6 +1697,8 @@ static void HandleModCtrl(UINT32 const key, UIEventKind* const new_event)
 
 		case 'k': if (CHEATER_CHEAT_LEVEL()) GrenadeTest2();           break;
 
+		case 'p': if (INFORMATION_CHEAT_LEVEL()) LogScriptingHookStats(); break;
+
 		case 'l':
 			if (!(gTacticalStatus.uiFlags & ENGAGED_IN_CONV))
 			{
@@ -2796,6 +2800,17 @@ static void SwitchHeadGear(bool dayGear)
 	}
 }
 
+// Logs the calls of and the time spent in each Lua listener
+static void LogScriptingHookStats()
+{
+	std::vector<ScriptingHookStats> const stats = GetScriptingHookStats();
+	for (ScriptingHookStats const& s : stats)
+	{
+		STLOGI("Lua listener {} for {}: {} calls, {}us", s.function, s.observable, s.calls, s.totalMicroseconds);
+	}
+	ScreenMsg(FONT_MCOLOR_LTYELLOW, MSG_INTERFACE, ST::format("Logged the timings of {} Lua listeners", stats.size()));
+}
+
 static void ObliterateSector()
 {
 	SLOGD("Obliterating Sector!");
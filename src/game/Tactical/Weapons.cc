@@ -2667,16 +2667,16 @@ INT32 CalcBodyImpactReduction( UINT8 ubAmmoType, UINT8 ubHitLocation )
 }
 
 
-static INT32 ArmourProtection(SOLDIERTYPE const& pTarget, UINT8 const ubArmourType, INT8* const pbStatus, INT32 const iImpact, UINT8 const ubAmmoType)
+INT32 ArmourProtection(UINT8 const ubArmourType, INT8* const pbStatus, INT32 const iImpact, UINT8 const ubAmmoType, BOOLEAN const fRobot, UINT32 const uiWeakSpot)
 {
 	INT32 iProtection, iAppliedProtection, iFailure;
 
 	iProtection = Armour[ ubArmourType ].ubProtection;
 
-	if (!AM_A_ROBOT(&pTarget))
+	if (!fRobot)
 	{
 		// check for the bullet hitting a weak spot in the armour
-		iFailure = PreRandom( 100 ) + 1 - *pbStatus;
+		iFailure = uiWeakSpot - *pbStatus;
 		if (iFailure > 0)
 		{
 			iProtection -= iFailure;
@@ -2736,7 +2736,7 @@ static INT32 ArmourProtection(SOLDIERTYPE const& pTarget, UINT8 const ubArmourTy
 		iProtection /= 2;
 	}
 
-	if (!AM_A_ROBOT(&pTarget))
+	if (!fRobot)
 	{
 		*pbStatus -= (iAppliedProtection * Armour[ubArmourType].ubDegradePercent) / 100;
 	}
@@ -2746,6 +2746,14 @@ static INT32 ArmourProtection(SOLDIERTYPE const& pTarget, UINT8 const ubArmourTy
 }
 
 
+static INT32 ArmourProtection(SOLDIERTYPE const& pTarget, UINT8 const ubArmourType, INT8* const pbStatus, INT32 const iImpact, UINT8 const ubAmmoType)
+{
+	BOOLEAN const fRobot = AM_A_ROBOT(&pTarget);
+	UINT32  const uiWeakSpot = fRobot ? 0 : PreRandom( 100 ) + 1;
+	return ArmourProtection(ubArmourType, pbStatus, iImpact, ubAmmoType, fRobot, uiWeakSpot);
+}
+
+
 INT32 TotalArmourProtection(SOLDIERTYPE& pTarget, const UINT8 ubHitLocation, const INT32 iImpact, const UINT8 ubAmmoType)
 {
 	INT32      iTotalProtection = 0, iSlot;
@@ -181,6 +181,10 @@ void ReloadWeapon(SOLDIERTYPE*, UINT8 inv_pos);
 bool IsGunBurstCapable(SOLDIERTYPE const*, UINT8 inv_pos);
 extern INT32 CalcBodyImpactReduction( UINT8 ubAmmoType, UINT8 ubHitLocation );
 INT32 TotalArmourProtection(SOLDIERTYPE&, UINT8 ubHitLocation, INT32 iImpact, UINT8 ubAmmoType);
+/* Protection of one piece of armour against a hit, wearing the armour down.
+ * uiWeakSpot is the 1-100 roll for the hit finding a weak spot; the armour of
+ * the robot has none and does not wear. */
+INT32 ArmourProtection(UINT8 ubArmourType, INT8* pbStatus, INT32 iImpact, UINT8 ubAmmoType, BOOLEAN fRobot, UINT32 uiWeakSpot);
 INT8 ArmourPercent(const SOLDIERTYPE* pSoldier);
 
 extern void GetTargetWorldPositions( SOLDIERTYPE *pSoldier, INT16 sTargetGridNo, FLOAT *pdXPos, FLOAT *pdYPos, FLOAT *pdZPos );
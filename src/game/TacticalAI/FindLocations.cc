@@ -7,6 +7,7 @@
 #include "AIInternals.h"
 #include "LOS.h"
 #include "Soldier_Profile.h"
+#include "Soldier_Index.h"
 #include "Structure.h"
 #include "Weapons.h"
 #include "OppList.h"
@@ -224,6 +225,7 @@ static INT8 CalcBestCTGT(SOLDIERTYPE* const pSoldier, const SOLDIERTYPE* const o
 					// NOTE: GOTTA SET THESE 3 FIELDS *BACK* AFTER USING THIS FUNCTION!!!
 					pSoldier->sGridNo = sAdjSpot;     // pretend he's standing at 'sAdjSpot'
 					AICenterXY( sAdjSpot, &(pSoldier->dXPos), &(pSoldier->dYPos) );
+					SoldierIndexUpdate(*pSoldier);
 					bThisCTGT = CalcWorstCTGTForPosition(pSoldier, opponent, sOppGridNo, bLevel, iMyAPsLeft);
 					if (bThisCTGT > bBestCTGT)
 					{
@@ -273,6 +275,7 @@ static INT32 CalcCoverValue(SOLDIERTYPE* pMe, INT16 sMyGridNo, INT32 iMyThreat,
 		ConvertGridNoToCenterCellXY( sMyGridNo, &sTempX, &sTempY );
 		pMe->dXPos = (FLOAT) sTempX;
 		pMe->dYPos = (FLOAT) sTempY;
+		SoldierIndexUpdate(*pMe);
 	}
 
 	// if this is theoretical, and he's not actually at hisGrid right now
@@ -286,6 +289,7 @@ static INT32 CalcCoverValue(SOLDIERTYPE* pMe, INT16 sMyGridNo, INT32 iMyThreat,
 		ConvertGridNoToCenterCellXY( sHisGridNo, &sTempX, &sTempY );
 		pHim->dXPos = (FLOAT) sTempX;
 		pHim->dYPos = (FLOAT) sTempY;
+		SoldierIndexUpdate(*pHim);
 	}
 
 
@@ -342,6 +346,7 @@ static INT32 CalcCoverValue(SOLDIERTYPE* pMe, INT16 sMyGridNo, INT32 iMyThreat,
 			ConvertGridNoToCenterCellXY( sHisGridNo, &sTempX, &sTempY );
 			pHim->dXPos = (FLOAT) sTempX;
 			pHim->dYPos = (FLOAT) sTempY;
+			SoldierIndexUpdate(*pHim);
 		}
 		// bMyCTGT = ChanceToGetThrough(pMe,sHisGridNo,FAKE,ACTUAL,TESTWALLS,9999,M9PISTOL,NOT_FOR_LOS); // assume a gunshot
 		// bMyCTGT = SoldierToLocationChanceToGetThrough( pMe, sHisGridNo, pMe->bTargetLevel, pMe->bTargetCubeLevel );
@@ -365,6 +370,7 @@ static INT32 CalcCoverValue(SOLDIERTYPE* pMe, INT16 sMyGridNo, INT32 iMyThreat,
 		pMe->sGridNo = sMyRealGridNo;        // put me back where I belong!
 		pMe->dXPos = dMyX;                      // also change the 'x'
 		pMe->dYPos = dMyY;                      // and the 'y'
+		SoldierIndexUpdate(*pMe);
 	}
 
 	if (sHisRealGridNo != NOWHERE)
@@ -372,6 +378,7 @@ static INT32 CalcCoverValue(SOLDIERTYPE* pMe, INT16 sMyGridNo, INT32 iMyThreat,
 		pHim->sGridNo = sHisRealGridNo;      // put HIM back where HE belongs!
 		pHim->dXPos = dHisX;                    // also change the 'x'
 		pHim->dYPos = dHisY;                    // and the 'y'
+		SoldierIndexUpdate(*pHim);
 	}
 
 
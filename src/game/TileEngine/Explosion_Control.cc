@@ -59,6 +59,7 @@
 #include "TileDef.h"
 #include "Tile_Animation.h"
 #include "Timer_Control.h"
+#include "VObject.h"
 #include "Weapons.h"
 #include "WorldDat.h"
 #include "WorldDef.h"
@@ -98,6 +99,21 @@ BOOLEAN                      gfExplosionQueueActive      = FALSE;
 static BOOLEAN      gfExplosionQueueMayHaveChangedSight = FALSE;
 static SOLDIERTYPE* gPersonToSetOffExplosions           = 0;
 
+/* Structures changed by an explosion change which tiles are hidden behind
+ * others. Instead of invalidating the redundancy of the whole world for each
+ * of them, the area the changed images reach is collected and invalidated
+ * together with a single redraw once the explosion has spread. Movement costs
+ * are still recompiled as the explosion goes, its rays depend on them. */
+struct ExplosionDamageArea
+{
+	BOOLEAN fDamaged;
+	INT16   sLeft;
+	INT16   sTop;
+	INT16   sRight;
+	INT16   sBottom;
+};
+static ExplosionDamageArea gExplosionDamage;
+
 #define NUM_EXPLOSION_SLOTS 100
 static EXPLOSIONTYPE gExplosionData[NUM_EXPLOSION_SLOTS];
 
@@ -284,6 +300,60 @@ void RemoveExplosionData(EXPLOSIONTYPE* const e)
 }
 
 
+/* Returns how many tiles away from the tile it stands on an image may cover
+ * the land, on level ground. The image is blitted relative to the top left
+ * corner of the box of its tile. Each tile further east or south moves that box
+ * by half its width across and half its height down the screen, so the reach
+ * is counted in these steps of x - y across and x + y down. */
+static INT16 RedundencyMargin(ETRLEObject const& e)
+{
+	INT32 const across = MAX(ABS(e.sOffsetX - WORLD_TILE_X), ABS(e.sOffsetX + e.usWidth))  / (WORLD_TILE_X / 2) + 1;
+	INT32 const down   = MAX(ABS(e.sOffsetY - WORLD_TILE_Y), ABS(e.sOffsetY + e.usHeight)) / (WORLD_TILE_Y / 2) + 1;
+	return (across + down + 1) / 2;
+}
+
+
+static void AddExplosionDamage(GridNo const grid_no, INT16 const margin)
+{
+	INT16 const x = grid_no % WORLD_COLS;
+	INT16 const y = grid_no / WORLD_COLS;
+	ExplosionDamageArea& a = gExplosionDamage;
+	if (!a.fDamaged)
+	{
+		a = ExplosionDamageArea{ TRUE, INT16(x - margin), INT16(y - margin), INT16(x + margin), INT16(y + margin) };
+		return;
+	}
+	a.sLeft   = MIN(a.sLeft,   x - margin);
+	a.sTop    = MIN(a.sTop,    y - margin);
+	a.sRight  = MAX(a.sRight,  x + margin);
+	a.sBottom = MAX(a.sBottom, y + margin);
+}
+
+
+// Records that the image of a structure tile appeared or vanished at grid_no
+static void AddExplosionDamage(GridNo const grid_no, UINT16 const tile_idx)
+{
+	if (tile_idx >= NUMBEROFTILES) return;
+	TILE_ELEMENT const& te = gTileDatabase[tile_idx];
+	if (!te.hTileSurface) return;
+	AddExplosionDamage(grid_no, RedundencyMargin(te.hTileSurface->SubregionProperties(te.usRegionIndex)));
+}
+
+
+static void ApplyExplosionDamage()
+{
+	ExplosionDamageArea& a = gExplosionDamage;
+	if (!a.fDamaged) return;
+
+	// Rerender world!
+	// Reevaluate redundancy around the changes
+	gTacticalStatus.uiFlags |= NOHIDE_REDUNDENCY;
+	InvalidateWorldRedundencyInArea(a.sLeft, a.sTop, a.sRight, a.sBottom);
+	SetRenderFlags(RENDER_FLAG_FULL);
+	a.fDamaged = FALSE;
+}
+
+
 static void HandleFencePartnerCheck(INT16 sStructGridNo)
 {
 	STRUCTURE *pFenceStructure, *pFenceBaseStructure;
@@ -311,6 +381,8 @@ static void HandleFencePartnerCheck(INT16 sStructGridNo)
 			UINT16 usTileIndex = GetTileIndexFromTypeSubIndex(uiFenceType, bFenceDestructionPartner);
 
 			ApplyMapChangesToMapTempFile app;
+			AddExplosionDamage(pFenceBaseStructure->sGridNo, pFenceNode->usIndex);
+			AddExplosionDamage(pFenceBaseStructure->sGridNo, usTileIndex);
 			// Remove it!
 			RemoveStructFromLevelNode( pFenceBaseStructure->sGridNo, pFenceNode );
 			// Add it!
@@ -328,6 +400,8 @@ static void ReplaceWall(GridNo const grid_no, UINT8 const orientation, INT16 con
 	LEVELNODE* const node    = FindLevelNodeBasedOnStructure(wall_struct);
 	UINT16     const new_idx = GetTileIndexFromTypeSubIndex(gTileDatabase[node->usIndex].fType, sub_idx);
 	ApplyMapChangesToMapTempFile app;
+	AddExplosionDamage(grid_no, node->usIndex);
+	AddExplosionDamage(grid_no, new_idx);
 	RemoveStructFromLevelNode(grid_no, node);
 	AddWallToStructLayer(grid_no, new_idx, TRUE);
 }
@@ -351,6 +425,7 @@ static STRUCTURE* RemoveOnWall(GridNo const grid_no, StructureFlags const flags,
 
 		LEVELNODE* const node = FindLevelNodeBasedOnStructure(base);
 		ApplyMapChangesToMapTempFile app;
+		AddExplosionDamage(base->sGridNo, node->usIndex);
 		RemoveStructFromLevelNode(base->sGridNo, node);
 	}
 	return next;
@@ -590,6 +665,8 @@ static bool ExplosiveDamageStructureAtGridNo(STRUCTURE* const pCurrent, STRUCTUR
 			RecompileLocalMovementCostsForWall(base_grid_no, base->ubWallOrientation);
 		}
 
+		// Rerender world and reevaluate redundancy once the explosion has spread
+		AddExplosionDamage(base_grid_no, node->usIndex);
 		{ ApplyMapChangesToMapTempFile app;
 			RemoveStructFromLevelNode(base_grid_no, node);
 		}
@@ -598,16 +675,11 @@ static bool ExplosiveDamageStructureAtGridNo(STRUCTURE* const pCurrent, STRUCTUR
 		if (fContinue == 2)
 		{ // We have a levelnode, get new index for new graphic
 			UINT16 const tile_idx = GetTileIndexFromTypeSubIndex(tile_type, destruction_partner);
+			AddExplosionDamage(base_grid_no, tile_idx);
 			ApplyMapChangesToMapTempFile app;
 			AddStructToHead(base_grid_no, tile_idx);
 		}
 
-		// Rerender world!
-		// Reevaluate world movement costs, redundancy!
-		gTacticalStatus.uiFlags |= NOHIDE_REDUNDENCY;
-		// For the next render loop, re-evaluate redundent tiles
-		InvalidateWorldRedundency();
-		SetRenderFlags(RENDER_FLAG_FULL);
 		// Movement costs!
 		*pfRecompileMovementCosts = TRUE;
 
@@ -1516,16 +1588,8 @@ static void GetRayStopInfo(UINT32 uiNewSpot, UINT8 ubDir, INT8 bLevel, BOOLEAN f
 }
 
 
-void SpreadEffect(const INT16 sGridNo, const UINT8 ubRadius, const UINT16 usItem, SOLDIERTYPE* const owner, const BOOLEAN fSubsequent, const INT8 bLevel, const SMOKEEFFECT* const smoke)
+static BOOLEAN IsSmokeEffectItem(UINT16 const usItem)
 {
-	INT32   uiNewSpot, uiTempSpot, uiBranchSpot, branchCnt;
-	INT32   uiTempRange, ubBranchRange;
-	UINT8   ubDir,ubBranchDir, ubKeepGoing;
-	INT16   sRange;
-	BOOLEAN fRecompileMovement = FALSE;
-	BOOLEAN fAnyMercHit = FALSE;
-	BOOLEAN fSmokeEffect = FALSE;
-
 	switch( usItem )
 	{
 		case MUSTARD_GRENADE:
@@ -1537,24 +1601,30 @@ void SpreadEffect(const INT16 sGridNo, const UINT8 ubRadius, const UINT16 usItem
 		case SMALL_CREATURE_GAS:
 		case LARGE_CREATURE_GAS:
 		case VERY_SMALL_CREATURE_GAS:
-			fSmokeEffect = TRUE;
-			break;
+			return TRUE;
+
+		default:
+			return FALSE;
 	}
+}
 
-	// Set values for recompile region to optimize area we need to recompile for MPs
-	gsRecompileAreaTop = sGridNo / WORLD_COLS;
-	gsRecompileAreaLeft = sGridNo % WORLD_COLS;
-	gsRecompileAreaRight = gsRecompileAreaLeft;
-	gsRecompileAreaBottom = gsRecompileAreaTop;
+
+/* Walks the rays of an effect with the given radius and calls
+ * affect(gridno, distance) for every tile they reach, the center first. The
+ * rays are checked as they go, so affect() may change what stops them. */
+template<typename Affect>
+static void WalkSpreadEffect(const INT16 sGridNo, const UINT8 ubRadius, const INT8 bLevel, const BOOLEAN fSmokeEffect, Affect&& affect)
+{
+	INT32   uiNewSpot, uiTempSpot, uiBranchSpot, branchCnt;
+	INT32   uiTempRange, ubBranchRange;
+	UINT8   ubDir,ubBranchDir, ubKeepGoing;
+	INT16   sRange;
 
 	// multiply range by 2 so we can correctly calculate approximately round explosion regions
 	sRange = ubRadius * 2;
 
 	// first, affect main spot
-	if (ExpAffect(sGridNo, sGridNo, 0, usItem, owner, fSubsequent, &fAnyMercHit, bLevel, smoke))
-	{
-		fRecompileMovement = TRUE;
-	}
+	affect(sGridNo, 0);
 
 
 	for (ubDir = NORTH; ubDir <= NORTHWEST; ubDir++ )
@@ -1595,10 +1665,7 @@ void SpreadEffect(const INT16 sGridNo, const UINT8 ubRadius, const UINT16 usItem
 
 				SLOGD("Explosion affects %d", uiNewSpot);
 				// ok, do what we do here...
-				if (ExpAffect(sGridNo, uiNewSpot, cnt / 2, usItem, owner, fSubsequent, &fAnyMercHit, bLevel, smoke))
-				{
-					fRecompileMovement = TRUE;
-				}
+				affect(uiNewSpot, cnt / 2);
 
 				// how far should we branch out here?
 				ubBranchRange = (UINT8)( sRange - cnt );
@@ -1634,10 +1701,7 @@ void SpreadEffect(const INT16 sGridNo, const UINT8 ubRadius, const UINT16 usItem
 							{
 								// ok, do what we do here
 								SLOGD("Explosion affects %d", uiNewSpot);
-								if (ExpAffect(sGridNo, uiNewSpot, (INT16)((cnt + branchCnt) / 2), usItem, owner, fSubsequent, &fAnyMercHit, bLevel, smoke))
-								{
-									fRecompileMovement = TRUE;
-								}
+								affect(uiNewSpot, (INT16)((cnt + branchCnt) / 2));
 								uiBranchSpot = uiNewSpot;
 							}
 							//else
@@ -1681,6 +1745,22 @@ void SpreadEffect(const INT16 sGridNo, const UINT8 ubRadius, const UINT16 usItem
 		}
 
 	} // end of dir loop
+}
+
+
+static void BeginSpreadEffect(const INT16 sGridNo)
+{
+	// Set values for recompile region to optimize area we need to recompile for MPs
+	gsRecompileAreaTop = sGridNo / WORLD_COLS;
+	gsRecompileAreaLeft = sGridNo % WORLD_COLS;
+	gsRecompileAreaRight = gsRecompileAreaLeft;
+	gsRecompileAreaBottom = gsRecompileAreaTop;
+}
+
+
+static void EndSpreadEffect(const INT16 sGridNo, const UINT8 ubRadius, const UINT16 usItem, const BOOLEAN fSubsequent, const INT8 bLevel, const BOOLEAN fSmokeEffect, const BOOLEAN fRecompileMovement, const BOOLEAN fAnyMercHit)
+{
+	ApplyExplosionDamage();
 
 	// Recompile movement costs...
 	if ( fRecompileMovement )
@@ -1728,12 +1808,61 @@ void SpreadEffect(const INT16 sGridNo, const UINT8 ubRadius, const UINT16 usItem
 }
 
 
+void SpreadEffect(const INT16 sGridNo, const UINT8 ubRadius, const UINT16 usItem, SOLDIERTYPE* const owner, const BOOLEAN fSubsequent, const INT8 bLevel, const SMOKEEFFECT* const smoke)
+{
+	BOOLEAN fRecompileMovement = FALSE;
+	BOOLEAN fAnyMercHit = FALSE;
+	BOOLEAN const fSmokeEffect = IsSmokeEffectItem(usItem);
+
+	BeginSpreadEffect(sGridNo);
+
+	WalkSpreadEffect(sGridNo, ubRadius, bLevel, fSmokeEffect, [&](INT16 const sNewGridNo, UINT32 const uiDist)
+	{
+		if (ExpAffect(sGridNo, sNewGridNo, uiDist, usItem, owner, fSubsequent, &fAnyMercHit, bLevel, smoke))
+		{
+			fRecompileMovement = TRUE;
+		}
+	});
+
+	EndSpreadEffect(sGridNo, ubRadius, usItem, fSubsequent, bLevel, fSmokeEffect, fRecompileMovement, fAnyMercHit);
+}
+
+
 void SpreadEffectSmoke(const SMOKEEFFECT* const s, const BOOLEAN subsequent, const INT8 level)
 {
 	SpreadEffect(s->sGridNo, s->ubRadius, s->usItem, s->owner, subsequent, level, s);
 }
 
 
+void GetSmokeEffectTiles(const SMOKEEFFECT* const s, const INT8 level, std::vector<SPREAD_TILE>& tiles)
+{
+	tiles.clear();
+	WalkSpreadEffect(s->sGridNo, s->ubRadius, level, TRUE, [&](INT16 const sGridNo, UINT32 const uiDist)
+	{
+		tiles.push_back(SPREAD_TILE{ sGridNo, (UINT8)uiDist });
+	});
+}
+
+
+void SpreadEffectSmokeOnTiles(const SMOKEEFFECT* const s, const BOOLEAN subsequent, const INT8 level, const std::vector<SPREAD_TILE>& tiles)
+{
+	BOOLEAN fRecompileMovement = FALSE;
+	BOOLEAN fAnyMercHit = FALSE;
+
+	BeginSpreadEffect(s->sGridNo);
+
+	for (const SPREAD_TILE& t : tiles)
+	{
+		if (ExpAffect(s->sGridNo, t.sGridNo, t.ubDist, s->usItem, s->owner, subsequent, &fAnyMercHit, level, s))
+		{
+			fRecompileMovement = TRUE;
+		}
+	}
+
+	EndSpreadEffect(s->sGridNo, s->ubRadius, s->usItem, subsequent, level, TRUE, fRecompileMovement, fAnyMercHit);
+}
+
+
 static void ToggleActionItemsByFrequency(INT8 bFrequency)
 {
 	// Go through all the bombs in the world, and look for remote ones
@@ -2655,3 +2784,92 @@ void RemoveAllActiveTimedBombs(void)
 		RemoveItemFromWorld(item_idx);
 	}
 }
+
+
+#ifdef WITH_UNITTESTS
+#include "gtest/gtest.h"
+
+TEST(ExplosionControl, redundencyMarginCoversImage)
+{
+	// Wall, tall building piece, wide roof piece, and an image off its tile
+	ETRLEObject images[4] = {};
+	images[0].sOffsetX = 0;   images[0].sOffsetY = -45;  images[0].usWidth = 22; images[0].usHeight = 65;
+	images[1].sOffsetX = -2;  images[1].sOffsetY = -120; images[1].usWidth = 42; images[1].usHeight = 140;
+	images[2].sOffsetX = -40; images[2].sOffsetY = -30;  images[2].usWidth = 120; images[2].usHeight = 50;
+	images[3].sOffsetX = 35;  images[3].sOffsetY = 15;   images[3].usWidth = 10; images[3].usHeight = 10;
+
+	for (ETRLEObject const& e : images)
+	{
+		INT16 const margin = RedundencyMargin(e);
+		// Every tile whose land box the image overlaps lies within the margin
+		for (INT32 dy = -30; dy <= 30; ++dy)
+		{
+			for (INT32 dx = -30; dx <= 30; ++dx)
+			{
+				INT32 const x = (dx - dy) * WORLD_TILE_X / 2;
+				INT32 const y = (dx + dy) * WORLD_TILE_Y / 2;
+				bool const overlaps =
+					x < e.sOffsetX + e.usWidth  && e.sOffsetX < x + WORLD_TILE_X &&
+					y < e.sOffsetY + e.usHeight && e.sOffsetY < y + WORLD_TILE_Y;
+				if (!overlaps) continue;
+				EXPECT_LE(ABS(dx), margin);
+				EXPECT_LE(ABS(dy), margin);
+			}
+		}
+	}
+}
+
+TEST(ExplosionControl, batchedDamageCoversChangedTiles)
+{
+	MAP_ELEMENT* const saved_world = gpWorldLevelData;
+	UINT32       const saved_flags = gTacticalStatus.uiFlags;
+	std::vector<MAP_ELEMENT> world(WORLD_MAX);
+	gpWorldLevelData = world.data();
+
+	struct Change { GridNo grid_no; INT16 margin; };
+	Change const changes[] = { { 5 * WORLD_COLS + 2, 4 }, { 20 * WORLD_COLS + 30, 7 }, { 12 * WORLD_COLS + 9, 2 } };
+
+	// What the whole world invalidation used before marked
+	InvalidateWorldRedundency();
+	std::vector<MAP_ELEMENT> const whole_world = world;
+
+	// Invalidated once after all changes
+	world.assign(WORLD_MAX, MAP_ELEMENT{});
+	gTacticalStatus.uiFlags = 0;
+	for (Change const& c : changes) AddExplosionDamage(c.grid_no, c.margin);
+	ApplyExplosionDamage();
+	EXPECT_TRUE(gTacticalStatus.uiFlags & NOHIDE_REDUNDENCY);
+
+	// Every tile an image change reaches is marked like the whole world
+	// invalidation marked it, and the batch stays within the box of all changes
+	INT16 const left   = 2 - 4;
+	INT16 const top    = 5 - 4;
+	INT16 const right  = 30 + 7;
+	INT16 const bottom = 20 + 7;
+	for (GridNo g = 0; g != WORLD_MAX; ++g)
+	{
+		INT16 const x = g % WORLD_COLS;
+		INT16 const y = g / WORLD_COLS;
+		bool changed = false;
+		for (Change const& c : changes)
+		{
+			changed |=
+				ABS(x - c.grid_no % WORLD_COLS) <= c.margin &&
+				ABS(y - c.grid_no / WORLD_COLS) <= c.margin;
+		}
+
+		UINT32 const batched = world[g].uiFlags & MAPELEMENT_REEVALUATE_REDUNDENCY;
+		if (changed) EXPECT_EQ(batched, whole_world[g].uiFlags & MAPELEMENT_REEVALUATE_REDUNDENCY) << "tile " << g;
+		EXPECT_EQ(batched != 0, left <= x && x <= right && top <= y && y <= bottom) << "tile " << g;
+	}
+
+	// The changes are applied once
+	world.assign(WORLD_MAX, MAP_ELEMENT{});
+	ApplyExplosionDamage();
+	EXPECT_FALSE(world[changes[0].grid_no].uiFlags & MAPELEMENT_REEVALUATE_REDUNDENCY);
+
+	gpWorldLevelData        = saved_world;
+	gTacticalStatus.uiFlags = saved_flags;
+}
+
+#endif
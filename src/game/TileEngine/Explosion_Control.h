@@ -5,6 +5,8 @@
 #include "Weapons.h"
 #include "Observable.h"
 
+#include <vector>
+
 #define MAX_DISTANCE_EXPLOSIVE_CAN_DESTROY_STRUCTURES 2
 
 
@@ -70,6 +72,19 @@ void InternalIgniteExplosion(SOLDIERTYPE* owner, INT16 sX, INT16 sY, INT16 sZ, I
 void SpreadEffect(INT16 sGridNo, UINT8 ubRadius, UINT16 usItem, SOLDIERTYPE* owner, BOOLEAN fSubsequent, INT8 bLevel, const SMOKEEFFECT* s);
 void SpreadEffectSmoke(const SMOKEEFFECT* s, BOOLEAN subsequent, INT8 level);
 
+// A tile reached by the spread of an effect and its distance from the center
+struct SPREAD_TILE
+{
+	INT16 sGridNo;
+	UINT8 ubDist;
+};
+
+// Collects the tiles SpreadEffectSmoke() would affect, in the same order
+void GetSmokeEffectTiles(const SMOKEEFFECT* s, INT8 level, std::vector<SPREAD_TILE>& tiles);
+
+// Like SpreadEffectSmoke(), but affects only the given tiles of the cloud
+void SpreadEffectSmokeOnTiles(const SMOKEEFFECT* s, BOOLEAN subsequent, INT8 level, const std::vector<SPREAD_TILE>& tiles);
+
 void DecayBombTimers( void );
 void SetOffBombsByFrequency(SOLDIERTYPE* s, INT8 bFrequency);
 BOOLEAN SetOffBombsInGridNo(SOLDIERTYPE* s, INT16 sGridNo, BOOLEAN fAllBombs, INT8 bLevel);
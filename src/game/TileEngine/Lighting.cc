@@ -35,6 +35,7 @@
 #include "Sys_Globals.h"
 #include "TileDef.h"
 #include "Lighting.h"
+#include "Overhead_Map.h"
 #include "Structure_Wrap.h"
 #include "Rotting_Corpses.h"
 #include "FileMan.h"
@@ -53,6 +54,7 @@
 #include <iterator>
 #include <sstream>
 #include <stdexcept>
+#include <tuple>
 #include <vector>
 
 #define MAX_LIGHT_TEMPLATES 32 // maximum number of light types
@@ -88,6 +90,51 @@ static LightTemplate g_light_templates[MAX_LIGHT_TEMPLATES];
 // Sprite data
 LIGHT_SPRITE	LightSprites[MAX_LIGHT_SPRITES];
 
+/* One tile lit by a light sprite, with everything LightAddTile() needs to
+	* apply it. The list of these is the result of casting the rays of a light
+	* against the world structures at its current position, so it serves as the
+	* occlusion mask of that light: erasing replays it instead of casting the rays
+	* again, and moving the light only touches tiles whose contribution changed. */
+struct LightContribution
+{
+	INT16   iSrcX;
+	INT16   iSrcY;
+	INT16   iX;
+	INT16   iY;
+	UINT32  uiFlags;
+	UINT8   ubShade;
+	BOOLEAN fOnlyWalls;
+
+	bool operator<(const LightContribution& o) const
+	{
+		return std::tie(iX, iY, iSrcX, iSrcY, uiFlags, ubShade, fOnlyWalls) <
+			std::tie(o.iX, o.iY, o.iSrcX, o.iSrcY, o.uiFlags, o.ubShade, o.fOnlyWalls);
+	}
+};
+
+// What each light sprite contributed when it was last drawn, sorted
+static std::vector<LightContribution> g_light_contributions[MAX_LIGHT_SPRITES];
+
+
+static std::vector<LightContribution>& LightContributions(const LIGHT_SPRITE* const l)
+{
+	return g_light_contributions[l - LightSprites];
+}
+
+/* When a LEVELNODE was last added to each tile and when each light sprite was
+	* last drawn, counted in added LEVELNODEs */
+static UINT32 g_light_nodes_added = 0;
+static UINT32 g_light_tile_node_added[WORLD_MAX];
+static UINT32 g_light_drawn[MAX_LIGHT_SPRITES];
+
+
+void LightTileNodeAdded(const UINT32 tile)
+{
+	if (tile >= WORLD_MAX) return;
+	g_light_tile_node_added[tile] = ++g_light_nodes_added;
+}
+
+
 // Lighting system general data
 UINT8 ubAmbientLightLevel = DEFAULT_SHADE_LEVEL;
 
@@ -249,6 +296,10 @@ void LightReset(void)
 
 	// init all light sprites
 	std::fill(std::begin(LightSprites), std::end(LightSprites), LIGHT_SPRITE{});
+	for (std::vector<LightContribution>& c : g_light_contributions) c.clear();
+	std::fill(std::begin(g_light_drawn), std::end(g_light_drawn), 0);
+	std::fill(std::begin(g_light_tile_node_added), std::end(g_light_tile_node_added), 0);
+	g_light_nodes_added = 0;
 
 	LightLoad("TRANSLUC.LHT");
 
@@ -621,6 +672,7 @@ static BOOLEAN LightAddTile(const INT16 iSrcX, const INT16 iSrcY, const INT16 iX
 	}
 
 	gpWorldLevelData[uiTile].uiFlags|=MAPELEMENT_REDRAW;
+	InvalidateOverheadTile(uiTile);
 
 	//if((uiFlags&LIGHT_BACKLIGHT) && !(uiFlags&LIGHT_ROOF_ONLY))
 	//	ubShadeAdd = ubShade*7/10;
@@ -757,6 +809,7 @@ static BOOLEAN LightSubtractTile(const INT16 iSrcX, const INT16 iSrcY, const INT
 
 
 	gpWorldLevelData[uiTile].uiFlags|=MAPELEMENT_REDRAW;
+	InvalidateOverheadTile(uiTile);
 
 //	if((uiFlags&LIGHT_BACKLIGHT) && !(uiFlags&LIGHT_ROOF_ONLY))
 //		ubShadeSubtract=ubShade*7/10;
@@ -885,13 +938,15 @@ static void LightSetNaturalLevel(LEVELNODE* n, UINT8 const shade)
 		n->ubMaxLights         = 0;
 		n->ubNaturalShadeLevel = shade;
 		n->ubShadeLevel        = shade;
+		n->ubFakeShadeLevel    = 0;
 	}
 }
 
 
 /* Set the natural light value of all objects on a given tile to the specified
 	* value.  This is the light value a tile has with no artificial lighting
-	* affecting it. */
+	* affecting it. Any artificial lighting is cleared as well, which leaves the
+	* tile in the same state as LightResetAllTiles() would. */
 static void LightSetNaturalTile(MAP_ELEMENT const& e, UINT8 shade)
 {
 	LightSetNaturalLevel(e.pLandHead,    shade);
@@ -921,6 +976,7 @@ static void LightResetLevel(LEVELNODE* n)
 // Reset all tiles on the map to their baseline values.
 static void LightResetAllTiles(void)
 {
+	InvalidateOverheadRaster();
 	FOR_EACH_WORLD_TILE(i)
 	{
 		LightResetLevel(i->pLandHead);
@@ -1426,6 +1482,8 @@ static void LightGenerateElliptical(LightTemplate* const t, const UINT8 iIntensi
 	}
 }
 
+static void LightSpriteDrawAll();
+
 /****************************************************************************************
 	LightSetBaseLevel
 
@@ -1449,12 +1507,15 @@ void LightSetBaseLevel(UINT8 iIntensity)
 	UINT16 shade = iIntensity;
 	shade = __max(SHADE_MAX, shade);
 	shade = __min(SHADE_MIN, shade);
+	InvalidateOverheadRaster();
 	FOR_EACH_WORLD_TILE(i)
 	{
 		LightSetNaturalTile(*i, shade);
 	}
 
-	LightSpriteRenderAll();
+	// the pass above already cleared all artificial light, so skip the reset
+	// LightSpriteRenderAll() would do and walk the world only once
+	LightSpriteDrawAll();
 
 	if(iIntensity >= LIGHT_DUSK_CUTOFF)
 		RenderSetShadows(FALSE);
@@ -1467,6 +1528,7 @@ void LightAddBaseLevel(const UINT8 iIntensity)
 {
 	INT16 iCountY, iCountX;
 
+	InvalidateOverheadRaster();
 	ubAmbientLightLevel=__max(SHADE_MAX, ubAmbientLightLevel-iIntensity);
 
 	for(iCountY=0; iCountY < WORLD_ROWS; iCountY++)
@@ -1484,6 +1546,7 @@ void LightSubtractBaseLevel(const UINT8 iIntensity)
 {
 	INT16 iCountY, iCountX;
 
+	InvalidateOverheadRaster();
 	ubAmbientLightLevel=__min(SHADE_MIN, ubAmbientLightLevel+iIntensity);
 
 	for(iCountY=0; iCountY < WORLD_ROWS; iCountY++)
@@ -1540,15 +1603,18 @@ static BOOLEAN LightIlluminateWall(INT16 iSourceX, INT16 iSourceY, INT16 iTileX,
 }
 
 
-BOOLEAN LightDraw(const LIGHT_SPRITE* const l)
+/* Casts the rays of a light sprite at its current position and collects the
+	* tiles it lights, without changing any light levels. */
+static void LightCollectContributions(const LIGHT_SPRITE* const l, std::vector<LightContribution>& out)
 {
 	UINT32  uiFlags;
 	INT32   iOldX, iOldY;
 	BOOLEAN fBlocked = FALSE;
 	BOOLEAN fOnlyWalls;
 
+	out.clear();
+
 	LightTemplate* const t = l->light_template;
-	if (t->lights.empty()) return FALSE;
 
 	// clear out all the flags
 	for (LIGHT_NODE& light : t->lights)
@@ -1590,7 +1656,15 @@ BOOLEAN LightDraw(const LIGHT_SPRITE* const l)
 				if (l->uiFlags & MERC_LIGHT)       uiFlags |= LIGHT_FAKE;
 				if (l->uiFlags & LIGHT_SPR_ONROOF) uiFlags |= LIGHT_ROOF_ONLY;
 
-				LightAddTile(iOldX, iOldY, iX + pLight->iDX, iY + pLight->iDY, pLight->ubLight, uiFlags, fOnlyWalls);
+				LightContribution c;
+				c.iSrcX      = (INT16)iOldX;
+				c.iSrcY      = (INT16)iOldY;
+				c.iX         = iX + pLight->iDX;
+				c.iY         = iY + pLight->iDY;
+				c.uiFlags    = uiFlags;
+				c.ubShade    = pLight->ubLight;
+				c.fOnlyWalls = fOnlyWalls;
+				out.push_back(c);
 
 				pLight->uiFlags|=LIGHT_NODE_DRAWN;
 			}
@@ -1614,6 +1688,36 @@ BOOLEAN LightDraw(const LIGHT_SPRITE* const l)
 		}
 	}
 
+	std::sort(out.begin(), out.end());
+}
+
+
+static void LightAddContributions(const std::vector<LightContribution>& contributions)
+{
+	for (const LightContribution& c : contributions)
+	{
+		LightAddTile(c.iSrcX, c.iSrcY, c.iX, c.iY, c.ubShade, c.uiFlags, c.fOnlyWalls);
+	}
+}
+
+
+static void LightSubtractContributions(const std::vector<LightContribution>& contributions)
+{
+	for (const LightContribution& c : contributions)
+	{
+		LightSubtractTile(c.iSrcX, c.iSrcY, c.iX, c.iY, c.ubShade, c.uiFlags, c.fOnlyWalls);
+	}
+}
+
+
+BOOLEAN LightDraw(const LIGHT_SPRITE* const l)
+{
+	if (l->light_template->lights.empty()) return FALSE;
+
+	std::vector<LightContribution>& contributions = LightContributions(l);
+	LightCollectContributions(l, contributions);
+	LightAddContributions(contributions);
+	g_light_drawn[l - LightSprites] = g_light_nodes_added;
 	return(TRUE);
 }
 
@@ -1717,79 +1821,68 @@ BOOLEAN ApplyTranslucencyToWalls(INT16 iX, INT16 iY)
 }
 
 
-// Reverts all tiles a given light affects to their natural light levels.
+/* Reverts all tiles a given light affects to their natural light levels. The
+	* tiles are the ones recorded by the last LightDraw(), so structures that
+	* changed in the meantime cannot make the erase miss or double-subtract. */
 static BOOLEAN LightErase(const LIGHT_SPRITE* const l)
 {
-	UINT32  uiFlags;
-	INT32   iOldX, iOldY;
-	BOOLEAN fBlocked = FALSE;
-	BOOLEAN fOnlyWalls;
-
-	LightTemplate* const t = l->light_template;
-	if (t->lights.empty()) return FALSE;
+	if (l->light_template->lights.empty()) return FALSE;
 
-	// clear out all the flags
-	for (LIGHT_NODE& light : t->lights)
-	{
-		light.uiFlags &= ~LIGHT_NODE_DRAWN;
-	}
+	std::vector<LightContribution>& contributions = LightContributions(l);
+	LightSubtractContributions(contributions);
+	contributions.clear();
+	return(TRUE);
+}
 
-	const INT16 iX = l->iX;
-	const INT16 iY = l->iY;
-	iOldX = iX;
-	iOldY = iY;
 
-	Assert(t->rays.size() <= UINT16_MAX);
-	for (UINT16 uiCount = 0; uiCount < static_cast<UINT16>(t->rays.size()); ++uiCount)
-	{
-		const UINT16 usNodeIndex = t->rays[uiCount];
-		if (!(usNodeIndex & LIGHT_NEW_RAY))
-		{
-			fBlocked = FALSE;
-			fOnlyWalls = FALSE;
-
-			LIGHT_NODE* const pLight = &t->lights[usNodeIndex & ~LIGHT_BACKLIGHT];
+static void LightSpriteDirty(const LIGHT_SPRITE* l);
 
-			if (!(l->uiFlags&LIGHT_SPR_ONROOF))
-			{
-				if(LightTileBlocked( (INT16)iOldX, (INT16)iOldY, (INT16)(iX+pLight->iDX), (INT16)(iY+pLight->iDY)))
-				{
-					uiCount = LightFindNextRay(t, uiCount);
 
-					fOnlyWalls = TRUE;
-					fBlocked = TRUE;
-				}
-			}
+/* Replaces what a light sprite contributed at its last draw with what it
+	* contributes now. Tiles lit identically before and after are left alone, so
+	* a light moving by one tile only touches the edge of its area and the tiles
+	* whose occlusion changed. Tiles which got LEVELNODEs since the last draw are
+	* lit again, as the new nodes lack the light. fErase tells whether the
+	* previous contribution is still applied, fDraw whether the light is to be
+	* drawn at all. */
+static void LightRedraw(LIGHT_SPRITE* const l, const bool fErase, const bool fDraw)
+{
+	std::vector<LightContribution>& old_contributions = LightContributions(l);
+	if (!fErase) old_contributions.clear();
 
-			if(!(pLight->uiFlags&LIGHT_NODE_DRAWN) && (pLight->ubLight) )
-			{
-				uiFlags=(UINT32)(usNodeIndex&LIGHT_BACKLIGHT);
-				if (l->uiFlags & MERC_LIGHT)       uiFlags |= LIGHT_FAKE;
-				if (l->uiFlags & LIGHT_SPR_ONROOF) uiFlags |= LIGHT_ROOF_ONLY;
+	std::vector<LightContribution> new_contributions;
+	if (fDraw && !l->light_template->lights.empty())
+	{
+		LightCollectContributions(l, new_contributions);
+	}
 
-				LightSubtractTile(iOldX, iOldY, iX + pLight->iDX, iY + pLight->iDY, pLight->ubLight, uiFlags, fOnlyWalls);
-				pLight->uiFlags|=LIGHT_NODE_DRAWN;
-			}
+	std::vector<LightContribution> removed;
+	std::vector<LightContribution> added;
+	std::set_difference(old_contributions.begin(), old_contributions.end(),
+		new_contributions.begin(), new_contributions.end(), std::back_inserter(removed));
+	std::set_difference(new_contributions.begin(), new_contributions.end(),
+		old_contributions.begin(), old_contributions.end(), std::back_inserter(added));
 
-			if ( fBlocked )
-			{
-				iOldX = iX;
-				iOldY = iY;
-			}
-			else
-			{
-				iOldX = iX+pLight->iDX;
-				iOldY = iY+pLight->iDY;
-			}
-		}
-		else
-		{
-			iOldX = iX;
-			iOldY = iY;
-		}
+	UINT32& drawn = g_light_drawn[l - LightSprites];
+	std::vector<LightContribution> kept;
+	std::set_intersection(old_contributions.begin(), old_contributions.end(),
+		new_contributions.begin(), new_contributions.end(), std::back_inserter(kept));
+	for (const LightContribution& c : kept)
+	{
+		const UINT32 uiTile = MAPROWCOLTOPOS(c.iY, c.iX);
+		if (uiTile >= WORLD_MAX || g_light_tile_node_added[uiTile] <= drawn) continue;
+		removed.push_back(c);
+		added.push_back(c);
 	}
 
-	return(TRUE);
+	// subtract first, like the separate erase and draw did
+	LightSubtractContributions(removed);
+	LightAddContributions(added);
+	old_contributions = std::move(new_contributions);
+	drawn = g_light_nodes_added;
+
+	if (fDraw) l->uiFlags |= LIGHT_SPR_ERASE;
+	if (!removed.empty() || !added.empty()) LightSpriteDirty(l);
 }
 
 
@@ -1936,9 +2029,6 @@ BOOLEAN LightSpriteFake(LIGHT_SPRITE* const l)
 }
 
 
-static void LightSpriteDirty(const LIGHT_SPRITE* l);
-
-
 BOOLEAN LightSpriteDestroy(LIGHT_SPRITE* const l)
 {
 	if (l->uiFlags & LIGHT_SPR_ACTIVE)
@@ -1952,6 +2042,7 @@ BOOLEAN LightSpriteDestroy(LIGHT_SPRITE* const l)
 			}
 			l->uiFlags &= ~LIGHT_SPR_ERASE;
 		}
+		LightContributions(l).clear();
 
 		l->uiFlags &= ~LIGHT_SPR_ACTIVE;
 		return(TRUE);
@@ -1961,13 +2052,14 @@ BOOLEAN LightSpriteDestroy(LIGHT_SPRITE* const l)
 }
 
 
-void LightSpriteRenderAll()
+// Draws all lights that are switched on, assuming no light is applied yet.
+static void LightSpriteDrawAll()
 {
-	LightResetAllTiles();
 	FOR_EACH(LIGHT_SPRITE, i, LightSprites)
 	{
 		LIGHT_SPRITE& l = *i;
 		l.uiFlags &= ~LIGHT_SPR_ERASE;
+		LightContributions(&l).clear();
 		if (!(l.uiFlags & LIGHT_SPR_ACTIVE)) continue;
 		if (!(l.uiFlags & LIGHT_SPR_ON))     continue;
 		LightDraw(&l);
@@ -1977,33 +2069,29 @@ void LightSpriteRenderAll()
 }
 
 
+void LightSpriteRenderAll()
+{
+	LightResetAllTiles();
+	LightSpriteDrawAll();
+}
+
+
 void LightSpritePosition(LIGHT_SPRITE* const l, const INT16 iX, const INT16 iY)
 {
 	Assert(l->uiFlags & LIGHT_SPR_ACTIVE);
 
 	if (l->iX == iX && l->iY == iY) return;
 
-	if (l->uiFlags & LIGHT_SPR_ERASE)
-	{
-		if (l->iX < WORLD_COLS && l->iY < WORLD_ROWS)
-		{
-			LightErase(l);
-			LightSpriteDirty(l);
-		}
-	}
+	const bool fErase = (l->uiFlags & LIGHT_SPR_ERASE) &&
+		l->iX < WORLD_COLS && l->iY < WORLD_ROWS;
 
 	l->iX = iX;
 	l->iY = iY;
 
-	if (l->uiFlags & LIGHT_SPR_ON)
-	{
-		if (l->iX < WORLD_COLS && l->iY < WORLD_ROWS)
-		{
-			LightDraw(l);
-			l->uiFlags |= LIGHT_SPR_ERASE;
-			LightSpriteDirty(l);
-		}
-	}
+	const bool fDraw = (l->uiFlags & LIGHT_SPR_ON) &&
+		l->iX < WORLD_COLS && l->iY < WORLD_ROWS;
+
+	LightRedraw(l, fErase, fDraw);
 }
 
 
@@ -96,6 +96,8 @@ LightTemplate* LightCreateOmni(UINT8 ubIntensity, INT16 iRadius);
 BOOLEAN LightDraw(const LIGHT_SPRITE* l);
 // Save a light list into a file
 void LightSave(LightTemplate const*, char const* filename);
+// Notes that a LEVELNODE was added to the tile, so lights get applied to it
+void LightTileNodeAdded(UINT32 tile);
 
 // Sets the light color
 void LightSetColor(const SGPPaletteEntry* pPal);
@@ -47,6 +47,10 @@
 #include "World_Items.h"
 #include "WorldDef.h"
 #include <string_theory/string>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
 
 extern SOLDIERINITNODE *gpSelected;
 
@@ -60,6 +64,12 @@ extern SOLDIERINITNODE *gpSelected;
 
 #define FASTMAPROWCOLTOPOS( r, c )	( (r) * WORLD_COLS + (c) )
 
+// The area of the world the overhead map shows
+#define OVERHEAD_RASTER_START_X_M	0
+#define OVERHEAD_RASTER_START_Y_M	(WORLD_COLS / 2)
+#define OVERHEAD_RASTER_WIDTH		640
+#define OVERHEAD_RASTER_HEIGHT		320
+
 
 struct SMALL_TILE_SURF
 {
@@ -281,7 +291,7 @@ void HandleOverheadMap(void)
 		DecayLightEffects(GetWorldTotalSeconds());
 	}
 
-	RenderOverheadMap(0, WORLD_COLS / 2, STD_SCREEN_X, STD_SCREEN_Y, STD_SCREEN_X + 640, STD_SCREEN_Y + 320, FALSE);
+	RenderOverheadMap(OVERHEAD_RASTER_START_X_M, OVERHEAD_RASTER_START_Y_M, STD_SCREEN_X, STD_SCREEN_Y, STD_SCREEN_X + OVERHEAD_RASTER_WIDTH, STD_SCREEN_Y + OVERHEAD_RASTER_HEIGHT, FALSE);
 
 	HandleTalkingAutoFaces();
 
@@ -474,239 +484,431 @@ static INT16 GetModifiedOffsetLandHeight(INT32 const gridno)
 }
 
 
-void RenderOverheadMap(INT16 const sStartPointX_M, INT16 const sStartPointY_M, INT16 const sStartPointX_S, INT16 const sStartPointY_S, INT16 const sEndXS, INT16 const sEndYS, BOOLEAN const fFromMapUtility)
+enum OverheadPass
 {
-	if (!gfOverheadMapDirty) return;
+	OVERHEAD_PASS_LAND,
+	OVERHEAD_PASS_OBJECTS, // objects, shadows and structures
+	OVERHEAD_PASS_ROOFS
+};
 
-	// Black out
-	ColorFillVideoSurfaceArea(FRAME_BUFFER, sStartPointX_S, sStartPointY_S, sEndXS,	sEndYS, 0);
 
-	InvalidateScreen();
-	gfOverheadMapDirty = FALSE;
+/* Calls f(vo, sub_index, x, y, shade, shadow) for every small tile image the
+ * given map tile shows in a render pass, in render order. x and y are relative
+ * to the overhead screen position of the tile. */
+template<typename F>
+static void ForEachOverheadTileImage(OverheadPass const pass, UINT32 const tile, INT16 const sX, INT16 const sY, F&& f)
+{
+	MAP_ELEMENT const& e       = gpWorldLevelData[tile];
+	INT16       const  sHeight = GetOffsetLandHeight(tile) / 5;
+	switch (pass)
+	{
+		case OVERHEAD_PASS_LAND:
+			for (LEVELNODE const* n = e.pLandStart; n; n = n->pPrevNode)
+			{
+				SMALL_TILE_DB const& pTile = gSmTileDB[n->usIndex];
+				f(pTile.vo, pTile.usSubIndex, sX, sY - sHeight + gsRenderHeight / 5, n->ubShadeLevel, false);
+			}
+			break;
+
+		case OVERHEAD_PASS_OBJECTS:
+		{
+			INT16 const sModifiedHeight = GetModifiedOffsetLandHeight(tile) / 5;
 
-	{ SGPVSurface::Lock l(FRAME_BUFFER);
-		UINT16* const pDestBuf         = l.Buffer<UINT16>();
-		UINT32  const uiDestPitchBYTES = l.Pitch();
-
-		{ // Begin Render Loop
-			INT16 sAnchorPosX_M = sStartPointX_M;
-			INT16 sAnchorPosY_M = sStartPointY_M;
-			INT16 sAnchorPosX_S = sStartPointX_S;
-			INT16 sAnchorPosY_S = sStartPointY_S;
-			bool  bXOddFlag     = false;
-			do
+			for (LEVELNODE const* n = e.pObjectHead; n; n = n->pNext)
 			{
-				INT16 sTempPosX_M = sAnchorPosX_M;
-				INT16 sTempPosY_M = sAnchorPosY_M;
-				INT16 sTempPosX_S = sAnchorPosX_S;
-				INT16 sTempPosY_S = sAnchorPosY_S;
-				if (bXOddFlag) sTempPosX_S += 4;
-				do
-				{
-					UINT32 const usTileIndex = FASTMAPROWCOLTOPOS(sTempPosY_M, sTempPosX_M);
-					if (usTileIndex < GRIDSIZE)
-					{
-						INT16 const sHeight = GetOffsetLandHeight(usTileIndex) / 5;
-						for (LEVELNODE const* n = gpWorldLevelData[usTileIndex].pLandStart; n; n = n->pPrevNode)
-						{
-							SMALL_TILE_DB const& pTile = gSmTileDB[n->usIndex];
-							INT16         const  sX    = sTempPosX_S;
-							INT16         const  sY    = sTempPosY_S - sHeight + gsRenderHeight / 5;
-							pTile.vo->CurrentShade(n->ubShadeLevel);
-							Blt8BPPDataTo16BPPBufferTransparent(pDestBuf, uiDestPitchBYTES, pTile.vo, sX, sY, pTile.usSubIndex);
-						}
-					}
+				if (n->usIndex >= NUMBEROFTILES) continue;
+				// Don't render itempools!
+				if (n->uiFlags & LEVELNODE_ITEM) continue;
 
-					sTempPosX_S += 8;
-					++sTempPosX_M;
-					--sTempPosY_M;
-				}
-				while (sTempPosX_S < sEndXS);
+				SMALL_TILE_DB const& pTile = gSmTileDB[n->usIndex];
+				INT16 const h = gTileDatabase[n->usIndex].uiFlags & IGNORE_WORLD_HEIGHT ? sModifiedHeight : sHeight;
+				f(pTile.vo, pTile.usSubIndex, sX, sY - h + gsRenderHeight / 5, n->ubShadeLevel, false);
+			}
 
-				if (bXOddFlag)
-				{
-					++sAnchorPosY_M;
-				}
-				else
-				{
-					++sAnchorPosX_M;
-				}
+			for (LEVELNODE const* n = e.pShadowHead; n; n = n->pNext)
+			{
+				if (n->usIndex >= NUMBEROFTILES) continue;
 
-				bXOddFlag = !bXOddFlag;
-				sAnchorPosY_S += 2;
+				SMALL_TILE_DB const& pTile = gSmTileDB[n->usIndex];
+				f(pTile.vo, pTile.usSubIndex, sX, sY - sHeight + gsRenderHeight / 5, n->ubShadeLevel, true);
 			}
-			while (sAnchorPosY_S < sEndYS);
+
+			for (LEVELNODE const* n = e.pStructHead; n; n = n->pNext)
+			{
+				if (n->usIndex >= NUMBEROFTILES) continue;
+				// Don't render itempools!
+				if (n->uiFlags & LEVELNODE_ITEM) continue;
+
+				SMALL_TILE_DB const& pTile = gSmTileDB[n->usIndex];
+				INT16 const h = gTileDatabase[n->usIndex].uiFlags & IGNORE_WORLD_HEIGHT ? sModifiedHeight : sHeight;
+				f(pTile.vo, pTile.usSubIndex, sX, sY - h + gsRenderHeight / 5, n->ubShadeLevel, false);
+			}
+			break;
 		}
 
-		{ // Begin Render Loop
-			INT16 sAnchorPosX_M = sStartPointX_M;
-			INT16 sAnchorPosY_M = sStartPointY_M;
-			INT16 sAnchorPosX_S = sStartPointX_S;
-			INT16 sAnchorPosY_S = sStartPointY_S;
-			bool  bXOddFlag     = false;
-			do
+		case OVERHEAD_PASS_ROOFS:
+			for (LEVELNODE const* n = e.pRoofHead; n; n = n->pNext)
 			{
-				INT16 sTempPosX_M = sAnchorPosX_M;
-				INT16 sTempPosY_M = sAnchorPosY_M;
-				INT16 sTempPosX_S = sAnchorPosX_S;
-				INT16 sTempPosY_S = sAnchorPosY_S;
-				if (bXOddFlag) sTempPosX_S += 4;
-				do
-				{
-					UINT32 const usTileIndex = FASTMAPROWCOLTOPOS(sTempPosY_M, sTempPosX_M);
-					if (usTileIndex < GRIDSIZE)
-					{
-						INT16 const sHeight         = GetOffsetLandHeight(usTileIndex) / 5;
-						INT16 const sModifiedHeight = GetModifiedOffsetLandHeight(usTileIndex) / 5;
+				if (n->usIndex >= NUMBEROFTILES)   continue;
+				if (n->uiFlags & LEVELNODE_HIDDEN) continue;
 
-						for (LEVELNODE const* n = gpWorldLevelData[usTileIndex].pObjectHead; n; n = n->pNext)
-						{
-							if (n->usIndex >= NUMBEROFTILES) continue;
-							// Don't render itempools!
-							if (n->uiFlags & LEVELNODE_ITEM) continue;
-
-							SMALL_TILE_DB const& pTile = gSmTileDB[n->usIndex];
-							INT16         const  sX    = sTempPosX_S;
-							INT16                sY    = sTempPosY_S;
-
-							if (gTileDatabase[n->usIndex].uiFlags & IGNORE_WORLD_HEIGHT)
-							{
-								sY -= sModifiedHeight;
-							}
-							else
-							{
-								sY -= sHeight;
-							}
-
-							sY += gsRenderHeight / 5;
-
-							pTile.vo->CurrentShade(n->ubShadeLevel);
-							Blt8BPPDataTo16BPPBufferTransparent(pDestBuf, uiDestPitchBYTES, pTile.vo, sX, sY, pTile.usSubIndex);
-						}
+				SMALL_TILE_DB const& pTile = gSmTileDB[n->usIndex];
+				f(pTile.vo, pTile.usSubIndex, sX, sY - sHeight - WALL_HEIGHT / 5 + gsRenderHeight / 5, n->ubShadeLevel, false);
+			}
+			break;
+	}
+}
 
-						for (LEVELNODE const* n = gpWorldLevelData[usTileIndex].pShadowHead; n; n = n->pNext)
-						{
-							if (n->usIndex >= NUMBEROFTILES) continue;
 
-							SMALL_TILE_DB const& pTile = gSmTileDB[n->usIndex];
-							INT16         const  sX    = sTempPosX_S;
-							INT16                sY    = sTempPosY_S - sHeight;
+/* Calls f(tile, x, y) for every map tile shown in the given screen area, with
+ * the overhead screen position of the tile. */
+template<typename F>
+static void ForEachOverheadTile(INT16 const sStartPointX_M, INT16 const sStartPointY_M, INT16 const sStartPointX_S, INT16 const sStartPointY_S, INT16 const sEndXS, INT16 const sEndYS, F&& f)
+{
+	INT16 sAnchorPosX_M = sStartPointX_M;
+	INT16 sAnchorPosY_M = sStartPointY_M;
+	INT16 sAnchorPosX_S = sStartPointX_S;
+	INT16 sAnchorPosY_S = sStartPointY_S;
+	bool  bXOddFlag     = false;
+	do
+	{
+		INT16 sTempPosX_M = sAnchorPosX_M;
+		INT16 sTempPosY_M = sAnchorPosY_M;
+		INT16 sTempPosX_S = sAnchorPosX_S;
+		INT16 sTempPosY_S = sAnchorPosY_S;
+		if (bXOddFlag) sTempPosX_S += 4;
+		do
+		{
+			UINT32 const usTileIndex = FASTMAPROWCOLTOPOS(sTempPosY_M, sTempPosX_M);
+			if (usTileIndex < GRIDSIZE) f(usTileIndex, sTempPosX_S, sTempPosY_S);
 
-							sY += gsRenderHeight / 5;
+			sTempPosX_S += 8;
+			++sTempPosX_M;
+			--sTempPosY_M;
+		}
+		while (sTempPosX_S < sEndXS);
 
-							pTile.vo->CurrentShade(n->ubShadeLevel);
-							Blt8BPPDataTo16BPPBufferShadow(pDestBuf, uiDestPitchBYTES, pTile.vo, sX, sY, pTile.usSubIndex);
-						}
+		if (bXOddFlag)
+		{
+			++sAnchorPosY_M;
+		}
+		else
+		{
+			++sAnchorPosX_M;
+		}
 
-						for (LEVELNODE const* n = gpWorldLevelData[usTileIndex].pStructHead; n; n = n->pNext)
-						{
-							if (n->usIndex >= NUMBEROFTILES) continue;
-							// Don't render itempools!
-							if (n->uiFlags & LEVELNODE_ITEM) continue;
-
-							SMALL_TILE_DB const& pTile = gSmTileDB[n->usIndex];
-							INT16         const  sX    = sTempPosX_S;
-							INT16                sY    = sTempPosY_S;
-
-							if (gTileDatabase[n->usIndex].uiFlags & IGNORE_WORLD_HEIGHT)
-							{
-								sY -= sModifiedHeight;
-							}
-							else
-							{
-								sY -= sHeight;
-							}
-
-							sY += gsRenderHeight / 5;
-
-							pTile.vo->CurrentShade(n->ubShadeLevel);
-							Blt8BPPDataTo16BPPBufferTransparent(pDestBuf, uiDestPitchBYTES, pTile.vo, sX, sY, pTile.usSubIndex);
-						}
-					}
+		bXOddFlag = !bXOddFlag;
+		sAnchorPosY_S += 2;
+	}
+	while (sAnchorPosY_S < sEndYS);
+}
 
-					sTempPosX_S += 8;
-					++sTempPosX_M;
-					--sTempPosY_M;
-				}
-				while (sTempPosX_S < sEndXS);
 
-				if (bXOddFlag)
-				{
-					++sAnchorPosY_M;
-				}
-				else
-				{
-					++sAnchorPosX_M;
-				}
+/* The rendered tiles are kept in an off-screen raster for as long as the world
+ * is loaded. It is rendered in full when the world is loaded and afterwards
+ * only where InvalidateOverheadTile() reported a change, which WorldMan and
+ * the lighting do whenever they change what a tile shows. Each map tile keeps
+ * its position in the raster and the area its images cover there, so the
+ * tiles overlapping a changed one can be rendered again. */
+struct OverheadRasterTile
+{
+	INT16 x;
+	INT16 y;
+	INT16 left;
+	INT16 top;
+	INT16 right;
+	INT16 bottom;
+	bool  shown; // lies in the raster
+	bool  dirty; // queued in gOverheadRasterDirtyTiles
+};
 
-				bXOddFlag = !bXOddFlag;
-				sAnchorPosY_S += 2;
-			}
-			while (sAnchorPosY_S < sEndYS);
+static SGPVSurface*        guiOverheadRaster;
+static SGPVSurface*        guiOverheadRadar; // the raster shrunk for the radar
+static bool                gfOverheadRasterValid;
+static bool                gfOverheadRadarValid;
+static INT16               gsOverheadRasterStartX_M;
+static INT16               gsOverheadRasterStartY_M;
+static OverheadRasterTile  gOverheadRasterTiles[WORLD_MAX];
+static std::vector<GridNo> gOverheadRasterDirtyTiles;
+
+
+void InvalidateOverheadRaster()
+{
+	gfOverheadRasterValid = false;
+}
+
+
+void InvalidateOverheadTile(GridNo const grid_no)
+{
+	// Until the raster is rendered in full again, there is nothing to patch
+	if (!gfOverheadRasterValid) return;
+
+	OverheadRasterTile& t = gOverheadRasterTiles[grid_no];
+	if (t.dirty) return;
+
+	// Changes to a large part of the world, e.g. by the ambient light, are
+	// cheaper to render in one go
+	if (gOverheadRasterDirtyTiles.size() >= WORLD_MAX / 4)
+	{
+		InvalidateOverheadRaster();
+		return;
+	}
+	t.dirty = true;
+	gOverheadRasterDirtyTiles.push_back(grid_no);
+}
+
+
+static void DestroyOverheadRaster()
+{
+	gfOverheadRasterValid = false;
+	gfOverheadRadarValid  = false;
+	gOverheadRasterDirtyTiles.clear();
+	if (guiOverheadRadar)
+	{
+		DeleteVideoSurface(guiOverheadRadar);
+		guiOverheadRadar = 0;
+	}
+	if (!guiOverheadRaster) return;
+	DeleteVideoSurface(guiOverheadRaster);
+	guiOverheadRaster = 0;
+}
+
+
+// Updates the area a map tile covers in the overhead raster
+static void MeasureOverheadTile(UINT32 const tile, OverheadRasterTile& t)
+{
+	t.left   = INT16_MAX;
+	t.top    = INT16_MAX;
+	t.right  = INT16_MIN;
+	t.bottom = INT16_MIN;
+
+	auto const measure = [&t](SGPVObject* const vo, UINT16 const sub, INT16 const x, INT16 const y, UINT8, bool)
+	{
+		ETRLEObject const& e = vo->SubregionProperties(sub);
+		t.left   = MIN(t.left,   x + e.sOffsetX);
+		t.top    = MIN(t.top,    y + e.sOffsetY);
+		t.right  = MAX(t.right,  x + e.sOffsetX + e.usWidth);
+		t.bottom = MAX(t.bottom, y + e.sOffsetY + e.usHeight);
+	};
+
+	ForEachOverheadTileImage(OVERHEAD_PASS_LAND,    tile, t.x, t.y, measure);
+	ForEachOverheadTileImage(OVERHEAD_PASS_OBJECTS, tile, t.x, t.y, measure);
+	ForEachOverheadTileImage(OVERHEAD_PASS_ROOFS,   tile, t.x, t.y, measure);
+}
+
+
+/* Brings the overhead raster up to date with the world and returns whether
+ * anything had to be rendered. */
+static bool UpdateOverheadRaster(INT16 const sStartPointX_M, INT16 const sStartPointY_M, UINT16 const w, UINT16 const h)
+{
+	if (!guiOverheadRaster || guiOverheadRaster->Width() != w || guiOverheadRaster->Height() != h)
+	{
+		DestroyOverheadRaster();
+		guiOverheadRaster = AddVideoSurface(w, h, PIXEL_DEPTH);
+	}
+	if (gsOverheadRasterStartX_M != sStartPointX_M || gsOverheadRasterStartY_M != sStartPointY_M)
+	{
+		gsOverheadRasterStartX_M = sStartPointX_M;
+		gsOverheadRasterStartY_M = sStartPointY_M;
+		gfOverheadRasterValid    = false;
+	}
+
+	INT32 left;
+	INT32 top;
+	INT32 right;
+	INT32 bottom;
+	if (!gfOverheadRasterValid)
+	{
+		std::fill(std::begin(gOverheadRasterTiles), std::end(gOverheadRasterTiles), OverheadRasterTile{});
+		ForEachOverheadTile(sStartPointX_M, sStartPointY_M, 0, 0, w, h, [](UINT32 const tile, INT16 const sX, INT16 const sY)
+		{
+			OverheadRasterTile& t = gOverheadRasterTiles[tile];
+			t.x     = sX;
+			t.y     = sY;
+			t.shown = true;
+			MeasureOverheadTile(tile, t);
+		});
+		gOverheadRasterDirtyTiles.clear();
+		gfOverheadRasterValid = true;
+
+		left   = 0;
+		top    = 0;
+		right  = w;
+		bottom = h;
+	}
+	else
+	{
+		if (gOverheadRasterDirtyTiles.empty()) return false;
+
+		// Collect the area the changed tiles covered before and cover now
+		left   = INT32_MAX;
+		top    = INT32_MAX;
+		right  = INT32_MIN;
+		bottom = INT32_MIN;
+		auto const extend = [&](OverheadRasterTile const& t)
+		{
+			if (t.left >= t.right) return; // shows nothing
+			left   = MIN(left,   t.left);
+			top    = MIN(top,    t.top);
+			right  = MAX(right,  t.right);
+			bottom = MAX(bottom, t.bottom);
+		};
+
+		for (GridNo const tile : gOverheadRasterDirtyTiles)
+		{
+			OverheadRasterTile& t = gOverheadRasterTiles[tile];
+			t.dirty = false;
+			if (!t.shown) continue;
+			extend(t);
+			MeasureOverheadTile(tile, t);
+			extend(t);
 		}
+		gOverheadRasterDirtyTiles.clear();
 
-		{ // ROOF RENDR LOOP
-			// Begin Render Loop
-			INT16 sAnchorPosX_M = sStartPointX_M;
-			INT16 sAnchorPosY_M = sStartPointY_M;
-			INT16 sAnchorPosX_S = sStartPointX_S;
-			INT16 sAnchorPosY_S = sStartPointY_S;
-			bool  bXOddFlag     = false;
-			do
-			{
-				INT16 sTempPosX_M = sAnchorPosX_M;
-				INT16 sTempPosY_M = sAnchorPosY_M;
-				INT16 sTempPosX_S = sAnchorPosX_S;
-				INT16 sTempPosY_S = sAnchorPosY_S;
-				if (bXOddFlag) sTempPosX_S += 4;
-				do
-				{
-					UINT32 const usTileIndex = FASTMAPROWCOLTOPOS(sTempPosY_M, sTempPosX_M);
-					if (usTileIndex < GRIDSIZE)
-					{
-						INT16 const sHeight = GetOffsetLandHeight(usTileIndex) / 5;
+		left   = MAX(left,   0);
+		top    = MAX(top,    0);
+		right  = MIN(right,  w);
+		bottom = MIN(bottom, h);
+		if (left >= right || top >= bottom) return false;
+	}
 
-						for (LEVELNODE const* n = gpWorldLevelData[usTileIndex].pRoofHead; n; n = n->pNext)
-						{
-							if (n->usIndex >= NUMBEROFTILES)   continue;
-							if (n->uiFlags & LEVELNODE_HIDDEN) continue;
+	gfOverheadRadarValid = false;
 
-							SMALL_TILE_DB const& pTile = gSmTileDB[n->usIndex];
-							INT16         const  sX    = sTempPosX_S;
-							INT16                sY    = sTempPosY_S - sHeight;
+	// Render everything that overlaps the changed area, in the usual order
+	ColorFillVideoSurfaceArea(guiOverheadRaster, left, top, right, bottom, 0);
 
-							sY -= WALL_HEIGHT / 5;
-							sY += gsRenderHeight / 5;
+	SGPRect clip;
+	clip.set(left, top, right, bottom);
 
-							pTile.vo->CurrentShade(n->ubShadeLevel);
+	SGPVSurface::Lock l(guiOverheadRaster);
+	UINT16* const pDestBuf         = l.Buffer<UINT16>();
+	UINT32  const uiDestPitchBYTES = l.Pitch();
 
-							// RENDER!
-							Blt8BPPDataTo16BPPBufferTransparent(pDestBuf, uiDestPitchBYTES, pTile.vo, sX, sY, pTile.usSubIndex);
-						}
-					}
+	auto const blt = [&](SGPVObject* const vo, UINT16 const sub, INT16 const x, INT16 const y, UINT8 const shade, bool const shadow)
+	{
+		vo->CurrentShade(shade);
+		if (shadow)
+		{
+			Blt8BPPDataTo16BPPBufferShadowClip(pDestBuf, uiDestPitchBYTES, vo, x, y, sub, &clip);
+		}
+		else
+		{
+			Blt8BPPDataTo16BPPBufferTransparentClip(pDestBuf, uiDestPitchBYTES, vo, x, y, sub, &clip);
+		}
+	};
 
-					sTempPosX_S += 8;
-					++sTempPosX_M;
-					--sTempPosY_M;
-				}
-				while (sTempPosX_S < sEndXS);
+	OverheadPass const passes[] = { OVERHEAD_PASS_LAND, OVERHEAD_PASS_OBJECTS, OVERHEAD_PASS_ROOFS };
+	for (OverheadPass const pass : passes)
+	{
+		ForEachOverheadTile(sStartPointX_M, sStartPointY_M, 0, 0, w, h, [&](UINT32 const tile, INT16 const sX, INT16 const sY)
+		{
+			OverheadRasterTile const& t = gOverheadRasterTiles[tile];
+			if (t.right <= left || t.left >= right || t.bottom <= top || t.top >= bottom) return;
+			ForEachOverheadTileImage(pass, tile, sX, sY, blt);
+		});
+	}
+	return true;
+}
 
-				if (bXOddFlag)
-				{
-					++sAnchorPosY_M;
-				}
-				else
+
+BOOLEAN BltOverheadRadar(SGPVSurface* const dst, INT16 const sX, INT16 const sY, UINT16 const w, UINT16 const h)
+{
+	if (!gfWorldLoaded) return FALSE;
+
+	InitNewOverheadDB(giCurrentTilesetID);
+	UpdateOverheadRaster(OVERHEAD_RASTER_START_X_M, OVERHEAD_RASTER_START_Y_M, OVERHEAD_RASTER_WIDTH, OVERHEAD_RASTER_HEIGHT);
+
+	if (!guiOverheadRadar || guiOverheadRadar->Width() != w || guiOverheadRadar->Height() != h)
+	{
+		if (guiOverheadRadar) DeleteVideoSurface(guiOverheadRadar);
+		guiOverheadRadar     = AddVideoSurface(w, h, PIXEL_DEPTH);
+		gfOverheadRadarValid = false;
+	}
+
+	if (!gfOverheadRadarValid)
+	{
+		{ // Shrink the raster
+			SGPVSurface::Lock src(guiOverheadRaster);
+			SGPVSurface::Lock dest(guiOverheadRadar);
+			UINT16 const* const pSrcBuf     = src.Buffer<UINT16>();
+			UINT32        const uiSrcPitch  = src.Pitch() / 2;
+			UINT16*       const pDestBuf    = dest.Buffer<UINT16>();
+			UINT32        const uiDestPitch = dest.Pitch() / 2;
+			UINT32        const uiSrcW      = guiOverheadRaster->Width();
+			UINT32        const uiSrcH      = guiOverheadRaster->Height();
+
+			// Each radar pixel is the average of the raster pixels it covers
+			for (UINT32 y = 0; y != h; ++y)
+			{
+				UINT32 const y0 = y * uiSrcH / h;
+				UINT32 const y1 = MAX((y + 1) * uiSrcH / h, y0 + 1);
+				for (UINT32 x = 0; x != w; ++x)
 				{
-					++sAnchorPosX_M;
+					UINT32 const x0 = x * uiSrcW / w;
+					UINT32 const x1 = MAX((x + 1) * uiSrcW / w, x0 + 1);
+
+					UINT32 r = 0;
+					UINT32 g = 0;
+					UINT32 b = 0;
+					for (UINT32 v = y0; v != y1; ++v)
+					{
+						for (UINT32 u = x0; u != x1; ++u)
+						{
+							UINT32 const rgb = GetRGBColor(pSrcBuf[v * uiSrcPitch + u]);
+							r += SGPGetRValue(rgb);
+							g += SGPGetGValue(rgb);
+							b += SGPGetBValue(rgb);
+						}
+					}
+					UINT32 const n = (x1 - x0) * (y1 - y0);
+					pDestBuf[y * uiDestPitch + x] = Get16BPPColor(FROMRGB(r / n, g / n, b / n));
 				}
+			}
+		}
 
-				bXOddFlag = !bXOddFlag;
-				sAnchorPosY_S += 2;
+		// Blacken out the edges of smaller maps like the overhead map does
+		if (gMapInformation.ubRestrictedScrollID != 0)
+		{
+			UINT16 const black    = Get16BPPColor(FROMRGB(0, 0, 0));
+			INT32  const sRasterW = OVERHEAD_RASTER_WIDTH;
+			INT32  const sRasterH = OVERHEAD_RASTER_HEIGHT;
+			INT8   const dirs[]   = { NORTH, WEST, SOUTH, EAST };
+			for (INT8 const dir : dirs)
+			{
+				INT16 sX1;
+				INT16 sY1;
+				INT16 sX2;
+				INT16 sY2;
+				CalculateRestrictedMapCoords(dir, &sX1, &sY1, &sX2, &sY2, sRasterW, sRasterH);
+				// Radar pixels which show any part of the off map area go black
+				ColorFillVideoSurfaceArea(guiOverheadRadar,
+					sX1 * w / sRasterW, sY1 * h / sRasterH,
+					(sX2 * w + sRasterW - 1) / sRasterW, (sY2 * h + sRasterH - 1) / sRasterH,
+					black);
 			}
-			while (sAnchorPosY_S < sEndYS);
 		}
+		gfOverheadRadarValid = true;
 	}
 
+	BltVideoSurface(dst, guiOverheadRadar, sX, sY, NULL);
+	return TRUE;
+}
+
+
+void RenderOverheadMap(INT16 const sStartPointX_M, INT16 const sStartPointY_M, INT16 const sStartPointX_S, INT16 const sStartPointY_S, INT16 const sEndXS, INT16 const sEndYS, BOOLEAN const fFromMapUtility)
+{
+	if (!gfOverheadMapDirty) return;
+
+	InvalidateScreen();
+	gfOverheadMapDirty = FALSE;
+
+	UINT16 const w = sEndXS - sStartPointX_S;
+	UINT16 const h = sEndYS - sStartPointY_S;
+	UpdateOverheadRaster(sStartPointX_M, sStartPointY_M, w, h);
+
+	SGPBox const raster_box = { 0, 0, w, h };
+	BltVideoSurface(FRAME_BUFFER, guiOverheadRaster, sStartPointX_S, sStartPointY_S, &raster_box);
+
 	// OK, blacken out edges of smaller maps...
 	if (gMapInformation.ubRestrictedScrollID != 0)
 	{
@@ -956,6 +1158,9 @@ static void CopyOverheadDBShadetablesFromTileset(void)
 
 void TrashOverheadMap(void)
 {
+	// The raster belongs to the world, which is going away
+	DestroyOverheadRaster();
+
 	if (gubSmTileNum == TILESET_INVALID) return;
 	gubSmTileNum = TILESET_INVALID;
 
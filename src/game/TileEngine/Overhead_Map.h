@@ -19,6 +19,14 @@ void CalculateRestrictedMapCoords( INT8 bDirection, INT16 *psX1, INT16 *psY1, IN
 
 void TrashOverheadMap(void);
 
+// Marks the raster of a map tile out of date after what it shows changed
+void InvalidateOverheadTile(GridNo);
+// Marks the whole raster out of date, e.g. after the light changed everywhere
+void InvalidateOverheadRaster(void);
+/* Shrinks the overhead raster of the loaded world to w x h and puts it at x,y
+ * into dst. Returns FALSE if no world is loaded. */
+BOOLEAN BltOverheadRadar(SGPVSurface* dst, INT16 x, INT16 y, UINT16 w, UINT16 h);
+
 GridNo GetOverheadMouseGridNo(void);
 
 extern BOOLEAN gfOverheadMapDirty;
@@ -115,10 +115,7 @@ void MoveRadarScreen( )
 	// check if we are allowed to do anything?
 	if (!fRenderRadarScreen) return;
 
-	gRadarRegion.RegionTopLeftX     = RADAR_WINDOW_X;
-	gRadarRegion.RegionTopLeftY     = RADAR_WINDOW_TM_Y;
-	gRadarRegion.RegionBottomRightX = RADAR_WINDOW_X + RADAR_WINDOW_WIDTH;
-	gRadarRegion.RegionBottomRightY = RADAR_WINDOW_TM_Y + RADAR_WINDOW_HEIGHT;
+	gRadarRegion.SetArea(RADAR_WINDOW_X, RADAR_WINDOW_TM_Y, RADAR_WINDOW_X + RADAR_WINDOW_WIDTH, RADAR_WINDOW_TM_Y + RADAR_WINDOW_HEIGHT);
 
 }
 
@@ -205,17 +202,25 @@ void RenderRadarScreen()
 	// in a meanwhile, don't render any map
 	if (AreInMeanwhile()) ClearOutRadarMapImage();
 
-	if (fInterfacePanelDirty == DIRTYLEVEL2 && gusRadarImage)
+	if (fInterfacePanelDirty == DIRTYLEVEL2)
 	{
-		// If night time and on surface, darken the radarmap.
-		size_t const shade =
-			NightTime() &&
-			(
-				(guiCurrentScreen == MAP_SCREEN  && iCurrentMapSectorZ == 0) ||
-				(guiCurrentScreen == GAME_SCREEN && gbWorldSectorZ     == 0)
-			) ? 1 : 0;
-		gusRadarImage->CurrentShade(shade);
-		BltVideoObject(guiSAVEBUFFER, gusRadarImage, 0, RADAR_WINDOW_X, RADAR_WINDOW_TM_Y);
+		/* In tactical the loaded sector is shrunk from the overhead map, so it
+		 * shows destroyed buildings and the light of the overhead map. */
+		BOOLEAN const fLive =
+			guiCurrentScreen == GAME_SCREEN && !AreInMeanwhile() &&
+			BltOverheadRadar(guiSAVEBUFFER, RADAR_WINDOW_X, RADAR_WINDOW_TM_Y, RADAR_WINDOW_WIDTH, RADAR_WINDOW_HEIGHT);
+		if (!fLive && gusRadarImage)
+		{
+			// If night time and on surface, darken the radarmap.
+			size_t const shade =
+				NightTime() &&
+				(
+					(guiCurrentScreen == MAP_SCREEN  && iCurrentMapSectorZ == 0) ||
+					(guiCurrentScreen == GAME_SCREEN && gbWorldSectorZ     == 0)
+				) ? 1 : 0;
+			gusRadarImage->CurrentShade(shade);
+			BltVideoObject(guiSAVEBUFFER, gusRadarImage, 0, RADAR_WINDOW_X, RADAR_WINDOW_TM_Y);
+		}
 	}
 
 	// First delete what's there
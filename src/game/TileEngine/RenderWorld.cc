@@ -2428,6 +2428,19 @@ void InvalidateWorldRedundency(void)
 }
 
 
+void InvalidateWorldRedundencyInArea(INT16 const sLeft, INT16 const sTop, INT16 const sRight, INT16 const sBottom)
+{
+	SetRenderFlags(RENDER_FLAG_CHECKZ);
+	for (INT16 y = MAX(sTop, 0); y <= MIN(sBottom, WORLD_ROWS - 1); ++y)
+	{
+		for (INT16 x = MAX(sLeft, 0); x <= MIN(sRight, WORLD_COLS - 1); ++x)
+		{
+			gpWorldLevelData[y * WORLD_COLS + x].uiFlags |= MAPELEMENT_REEVALUATE_REDUNDENCY;
+		}
+	}
+}
+
+
 #define Z_STRIP_DELTA_Y  (Z_SUBLAYERS * 10)
 
 /**********************************************************************************************
@@ -117,6 +117,8 @@ extern BOOLEAN gfScrollPending;
 void RenderStaticWorldRect(INT16 sLeft, INT16 sTop, INT16 sRight, INT16 sBottom, BOOLEAN fDynamicsToo);
 
 void InvalidateWorldRedundency(void);
+// Like InvalidateWorldRedundency(), but only for the tiles in the given columns and rows
+void InvalidateWorldRedundencyInArea(INT16 sLeft, INT16 sTop, INT16 sRight, INT16 sBottom);
 
 void SetRenderCenter(INT16 sNewX, INT16 sNewY);
 
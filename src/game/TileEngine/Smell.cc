@@ -457,7 +457,7 @@ void UpdateBloodGraphics(GridNo const gridno, INT8 const level)
 		INT8 const strength = BLOOD_FLOOR_STRENGTH(me.ubBloodInfo);
 		if (strength == 0) return;
 
-		UINT16 const index     = Random(4) * 4 + 3 - strength / 2U;
+		UINT16 const index     = Random(4, RANDOM_COSMETIC) * 4 + 3 - strength / 2U;
 		UINT32 const type      =
 			BLOOD_FLOOR_TYPE(me.ubSmellInfo) == HUMAN ? HUMANBLOOD :
 			CREATUREBLOOD;
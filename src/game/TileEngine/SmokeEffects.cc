@@ -20,12 +20,15 @@
 #include "Campaign_Types.h"
 #include "FileMan.h"
 #include "SaveLoadGame.h"
+#include "Structure.h"
 
 #include "ContentManager.h"
 #include "GameInstance.h"
 
 #include <algorithm>
+#include <bitset>
 #include <stdexcept>
+#include <vector>
 
 #define NUM_SMOKE_EFFECT_SLOTS 25
 
@@ -34,6 +37,27 @@
 static SMOKEEFFECT gSmokeEffectData[NUM_SMOKE_EFFECT_SLOTS];
 static UINT32      guiNumSmokeEffects = 0;
 
+/* Tiles covered by each smoke effect, collected for the radius it had and the
+ * structures the world had then */
+struct SMOKE_COVERAGE
+{
+	UINT8                    ubRadius;
+	UINT32                   uiStructureGeneration;
+	std::vector<SPREAD_TILE> tiles;
+};
+static SMOKE_COVERAGE gSmokeCoverage[NUM_SMOKE_EFFECT_SLOTS];
+
+// Smoke flags that hinder sight, see LineOfSightTest()
+#define SIGHT_SMOKE_EFFECT (MAPELEMENT_EXT_SMOKE | MAPELEMENT_EXT_TEARGAS | MAPELEMENT_EXT_MUSTARDGAS)
+
+/* While smoke effects decay, the tiles whose smoke flags got touched and the
+ * flags they had before, so only sight lines through actual changes are
+ * checked again */
+static BOOLEAN                 gfTrackSmokeChanges = FALSE;
+static std::bitset<WORLD_MAX>  gSmokeTouched[2];
+static std::vector<INT16>      gSmokeTouchedTiles[2];
+static std::vector<UINT8>      gSmokeTouchedFlags[2];
+
 
 #define BASE_FOR_EACH_SMOKE_EFFECT(type, iter)                    \
 	for (type* iter        = gSmokeEffectData,                      \
@@ -118,6 +142,100 @@ static UINT8 FromSmokeTypeToWorldFlags(SmokeEffectKind const bType)
 }
 
 
+static void TouchSmokeTile(INT16 const sGridNo, INT8 const bLevel)
+{
+	if (!gfTrackSmokeChanges || gSmokeTouched[bLevel][sGridNo]) return;
+	gSmokeTouched[bLevel][sGridNo] = true;
+	gSmokeTouchedTiles[bLevel].push_back(sGridNo);
+	gSmokeTouchedFlags[bLevel].push_back(gpWorldLevelData[sGridNo].ubExtFlags[bLevel]);
+}
+
+
+// Collects the touched tiles whose sight hindering smoke changed and forgets the rest
+static std::vector<INT16> TakeSmokeSightChanges()
+{
+	std::vector<INT16> changed;
+	for (INT8 bLevel = 0; bLevel != 2; ++bLevel)
+	{
+		std::vector<INT16>& tiles = gSmokeTouchedTiles[bLevel];
+		for (size_t i = 0; i != tiles.size(); ++i)
+		{
+			UINT8 const now = gpWorldLevelData[tiles[i]].ubExtFlags[bLevel];
+			if ((now ^ gSmokeTouchedFlags[bLevel][i]) & SIGHT_SMOKE_EFFECT) changed.push_back(tiles[i]);
+		}
+		gSmokeTouched[bLevel].reset();
+		tiles.clear();
+		gSmokeTouchedFlags[bLevel].clear();
+	}
+	return changed;
+}
+
+
+static INT8 GetSmokeEffectLevel(SMOKEEFFECT const* const s)
+{
+	return s->bFlags & SMOKE_EFFECT_ON_ROOF ? 1 : 0;
+}
+
+
+/* Collects the tiles the smoke effect covers again if there are none yet, the
+ * radius changed or a wall or door was added or removed since. Returns whether
+ * it did, the tiles covered before are marked in old_tiles then. */
+static bool RegrowSmokeCoverage(SMOKEEFFECT const* const s, INT8 const level, SMOKE_COVERAGE& coverage, std::bitset<WORLD_MAX>& old_tiles)
+{
+	if (!coverage.tiles.empty() &&
+		coverage.ubRadius == s->ubRadius &&
+		coverage.uiStructureGeneration == guiWorldStructureGeneration)
+	{
+		return false;
+	}
+
+	for (SPREAD_TILE const& t : coverage.tiles) old_tiles[t.sGridNo] = true;
+	GetSmokeEffectTiles(s, level, coverage.tiles);
+	coverage.ubRadius              = s->ubRadius;
+	coverage.uiStructureGeneration = guiWorldStructureGeneration;
+	return true;
+}
+
+
+/* Affects the tiles the smoke effect covers. Smoke is added to the tiles which
+ * are new or lost their smoke, or all when the cloud starts dissipating and
+ * changes its graphics. Gas damage is dealt where someone stands in the
+ * cloud. */
+static void SpreadSmokeEffect(SMOKEEFFECT const* const s, BOOLEAN const subsequent)
+{
+	INT8            const level    = GetSmokeEffectLevel(s);
+	SMOKE_COVERAGE&       coverage = gSmokeCoverage[s - gSmokeEffectData];
+
+	static std::bitset<WORLD_MAX> old_tiles;
+	bool const regrow = RegrowSmokeCoverage(s, level, coverage, old_tiles);
+
+	BOOLEAN const dissipating = s->ubDuration - s->bAge < 2;
+	std::vector<SPREAD_TILE> affected;
+	for (SPREAD_TILE const& t : coverage.tiles)
+	{
+		if (dissipating ||
+			(regrow && !old_tiles[t.sGridNo]) ||
+			!(gpWorldLevelData[t.sGridNo].ubExtFlags[level] & ANY_SMOKE_EFFECT) ||
+			WhoIsThere2(t.sGridNo, level))
+		{
+			affected.push_back(t);
+		}
+	}
+	if (regrow) old_tiles.reset();
+
+	SpreadEffectSmokeOnTiles(s, subsequent, level, affected);
+}
+
+
+static void EraseSmokeEffect(SMOKEEFFECT* const s)
+{
+	SMOKE_COVERAGE& coverage = gSmokeCoverage[s - gSmokeEffectData];
+	SpreadEffectSmokeOnTiles(s, ERASE_SPREAD_EFFECT, GetSmokeEffectLevel(s), coverage.tiles);
+	coverage.tiles.clear();
+	s->fAllocated = FALSE;
+}
+
+
 void NewSmokeEffect(const INT16 sGridNo, const UINT16 usItem, const INT8 bLevel, SOLDIERTYPE* const owner)
 {
 	INT8				bSmokeEffectType=0;
@@ -128,6 +246,7 @@ void NewSmokeEffect(const INT16 sGridNo, const UINT16 usItem, const INT8 bLevel,
 	if (pSmoke == NULL) return;
 
 	*pSmoke = SMOKEEFFECT{};
+	gSmokeCoverage[pSmoke - gSmokeEffectData].tiles.clear();
 
 	// Set some values...
 	pSmoke->sGridNo									= sGridNo;
@@ -212,7 +331,7 @@ void NewSmokeEffect(const INT16 sGridNo, const UINT16 usItem, const INT8 bLevel,
 	}
 
 	// ATE: FALSE into subsequent-- it's the first one!
-	SpreadEffectSmoke(pSmoke, FALSE, bLevel);
+	SpreadSmokeEffect(pSmoke, FALSE);
 }
 
 
@@ -220,6 +339,8 @@ void NewSmokeEffect(const INT16 sGridNo, const UINT16 usItem, const INT8 bLevel,
 // ( Replacement algorithm uses distance away )
 void AddSmokeEffectToTile(SMOKEEFFECT const* const smoke, SmokeEffectKind const bType, INT16 const sGridNo, INT8 const bLevel)
 {
+	TouchSmokeTile(sGridNo, bLevel);
+
 	BOOLEAN dissipating = FALSE;
 	if (smoke->ubDuration - smoke->bAge < 2)
 	{
@@ -259,7 +380,7 @@ void AddSmokeEffectToTile(SMOKEEFFECT const* const smoke, SmokeEffectKind const
 				default: throw std::logic_error("Invalid smoke effect type");
 			}
 		}
-		start_frame  = Random(5);
+		start_frame  = Random(5, RANDOM_COSMETIC);
 		ani_flags   |= ANITILE_ALWAYS_TRANSLUCENT;
 	}
 	else
@@ -283,7 +404,7 @@ void AddSmokeEffectToTile(SMOKEEFFECT const* const smoke, SmokeEffectKind const
 	ani_params.sStartFrame = start_frame;
 	ani_params.sGridNo     = sGridNo;
 	ani_params.ubLevelID   = (bLevel == 0 ? ANI_STRUCT_LEVEL : ANI_ONROOF_LEVEL);
-	ani_params.sDelay      = 300 + Random(300);
+	ani_params.sDelay      = 300 + Random(300, RANDOM_COSMETIC);
 	ani_params.sX          = CenterX(sGridNo);
 	ani_params.sY          = CenterY(sGridNo);
 	ani_params.sZ          = 0;
@@ -309,6 +430,8 @@ void RemoveSmokeEffectFromTile( INT16 sGridNo, INT8 bLevel )
 		ubLevelID = ANI_ONROOF_LEVEL;
 	}
 
+	TouchSmokeTile(sGridNo, bLevel);
+
 	pAniTile = GetCachedAniTileOfType( sGridNo, ubLevelID, ANITILE_SMOKE_EFFECT );
 
 	if ( pAniTile != NULL )
@@ -331,12 +454,13 @@ void DecaySmokeEffects( UINT32 uiTime )
 {
 	BOOLEAN fUpdate = FALSE;
 	BOOLEAN fSpreadEffect;
-	INT8    bLevel;
 	UINT16  usNumUpdates = 1;
 
 	// reset 'hit by gas' flags
 	FOR_EACH_MERC(i) (*i)->fHitByGasFlags = 0;
 
+	gfTrackSmokeChanges = TRUE;
+
 	// ATE: 1 ) make first pass and delete/mark any smoke effect for update
 	// all the deleting has to be done first///
 
@@ -345,16 +469,6 @@ void DecaySmokeEffects( UINT32 uiTime )
 	{
 		fSpreadEffect = TRUE;
 
-		if ( pSmoke->bFlags & SMOKE_EFFECT_ON_ROOF )
-		{
-			bLevel = 1;
-		}
-		else
-		{
-			bLevel = 0;
-		}
-
-
 		// Do things differently for combat /vs realtime
 		// always try to update during combat
 		if (gTacticalStatus.uiFlags & INCOMBAT )
@@ -413,8 +527,7 @@ void DecaySmokeEffects( UINT32 uiTime )
 					else
 					{
 						// deactivate tear gas cloud (use last known radius)
-						SpreadEffectSmoke(pSmoke, ERASE_SPREAD_EFFECT, bLevel);
-						pSmoke->fAllocated = FALSE;
+						EraseSmokeEffect(pSmoke);
 						break;
 					}
 				}
@@ -423,30 +536,24 @@ void DecaySmokeEffects( UINT32 uiTime )
 		else
 		{
 			// damage anyone standing in cloud
-			SpreadEffectSmoke(pSmoke, REDO_SPREAD_EFFECT, bLevel);
+			SpreadSmokeEffect(pSmoke, REDO_SPREAD_EFFECT);
 		}
 	}
 
 	FOR_EACH_SMOKE_EFFECT(pSmoke)
 	{
-		if ( pSmoke->bFlags & SMOKE_EFFECT_ON_ROOF )
-		{
-			bLevel = 1;
-		}
-		else
-		{
-			bLevel = 0;
-		}
-
 		// if this cloud remains effective (duration not reached)
 		if ( pSmoke->bFlags & SMOKE_EFFECT_MARK_FOR_UPDATE )
 		{
-			SpreadEffectSmoke(pSmoke, TRUE, bLevel);
+			SpreadSmokeEffect(pSmoke, TRUE);
 			pSmoke->bFlags &= (~SMOKE_EFFECT_MARK_FOR_UPDATE);
 		}
 	}
 
-	AllTeamsLookForAll( TRUE );
+	gfTrackSmokeChanges = FALSE;
+
+	// Only sight lines through tiles whose smoke changed need to be checked again
+	AllTeamsLookThroughTiles(TRUE, TakeSmokeSightChanges());
 }
 
 
@@ -455,7 +562,7 @@ void LoadSmokeEffectsFromLoadGameFile(HWFILE const hFile, UINT32 const savegame_
 	UINT32	uiCnt=0;
 
 	//Clear out the old list
-	std::fill_n(gSmokeEffectData, NUM_SMOKE_EFFECT_SLOTS, SMOKEEFFECT{});
+	ResetSmokeEffects();
 
 	//Load the Number of Smoke Effects
 	hFile->read(&guiNumSmokeEffects, sizeof(UINT32));
@@ -479,8 +586,7 @@ void LoadSmokeEffectsFromLoadGameFile(HWFILE const hFile, UINT32 const savegame_
 	//loop through and apply the smoke effects to the map
 	FOR_EACH_SMOKE_EFFECT(s)
 	{
-		const INT8 bLevel = (s->bFlags & SMOKE_EFFECT_ON_ROOF ? 1 : 0);
-		SpreadEffectSmoke(s, TRUE, bLevel);
+		SpreadSmokeEffect(s, TRUE);
 	}
 }
 
@@ -544,8 +650,7 @@ void LoadSmokeEffectsFromMapTempFile(INT16 const sMapX, INT16 const sMapY, INT8
 	//loop through and apply the smoke effects to the map
 	FOR_EACH_SMOKE_EFFECT(s)
 	{
-		const INT8 bLevel = (s->bFlags & SMOKE_EFFECT_ON_ROOF ? 1 : 0);
-		SpreadEffectSmoke(s, TRUE, bLevel);
+		SpreadSmokeEffect(s, TRUE);
 	}
 }
 
@@ -555,6 +660,7 @@ void ResetSmokeEffects()
 	//Clear out the old list
 	std::fill_n(gSmokeEffectData, NUM_SMOKE_EFFECT_SLOTS, SMOKEEFFECT{});
 	guiNumSmokeEffects = 0;
+	for (SMOKE_COVERAGE& c : gSmokeCoverage) c.tiles.clear();
 }
 
 
@@ -562,8 +668,113 @@ void UpdateSmokeEffectGraphics( )
 {
 	FOR_EACH_SMOKE_EFFECT(s)
 	{
-		const INT8 bLevel = (s->bFlags & SMOKE_EFFECT_ON_ROOF ? 1 : 0);
-		SpreadEffectSmoke(s, ERASE_SPREAD_EFFECT, bLevel);
-		SpreadEffectSmoke(s, TRUE,                bLevel);
+		SMOKE_COVERAGE const& coverage = gSmokeCoverage[s - gSmokeEffectData];
+		const INT8 bLevel = GetSmokeEffectLevel(s);
+		SpreadEffectSmokeOnTiles(s, ERASE_SPREAD_EFFECT, bLevel, coverage.tiles);
+		SpreadEffectSmokeOnTiles(s, TRUE,                bLevel, coverage.tiles);
+	}
+}
+
+
+#ifdef WITH_UNITTESTS
+#include "gtest/gtest.h"
+#include "PathAI.h"
+
+static bool CoversTile(SMOKE_COVERAGE const& coverage, INT16 const sGridNo)
+{
+	for (SPREAD_TILE const& t : coverage.tiles)
+	{
+		if (t.sGridNo == sGridNo) return true;
 	}
+	return false;
 }
+
+TEST(SmokeEffects, coverageFollowsRadiusAndStructures)
+{
+	MAP_ELEMENT* const saved_world = gpWorldLevelData;
+	std::vector<MAP_ELEMENT> world(WORLD_MAX);
+	gpWorldLevelData = world.data();
+
+	SMOKEEFFECT s{};
+	s.sGridNo    = 40 * WORLD_COLS + 40;
+	s.ubRadius   = 3;
+	s.ubDuration = 5;
+	INT16 const wall = NewGridNo(s.sGridNo, DirectionInc(NORTH));
+
+	SMOKE_COVERAGE          coverage{};
+	std::bitset<WORLD_MAX>  old_tiles;
+	EXPECT_TRUE(RegrowSmokeCoverage(&s, 0, coverage, old_tiles));
+	EXPECT_TRUE(CoversTile(coverage, wall));
+	EXPECT_TRUE(old_tiles.none());
+	size_t const open_tiles = coverage.tiles.size();
+
+	// Nothing changed, the cached tiles are kept
+	EXPECT_FALSE(RegrowSmokeCoverage(&s, 0, coverage, old_tiles));
+	EXPECT_EQ(coverage.tiles.size(), open_tiles);
+
+	// A wall goes up, but the tiles are only collected again once the
+	// structure code says so
+	UINT8 saved_costs[MAXDIR];
+	for (UINT8 dir = 0; dir != MAXDIR; ++dir)
+	{
+		saved_costs[dir] = gubWorldMovementCosts[wall][dir][0];
+		gubWorldMovementCosts[wall][dir][0] = TRAVELCOST_WALL;
+	}
+	EXPECT_FALSE(RegrowSmokeCoverage(&s, 0, coverage, old_tiles));
+	EXPECT_TRUE(CoversTile(coverage, wall));
+
+	++guiWorldStructureGeneration;
+	EXPECT_TRUE(RegrowSmokeCoverage(&s, 0, coverage, old_tiles));
+	EXPECT_FALSE(CoversTile(coverage, wall));
+	EXPECT_LT(coverage.tiles.size(), open_tiles);
+	EXPECT_TRUE(old_tiles[wall]);
+	old_tiles.reset();
+
+	// The cloud grows
+	s.ubRadius = 4;
+	EXPECT_TRUE(RegrowSmokeCoverage(&s, 0, coverage, old_tiles));
+	EXPECT_FALSE(RegrowSmokeCoverage(&s, 0, coverage, old_tiles));
+
+	for (UINT8 dir = 0; dir != MAXDIR; ++dir) gubWorldMovementCosts[wall][dir][0] = saved_costs[dir];
+	gpWorldLevelData = saved_world;
+}
+
+TEST(SmokeEffects, sightChangesAreTheTouchedSightSmoke)
+{
+	MAP_ELEMENT* const saved_world = gpWorldLevelData;
+	std::vector<MAP_ELEMENT> world(WORLD_MAX);
+	gpWorldLevelData = world.data();
+
+	INT16 const added     = 100;
+	INT16 const removed   = 200;
+	INT16 const creature  = 300;
+	INT16 const unchanged = 400;
+	INT16 const untracked = 500;
+	world[removed].ubExtFlags[1]   = MAPELEMENT_EXT_TEARGAS;
+	world[unchanged].ubExtFlags[0] = MAPELEMENT_EXT_SMOKE;
+
+	gfTrackSmokeChanges = TRUE;
+	TouchSmokeTile(added,     0);
+	TouchSmokeTile(removed,   1);
+	TouchSmokeTile(creature,  0);
+	TouchSmokeTile(unchanged, 0);
+	world[added].ubExtFlags[0]    |= MAPELEMENT_EXT_SMOKE;
+	world[removed].ubExtFlags[1]   = 0;
+	world[creature].ubExtFlags[0] |= MAPELEMENT_EXT_CREATUREGAS;
+	world[unchanged].ubExtFlags[0] |= MAPELEMENT_EXT_SMOKE;
+	// Touching a tile again keeps the flags it had at first
+	TouchSmokeTile(added, 0);
+	gfTrackSmokeChanges = FALSE;
+	TouchSmokeTile(untracked, 0);
+	world[untracked].ubExtFlags[0] |= MAPELEMENT_EXT_MUSTARDGAS;
+
+	std::vector<INT16> const changed = TakeSmokeSightChanges();
+	EXPECT_EQ(changed, (std::vector<INT16>{ added, removed }));
+
+	// Taken changes are forgotten
+	EXPECT_TRUE(TakeSmokeSightChanges().empty());
+
+	gpWorldLevelData = saved_world;
+}
+
+#endif
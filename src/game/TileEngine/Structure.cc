@@ -64,6 +64,8 @@ UINT8 AtHeight[PROFILE_Z_SIZE] = { 0x01, 0x02, 0x04, 0x08 };
 
 static UINT16 gusNextAvailableStructureID = FIRST_AVAILABLE_STRUCTURE_ID;
 
+UINT32 guiWorldStructureGeneration = 0;
+
 static STRUCTURE_FILE_REF* gpStructureFileRefs;
 
 
@@ -241,6 +243,7 @@ void FreeStructureFile(STRUCTURE_FILE_REF* const sfr)
 static void LoadStructureData(char const* const filename, STRUCTURE_FILE_REF* const sfr, UINT32* const structure_data_size)
 {
 	AutoSGPFile f(GCM->openGameResForReading(filename));
+	f->slurp();
 
 	BYTE data[16];
 	f->read(data, sizeof(data));
@@ -682,6 +685,13 @@ static void AddStructureToTile(MAP_ELEMENT* const me, STRUCTURE* const s, UINT16
 static void DeleteStructureFromTile(MAP_ELEMENT* pMapElement, STRUCTURE* pStructure);
 
 
+// Whether the structure stays put, unlike soldiers and corpses
+static bool IsFixedStructure(STRUCTURE const* const s)
+{
+	return !(s->fFlags & (STRUCTURE_MOBILE | STRUCTURE_PERSON | STRUCTURE_CORPSE));
+}
+
+
 STRUCTURE* AddStructureToWorld(INT16 const sBaseGridNo, INT8 const bLevel, DB_STRUCTURE_REF const* const pDBStructureRef, LEVELNODE* const pLevelNode)
 try
 { // Adds a complete structure to the world at a location plus all other locations covered by the structure
@@ -814,6 +824,7 @@ try
 
 	STRUCTURE* const base = structures[BASE_TILE];
 	pLevelNode->pStructureData = base;
+	if (IsFixedStructure(base)) ++guiWorldStructureGeneration;
 	return base;
 }
 catch (...) { return 0; }
@@ -850,6 +861,7 @@ BOOLEAN DeleteStructureFromWorld(STRUCTURE* const structure)
 	UINT16              const structure_id           = base->usStructureID;
 	bool                const recompile_mps          = gsRecompileAreaLeft != 0 && !(base->fFlags & STRUCTURE_MOBILE);
 	bool                const recompile_extra_radius = recompile_mps && base->fFlags & STRUCTURE_WALLSTUFF; // For doors, yuck
+	bool                const fixed                  = IsFixedStructure(base);
 	GridNo              const base_grid_no           = base->sGridNo;
 	DB_STRUCTURE_TILE** const tile                   = base->pDBStructureRef->ppTile;
 	DB_STRUCTURE_TILE** const end_tile               = tile + base->pDBStructureRef->pDBStructure->ubNumberOfTiles;
@@ -878,6 +890,7 @@ BOOLEAN DeleteStructureFromWorld(STRUCTURE* const structure)
 			AddTileToRecompileArea(check_grid_no);
 		}
 	}
+	if (fixed) ++guiWorldStructureGeneration;
 	return TRUE;
 }
 
@@ -138,6 +138,11 @@ SoundID GetStructureOpenSound(STRUCTURE const*, bool closing);
 
 extern const UINT8 gubMaterialArmour[];
 
+/* Bumped whenever a structure which stays put, e.g. a wall or a door, is added
+ * to or removed from the world. Opening a door swaps its structure, so that
+ * counts, too. */
+extern UINT32 guiWorldStructureGeneration;
+
 typedef SGP::AutoObj<STRUCTURE_FILE_REF, FreeStructureFile> AutoStructureFileRef;
 
 #endif
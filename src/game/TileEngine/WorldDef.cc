@@ -54,6 +54,7 @@
 #include "Summary_Info.h"
 #include "Sys_Globals.h"
 #include "Tile_Animation.h"
+#include "ThreadPool.h"
 #include "Tile_Surface.h"
 #include "TileDat.h"
 #include "TileDef.h"
@@ -61,6 +62,11 @@
 #include "World_Items.h"
 #include "WorldDat.h"
 #include "WorldMan.h"
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <string_theory/format>
@@ -189,6 +195,8 @@ static void DestroyTileSurfaces(void);
 void DeinitializeWorld( )
 {
 	TrashWorld();
+	// The overhead map may outlive a world that was never loaded completely
+	TrashOverheadMap();
 
 	if ( gpWorldLevelData != NULL )
 	{
@@ -1696,79 +1704,91 @@ void InitLoadedWorld(void)
 }
 
 
-extern double MasterStart, MasterEnd;
-extern BOOLEAN gfUpdatingNow;
-
-/* This is a specialty function that is very similar to LoadWorld, except that
- * it doesn't actually load the world, it instead evaluates the map and
- * generates summary information for use within the summary editor.  The header
- * is defined in Summary Info.h, not worlddef.h -- though it's not likely this
- * is going to be used anywhere where it would matter. */
-BOOLEAN EvaluateWorld(const char* const pSector, const UINT8 ubLevel)
-try
+namespace
 {
-	// Make sure the file exists... if not, then return false
-	char filename[40];
-	snprintf(filename, lengthof(filename), "%s%s%.0d%s.dat",
-		pSector,
-		ubLevel % 4 != 0 ? "_b" : "",
-		ubLevel % 4,
-		ubLevel     >= 4 ? "_a" : ""
-	);
-
-	if (gfMajorUpdate)
+	// Bounds checked reads from a map file held in memory
+	class MapReader
 	{
-		LoadWorld(filename);
-		SaveWorldAbsolute(filename);
-	}
+	public:
+		MapReader(BYTE const* const data, size_t const size) : data_(data), size_(size), pos_(0) {}
 
-	AutoSGPFile f(GCM->openMapForReading(filename));
+		BYTE const* take(size_t const n)
+		{
+			if (size_ - pos_ < n) throw std::runtime_error("Unexpected end of map file");
+			BYTE const* const p = data_ + pos_;
+			pos_ += n;
+			return p;
+		}
 
-	ST::string str = ST::format("Analyzing map {}", filename);
-	if (!gfUpdatingNow)
-	{
-		SetRelativeStartAndEndPercentage(0, 0, 100, str);
-	}
-	else
+		void   read(void* const dst, size_t const n) { std::memcpy(dst, take(n), n); }
+		void   skip(size_t const n)                  { take(n); }
+		UINT32 pos() const                           { return static_cast<UINT32>(pos_); }
+
+	private:
+		BYTE const* data_;
+		size_t      size_;
+		size_t      pos_;
+	};
+
+	// The same reads going to a map file one by one
+	class FileMapReader
 	{
-		SetRelativeStartAndEndPercentage(0, (UINT16)MasterStart, (UINT16)MasterEnd, str);
-	}
+	public:
+		FileMapReader(SGPFile* const f) : f_(f) {}
 
-	RenderProgressBar(0, 0);
+		BYTE const* take(size_t const n)
+		{
+			buf_.resize(n);
+			read(buf_.data(), n);
+			return buf_.data();
+		}
+
+		void   read(void* const dst, size_t const n) { f_->read(dst, n); }
+		void   skip(size_t const n)                  { f_->seek(static_cast<INT32>(n), FILE_SEEK_FROM_CURRENT); }
+		UINT32 pos() const                           { return f_->pos(); }
+
+	private:
+		SGPFile*          f_;
+		std::vector<BYTE> buf_;
+	};
+}
 
-	//clear the summary file info
-	SUMMARYFILE* const pSummary = new SUMMARYFILE{};
-	pSummary->ubSummaryVersion = GLOBAL_SUMMARY_VERSION;
-	pSummary->dMajorMapVersion = getMajorMapVersion();
+
+template<typename Reader> static SUMMARYFILE* ParseWorldSummaryFrom(Reader& r)
+{
+	// Cleared bytewise, the summary is written to disk as it is
+	std::unique_ptr<SUMMARYFILE> summary(new SUMMARYFILE);
+	SUMMARYFILE* const s = summary.get();
+	std::memset(s, 0, sizeof(*s));
+	s->ubSummaryVersion = GLOBAL_SUMMARY_VERSION;
+	s->dMajorMapVersion = getMajorMapVersion();
 
 	//skip JA2 Version ID
 	FLOAT	dMajorMapVersion;
-	f->read(&dMajorMapVersion, sizeof(dMajorMapVersion));
+	r.read(&dMajorMapVersion, sizeof(dMajorMapVersion));
 	if (dMajorMapVersion >= 4.00)
 	{
-		f->seek(sizeof(UINT8), FILE_SEEK_FROM_CURRENT);
+		r.skip(sizeof(UINT8));
 	}
 
 	//Read FLAGS FOR WORLD
 	UINT32 uiFlags;
-	f->read(&uiFlags, sizeof(uiFlags));
+	r.read(&uiFlags, sizeof(uiFlags));
 
 	//Read tilesetID
 	INT32 iTilesetID;
-	f->read(&iTilesetID, sizeof(iTilesetID));
-	pSummary->ubTilesetID = (UINT8)iTilesetID;
+	r.read(&iTilesetID, sizeof(iTilesetID));
+	s->ubTilesetID = (UINT8)iTilesetID;
 
 	// Skip soldier size and height values
-	f->seek(sizeof(UINT32) + (1 + 1) * WORLD_MAX, FILE_SEEK_FROM_CURRENT);
+	r.skip(sizeof(UINT32) + (1 + 1) * WORLD_MAX);
 
 	// Skip all layers
 	INT32 skip = 0;
 	for (UINT32 row = 0; row != WORLD_ROWS; ++row)
 	{
-		if (row % 16 == 0) RenderProgressBar(0, row * 90 / WORLD_ROWS + 1); // 1 - 90
-
 		UINT8 combine[WORLD_COLS][4];
-		f->read(combine, sizeof(combine));
+		r.read(combine, sizeof(combine));
 		for (UINT8 const (*i)[4] = combine; i != endof(combine); ++i)
 		{
 			skip +=
@@ -1780,91 +1800,86 @@ try
 				((*i)[3] & 0x0F) * 2;  // #on roof
 		}
 	}
-	f->seek(skip, FILE_SEEK_FROM_CURRENT);
+	r.skip(skip);
 
 	//extract highest room number
 	UINT8 max_room = 0;
 	for (INT32 row = 0; row != WORLD_ROWS; ++row)
 	{
 		UINT8 room[WORLD_COLS];
-		f->read(room, sizeof(room));
+		r.read(room, sizeof(room));
 		for (INT32 col = 0; col != WORLD_COLS; ++col)
 		{
 			if (max_room < room[col]) max_room = room[col];
 		}
 	}
-	pSummary->ubNumRooms = max_room;
+	s->ubNumRooms = max_room;
 
 	if (uiFlags & MAP_WORLDITEMS_SAVED)
 	{
-		RenderProgressBar(0, 91);
 		//Important:  Saves the file position (byte offset) of the position where the numitems
 		//            resides.  Checking this value and comparing to usNumItems will ensure validity.
-		pSummary->uiNumItemsPosition = f->pos();
+		s->uiNumItemsPosition = r.pos();
 		//get number of items (for now)
 		UINT32 n_items;
-		f->read(&n_items, sizeof(n_items));
-		pSummary->usNumItems = n_items;
+		r.read(&n_items, sizeof(n_items));
+		s->usNumItems = n_items;
 		//Skip the contents of the world items.
-		f->seek(sizeof(WORLDITEM) * n_items, FILE_SEEK_FROM_CURRENT);
+		r.skip(sizeof(WORLDITEM) * n_items);
 	}
 
-	if (uiFlags & MAP_AMBIENTLIGHTLEVEL_SAVED) f->seek(3, FILE_SEEK_FROM_CURRENT);
+	if (uiFlags & MAP_AMBIENTLIGHTLEVEL_SAVED) r.skip(3);
 
 	if (uiFlags & MAP_WORLDLIGHTS_SAVED)
 	{
-		RenderProgressBar(0, 92);
-
 		//skip number of light palette entries
 		UINT8 n_light_colours;
-		f->read(&n_light_colours, sizeof(n_light_colours));
-		f->seek(sizeof(SGPPaletteEntry) * n_light_colours, FILE_SEEK_FROM_CURRENT);
+		r.read(&n_light_colours, sizeof(n_light_colours));
+		r.skip(sizeof(SGPPaletteEntry) * n_light_colours);
 
 		//get number of lights
-		f->read(&pSummary->usNumLights, sizeof(pSummary->usNumLights));
+		r.read(&s->usNumLights, sizeof(s->usNumLights));
 		//skip the light loading
-		for (INT32 n = pSummary->usNumLights; n != 0; --n)
+		for (INT32 n = s->usNumLights; n != 0; --n)
 		{
-			f->seek(24 /* size of a LIGHT_SPRITE on disk */, FILE_SEEK_FROM_CURRENT);
+			r.skip(24 /* size of a LIGHT_SPRITE on disk */);
 			UINT8 ubStrLen;
-			f->read(&ubStrLen, sizeof(ubStrLen));
-			f->seek(ubStrLen, FILE_SEEK_FROM_CURRENT);
+			r.read(&ubStrLen, sizeof(ubStrLen));
+			r.skip(ubStrLen);
 		}
 	}
 
 	//read the mapinformation
-	f->read(&pSummary->MapInfo, sizeof(pSummary->MapInfo));
+	r.read(&s->MapInfo, sizeof(s->MapInfo));
 
 	if (uiFlags & MAP_FULLSOLDIER_SAVED)
 	{
-		RenderProgressBar(0, 94);
-
-		pSummary->uiEnemyPlacementPosition = f->pos();
+		s->uiEnemyPlacementPosition = r.pos();
 
-		for (INT32 i = 0; i < pSummary->MapInfo.ubNumIndividuals; ++i)
+		for (INT32 i = 0; i < s->MapInfo.ubNumIndividuals; ++i)
 		{
 			BASIC_SOLDIERCREATE_STRUCT basic;
-			ExtractBasicSoldierCreateStructFromFile(f, basic);
+			ExtractBasicSoldierCreateStruct(r.take(BASIC_SOLDIERCREATE_STRUCT_SIZE), basic);
 
 			TEAMSUMMARY* pTeam = NULL;
 			switch (basic.bTeam)
 			{
-				case ENEMY_TEAM:    pTeam = &pSummary->EnemyTeam;    break;
-				case CREATURE_TEAM: pTeam = &pSummary->CreatureTeam; break;
-				case MILITIA_TEAM:  pTeam = &pSummary->RebelTeam;    break;
-				case CIV_TEAM:      pTeam = &pSummary->CivTeam;      break;
+				case ENEMY_TEAM:    pTeam = &s->EnemyTeam;    break;
+				case CREATURE_TEAM: pTeam = &s->CreatureTeam; break;
+				case MILITIA_TEAM:  pTeam = &s->RebelTeam;    break;
+				case CIV_TEAM:      pTeam = &s->CivTeam;      break;
 			}
 
 			if (basic.bOrders == RNDPTPATROL || basic.bOrders == POINTPATROL)
 			{ //make sure the placement has at least one waypoint.
 				if (!basic.bPatrolCnt)
 				{
-					++pSummary->ubEnemiesReqWaypoints;
+					++s->ubEnemiesReqWaypoints;
 				}
 			}
 			else if (basic.bPatrolCnt)
 			{
-				++pSummary->ubEnemiesHaveWaypoints;
+				++s->ubEnemiesHaveWaypoints;
 			}
 
 			if (basic.fPriorityExistance) ++pTeam->ubExistance;
@@ -1893,7 +1908,7 @@ try
 
 				// Always use windows format because here we are loading a map
 				// file, not a user save
-				ExtractSoldierCreateFromFile(f, &priority, false);
+				ExtractSoldierCreate(r.take(SOLDIERCREATE_STRUCT_SIZE), &priority, false);
 
 				if (priority.ubProfile != NO_PROFILE)
 					++pTeam->ubProfile;
@@ -1902,11 +1917,11 @@ try
 
 				if (basic.bTeam == CIV_TEAM)
 				{
-					if (priority.ubScheduleID) ++pSummary->ubCivSchedules;
+					if (priority.ubScheduleID) ++s->ubCivSchedules;
 					switch (priority.bBodyType)
 					{
-						case COW:      ++pSummary->ubCivCows; break;
-						case BLOODCAT: ++pSummary->ubCivBloodcats; break;
+						case COW:      ++s->ubCivCows; break;
+						case BLOODCAT: ++s->ubCivBloodcats; break;
 					}
 				}
 			}
@@ -1916,38 +1931,38 @@ try
 				switch (basic.ubSoldierClass)
 				{
 					case SOLDIER_CLASS_ADMINISTRATOR:
-						++pSummary->ubNumAdmins;
-						if (basic.fPriorityExistance) ++pSummary->ubAdminExistance;
+						++s->ubNumAdmins;
+						if (basic.fPriorityExistance) ++s->ubAdminExistance;
 						if (basic.fDetailedPlacement)
 						{
 							if (priority.ubProfile != NO_PROFILE)
-								++pSummary->ubAdminProfile;
+								++s->ubAdminProfile;
 							else
-								++pSummary->ubAdminDetailed;
+								++s->ubAdminDetailed;
 						}
 						break;
 
 					case SOLDIER_CLASS_ELITE:
-						++pSummary->ubNumElites;
-						if (basic.fPriorityExistance) ++pSummary->ubEliteExistance;
+						++s->ubNumElites;
+						if (basic.fPriorityExistance) ++s->ubEliteExistance;
 						if (basic.fDetailedPlacement)
 						{
 							if (priority.ubProfile != NO_PROFILE)
-								++pSummary->ubEliteProfile;
+								++s->ubEliteProfile;
 							else
-								++pSummary->ubEliteDetailed;
+								++s->ubEliteDetailed;
 						}
 						break;
 
 					case SOLDIER_CLASS_ARMY:
-						++pSummary->ubNumTroops;
-						if (basic.fPriorityExistance) ++pSummary->ubTroopExistance;
+						++s->ubNumTroops;
+						if (basic.fPriorityExistance) ++s->ubTroopExistance;
 						if (basic.fDetailedPlacement)
 						{
 							if (priority.ubProfile != NO_PROFILE)
-								++pSummary->ubTroopProfile;
+								++s->ubTroopProfile;
 							else
-								++pSummary->ubTroopDetailed;
+								++s->ubTroopDetailed;
 						}
 						break;
 				}
@@ -1958,35 +1973,32 @@ try
 			}
 			++pTeam->ubTotal;
 		}
-		RenderProgressBar(0, 96);
 	}
 
 	if (uiFlags & MAP_EXITGRIDS_SAVED)
 	{
-		RenderProgressBar(0, 98);
-
 		UINT16 cnt;
-		f->read(&cnt, sizeof(cnt));
+		r.read(&cnt, sizeof(cnt));
 
 		for (INT32 n = cnt; n != 0; --n)
 		{
 			UINT16 usMapIndex;
-			f->read(&usMapIndex, sizeof(usMapIndex));
+			r.read(&usMapIndex, sizeof(usMapIndex));
 			EXITGRID exitGrid;
-			f->read(&exitGrid, 5 /* XXX sic! The 6th byte luckily is padding */);
+			r.read(&exitGrid, 5 /* XXX sic! The 6th byte luckily is padding */);
 			for (INT32 loop = 0;; ++loop)
 			{
-				if (loop >= pSummary->ubNumExitGridDests)
+				if (loop >= s->ubNumExitGridDests)
 				{
 					if (loop >= 4)
 					{
-						pSummary->fTooManyExitGridDests = TRUE;
+						s->fTooManyExitGridDests = TRUE;
 					}
 					else
 					{
-						++pSummary->ubNumExitGridDests;
-						++pSummary->usExitGridSize[loop];
-						EXITGRID* const eg = &pSummary->ExitGrid[loop];
+						++s->ubNumExitGridDests;
+						++s->usExitGridSize[loop];
+						EXITGRID* const eg = &s->ExitGrid[loop];
 						eg->usGridNo      = exitGrid.usGridNo;
 						eg->ubGotoSectorX = exitGrid.ubGotoSectorX;
 						eg->ubGotoSectorY = exitGrid.ubGotoSectorY;
@@ -1994,19 +2006,19 @@ try
 						if (eg->ubGotoSectorX != exitGrid.ubGotoSectorX ||
 								eg->ubGotoSectorY != exitGrid.ubGotoSectorY)
 						{
-							pSummary->fInvalidDest[loop] = TRUE;
+							s->fInvalidDest[loop] = TRUE;
 						}
 					}
 					break;
 				}
 
-				const EXITGRID* const eg = &pSummary->ExitGrid[loop];
+				const EXITGRID* const eg = &s->ExitGrid[loop];
 				if (eg->usGridNo      == exitGrid.usGridNo      &&
 						eg->ubGotoSectorX == exitGrid.ubGotoSectorX &&
 						eg->ubGotoSectorY == exitGrid.ubGotoSectorY &&
 						eg->ubGotoSectorZ == exitGrid.ubGotoSectorZ)
 				{ //same destination.
-					++pSummary->usExitGridSize[loop];
+					++s->usExitGridSize[loop];
 					break;
 				}
 			}
@@ -2015,19 +2027,91 @@ try
 
 	if (uiFlags & MAP_DOORTABLE_SAVED)
 	{
-		f->read(&pSummary->ubNumDoors, sizeof(pSummary->ubNumDoors));
+		r.read(&s->ubNumDoors, sizeof(s->ubNumDoors));
 
-		for (INT32 n = pSummary->ubNumDoors; n != 0; --n)
+		for (INT32 n = s->ubNumDoors; n != 0; --n)
 		{
 			DOOR Door;
-			f->read(&Door, sizeof(Door));
+			r.read(&Door, sizeof(Door));
 
-			if      (Door.ubLockID && Door.ubTrapID) ++pSummary->ubNumDoorsLockedAndTrapped;
-			else if (Door.ubLockID)                  ++pSummary->ubNumDoorsLocked;
-			else if (Door.ubTrapID)                  ++pSummary->ubNumDoorsTrapped;
+			if      (Door.ubLockID && Door.ubTrapID) ++s->ubNumDoorsLockedAndTrapped;
+			else if (Door.ubLockID)                  ++s->ubNumDoorsLocked;
+			else if (Door.ubTrapID)                  ++s->ubNumDoorsTrapped;
 		}
 	}
 
+	return summary.release();
+}
+
+
+SUMMARYFILE* ParseWorldSummary(BYTE const* const data, size_t const size)
+{
+	MapReader r(data, size);
+	return ParseWorldSummaryFrom(r);
+}
+
+
+SUMMARYFILE* ParseWorldSummary(SGPFile* const f)
+{
+	FileMapReader r(f);
+	return ParseWorldSummaryFrom(r);
+}
+
+
+static ST::string GetSummaryMapFilename(const char* const pSector, UINT8 const ubLevel)
+{
+	return ST::format("{}{}{}{}.dat",
+		pSector,
+		ubLevel % 4 != 0 ? "_b" : "",
+		ubLevel % 4 != 0 ? ST::format("{}", ubLevel % 4) : ST::string(),
+		ubLevel     >= 4 ? "_a" : ""
+	);
+}
+
+
+extern double MasterStart, MasterEnd;
+extern BOOLEAN gfUpdatingNow;
+
+static void SetSummaryProgressText(const ST::string& filename)
+{
+	ST::string str = ST::format("Analyzing map {}", filename);
+	if (!gfUpdatingNow)
+	{
+		SetRelativeStartAndEndPercentage(0, 0, 100, str);
+	}
+	else
+	{
+		SetRelativeStartAndEndPercentage(0, (UINT16)MasterStart, (UINT16)MasterEnd, str);
+	}
+}
+
+
+/* This is a specialty function that is very similar to LoadWorld, except that
+ * it doesn't actually load the world, it instead evaluates the map and
+ * generates summary information for use within the summary editor.  The header
+ * is defined in Summary Info.h, not worlddef.h -- though it's not likely this
+ * is going to be used anywhere where it would matter. */
+BOOLEAN EvaluateWorld(const char* const pSector, const UINT8 ubLevel)
+try
+{
+	ST::string const filename = GetSummaryMapFilename(pSector, ubLevel);
+
+	if (gfMajorUpdate)
+	{
+		LoadWorld(filename);
+		SaveWorldAbsolute(filename);
+	}
+
+	SetSummaryProgressText(filename);
+	RenderProgressBar(0, 0);
+
+	SUMMARYFILE* pSummary;
+	{
+		AutoSGPFile f(GCM->openMapForReading(filename));
+		f->bufferReads();
+		pSummary = ParseWorldSummary(f);
+	}
+
 	RenderProgressBar(0, 100);
 
 	WriteSectorSummaryUpdate(filename, ubLevel, pSummary);
@@ -2036,6 +2120,86 @@ try
 catch (...) { return FALSE; }
 
 
+// Workers for summarizing maps, started on first use
+static ThreadPool& SummaryPool()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+
+std::vector<std::unique_ptr<SUMMARYFILE>> ParseWorldSummaries(size_t const n_maps, std::function<std::vector<UINT8>(size_t)> const& load)
+{
+	std::vector<std::future<std::unique_ptr<SUMMARYFILE>>> parsed;
+	parsed.reserve(n_maps);
+	for (size_t i = 0; i != n_maps; ++i)
+	{
+		parsed.push_back(SummaryPool().enqueue([&load, i]() {
+			std::vector<UINT8> const data = load(i);
+			return std::unique_ptr<SUMMARYFILE>(ParseWorldSummary(data.data(), data.size()));
+		}));
+	}
+
+	std::vector<std::unique_ptr<SUMMARYFILE>> summaries;
+	summaries.reserve(n_maps);
+	for (std::future<std::unique_ptr<SUMMARYFILE>>& p : parsed)
+	{
+		try
+		{
+			summaries.push_back(p.get());
+		}
+		catch (...)
+		{
+			summaries.push_back(std::unique_ptr<SUMMARYFILE>());
+		}
+	}
+	return summaries;
+}
+
+
+std::vector<bool> EvaluateWorlds(std::vector<SUMMARY_MAP> const& maps)
+{
+	std::vector<bool> evaluated;
+	evaluated.reserve(maps.size());
+
+	if (gfMajorUpdate)
+	{
+		// Every map is loaded and saved again, which uses the world globals
+		for (SUMMARY_MAP const& m : maps)
+		{
+			evaluated.push_back(EvaluateWorld(m.sector.c_str(), m.ubLevel));
+		}
+		return evaluated;
+	}
+
+	std::vector<ST::string> filenames;
+	filenames.reserve(maps.size());
+	for (SUMMARY_MAP const& m : maps)
+	{
+		filenames.push_back(GetSummaryMapFilename(m.sector.c_str(), m.ubLevel));
+	}
+
+	std::vector<std::unique_ptr<SUMMARYFILE>> summaries = ParseWorldSummaries(maps.size(),
+		[&filenames](size_t const i) {
+			AutoSGPFile f(GCM->openMapForReading(filenames[i]));
+			return f->readToEnd();
+		});
+
+	// Written back in the order given, so the progress and the results are the same as one at a time
+	for (size_t i = 0; i != maps.size(); ++i)
+	{
+		SUMMARYFILE* const s = summaries[i].release();
+		evaluated.push_back(s != NULL);
+		if (!s) continue;
+
+		SetSummaryProgressText(filenames[i]);
+		RenderProgressBar(0, 100);
+		WriteSectorSummaryUpdate(filenames[i], maps[i].ubLevel, s);
+	}
+	return evaluated;
+}
+
+
 static void LoadMapLights(HWFILE);
 
 void LoadWorldFromSGPFile(SGPFile *f);
@@ -2043,8 +2207,15 @@ void LoadWorldFromSGPFile(SGPFile *f);
 void LoadWorld(const ST::string &name)
 try
 {
+	auto const start = std::chrono::steady_clock::now();
+	uint64_t const calls = SGPFile::fileSystemCalls();
+
 	AutoSGPFile f(GCM->openMapForReading(name));
+	f->slurp();
 	LoadWorldFromSGPFile(f);
+
+	auto const ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+	STLOGD("Loaded map '{}' in {} ms with {} file system calls", name, ms, SGPFile::fileSystemCalls() - calls);
 }
 catch (const std::runtime_error& err)
 {
@@ -2056,6 +2227,7 @@ void LoadWorldAbsolute(const ST::string &absolutePath)
 try
 {
 	AutoSGPFile f{FileMan::openForReading(absolutePath)};
+	f->slurp();
 	LoadWorldFromSGPFile(f);
 }
 catch (const std::runtime_error& err)
@@ -2160,15 +2332,12 @@ void LoadWorldFromSGPFile(SGPFile *f)
 	{
 		for (INT32 n = bCounts[cnt][0]; n != 0; --n)
 		{
-			BYTE data[2];
-			f->read(data, sizeof(data));
-
 			UINT8       ubType;
 			UINT8       ubSubIndex;
-			DataReader d{data};
+			DataReader d{f->readInPlace(2)};
 			EXTR_U8(d, ubType)
 			EXTR_U8(d, ubSubIndex)
-			Assert(d.getConsumed() == lengthof(data));
+			Assert(d.getConsumed() == 2);
 
 			UINT16 const usTileIndex = GetTileIndexFromTypeSubIndex(ubType, ubSubIndex);
 			AddLandToHead(cnt, usTileIndex);
@@ -2184,15 +2353,12 @@ void LoadWorldFromSGPFile(SGPFile *f)
 		{
 			for (INT32 n = bCounts[cnt][1]; n != 0; --n)
 			{
-				BYTE data[2];
-				f->read(data, sizeof(data));
-
 				UINT8       ubType;
 				UINT8       ubSubIndex;
-				DataReader d{data};
+				DataReader d{f->readInPlace(2)};
 				EXTR_U8(d, ubType)
 				EXTR_U8(d, ubSubIndex)
-				Assert(d.getConsumed() == lengthof(data));
+				Assert(d.getConsumed() == 2);
 
 				if (ubType >= FIRSTPOINTERS) continue;
 				UINT16 const usTileIndex = GetTileIndexFromTypeSubIndex(ubType, ubSubIndex);
@@ -2207,15 +2373,12 @@ void LoadWorldFromSGPFile(SGPFile *f)
 		{
 			for (INT32 n = bCounts[cnt][1]; n != 0; --n)
 			{
-				BYTE data[3];
-				f->read(data, sizeof(data));
-
 				UINT8       ubType;
 				UINT16      usTypeSubIndex;
-				DataReader d{data};
+				DataReader d{f->readInPlace(3)};
 				EXTR_U8( d, ubType)
 				EXTR_U16(d, usTypeSubIndex)
-				Assert(d.getConsumed() == lengthof(data));
+				Assert(d.getConsumed() == 3);
 
 				if (ubType >= FIRSTPOINTERS) continue;
 				UINT16 const usTileIndex = GetTileIndexFromTypeSubIndex(ubType, usTypeSubIndex);
@@ -2231,15 +2394,12 @@ void LoadWorldFromSGPFile(SGPFile *f)
 	{ // Set structs
 		for (INT32 n = bCounts[cnt][2]; n != 0; --n)
 		{
-			BYTE data[2];
-			f->read(data, sizeof(data));
-
 			UINT8       ubType;
 			UINT8       ubSubIndex;
-			DataReader d{data};
+			DataReader d{f->readInPlace(2)};
 			EXTR_U8(d, ubType)
 			EXTR_U8(d, ubSubIndex)
-			Assert(d.getConsumed() == lengthof(data));
+			Assert(d.getConsumed() == 2);
 
 			UINT16 usTileIndex = GetTileIndexFromTypeSubIndex(ubType, ubSubIndex);
 
@@ -2274,15 +2434,12 @@ void LoadWorldFromSGPFile(SGPFile *f)
 	{
 		for (INT32 n = bCounts[cnt][3]; n != 0; --n)
 		{
-			BYTE data[2];
-			f->read(data, sizeof(data));
-
 			UINT8       ubType;
 			UINT8       ubSubIndex;
-			DataReader d{data};
+			DataReader d{f->readInPlace(2)};
 			EXTR_U8(d, ubType)
 			EXTR_U8(d, ubSubIndex)
-			Assert(d.getConsumed() == lengthof(data));
+			Assert(d.getConsumed() == 2);
 
 			UINT16 const usTileIndex = GetTileIndexFromTypeSubIndex(ubType, ubSubIndex);
 			AddShadowToTail(cnt, usTileIndex);
@@ -2296,15 +2453,12 @@ void LoadWorldFromSGPFile(SGPFile *f)
 	{
 		for (INT32 n = bCounts[cnt][4]; n != 0; --n)
 		{
-			BYTE data[2];
-			f->read(data, sizeof(data));
-
 			UINT8       ubType;
 			UINT8       ubSubIndex;
-			DataReader d{data};
+			DataReader d{f->readInPlace(2)};
 			EXTR_U8(d, ubType)
 			EXTR_U8(d, ubSubIndex)
-			Assert(d.getConsumed() == lengthof(data));
+			Assert(d.getConsumed() == 2);
 
 			UINT16 const usTileIndex = GetTileIndexFromTypeSubIndex(ubType, ubSubIndex);
 			AddRoofToTail(cnt, usTileIndex);
@@ -2318,15 +2472,12 @@ void LoadWorldFromSGPFile(SGPFile *f)
 	{
 		for (INT32 n = bCounts[cnt][5]; n != 0; --n)
 		{
-			BYTE data[2];
-			f->read(data, sizeof(data));
-
 			UINT8       ubType;
 			UINT8       ubSubIndex;
-			DataReader d{data};
+			DataReader d{f->readInPlace(2)};
 			EXTR_U8(d, ubType)
 			EXTR_U8(d, ubSubIndex)
-			Assert(d.getConsumed() == lengthof(data));
+			Assert(d.getConsumed() == 2);
 
 			UINT16 const usTileIndex = GetTileIndexFromTypeSubIndex(ubType, ubSubIndex);
 			AddOnRoofToTail(cnt, usTileIndex);
@@ -2502,6 +2653,8 @@ void LoadWorldFromSGPFile(SGPFile *f)
 	RenderProgressBar(0, 80);
 
 	gfWorldLoaded = TRUE;
+	// The overhead map and radar render the new world when they first need it
+	InvalidateOverheadRaster();
 
 	RenderProgressBar(0, 100);
 	DequeueAllKeyBoardEvents();
@@ -3057,10 +3210,92 @@ static bool IsRoofVisibleForWireframe(GridNo const sMapPos)
 #ifdef WITH_UNITTESTS
 #include "gtest/gtest.h"
 
+#include "DirFs.h"
+
 TEST(WorldDef, asserts)
 {
 	EXPECT_EQ(sizeof(TEAMSUMMARY), 15u);
 	EXPECT_EQ(sizeof(SUMMARYFILE), 408u);
 }
 
+// A map with empty layers and the given tileset, highest room number and doors
+static std::vector<UINT8> MakeSummaryTestMap(INT32 const tileset, UINT8 const max_room, UINT8 const n_doors)
+{
+	std::vector<UINT8> map;
+	auto const append = [&map](void const* const src, size_t const n)
+	{
+		UINT8 const* const p = static_cast<UINT8 const*>(src);
+		map.insert(map.end(), p, p + n);
+	};
+
+	FLOAT  const version = 5.00;
+	UINT8  const minor   = 25;
+	UINT32 const flags   = MAP_DOORTABLE_SAVED;
+	append(&version, sizeof(version));
+	append(&minor,   sizeof(minor));
+	append(&flags,   sizeof(flags));
+	append(&tileset, sizeof(tileset));
+
+	// Soldier size, heights and layers, then the room numbers
+	map.resize(map.size() + sizeof(UINT32) + (1 + 1) * WORLD_MAX + WORLD_MAX * 4 + WORLD_MAX);
+	map.back() = max_room;
+
+	MAPCREATE_STRUCT const info{};
+	append(&info, sizeof(info));
+
+	append(&n_doors, sizeof(n_doors));
+	for (UINT8 i = 0; i != n_doors; ++i)
+	{
+		DOOR door{};
+		door.sGridNo  = i;
+		door.ubLockID = i % 2;
+		door.ubTrapID = i % 3;
+		append(&door, sizeof(door));
+	}
+	return map;
+}
+
+TEST(WorldDef, parallelSummariesMatchSerial)
+{
+	RustPointer<TempDir> tempDir(TempDir_create());
+	ASSERT_NE(tempDir.get(), nullptr);
+	RustPointer<char> tempPath(TempDir_path(tempDir.get()));
+	ASSERT_NE(tempPath.get(), nullptr);
+	DirFs dir(tempPath.get());
+
+	std::vector<std::vector<UINT8>> maps;
+	for (UINT8 i = 0; i != 20; ++i)
+	{
+		maps.push_back(MakeSummaryTestMap(i % 5, i, i));
+	}
+	maps.push_back(std::vector<UINT8>(10)); // truncated
+
+	std::vector<std::unique_ptr<SUMMARYFILE>> const parallel = ParseWorldSummaries(maps.size(), [&maps](size_t const i) { return maps[i]; });
+	ASSERT_EQ(parallel.size(), maps.size());
+
+	// EvaluateWorld() reads the map file piece by piece
+	for (size_t i = 0; i != maps.size() - 1; ++i)
+	{
+		ST::string const name = ST::format("map{}.dat", i);
+		{
+			AutoSGPFile f(dir.openForWriting(name));
+			f->write(maps[i].data(), maps[i].size());
+		}
+		AutoSGPFile f(dir.openForReading(name));
+		std::unique_ptr<SUMMARYFILE> const serial(ParseWorldSummary(f));
+		ASSERT_TRUE(parallel[i]);
+		EXPECT_EQ(std::memcmp(serial.get(), parallel[i].get(), sizeof(SUMMARYFILE)), 0) << i;
+	}
+
+	EXPECT_EQ(parallel[7]->ubTilesetID, 2);
+	EXPECT_EQ(parallel[7]->ubNumRooms, 7);
+	EXPECT_EQ(parallel[7]->ubNumDoors, 7);
+	EXPECT_EQ(parallel[7]->ubNumDoorsLockedAndTrapped, 2);
+	EXPECT_EQ(parallel[7]->ubNumDoorsLocked, 1);
+	EXPECT_EQ(parallel[7]->ubNumDoorsTrapped, 2);
+
+	EXPECT_FALSE(parallel.back());
+	EXPECT_THROW(ParseWorldSummary(maps.back().data(), maps.back().size()), std::runtime_error);
+}
+
 #endif
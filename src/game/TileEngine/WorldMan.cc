@@ -21,6 +21,7 @@
 #include "Render_Fun.h"
 #include "GameSettings.h"
 #include "MemMan.h"
+#include "Overhead_Map.h"
 
 #include <string_theory/format>
 #include <string_theory/string>
@@ -29,8 +30,10 @@
 
 
 // LEVEL NODE MANIPLULATION FUNCTIONS
-static LEVELNODE* CreateLevelNode(void)
+static LEVELNODE* CreateLevelNode(UINT32 const iMapIndex)
 {
+	LightTileNodeAdded(iMapIndex);
+
 	LEVELNODE* const Node = new LEVELNODE{};
 	Node->ubShadeLevel        = LightGetAmbient();
 	Node->ubNaturalShadeLevel = LightGetAmbient();
@@ -108,7 +111,7 @@ static LEVELNODE* FindTypeInLayer(LEVELNODE* const start_node, UINT32 const type
 
 LEVELNODE* AddObjectToTail(const UINT32 iMapIndex, const UINT16 usIndex)
 {
-	LEVELNODE* const n = CreateLevelNode();
+	LEVELNODE* const n = CreateLevelNode(iMapIndex);
 	n->usIndex = usIndex;
 
 	// Append node to list
@@ -117,13 +120,14 @@ LEVELNODE* AddObjectToTail(const UINT32 iMapIndex, const UINT16 usIndex)
 	*anchor = n;
 
 	ResetSpecificLayerOptimizing(TILES_DYNAMIC_OBJECTS);
+	InvalidateOverheadTile(iMapIndex);
 	return n;
 }
 
 
 LEVELNODE* AddObjectToHead(const UINT32 iMapIndex, const UINT16 usIndex)
 {
-	LEVELNODE* const n = CreateLevelNode();
+	LEVELNODE* const n = CreateLevelNode(iMapIndex);
 	n->usIndex = usIndex;
 
 	LEVELNODE** const head = &gpWorldLevelData[iMapIndex].pObjectHead;
@@ -131,6 +135,7 @@ LEVELNODE* AddObjectToHead(const UINT32 iMapIndex, const UINT16 usIndex)
 	*head    = n;
 
 	ResetSpecificLayerOptimizing(TILES_DYNAMIC_OBJECTS);
+	InvalidateOverheadTile(iMapIndex);
 	AddObjectToMapTempFile(iMapIndex, usIndex);
 	return n;
 }
@@ -159,6 +164,7 @@ BOOLEAN RemoveObject(UINT32 iMapIndex, UINT16 usIndex)
 			CheckForAndDeleteTileCacheStructInfo(pObject, usIndex);
 
 			delete pObject;
+			InvalidateOverheadTile(iMapIndex);
 
 			//Add the index to the maps temp file so we can remove it after reloading the map
 			AddRemoveObjectToMapTempFile(iMapIndex, usIndex);
@@ -229,7 +235,7 @@ BOOLEAN RemoveAllObjectsOfTypeRange( UINT32 iMapIndex, UINT32 fStartType, UINT32
 
 LEVELNODE* AddLandToTail(const UINT32 iMapIndex, const UINT16 usIndex)
 {
-	LEVELNODE* const n = CreateLevelNode();
+	LEVELNODE* const n = CreateLevelNode(iMapIndex);
 	n->usIndex = usIndex;
 
 	// Append node to list
@@ -244,13 +250,14 @@ LEVELNODE* AddLandToTail(const UINT32 iMapIndex, const UINT16 usIndex)
 	n->pPrevNode = prev;
 
 	ResetSpecificLayerOptimizing(TILES_DYNAMIC_LAND);
+	InvalidateOverheadTile(iMapIndex);
 	return n;
 }
 
 
 void AddLandToHead(const UINT32 iMapIndex, const UINT16 usIndex)
 {
-	LEVELNODE* const n = CreateLevelNode();
+	LEVELNODE* const n = CreateLevelNode(iMapIndex);
 	n->usIndex		= usIndex;
 
 	LEVELNODE** const head = &gpWorldLevelData[iMapIndex].pLandHead;
@@ -265,6 +272,7 @@ void AddLandToHead(const UINT32 iMapIndex, const UINT16 usIndex)
 	}
 
 	ResetSpecificLayerOptimizing(TILES_DYNAMIC_LAND);
+	InvalidateOverheadTile(iMapIndex);
 }
 
 
@@ -304,6 +312,7 @@ static void RemoveLandEx(UINT32 iMapIndex, UINT16 usIndex)
 			}
 
 			delete pLand;
+			InvalidateOverheadTile(iMapIndex);
 			break;
 		}
 	}
@@ -351,6 +360,7 @@ void ReplaceLandIndex(UINT32 const iMapIndex, UINT16 const usOldIndex, UINT16 co
 			// OK, set new index value
 			pLand->usIndex = usNewIndex;
 			AdjustForFullTile(iMapIndex);
+			InvalidateOverheadTile(iMapIndex);
 			return;
 		}
 	}
@@ -453,7 +463,7 @@ void InsertLandIndexAtLevel(const UINT32 iMapIndex, const UINT16 usIndex, const
 		pLand = pLand->pNext;
 	}
 
-	LEVELNODE* const n = CreateLevelNode();
+	LEVELNODE* const n = CreateLevelNode(iMapIndex);
 	n->usIndex = usIndex;
 
 	// Set links, according to position!
@@ -467,6 +477,7 @@ void InsertLandIndexAtLevel(const UINT32 iMapIndex, const UINT16 usIndex, const
 	AdjustForFullTile(iMapIndex);
 
 	ResetSpecificLayerOptimizing(TILES_DYNAMIC_LAND);
+	InvalidateOverheadTile(iMapIndex);
 }
 
 
@@ -501,7 +512,7 @@ void RemoveHigherLandLevels(UINT32 const map_idx, UINT32 const src_type, std::ve
 
 static LEVELNODE* AddNodeToWorld(UINT32 const iMapIndex, UINT16 const usIndex, INT8 const level)
 {
-	LEVELNODE* const n = CreateLevelNode();
+	LEVELNODE* const n = CreateLevelNode(iMapIndex);
 	n->usIndex = usIndex;
 
 	if (usIndex >= NUMBEROFTILES) return n;
@@ -555,6 +566,7 @@ static LEVELNODE* AddStructToTailCommon(UINT32 const map_idx, UINT16 const idx,
 	AddStructToMapTempFile(map_idx, idx);
 
 	ResetSpecificLayerOptimizing(TILES_DYNAMIC_STRUCTURES);
+	InvalidateOverheadTile(map_idx);
 	return n;
 }
 
@@ -568,7 +580,7 @@ LEVELNODE* AddStructToTail(UINT32 const map_idx, UINT16 const idx)
 
 LEVELNODE* ForceStructToTail(UINT32 const map_idx, UINT16 const idx)
 {
-	LEVELNODE* const n = CreateLevelNode();
+	LEVELNODE* const n = CreateLevelNode(map_idx);
 	n->usIndex = idx;
 	return AddStructToTailCommon(map_idx, idx, n);
 }
@@ -612,6 +624,7 @@ void AddStructToHead(UINT32 const map_idx, UINT16 const idx)
 	AddStructToMapTempFile(map_idx, idx);
 
 	ResetSpecificLayerOptimizing(TILES_DYNAMIC_STRUCTURES);
+	InvalidateOverheadTile(map_idx);
 }
 
 
@@ -642,6 +655,7 @@ static void InsertStructIndex(const UINT32 iMapIndex, const UINT16 usIndex, cons
 	pStruct->pNext = n;
 
 	ResetSpecificLayerOptimizing(TILES_DYNAMIC_STRUCTURES);
+	InvalidateOverheadTile(iMapIndex);
 }
 
 
@@ -688,6 +702,7 @@ void ForceRemoveStructFromTail(UINT32 const iMapIndex)
 			RemoveStructFromMapTempFile(iMapIndex, usIndex);
 
 			delete pStruct;
+			InvalidateOverheadTile(iMapIndex);
 
 			RemoveShadowBuddy(iMapIndex, usIndex);
 			return;
@@ -713,6 +728,7 @@ static void InternalRemoveStruct(UINT32 const map_idx, LEVELNODE** const anchor)
 
 	RemoveShadowBuddy(map_idx, idx);
 	delete removee;
+	InvalidateOverheadTile(map_idx);
 }
 
 
@@ -915,7 +931,7 @@ void HideStructOfGivenType(UINT32 const iMapIndex, UINT32 const fType, BOOLEAN c
 
 void AddShadowToTail(UINT32 const iMapIndex, UINT16 const usIndex)
 {
-	LEVELNODE* const n = CreateLevelNode();
+	LEVELNODE* const n = CreateLevelNode(iMapIndex);
 	n->usIndex = usIndex;
 
 	// Append node to list
@@ -924,6 +940,7 @@ void AddShadowToTail(UINT32 const iMapIndex, UINT16 const usIndex)
 	*anchor = n;
 
 	ResetSpecificLayerOptimizing(TILES_DYNAMIC_SHADOWS);
+	InvalidateOverheadTile(iMapIndex);
 }
 
 
@@ -944,7 +961,7 @@ void AddExclusiveShadow(UINT32 iMapIndex, UINT16 usIndex)
 
 LEVELNODE* AddShadowToHead(const UINT32 iMapIndex, const UINT16 usIndex)
 {
-	LEVELNODE* const n = CreateLevelNode();
+	LEVELNODE* const n = CreateLevelNode(iMapIndex);
 	n->usIndex = usIndex;
 
 	// Prepend node to list
@@ -953,6 +970,7 @@ LEVELNODE* AddShadowToHead(const UINT32 iMapIndex, const UINT16 usIndex)
 	*head = n;
 
 	ResetSpecificLayerOptimizing(TILES_DYNAMIC_SHADOWS);
+	InvalidateOverheadTile(iMapIndex);
 	return n;
 }
 
@@ -978,6 +996,7 @@ static BOOLEAN RemoveShadow(UINT32 iMapIndex, UINT16 usIndex)
 			}
 
 			delete pShadow;
+			InvalidateOverheadTile(iMapIndex);
 			return TRUE;
 		}
 
@@ -1009,6 +1028,7 @@ BOOLEAN RemoveShadowFromLevelNode(UINT32 iMapIndex, LEVELNODE* pNode)
 			}
 
 			delete pShadow;
+			InvalidateOverheadTile(iMapIndex);
 			return TRUE;
 		}
 
@@ -1077,7 +1097,7 @@ LEVELNODE* AddMercToHead(UINT32 const iMapIndex, SOLDIERTYPE& s, BOOLEAN const f
 {
 	LEVELNODE* pMerc = gpWorldLevelData[iMapIndex].pMercHead;
 
-	LEVELNODE* pNextMerc = CreateLevelNode();
+	LEVELNODE* pNextMerc = CreateLevelNode(iMapIndex);
 	pNextMerc->pNext = pMerc;
 	pNextMerc->pSoldier = &s;
 	pNextMerc->uiFlags |= LEVELNODE_SOLDIER;
@@ -1220,6 +1240,7 @@ static LEVELNODE* AddRoof(const UINT32 iMapIndex, const UINT16 usIndex)
 {
 	LEVELNODE* const n = AddNodeToWorld(iMapIndex, usIndex, 1);
 	ResetSpecificLayerOptimizing(TILES_DYNAMIC_ROOF);
+	InvalidateOverheadTile(iMapIndex);
 	return n;
 }
 
@@ -1272,6 +1293,7 @@ BOOLEAN RemoveRoof(UINT32 iMapIndex, UINT16 usIndex)
 
 			DeleteStructureFromWorld(pRoof->pStructureData);
 			delete pRoof;
+			InvalidateOverheadTile(iMapIndex);
 			return TRUE;
 		}
 
@@ -1354,6 +1376,7 @@ void RemoveRoofIndexFlagsFromTypeRange(UINT32 const iMapIndex, UINT32 const fSta
 			const UINT32 fTileType = GetTileType(pRoof->usIndex);
 			if (fTileType >= fStartType && fTileType <= fEndType)
 			{
+				if (pRoof->uiFlags & uiFlags) InvalidateOverheadTile(iMapIndex);
 				pRoof->uiFlags &= ~uiFlags;
 			}
 			pRoof = pRoof->pNext; // XXX TODO0009 if pRoof->usIndex == NO_TILE this is an endless loop
@@ -1372,6 +1395,7 @@ void SetRoofIndexFlagsFromTypeRange(UINT32 const iMapIndex, UINT32 const fStartT
 			const UINT32 fTileType = GetTileType(pRoof->usIndex);
 			if (fTileType >= fStartType && fTileType <= fEndType)
 			{
+				if (~pRoof->uiFlags & uiFlags) InvalidateOverheadTile(iMapIndex);
 				pRoof->uiFlags |= uiFlags;
 			}
 			pRoof = pRoof->pNext; // XXX TODO0009 if pRoof->usIndex == NO_TILE this is an endless loop
@@ -1519,7 +1543,7 @@ BOOLEAN RemoveAllOnRoofsOfTypeRange( UINT32 iMapIndex, UINT32 fStartType, UINT32
 
 LEVELNODE* AddTopmostToTail(const UINT32 iMapIndex, const UINT16 usIndex)
 {
-	LEVELNODE* const n = CreateLevelNode();
+	LEVELNODE* const n = CreateLevelNode(iMapIndex);
 	n->usIndex = usIndex;
 
 	// Append node to list
@@ -1548,7 +1572,7 @@ LEVELNODE* AddUIElem(UINT32 iMapIndex, UINT16 usIndex, INT8 sRelativeX, INT8 sRe
 
 LEVELNODE* AddTopmostToHead(const UINT32 iMapIndex, const UINT16 usIndex)
 {
-	LEVELNODE* const n = CreateLevelNode();
+	LEVELNODE* const n = CreateLevelNode(iMapIndex);
 	n->usIndex = usIndex;
 
 	// Prepend node to list
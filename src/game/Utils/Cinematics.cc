@@ -7,7 +7,13 @@
 //
 //------------------------------------------------------------------------------
 
+#include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include <SDL.h>
@@ -25,18 +31,47 @@ extern "C" {
 #include "sgp/VSurface.h"
 #include "sgp/SoundMan.h"
 
+// Number of decoded frames the decoder thread may be ahead of the screen
+#define SMK_FRAME_RING_SIZE 4
+
+struct SMKFRAME
+{
+	std::vector<UINT16> pixels; // converted to 16bpp
+	UINT32 frame_no;
+};
+
 struct SMKFLIC
 {
 	unsigned char* file_in_memory;
-	smk smacker; // object pointer type for libsmacker
+	smk smacker; // object pointer type for libsmacker, owned by the decoder while it runs
+	std::string name;
 	UINT32 sounds[7];
+	std::shared_ptr<SoundStream> audio[7];
 	UINT32 flags;
 	UINT32 left;
 	UINT32 top;
 	UINT32 start_tick;
-	UINT32 frame_no;
+	unsigned long width;
+	unsigned long height;
 	double milliseconds_per_frame;
 	char status;
+
+	/* The decoder thread fills the ring with converted frames. The frame at
+	 * ring_read is the one on screen once front_shown is set, it is released
+	 * as soon as a later frame is due. */
+	std::thread decoder;
+	std::mutex mutex;
+	std::condition_variable ring_space;
+	SMKFRAME ring[SMK_FRAME_RING_SIZE];
+	UINT32 ring_read;
+	UINT32 ring_write;
+	bool front_shown;
+	bool decoder_done; // no more frames will be added, decoder_status tells why
+	char decoder_status;
+	bool stop_decoder;
+
+	UINT32 frames_shown;
+	UINT32 frames_dropped;
 };
 
 
@@ -51,8 +86,9 @@ static SMKFLIC gSmkList[4];
 
 static SMKFLIC* SmkOpenFlic(const char* filename);
 static SMKFLIC* SmkGetFreeFlic(void);
-static void SmkSkipFrames(SMKFLIC* sf);
-static void SmkBlitVideoFrame(SMKFLIC* const sf, SGPVSurface* surface);
+static void SmkDecodeFrames(SMKFLIC* sf);
+static SMKFRAME const* SmkSkipFrames(SMKFLIC* sf);
+static void SmkBlitVideoFrame(SMKFLIC* const sf, SMKFRAME const& frame, SGPVSurface* surface);
 
 
 BOOLEAN SmkPollFlics(void)
@@ -62,7 +98,7 @@ BOOLEAN SmkPollFlics(void)
 	{
 		if (!(sf->flags & SMK_FLIC_PLAYING)) continue;
 
-		SmkSkipFrames(sf);
+		SMKFRAME const* const frame = SmkSkipFrames(sf);
 
 		if (sf->status == SMK_DONE || sf->status == SMK_ERROR)
 		{
@@ -78,7 +114,7 @@ BOOLEAN SmkPollFlics(void)
 		else
 		{
 			is_playing = TRUE;
-			SmkBlitVideoFrame(sf, FRAME_BUFFER);
+			if (frame) SmkBlitVideoFrame(sf, *frame, FRAME_BUFFER);
 		}
 	}
 
@@ -98,6 +134,7 @@ void SmkInitialize(void)
 			*sound = NO_SAMPLE;
 		}
 		sf->flags = 0;
+		sf->stop_decoder = false;
 	}
 }
 
@@ -121,66 +158,49 @@ SMKFLIC* SmkPlayFlic(const char* const filename, const UINT32 left, const UINT32
 	sf->left = left;
 	sf->top  = top;
 
-	// Get all the audio data
-	unsigned char audio_tracks;
-	unsigned char audio_channels[7];
-	unsigned char audio_depth[7];
-	unsigned long audio_rate[7];
-	std::vector<UINT8> audio[7];
-	if (smk_info_audio(sf->smacker, &audio_tracks, audio_channels, audio_depth, audio_rate) == 0 && audio_tracks != 0)
-	{
-		status = smk_enable_all(sf->smacker, audio_tracks);
-		Assert(status == 0);
-
-		for (sf->status = smk_first(sf->smacker); sf->status != SMK_DONE; sf->status = smk_next(sf->smacker))
-		{
-			if (sf->status == SMK_ERROR)
-			{
-				SLOGW("smacker failed to decode audio data");
-				break;
-			}
-			for (uint8_t i = 0; i < 7; i++)
-			{
-				if (!(audio_tracks & (1 << i))) continue;
-				unsigned long audio_size = smk_get_audio_size(sf->smacker, i);
-				if (audio_size > 0)
-				{
-					unsigned char* audio_data = smk_get_audio(sf->smacker, i);
-					audio[i].insert(audio[i].end(), audio_data, audio_data + audio_size);
-				}
-			}
-		}
-	}
-
 	// get play speed
 	// the video is too slow using microsecond resolution, speed it up by rounding down to milliseconds
 	double microseconds_per_frame;
 	status = smk_info_all(sf->smacker, nullptr, nullptr, &microseconds_per_frame);
 	Assert(status == 0);
 	sf->milliseconds_per_frame = microseconds_per_frame / 1000.0;
-
-
-	// Start playing
-	status = smk_enable_all(sf->smacker, SMK_VIDEO_TRACK);
+	status = smk_info_video(sf->smacker, &sf->width, &sf->height, nullptr);
 	Assert(status == 0);
-	sf->status = smk_first(sf->smacker);
-	for (uint8_t i = 0; i < 7; i++)
+
+	/* Stream the audio tracks. The decoder pushes each frame's audio as it
+	 * decodes the frame, a few frames ahead of the screen. */
+	unsigned char tracks = SMK_VIDEO_TRACK;
+	unsigned char audio_tracks;
+	unsigned char audio_channels[7];
+	unsigned char audio_depth[7];
+	unsigned long audio_rate[7];
+	if (IsSoundEnabled() && smk_info_audio(sf->smacker, &audio_tracks, audio_channels, audio_depth, audio_rate) == 0)
 	{
-		if (audio[i].empty() || !IsSoundEnabled())
-		{
-			sf->sounds[i] = NO_SAMPLE;
-		}
-		else
+		for (uint8_t i = 0; i < 7; i++)
 		{
+			if (!(audio_tracks & (1 << i))) continue;
 			char name[128];
 			snprintf(name, sizeof(name), "%u@%s", i, filename);
-			sf->sounds[i] = SoundPlayFromSmackBuff(name, audio_channels[i], audio_depth[i], audio_rate[i], audio[i], MAXVOLUME, 64, 1, nullptr, nullptr);
+			sf->sounds[i] = SoundPlayStream(name, audio_channels[i], audio_depth[i], audio_rate[i], MAXVOLUME, 64, sf->audio[i]);
+			if (sf->sounds[i] != NO_SAMPLE) tracks |= 1 << i;
 		}
 	}
+	status = smk_enable_all(sf->smacker, tracks);
+	Assert(status == 0);
 
-	// We have started to play the flick, so set start time and frame number
+	// Start decoding
+	sf->status         = SMK_MORE;
+	sf->ring_read      = 0;
+	sf->ring_write     = 0;
+	sf->front_shown    = false;
+	sf->decoder_done   = false;
+	sf->stop_decoder   = false;
+	sf->frames_shown   = 0;
+	sf->frames_dropped = 0;
+	sf->decoder = std::thread(SmkDecodeFrames, sf);
+
+	// We have started to play the flick, so set start time
 	sf->start_tick = SDL_GetTicks();
-	sf->frame_no = 0;
 	// We're now playing, flag the flic for the poller to update
 	sf->flags |= SMK_FLIC_PLAYING;
 	if (auto_close) sf->flags |= SMK_FLIC_AUTOCLOSE;
@@ -211,6 +231,7 @@ static SMKFLIC* SmkOpenFlic(const char* const filename)
 		// open with smacker
 		sf->smacker = smk_open_memory(sf->file_in_memory, bytes);
 		if (sf->smacker == nullptr) throw std::runtime_error("smk_open_memory failed");
+		sf->name = filename;
 		sf->flags |= SMK_FLIC_OPEN;
 		return sf;
 	}
@@ -228,6 +249,16 @@ static SMKFLIC* SmkOpenFlic(const char* const filename)
 void SmkCloseFlic(SMKFLIC* const sf)
 {
 	Assert(sf != nullptr);
+	if (sf->decoder.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(sf->mutex);
+			sf->stop_decoder = true;
+		}
+		sf->ring_space.notify_one();
+		sf->decoder.join();
+		SLOGD("Smacker video '%s': %u frames shown, %u dropped", sf->name.c_str(), sf->frames_shown, sf->frames_dropped);
+	}
 	FOR_EACH(UINT32, sound, sf->sounds)
 	{
 		if (*sound != NO_SAMPLE)
@@ -236,6 +267,10 @@ void SmkCloseFlic(SMKFLIC* const sf)
 			*sound = NO_SAMPLE;
 		}
 	}
+	FOR_EACH(std::shared_ptr<SoundStream>, stream, sf->audio)
+	{
+		stream->reset();
+	}
 	if (sf->smacker != nullptr)
 	{
 		smk_close(sf->smacker);
@@ -260,34 +295,20 @@ static SMKFLIC* SmkGetFreeFlic(void)
 }
 
 
-static void SmkSkipFrames(SMKFLIC* sf)
-{
-	// get target frame
-	UINT32 milliseconds = SDL_GetTicks() - sf->start_tick;
-	UINT32 frame_no = static_cast<UINT32>(milliseconds / sf->milliseconds_per_frame);
-
-	// skip until the target frame (video repeats if there is a ring frame)
-	while (sf->status != SMK_ERROR && sf->status != SMK_DONE && sf->frame_no != frame_no)
-	{
-		sf->status = smk_next(sf->smacker);
-		sf->frame_no++;
-	}
-}
-
-
-static void SmkBlitVideoFrame(SMKFLIC* const sf, SGPVSurface* surface)
+// Converts the current frame of the decoder to 16bpp
+static void SmkConvertFrame(SMKFLIC* const sf, std::vector<UINT16>& pixels)
 {
 	// get frame (source)
 	// TODO handle flags SMK_FLAG_Y_* (I need a sample of each case)
 	unsigned char* src;
 	unsigned char* src_palette;
-	unsigned long src_width;
-	unsigned long src_height;
 	src = smk_get_video(sf->smacker);
-	if (src == nullptr) return;
 	src_palette = smk_get_palette(sf->smacker);
-	if (src_palette == nullptr) return;
-	if (smk_info_video(sf->smacker, &src_width, &src_height, nullptr) < 0) return;
+	if (src == nullptr || src_palette == nullptr)
+	{
+		pixels.clear();
+		return;
+	}
 
 	// convert palette
 	UINT16 palette[256];
@@ -297,6 +318,113 @@ static void SmkBlitVideoFrame(SMKFLIC* const sf, SGPVSurface* surface)
 		palette[i] = Get16BPPColor(FROMRGB(rgb[0], rgb[1], rgb[2]));
 	}
 
+	size_t const n = sf->width * sf->height;
+	pixels.resize(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		pixels[i] = palette[src[i]];
+	}
+}
+
+
+/* Runs on the decoder thread. Decodes every frame (each one is a delta of the
+ * previous), pushes its audio and converts it into the ring, waiting while the
+ * ring is full. */
+static void SmkDecodeFrames(SMKFLIC* const sf)
+{
+	UINT32 frame_no = 0;
+	char status = smk_first(sf->smacker);
+	while (status != SMK_DONE && status != SMK_ERROR)
+	{
+		for (uint8_t i = 0; i < 7; i++)
+		{
+			if (!sf->audio[i]) continue;
+			unsigned long audio_size = smk_get_audio_size(sf->smacker, i);
+			if (audio_size > 0) SoundStreamPush(*sf->audio[i], smk_get_audio(sf->smacker, i), audio_size);
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(sf->mutex);
+			sf->ring_space.wait(lock, [sf]() { return sf->stop_decoder || sf->ring_write - sf->ring_read < SMK_FRAME_RING_SIZE; });
+			if (sf->stop_decoder) break;
+		}
+
+		// The slot is free, the main thread doesn't look at it before it is published
+		SMKFRAME& frame = sf->ring[sf->ring_write % SMK_FRAME_RING_SIZE];
+		SmkConvertFrame(sf, frame.pixels);
+		frame.frame_no = frame_no++;
+		{
+			std::lock_guard<std::mutex> lock(sf->mutex);
+			++sf->ring_write;
+		}
+
+		status = smk_next(sf->smacker);
+	}
+	if (status == SMK_ERROR) SLOGW("smacker failed to decode '%s'", sf->name.c_str());
+
+	FOR_EACH(std::shared_ptr<SoundStream>, stream, sf->audio)
+	{
+		if (*stream) SoundStreamEnd(**stream);
+	}
+
+	std::lock_guard<std::mutex> lock(sf->mutex);
+	sf->decoder_status = status == SMK_ERROR ? SMK_ERROR : SMK_DONE;
+	sf->decoder_done   = true;
+}
+
+
+/* Moves on to the frame that is due now and returns the frame to show, which
+ * is the previous one if the decoder is late. Frames that became due and
+ * overdue between two polls are dropped. */
+static SMKFRAME const* SmkSkipFrames(SMKFLIC* sf)
+{
+	// get target frame
+	UINT32 milliseconds = SDL_GetTicks() - sf->start_tick;
+	UINT32 frame_no = static_cast<UINT32>(milliseconds / sf->milliseconds_per_frame);
+
+	SMKFRAME const* frame = nullptr;
+	bool released = false;
+	{
+		std::lock_guard<std::mutex> lock(sf->mutex);
+		while (sf->ring_write - sf->ring_read >= 2 &&
+			sf->ring[(sf->ring_read + 1) % SMK_FRAME_RING_SIZE].frame_no <= frame_no)
+		{ // the next frame is due, so the front one is not needed any more
+			if (!sf->front_shown) ++sf->frames_dropped;
+			++sf->ring_read;
+			sf->front_shown = false;
+			released = true;
+		}
+
+		if (sf->ring_read != sf->ring_write)
+		{
+			SMKFRAME const& front = sf->ring[sf->ring_read % SMK_FRAME_RING_SIZE];
+			if (!sf->front_shown && front.frame_no <= frame_no)
+			{
+				sf->front_shown = true;
+				++sf->frames_shown;
+			}
+			if (sf->front_shown) frame = &front;
+		}
+
+		// Done when the last frame has been on screen for its time
+		if (sf->decoder_done && sf->ring_write - sf->ring_read <= 1 && frame_no >= sf->ring_write)
+		{
+			sf->status = sf->decoder_status;
+		}
+	}
+	if (released) sf->ring_space.notify_one();
+
+	return frame;
+}
+
+
+static void SmkBlitVideoFrame(SMKFLIC* const sf, SMKFRAME const& frame, SGPVSurface* surface)
+{
+	if (frame.pixels.empty()) return;
+	UINT16 const* src = frame.pixels.data();
+	unsigned long const src_width  = sf->width;
+	unsigned long const src_height = sf->height;
+
 	// get surface (destination)
 	SGPVSurface::Lock lock(surface);
 	UINT16* dst = lock.Buffer<UINT16>();
@@ -311,10 +439,7 @@ static void SmkBlitVideoFrame(SMKFLIC* const sf, SGPVSurface* surface)
 	dst += sf->left + sf->top * dst_pitch;
 	for (unsigned long y = 0; y < y_end; y++)
 	{
-		for (unsigned long x = 0; x < x_end; x++)
-		{
-			dst[x] = palette[src[x]];
-		}
+		std::copy_n(src, x_end, dst);
 		dst += dst_pitch;
 		src += src_width;
 	}
@@ -1,9 +1,12 @@
 #include "gtest/gtest.h"
 
 #include "FileMan.h"
+#include "LoadSaveData.h"
 
 #include "externalized/TestUtils.h"
 
+#include <chrono>
+
 TEST(FileManTest, joinPaths)
 {
 	{
@@ -233,3 +236,92 @@ TEST(FileManTest, FreeSpace)
 	ASSERT_NE(tempPath.get(), nullptr);
 	EXPECT_NE(FileMan::getFreeSpace(tempPath.get()), 0u);
 }
+
+TEST(FileManTest, BufferedAndSlurpedReads)
+{
+	RustPointer<TempDir> tempDir(TempDir_create());
+	ASSERT_NE(tempDir.get(), nullptr);
+	RustPointer<char> tempPath(TempDir_path(tempDir.get()));
+	ASSERT_NE(tempPath.get(), nullptr);
+	ST::string path = FileMan::joinPaths(tempPath.get(), "numbers.bin");
+
+	SGPFile* forWriting = FileMan::openForWriting(path);
+	ASSERT_NE(forWriting, nullptr);
+	for (UINT16 i = 0; i < 1000; ++i) forWriting->write(&i, sizeof(i));
+	delete forWriting;
+
+	for (int mode = 0; mode < 3; ++mode)
+	{
+		AutoSGPFile f(FileMan::openForReading(path));
+		if (mode == 1) f->bufferReads(64);
+		if (mode == 2) f->slurp();
+
+		UINT16 value;
+		f->read(&value, sizeof(value));
+		EXPECT_EQ(value, 0);
+		EXPECT_EQ(f->pos(), 2);
+
+		f->seek(2 * 9, FILE_SEEK_FROM_CURRENT);
+		DataReader d{f->readInPlace(4)};
+		EXPECT_EQ(d.readU16(), 10);
+		EXPECT_EQ(d.readU16(), 11);
+
+		f->seek(-4, FILE_SEEK_FROM_CURRENT);
+		f->read(&value, sizeof(value));
+		EXPECT_EQ(value, 10);
+
+		f->seek(-2, FILE_SEEK_FROM_END);
+		f->read(&value, sizeof(value));
+		EXPECT_EQ(value, 999);
+		EXPECT_EQ(f->pos(), 2000);
+		EXPECT_EQ(f->size(), 2000u);
+		EXPECT_THROW(f->read(&value, sizeof(value)), std::runtime_error);
+
+		f->seek(2 * 500, FILE_SEEK_FROM_START);
+		std::vector<uint8_t> rest = f->readToEnd();
+		ASSERT_EQ(rest.size(), 1000u);
+		EXPECT_EQ(rest[0] | rest[1] << 8, 500);
+	}
+}
+
+
+// Reads a map sized file field by field like LoadWorldFromSGPFile, in each
+// mode. Run with --gtest_also_run_disabled_tests to see the numbers.
+TEST(FileManTest, DISABLED_ReadModesBenchmark)
+{
+	RustPointer<TempDir> tempDir(TempDir_create());
+	ASSERT_NE(tempDir.get(), nullptr);
+	RustPointer<char> tempPath(TempDir_path(tempDir.get()));
+	ASSERT_NE(tempPath.get(), nullptr);
+	ST::string path = FileMan::joinPaths(tempPath.get(), "map.bin");
+
+	UINT32 const fileSize = 1024 * 1024;
+	{
+		std::vector<uint8_t> data(fileSize);
+		for (UINT32 i = 0; i < fileSize; ++i) data[i] = (uint8_t)(i * 31);
+		AutoSGPFile f(FileMan::openForWriting(path));
+		f->write(data.data(), data.size());
+	}
+
+	static char const* const names[] = { "unbuffered", "read-ahead", "slurp" };
+	for (int mode = 0; mode < 3; ++mode)
+	{
+		uint64_t const calls = SGPFile::fileSystemCalls();
+		auto const start = std::chrono::steady_clock::now();
+
+		AutoSGPFile f(FileMan::openForReading(path));
+		if (mode == 1) f->bufferReads();
+		if (mode == 2) f->slurp();
+
+		uint8_t field[8];
+		UINT32 sum = 0;
+		for (UINT32 pos = 0, n = 2; pos + n <= fileSize; pos += n, n = 2 + (pos & 6))
+		{
+			f->read(field, n);
+			sum += field[0];
+		}
+
+		std::chrono::duration<double, std::milli> const d = std::chrono::steady_clock::now() - start;
+		printf("%-10s %8.2fms %8u file system calls (%u)\n", names[mode], d.count(), (UINT32)(SGPFile::fileSystemCalls() - calls), sum);
+	}
+}
@@ -173,20 +173,49 @@ BOOLEAN CopyImageToBuffer(SGPImage const* const img, UINT32 const fBufferType, B
 }
 
 
+/* Converts 256 colors, given as separate channel arrays, to the 16 bit pixel
+ * format in the same way as Get16BPPColor(). The loop has neither calls nor
+ * data dependent branches, so the compiler can vectorize it. */
+static void Pack16BPPPalette(UINT16* const dst, const UINT8* const r, const UINT8* const g, const UINT8* const b)
+{
+	INT16  const rs = gusRedShift;
+	INT16  const gs = gusGreenShift;
+	INT16  const bs = gusBlueShift;
+	UINT16 const rm = gusRedMask;
+	UINT16 const gm = gusGreenMask;
+	UINT16 const bm = gusBlueMask;
+
+	for (UINT32 cnt = 0; cnt < 256; cnt++)
+	{
+		UINT32 const r16 = (rs < 0 ? r[cnt] >> -rs : r[cnt] << rs);
+		UINT32 const g16 = (gs < 0 ? g[cnt] >> -gs : g[cnt] << gs);
+		UINT32 const b16 = (bs < 0 ? b[cnt] >> -bs : b[cnt] << bs);
+
+		UINT16 const usColor = (r16 & rm) | (g16 & gm) | (b16 & bm);
+
+		// keep colors that are not black from becoming transparent
+		UINT16 const fSubstitute = usColor == 0 && (r[cnt] | g[cnt] | b[cnt]) != 0;
+		dst[cnt] = usColor | (fSubstitute * BLACK_SUBSTITUTE);
+	}
+}
+
+
 UINT16* Create16BPPPalette(const SGPPaletteEntry* pPalette)
 {
 	Assert(pPalette != NULL);
 
-	UINT16* const p16BPPPalette = new UINT16[256]{};
-
+	UINT8 r[256];
+	UINT8 g[256];
+	UINT8 b[256];
 	for (UINT32 cnt = 0; cnt < 256; cnt++)
 	{
-		UINT8 const r = pPalette[cnt].r;
-		UINT8 const g = pPalette[cnt].g;
-		UINT8 const b = pPalette[cnt].b;
-		p16BPPPalette[cnt] = Get16BPPColor(FROMRGB(r, g, b));
+		r[cnt] = pPalette[cnt].r;
+		g[cnt] = pPalette[cnt].g;
+		b[cnt] = pPalette[cnt].b;
 	}
 
+	UINT16* const p16BPPPalette = new UINT16[256];
+	Pack16BPPPalette(p16BPPPalette, r, g, b);
 	return p16BPPPalette;
 }
 
@@ -219,32 +248,27 @@ UINT16* Create16BPPPaletteShaded(const SGPPaletteEntry* pPalette, UINT32 rscale,
 {
 	Assert(pPalette != NULL);
 
-	UINT16* const p16BPPPalette = new UINT16[256]{};
-
+	UINT8 r[256];
+	UINT8 g[256];
+	UINT8 b[256];
 	for (UINT32 cnt = 0; cnt < 256; cnt++)
 	{
-		UINT32 rmod;
-		UINT32 gmod;
-		UINT32 bmod;
-		if (mono)
-		{
-			UINT32 lumin = (pPalette[cnt].r * 299 + pPalette[cnt].g * 587 + pPalette[cnt].b * 114) / 1000;
-			rmod = rscale * lumin / 256;
-			gmod = gscale * lumin / 256;
-			bmod = bscale * lumin / 256;
-		}
-		else
-		{
-			rmod = rscale * pPalette[cnt].r / 256;
-			gmod = gscale * pPalette[cnt].g / 256;
-			bmod = bscale * pPalette[cnt].b / 256;
-		}
-
-		UINT8 r = __min(rmod, 255);
-		UINT8 g = __min(gmod, 255);
-		UINT8 b = __min(bmod, 255);
-		p16BPPPalette[cnt] = Get16BPPColor(FROMRGB(r, g, b));
+		UINT32 const sr = pPalette[cnt].r;
+		UINT32 const sg = pPalette[cnt].g;
+		UINT32 const sb = pPalette[cnt].b;
+		// with mono, all channels scale the luminance instead of themselves
+		UINT32 const lumin = (sr * 299 + sg * 587 + sb * 114) / 1000;
+		UINT32 const rmod  = rscale * (mono ? lumin : sr) / 256;
+		UINT32 const gmod  = gscale * (mono ? lumin : sg) / 256;
+		UINT32 const bmod  = bscale * (mono ? lumin : sb) / 256;
+
+		r[cnt] = __min(rmod, 255);
+		g[cnt] = __min(gmod, 255);
+		b[cnt] = __min(bmod, 255);
 	}
+
+	UINT16* const p16BPPPalette = new UINT16[256];
+	Pack16BPPPalette(p16BPPPalette, r, g, b);
 	return p16BPPPalette;
 }
 
@@ -362,4 +386,35 @@ TEST(HImage, asserts)
 	EXPECT_EQ(sizeof(SGPPaletteEntry), 4u);
 }
 
+TEST(HImage, palettesMatchGet16BPPColor)
+{
+	UINT16 const masks[]  = { gusRedMask, gusGreenMask, gusBlueMask };
+	INT16  const shifts[] = { gusRedShift, gusGreenShift, gusBlueShift };
+	gusRedMask  = 0xF800; gusGreenMask  = 0x07E0; gusBlueMask  = 0x001F;
+	gusRedShift = 8;      gusGreenShift = 3;      gusBlueShift = -3;
+
+	SGPPaletteEntry pal[256];
+	for (UINT32 i = 0; i < 256; i++)
+	{
+		pal[i].r = i;
+		pal[i].g = (i * 7) & 0xFF;
+		pal[i].b = 255 - i;
+		pal[i].a = 0;
+	}
+
+	std::unique_ptr<UINT16[]> const plain(Create16BPPPalette(pal));
+	std::unique_ptr<UINT16[]> const shaded(Create16BPPPaletteShaded(pal, 300, 200, 100, FALSE));
+	std::unique_ptr<UINT16[]> const mono(Create16BPPPaletteShaded(pal, 255, 128, 0, TRUE));
+	for (UINT32 i = 0; i < 256; i++)
+	{
+		UINT32 const lumin = (pal[i].r * 299 + pal[i].g * 587 + pal[i].b * 114) / 1000;
+		EXPECT_EQ(plain[i], Get16BPPColor(FROMRGB(pal[i].r, pal[i].g, pal[i].b)));
+		EXPECT_EQ(shaded[i], Get16BPPColor(FROMRGB(__min(300 * pal[i].r / 256, 255), __min(200 * pal[i].g / 256, 255), 100 * pal[i].b / 256)));
+		EXPECT_EQ(mono[i], Get16BPPColor(FROMRGB(255 * lumin / 256, 128 * lumin / 256, 0)));
+	}
+
+	gusRedMask  = masks[0];  gusGreenMask  = masks[1];  gusBlueMask  = masks[2];
+	gusRedShift = shifts[0]; gusGreenShift = shifts[1]; gusBlueShift = shifts[2];
+}
+
 #endif
@@ -4,13 +4,193 @@
 
 #include <string_theory/string>
 
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
 #include <stdio.h>
+#include <thread>
 #if defined(_MSC_VER)
 #define vsnprintf(buf, size, format, args) vsnprintf_s(buf, size, _TRUNCATE, format, args)
 #endif
 
+// Matches the default of the Rust logger
+std::atomic<LogLevel> gLogLevel{LogLevel::Info};
+
+/* Background writer
+ *
+ * Producers claim a slot of the ring by advancing guiLogEnqueuePos and publish
+ * it by setting the slot sequence to pos + 1. The writer thread is the only
+ * consumer; it releases a slot for reuse by setting its sequence to
+ * pos + LOG_RING_SIZE. When the ring is full, producers yield until the writer
+ * catches up, so no message is ever dropped.
+ *
+ * Producers count themselves in guiLogProducers before they look at
+ * gfLogWriterRunning. Stopping waits until no producer is left, and the writer
+ * only exits once none is, so a producer which saw the writer running always
+ * gets its record written. Later producers see it stopped and log directly. */
+
+#define LOG_RING_SIZE 1024 // must be a power of two
+
+struct LogRecord
+{
+	std::atomic<size_t> sequence;
+	LogLevel level;
+	ST::string file;
+	ST::string message;
+};
+
+static LogRecord gLogRing[LOG_RING_SIZE];
+static std::atomic<size_t> guiLogEnqueuePos{0};
+static std::atomic<size_t> guiLogWrittenPos{0};
+static std::atomic<bool> gfLogWriterRunning{false};
+static std::atomic<UINT32> guiLogProducers{0};
+static std::thread gLogWriterThread;
+static std::mutex gLogWakeMutex;
+static std::condition_variable gLogWakeCondition;
+static bool gfLogWakePending = false; // guarded by gLogWakeMutex
+
+
+// Set under the mutex, so the writer cannot miss it between looking at the
+// ring and going to sleep
+static void WakeLogWriter()
+{
+	{
+		std::lock_guard<std::mutex> lock(gLogWakeMutex);
+		gfLogWakePending = true;
+	}
+	gLogWakeCondition.notify_one();
+}
+
+
+static void LogWriterLoop()
+{
+	size_t pos = guiLogWrittenPos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		LogRecord& r = gLogRing[pos & (LOG_RING_SIZE - 1)];
+		if (r.sequence.load(std::memory_order_acquire) == pos + 1)
+		{
+			Logger_log(r.level, r.message.c_str(), r.file.c_str());
+			r.message = ST::string();
+			r.file    = ST::string();
+			r.sequence.store(pos + LOG_RING_SIZE, std::memory_order_release);
+			guiLogWrittenPos.store(++pos, std::memory_order_release);
+			continue;
+		}
+
+		if (!gfLogWriterRunning.load() &&
+			guiLogProducers.load() == 0 &&
+			guiLogEnqueuePos.load() == pos)
+		{
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(gLogWakeMutex);
+		gLogWakeCondition.wait(lock, []() { return gfLogWakePending; });
+		gfLogWakePending = false;
+	}
+}
+
+
+static void PushLogRecord(LogLevel level, const char* file, const ST::string& str)
+{
+	size_t pos = guiLogEnqueuePos.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		LogRecord& r = gLogRing[pos & (LOG_RING_SIZE - 1)];
+		size_t const seq = r.sequence.load(std::memory_order_acquire);
+		if (seq == pos)
+		{
+			if (guiLogEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				r.level   = level;
+				r.file    = file;
+				r.message = str;
+				r.sequence.store(pos + 1, std::memory_order_release);
+				WakeLogWriter();
+				return;
+			}
+		}
+		else
+		{
+			if (seq < pos) std::this_thread::yield(); // ring is full
+			pos = guiLogEnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+
+void LogStartBackgroundWriter()
+{
+	if (gfLogWriterRunning.load()) return;
+
+	size_t const pos = guiLogEnqueuePos.load();
+	for (size_t i = 0; i < LOG_RING_SIZE; ++i)
+	{
+		gLogRing[(pos + i) & (LOG_RING_SIZE - 1)].sequence.store(pos + i);
+	}
+	guiLogWrittenPos.store(pos);
+
+	gfLogWriterRunning.store(true);
+	gLogWriterThread = std::thread(LogWriterLoop);
+
+	static bool registered = false;
+	if (!registered)
+	{
+		std::atexit(LogStopBackgroundWriter);
+		registered = true;
+	}
+}
+
+
+void LogStopBackgroundWriter()
+{
+	if (!gfLogWriterRunning.exchange(false)) return;
+
+	while (guiLogProducers.load() != 0)
+	{
+		std::this_thread::yield();
+	}
+	WakeLogWriter();
+	gLogWriterThread.join();
+}
+
+
+void LogFlush()
+{
+	if (!gfLogWriterRunning.load() || std::this_thread::get_id() == gLogWriterThread.get_id()) return;
+
+	size_t const target = guiLogEnqueuePos.load(std::memory_order_acquire);
+	WakeLogWriter();
+	while (guiLogWrittenPos.load(std::memory_order_acquire) < target)
+	{
+		std::this_thread::yield();
+	}
+}
+
+
+void LogSetLevel(LogLevel level)
+{
+	gLogLevel.store(level, std::memory_order_relaxed);
+	Logger_setLevel(level);
+}
+
+
 void LogMessage(bool isAssert, LogLevel level, const char* file, const ST::string& str)
 {
+	if (!isAssert && !LogIsEnabled(level)) return;
+
+	if (!isAssert)
+	{
+		guiLogProducers.fetch_add(1);
+		bool const queued = gfLogWriterRunning.load();
+		if (queued) PushLogRecord(level, file, str);
+		guiLogProducers.fetch_sub(1);
+		if (queued) return;
+	}
+
+	// asserts abort, so everything queued before must reach the log first
+	LogFlush();
 	Logger_log(level, str.c_str(), file);
 
 	#ifdef ENABLE_ASSERTS
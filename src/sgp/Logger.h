@@ -3,6 +3,7 @@
 
 #include "Platform.h"
 #include "RustInterface.h"
+#include <atomic>
 #include <string_view>
 #include <string_theory/format>
 #include <string_theory/string>
@@ -11,6 +12,39 @@
 void LogMessage(bool isAssert, LogLevel level, const char* file, const ST::string& str);
 void LogMessage(bool isAssert, LogLevel level, const char *file, const char *format, ...);
 
+/** Current log level, mirrored from the Rust logger so disabled messages are dropped before formatting. */
+extern std::atomic<LogLevel> gLogLevel;
+
+/** Set the log level both here and in the Rust logger. */
+void LogSetLevel(LogLevel level);
+
+/** Whether a message of the given level would be written. */
+inline bool LogIsEnabled(LogLevel level)
+{
+	return static_cast<int>(level) <= static_cast<int>(gLogLevel.load(std::memory_order_relaxed));
+}
+
+/** Start writing log messages from a background thread instead of the calling thread.
+ * Messages are handed over through a fixed size ring buffer. The writer is stopped automatically at exit. */
+void LogStartBackgroundWriter();
+
+/** Write all pending messages and stop the background writer. Safe to call multiple times. */
+void LogStopBackgroundWriter();
+
+/** Block until all messages logged so far have been written. */
+void LogFlush();
+
+/* Debug messages are compiled out completely when building without debug logging.
+ * The arguments stay in a dead branch so they are still type checked. */
+#ifdef WITHOUT_DEBUG_LOGGING
+#define LOG_DEBUG_COMPILED false
+#else
+#define LOG_DEBUG_COMPILED true
+#endif
+
+#define LOG_IF_ENABLED(LEVEL, CALL) (LogIsEnabled(LEVEL) ? (CALL) : (void)0)
+#define LOG_DEBUG_IF_ENABLED(CALL) ((LOG_DEBUG_COMPILED && LogIsEnabled(LogLevel::Debug)) ? (CALL) : (void)0)
+
 /** Get filename relative to src directory */
 constexpr size_t GetSourcePathSize(const char* filename)
 {
@@ -32,16 +66,16 @@ template <size_t p> constexpr const char* ToRelativePath(const char* filename)
 #define __FILENAME__ (ToRelativePath<SOURCE_PATH_SIZE>(__FILE__))
 
 /** Print debug message macro. */
-#define SLOGD(FORMAT, ...) LogMessage(false, LogLevel::Debug, __FILENAME__, FORMAT, ##__VA_ARGS__)
+#define SLOGD(FORMAT, ...) LOG_DEBUG_IF_ENABLED(LogMessage(false, LogLevel::Debug, __FILENAME__, FORMAT, ##__VA_ARGS__))
 
 /** Print info message macro. */
-#define SLOGI(FORMAT, ...) LogMessage(false, LogLevel::Info,  __FILENAME__, FORMAT, ##__VA_ARGS__)
+#define SLOGI(FORMAT, ...) LOG_IF_ENABLED(LogLevel::Info, LogMessage(false, LogLevel::Info,  __FILENAME__, FORMAT, ##__VA_ARGS__))
 
 /** Print warning message macro. */
-#define SLOGW(FORMAT, ...) LogMessage(false, LogLevel::Warn, __FILENAME__, FORMAT, ##__VA_ARGS__)
+#define SLOGW(FORMAT, ...) LOG_IF_ENABLED(LogLevel::Warn, LogMessage(false, LogLevel::Warn, __FILENAME__, FORMAT, ##__VA_ARGS__))
 
 /** Print error message macro. */
-#define SLOGE(FORMAT, ...) LogMessage(false, LogLevel::Error, __FILENAME__, FORMAT, ##__VA_ARGS__)
+#define SLOGE(FORMAT, ...) LOG_IF_ENABLED(LogLevel::Error, LogMessage(false, LogLevel::Error, __FILENAME__, FORMAT, ##__VA_ARGS__))
 
 /** Print error message macro and assert if ENABLE_ASSERTS is defined. */
 #define SLOGA(FORMAT, ...) LogMessage(true, LogLevel::Error, __FILENAME__, FORMAT, ##__VA_ARGS__)
@@ -58,16 +92,16 @@ constexpr void LogMessageST(bool isAssert, LogLevel level, const char* file, Arg
 	LogMessage(isAssert, level, file, ST::format(args...));
 }
 /** Print debug message macro. */
-#define STLOGD(...) LogMessageST(false, LogLevel::Debug, __FILENAME__, ##__VA_ARGS__)
+#define STLOGD(...) LOG_DEBUG_IF_ENABLED(LogMessageST(false, LogLevel::Debug, __FILENAME__, ##__VA_ARGS__))
 
 /** Print info message macro. */
-#define STLOGI(...) LogMessageST(false, LogLevel::Info,  __FILENAME__, ##__VA_ARGS__)
+#define STLOGI(...) LOG_IF_ENABLED(LogLevel::Info, LogMessageST(false, LogLevel::Info,  __FILENAME__, ##__VA_ARGS__))
 
 /** Print warning message macro. */
-#define STLOGW(...) LogMessageST(false, LogLevel::Warn, __FILENAME__, ##__VA_ARGS__)
+#define STLOGW(...) LOG_IF_ENABLED(LogLevel::Warn, LogMessageST(false, LogLevel::Warn, __FILENAME__, ##__VA_ARGS__))
 
 /** Print error message macro. */
-#define STLOGE(...) LogMessageST(false, LogLevel::Error, __FILENAME__, ##__VA_ARGS__)
+#define STLOGE(...) LOG_IF_ENABLED(LogLevel::Error, LogMessageST(false, LogLevel::Error, __FILENAME__, ##__VA_ARGS__))
 
 /** Print error message macro and assert if ENABLE_ASSERTS is defined. */
 #define STLOGA(...) LogMessageST(true,  LogLevel::Error, __FILENAME__, ##__VA_ARGS__)
@@ -22,4 +22,23 @@ TEST(Logger, sourcePathLength)
 #endif
 }
 
+TEST(Logger, levelGating)
+{
+	LogLevel const previous = gLogLevel.load();
+
+	LogSetLevel(LogLevel::Warn);
+	EXPECT_TRUE(LogIsEnabled(LogLevel::Error));
+	EXPECT_TRUE(LogIsEnabled(LogLevel::Warn));
+	EXPECT_FALSE(LogIsEnabled(LogLevel::Info));
+	EXPECT_FALSE(LogIsEnabled(LogLevel::Debug));
+
+	// arguments of disabled messages must not be evaluated
+	int evaluated = 0;
+	SLOGI("%d", ++evaluated);
+	STLOGD("{}", ++evaluated);
+	EXPECT_EQ(evaluated, 0);
+
+	LogSetLevel(previous);
+}
+
 #undef EXPECTED_FILENAME
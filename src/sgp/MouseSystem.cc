@@ -11,7 +11,9 @@
 //
 //=================================================================================================
 
+#include <algorithm>
 #include <stdexcept>
+#include <vector>
 
 #include "Font.h"
 #include "HImage.h"
@@ -58,6 +60,18 @@ static MOUSE_REGION* g_clicked_region;
 
 static MOUSE_REGION* MSYS_RegList = NULL;
 
+/* Hit test index. The screen is divided into square cells; every cell lists
+ * the regions overlapping it in the order they are checked, i.e. by priority
+ * and, within a priority, latest defined first. A hit test only has to look
+ * at the regions of the cell under the mouse. */
+#define MSYS_GRID_CELL_SHIFT 6 // 64x64 pixels
+
+static std::vector<std::vector<MOUSE_REGION*>> MSYS_Grid;
+static UINT16 MSYS_GridCols        = 0;
+static UINT16 MSYS_GridRows        = 0;
+static UINT32 MSYS_NextSequence    = 0;
+static UINT32 MSYS_RegionsExamined = 0;
+
 static MOUSE_REGION* MSYS_PrevRegion = 0;
 static MOUSE_REGION* MSYS_CurrRegion = NULL;
 
@@ -202,52 +216,121 @@ static void MSYS_TrashRegList(void)
 }
 
 
-static void MSYS_DeleteRegionFromList(MOUSE_REGION*);
+// Whether region a is checked before region b by hit tests
+static bool MSYS_RegionPrecedes(MOUSE_REGION const* const a, MOUSE_REGION const* const b)
+{
+	if (a->PriorityLevel != b->PriorityLevel) return a->PriorityLevel > b->PriorityLevel;
+	return a->IndexSequence > b->IndexSequence;
+}
 
 
-/* Add a region struct to the current list. The list is sorted by priority
- * levels. If two entries have the same priority level, then the latest to enter
- * the list gets the higher priority. */
-static void MSYS_AddRegionToList(MOUSE_REGION* const r)
+static bool MSYS_RegionContains(MOUSE_REGION const* const r, INT16 const x, INT16 const y)
 {
-	/* If region seems to already be in list, delete it so we can re-insert the
-	 * region. */
-	MSYS_DeleteRegionFromList(r);
+	return
+		r->RegionTopLeftX <= x && x <= r->RegionBottomRightX &&
+		r->RegionTopLeftY <= y && y <= r->RegionBottomRightY;
+}
 
-	MOUSE_REGION* i = MSYS_RegList;
-	if (!i)
-	{ // Empty list, so add it straight up.
-		MSYS_RegList = r;
-	}
-	else
+
+static void MSYS_FileRegionInGrid(MOUSE_REGION* const r)
+{
+	SGPRect const& c = r->IndexCells;
+	for (UINT32 y = c.iTop; y <= c.iBottom; ++y)
 	{
-		// Walk down list until we find place to insert (or at end of list)
-		for (; i->next; i = i->next)
+		for (UINT32 x = c.iLeft; x <= c.iRight; ++x)
 		{
-			if (i->PriorityLevel <= r->PriorityLevel) break;
+			std::vector<MOUSE_REGION*>& cell = MSYS_Grid[y * MSYS_GridCols + x];
+			cell.insert(std::lower_bound(cell.begin(), cell.end(), r, MSYS_RegionPrecedes), r);
 		}
+	}
+}
 
-		if (i->PriorityLevel > r->PriorityLevel)
-		{ // Add after node
-			r->prev = i;
-			r->next = i->next;
-			if (r->next) r->next->prev = r;
-			i->next = r;
-		}
-		else
-		{ // Add before node
-			r->prev = i->prev;
-			r->next = i;
-			*(r->prev ? &r->prev->next : &MSYS_RegList) = r;
-			i->prev = r;
+
+static void MSYS_ResizeGrid(UINT16 const cols, UINT16 const rows)
+{
+	MSYS_GridCols = cols;
+	MSYS_GridRows = rows;
+	MSYS_Grid.assign(cols * rows, std::vector<MOUSE_REGION*>());
+	for (MOUSE_REGION* i = MSYS_RegList; i; i = i->next)
+	{
+		if (i->IndexCells.iLeft <= i->IndexCells.iRight) MSYS_FileRegionInGrid(i);
+	}
+}
+
+
+static void MSYS_AddRegionToIndex(MOUSE_REGION* const r)
+{
+	INT16 const left   = MAX(r->RegionTopLeftX, 0);
+	INT16 const top    = MAX(r->RegionTopLeftY, 0);
+	INT16 const right  = r->RegionBottomRightX;
+	INT16 const bottom = r->RegionBottomRightY;
+	if (right < left || bottom < top)
+	{ // Covers no pixel, so it can never be hit
+		r->IndexCells.set(1, 1, 0, 0);
+		return;
+	}
+	r->IndexCells.set(left >> MSYS_GRID_CELL_SHIFT, top >> MSYS_GRID_CELL_SHIFT, right >> MSYS_GRID_CELL_SHIFT, bottom >> MSYS_GRID_CELL_SHIFT);
+
+	if (r->IndexCells.iRight >= MSYS_GridCols || r->IndexCells.iBottom >= MSYS_GridRows)
+	{ // The region is already in the list, so this files it, too
+		MSYS_ResizeGrid(MAX(MSYS_GridCols, r->IndexCells.iRight + 1), MAX(MSYS_GridRows, r->IndexCells.iBottom + 1));
+	}
+	else
+	{
+		MSYS_FileRegionInGrid(r);
+	}
+}
+
+
+static void MSYS_RemoveRegionFromIndex(MOUSE_REGION* const r)
+{
+	SGPRect const& c = r->IndexCells;
+	if (c.iRight < MSYS_GridCols && c.iBottom < MSYS_GridRows)
+	{
+		for (UINT32 y = c.iTop; y <= c.iBottom; ++y)
+		{
+			for (UINT32 x = c.iLeft; x <= c.iRight; ++x)
+			{
+				std::vector<MOUSE_REGION*>& cell = MSYS_Grid[y * MSYS_GridCols + x];
+				auto const i = std::find(cell.begin(), cell.end(), r);
+				if (i != cell.end()) cell.erase(i);
+			}
 		}
 	}
+	r->IndexCells.set(1, 1, 0, 0);
+}
+
+
+// The regions that may contain the given screen position, in hit test order
+static std::vector<MOUSE_REGION*> const* MSYS_GetGridCell(INT16 const x, INT16 const y)
+{
+	if (x < 0 || y < 0) return 0;
+	UINT32 const col = x >> MSYS_GRID_CELL_SHIFT;
+	UINT32 const row = y >> MSYS_GRID_CELL_SHIFT;
+	if (col >= MSYS_GridCols || row >= MSYS_GridRows) return 0;
+	return &MSYS_Grid[row * MSYS_GridCols + col];
+}
+
+
+/* Add a region struct to the current list. The list itself is unordered; the
+ * hit test order is kept by the grid index. */
+static void MSYS_AddRegionToList(MOUSE_REGION* const r)
+{
+	r->prev = 0;
+	r->next = MSYS_RegList;
+	if (MSYS_RegList) MSYS_RegList->prev = r;
+	MSYS_RegList = r;
+
+	r->IndexSequence = ++MSYS_NextSequence;
+	MSYS_AddRegionToIndex(r);
 }
 
 
 // Removes a region from the current list.
 static void MSYS_DeleteRegionFromList(MOUSE_REGION* const r)
 {
+	MSYS_RemoveRegionFromIndex(r);
+
 	MOUSE_REGION* const prev = r->prev;
 	MOUSE_REGION* const next = r->next;
 	if (prev) prev->next = next;
@@ -260,20 +343,31 @@ static void MSYS_DeleteRegionFromList(MOUSE_REGION* const r)
 }
 
 
+UINT32 MSYS_GetRegionsExamined(void)
+{
+	return MSYS_RegionsExamined;
+}
+
+
 /* Searches the list for the highest priority region and updates its info.  It
  * also dispatches the callback functions */
 static void MSYS_UpdateMouseRegion(void)
 {
-	MOUSE_REGION* cur;
-	for (cur = MSYS_RegList; cur != NULL; cur = cur->next)
+	MOUSE_REGION* cur = NULL;
+	MSYS_RegionsExamined = 0;
+	if (std::vector<MOUSE_REGION*> const* const cell = MSYS_GetGridCell(MSYS_CurrentMX, MSYS_CurrentMY))
 	{
-		if (cur->uiFlags & (MSYS_REGION_ENABLED | MSYS_ALLOW_DISABLED_FASTHELP) &&
-			cur->RegionTopLeftX <= MSYS_CurrentMX && MSYS_CurrentMX <= cur->RegionBottomRightX &&
-			cur->RegionTopLeftY <= MSYS_CurrentMY && MSYS_CurrentMY <= cur->RegionBottomRightY)
+		for (MOUSE_REGION* const i : *cell)
 		{
-			/* We got the right region. We don't need to check for priorities because
-			 * the whole list is sorted the right way! */
-			break;
+			++MSYS_RegionsExamined;
+			if (i->uiFlags & (MSYS_REGION_ENABLED | MSYS_ALLOW_DISABLED_FASTHELP) &&
+				MSYS_RegionContains(i, MSYS_CurrentMX, MSYS_CurrentMY))
+			{
+				/* We got the right region. We don't need to check for priorities
+				 * because the cell is sorted the right way! */
+				cur = i;
+				break;
+			}
 		}
 	}
 	MSYS_CurrRegion = cur;
@@ -345,15 +439,21 @@ static void MSYS_UpdateMouseRegion(void)
 			{
 				/* Addition Oct 10/1997 Carter, patch for mouse cursor
 				 * start at region and find another region encompassing */
-				for (const MOUSE_REGION* i = cur->next; i != NULL; i = i->next)
+				if (std::vector<MOUSE_REGION*> const* const cell = MSYS_GetGridCell(MSYS_CurrentMX, MSYS_CurrentMY))
 				{
-					if (i->uiFlags & MSYS_REGION_ENABLED &&
-							i->RegionTopLeftX <= MSYS_CurrentMX && MSYS_CurrentMX <= i->RegionBottomRightX &&
-							i->RegionTopLeftY <= MSYS_CurrentMY && MSYS_CurrentMY <= i->RegionBottomRightY &&
-							i->Cursor != MSYS_NO_CURSOR)
+					auto i = std::find(cell->begin(), cell->end(), cur);
+					if (i != cell->end()) ++i;
+					for (; i != cell->end(); ++i)
 					{
-						MSYS_SetCurrentCursor(i->Cursor);
-						break;
+						++MSYS_RegionsExamined;
+						MOUSE_REGION const* const r = *i;
+						if (r->uiFlags & MSYS_REGION_ENABLED &&
+								MSYS_RegionContains(r, MSYS_CurrentMX, MSYS_CurrentMY) &&
+								r->Cursor != MSYS_NO_CURSOR)
+						{
+							MSYS_SetCurrentCursor(r->Cursor);
+							break;
+						}
 					}
 				}
 			}
@@ -567,12 +667,29 @@ void MSYS_DefineRegion(MOUSE_REGION* const r, UINT16 const tlx, UINT16 const tly
 	r->FastHelpText       = ST::null;
 	r->next               = 0;
 	r->prev               = 0;
+	r->IndexSequence      = 0;
+	r->IndexCells.set(1, 1, 0, 0);
 
 	MSYS_AddRegionToList(r);
 	gfRefreshUpdate = TRUE;
 }
 
 
+void MOUSE_REGION::SetArea(INT16 const tlx, INT16 const tly, INT16 const brx, INT16 const bry)
+{
+	bool const indexed = uiFlags & MSYS_REGION_EXISTS;
+	if (indexed) MSYS_RemoveRegionFromIndex(this);
+
+	RegionTopLeftX     = tlx;
+	RegionTopLeftY     = tly;
+	RegionBottomRightX = brx;
+	RegionBottomRightY = bry;
+
+	if (indexed) MSYS_AddRegionToIndex(this);
+	gfRefreshUpdate = TRUE;
+}
+
+
 void MOUSE_REGION::ChangeCursor(UINT16 const crsr)
 {
 	Cursor = crsr;
@@ -47,6 +47,9 @@ struct MOUSE_REGION
 
 	void AllowDisabledRegionFastHelp(bool allow);
 
+	// Moves the region to a new screen area, keeping the hit test index current
+	void SetArea(INT16 tlx, INT16 tly, INT16 brx, INT16 bry);
+
 	void SetUserPtr(void* ptr) { user.ptr = ptr; }
 
 	template<typename T> T* GetUserPtr() const { return static_cast<T*>(user.ptr); }
@@ -83,6 +86,8 @@ struct MOUSE_REGION
 
 	MOUSE_REGION* next; // List maintenance, do NOT touch these entries
 	MOUSE_REGION* prev;
+	UINT32        IndexSequence; // Order of definition, breaks priority ties
+	SGPRect       IndexCells;    // Hit test grid cells the region is filed in
 };
 
 // Mouse region priorities
@@ -169,6 +174,10 @@ INT32 MSYS_GetRegionUserData(MOUSE_REGION const*, UINT32 index);
 // Usually used to force change of mouse cursor if panels switch, etc
 void RefreshMouseRegions(void);
 
+/* Number of regions the last mouse event had to examine to find the region
+ * under the mouse */
+UINT32 MSYS_GetRegionsExamined(void);
+
 // Now also used by Wizardry -- DB
 void RenderFastHelp(void);
 
@@ -1,13 +1,117 @@
 #include "Random.h"
 
+#include "Debug.h"
+
+#include <algorithm>
 #include <chrono>
 #include <random>
+#include <string.h>
+
+
+static inline UINT32 Rotl(UINT32 const x, int const k)
+{
+	return (x << k) | (x >> (32 - k));
+}
+
+
+static uint64_t SplitMix64(uint64_t& x)
+{
+	uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+
+void RandomEngine::Seed(uint64_t seed)
+{
+	// Expand the seed into the lane states, as recommended for xoshiro
+	for (UINT32 lane = 0; lane != RANDOM_LANES; ++lane)
+	{
+		UINT32 any = 0;
+		for (UINT32 w = 0; w != 4; w += 2)
+		{
+			uint64_t const z = SplitMix64(seed);
+			m_s[w][lane]     = UINT32(z);
+			m_s[w + 1][lane] = UINT32(z >> 32);
+			any |= m_s[w][lane] | m_s[w + 1][lane];
+		}
+		// An all zero state would only ever make zeroes
+		if (!any) m_s[0][lane] = 1;
+	}
+	m_pos = RANDOM_BLOCK;
+}
+
 
-/// Pseudo-random number engine.
-std::mt19937 gRandomEngine;
+void RandomEngine::Step(UINT32 out[RANDOM_LANES])
+{
+	// Made in a local array, as out could alias the state as far as the
+	// compiler knows, which would keep it from vectorizing the loop
+	UINT32 r[RANDOM_LANES];
+	UINT32 (&s)[4][RANDOM_LANES] = m_s;
+	for (UINT32 i = 0; i != RANDOM_LANES; ++i)
+	{
+		r[i] = Rotl(s[1][i] * 5, 7) * 9;
+
+		UINT32 const t = s[1][i] << 9;
+		s[2][i] ^= s[0][i];
+		s[3][i] ^= s[1][i];
+		s[1][i] ^= s[2][i];
+		s[0][i] ^= s[3][i];
+		s[2][i] ^= t;
+		s[3][i]  = Rotl(s[3][i], 11);
+	}
+	memcpy(out, r, sizeof(r));
+}
+
+
+void RandomEngine::Refill()
+{
+	for (UINT32 i = 0; i != RANDOM_BLOCK; i += RANDOM_LANES) Step(m_block + i);
+	m_pos = 0;
+}
+
+
+void RandomEngine::Generate(UINT32* out, size_t n)
+{
+	// Hand out what is left of the current block first to keep the sequence
+	size_t const left = std::min<size_t>(n, RANDOM_BLOCK - m_pos);
+	memcpy(out, m_block + m_pos, left * sizeof(*out));
+	m_pos += left;
+	out   += left;
+	n     -= left;
+
+	for (; n >= RANDOM_LANES; n -= RANDOM_LANES, out += RANDOM_LANES) Step(out);
+	while (n-- != 0) *out++ = (*this)();
+}
 
-/// Uniform distribution in the range [0,UINT32_MAX].
-static std::uniform_int_distribution<UINT32> guiDistribution(0, UINT32_MAX);
+
+/// Returns a number in the range [0,range) without the bias of a plain modulo,
+/// the same on every platform unlike std::uniform_int_distribution.
+template<typename Engine> static UINT32 BoundedRandom(Engine& e, UINT32 const range)
+{
+	// Lemire's nearly divisionless method
+	uint64_t m = uint64_t(e()) * range;
+	UINT32   l = UINT32(m);
+	if (l < range)
+	{
+		UINT32 const threshold = (0U - range) % range;
+		while (l < threshold)
+		{
+			m = uint64_t(e()) * range;
+			l = UINT32(m);
+		}
+	}
+	return UINT32(m >> 32);
+}
+
+
+static UINT32 guiRandomSeed;
+static RandomEngine gRandomStreams[NUM_RANDOM_STREAMS];
+
+/// Refills the pregenerated numbers, separate from the streams so that
+/// refilling does not move them.
+static RandomEngine gPreRandomEngine;
 
 // Pregenerated pseudo-random numbers.
 UINT32 guiPreRandomIndex = 0;
@@ -16,56 +120,90 @@ UINT32 guiPreRandomNums[ MAX_PREGENERATED_NUMS ];
 /// Pre-generated pseudo-random number engine.
 struct PreRandomEngine {
 	typedef UINT32 result_type;
-	static constexpr result_type min() { return 0; }
-	static constexpr result_type max() { return UINT32_MAX; }
 	result_type operator()()
 	{
 		// Extract the current pregenerated number
 		UINT32 uiNum = guiPreRandomNums[ guiPreRandomIndex ];
 
-		// Replace the current pregenerated number with a new one.
-		// NOTE the original code has this commented out in the name of optimization.
-		guiPreRandomNums[ guiPreRandomIndex ] = guiDistribution(gRandomEngine);
-
-		// Go to the next index.
+		// Go to the next index. Every number of the table has been used once it
+		// wraps around, so the whole table is replaced in one go.
 		guiPreRandomIndex++;
 		if (guiPreRandomIndex >= (UINT32)MAX_PREGENERATED_NUMS)
+		{
 			guiPreRandomIndex = 0;
+			gPreRandomEngine.Generate(guiPreRandomNums, MAX_PREGENERATED_NUMS);
+		}
 		return uiNum;
 	}
 };
-static PreRandomEngine gPreRandomEngine;
+static PreRandomEngine gPreRandomNumbers;
 
 void InitializeRandom(void)
 {
-	// Seed the pseudo-random number engine with the current time
-	// so that the numbers will be different every time we run.
+	// Seed with the current time so that the numbers will be different every
+	// time we run.
 	UINT32 uiSeed1 = std::chrono::system_clock::now().time_since_epoch().count();
 
-	// Also try to seed the pseudo-random number engine with a non-deterministic
-	// random number (entropy is 0 when not available).
+	// Also try to seed with a non-deterministic random number (entropy is 0
+	// when not available).
 	std::random_device randomDevice;
-	UINT32 uiSeed2 = guiDistribution(randomDevice);
+	UINT32 uiSeed2 = randomDevice();
 
 	std::seed_seq seed = { uiSeed1, uiSeed2 };
-	gRandomEngine = std::mt19937(seed);
+	UINT32 uiSeed;
+	seed.generate(&uiSeed, &uiSeed + 1);
 
-	// Pregenerate random numbers.
-	for (guiPreRandomIndex = 0; guiPreRandomIndex < MAX_PREGENERATED_NUMS; ++guiPreRandomIndex)
+	// Logged so that a run can be replayed with SeedRandom()
+	SLOGI("Random seed: %u", uiSeed);
+	SeedRandom(uiSeed);
+}
+
+void SeedRandom(UINT32 const uiSeed)
+{
+	guiRandomSeed = uiSeed;
+
+	// Every stream gets its own sequence derived from the seed
+	for (UINT32 i = 0; i != NUM_RANDOM_STREAMS; ++i)
 	{
-		guiPreRandomNums[ guiPreRandomIndex ] = guiDistribution(gRandomEngine);
+		gRandomStreams[i].Seed(uint64_t(uiSeed) << 32 | i);
 	}
+	gPreRandomEngine.Seed(uint64_t(uiSeed) << 32 | NUM_RANDOM_STREAMS);
+
+	// Pregenerate random numbers.
+	gPreRandomEngine.Generate(guiPreRandomNums, MAX_PREGENERATED_NUMS);
 	guiPreRandomIndex = 0;
 }
 
+UINT32 GetRandomSeed(void)
+{
+	return guiRandomSeed;
+}
+
+RandomEngine& GetRandomEngine(RandomStream const stream)
+{
+	Assert(stream < NUM_RANDOM_STREAMS);
+	return gRandomStreams[stream];
+}
+
 /// Returns a pseudo-random integer in the range [0,uiRange).
 /// Returns 0 if no range is given (not an error).
 UINT32 Random(UINT32 uiRange)
+{
+	return Random(uiRange, RANDOM_TACTICAL);
+}
+
+UINT32 Random(UINT32 const uiRange, RandomStream const stream)
 {
 	if (!uiRange)
 		return 0;
-	std::uniform_int_distribution<UINT32> distribution(0, uiRange - 1);
-	return distribution(gRandomEngine);
+	return BoundedRandom(GetRandomEngine(stream), uiRange);
+}
+
+UINT32 Random(UINT32 const uiRange, RandomEngine& engine)
+{
+	if (!uiRange)
+		return 0;
+	return BoundedRandom(engine, uiRange);
 }
 
 BOOLEAN Chance(UINT32 uiChance)
@@ -73,14 +211,18 @@ BOOLEAN Chance(UINT32 uiChance)
 	return Random(100) < uiChance;
 }
 
+BOOLEAN Chance(UINT32 const uiChance, RandomStream const stream)
+{
+	return Random(100, stream) < uiChance;
+}
+
 /// Returns a pregenerated pseudo-random integer in the range [0,uiRange).
 /// Returns 0 if no range is given (not an error).
 UINT32 PreRandom(UINT32 uiRange)
 {
 	if (!uiRange)
 		return 0;
-	std::uniform_int_distribution<UINT32> distribution(0, uiRange - 1);
-	return distribution(gPreRandomEngine);
+	return BoundedRandom(gPreRandomNumbers, uiRange);
 }
 
 BOOLEAN PreChance(UINT32 uiChance)
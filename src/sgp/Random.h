@@ -2,14 +2,77 @@
 #define __RANDOM_
 
 #include "Types.h"
-#include <random>
+
+
+// Number of xoshiro128** generators a RandomEngine runs side by side
+#define RANDOM_LANES	8
+// Numbers a RandomEngine makes at a time
+#define RANDOM_BLOCK	64
+
+
+/* Pseudo-random number engine: RANDOM_LANES xoshiro128** generators whose
+ * states are kept lane by lane, so that making a block of numbers is a loop
+ * the compiler can vectorize. The numbers are made a block at a time and
+ * handed out one by one, or in bulk by Generate(); either way a seed always
+ * gives the same sequence. */
+class RandomEngine
+{
+public:
+	typedef UINT32 result_type;
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return UINT32_MAX; }
+
+	explicit RandomEngine(uint64_t seed = 0) { Seed(seed); }
+
+	void Seed(uint64_t seed);
+
+	result_type operator()()
+	{
+		if (m_pos == RANDOM_BLOCK) Refill();
+		return m_block[m_pos++];
+	}
+
+	// Fills out with the next n numbers of the sequence
+	void Generate(UINT32* out, size_t n);
+
+private:
+	void Step(UINT32 out[RANDOM_LANES]);
+	void Refill();
+
+	UINT32 m_s[4][RANDOM_LANES];
+	UINT32 m_block[RANDOM_BLOCK];
+	UINT32 m_pos;
+};
+
+
+/* Separately seeded streams, so that for example drawing more numbers for the
+ * face animations does not change the outcome of the next shot */
+enum RandomStream
+{
+	RANDOM_TACTICAL,  // combat, AI and everything else in the tactical layer
+	RANDOM_STRATEGIC, // the strategic layer
+	RANDOM_COSMETIC,  // rolls which only change how things look or sound
+	NUM_RANDOM_STREAMS
+};
 
 
 extern void InitializeRandom(void);
+
+/* Seeds all streams and refills the pregenerated numbers, so that the same
+ * seed replays exactly the same numbers */
+extern void SeedRandom(UINT32 uiSeed);
+extern UINT32 GetRandomSeed(void);
+
+extern RandomEngine& GetRandomEngine(RandomStream);
+
 extern UINT32 Random( UINT32 uiRange );
+extern UINT32 Random(UINT32 uiRange, RandomStream);
+// For code that runs off the main thread with its own engine
+extern UINT32 Random(UINT32 uiRange, RandomEngine&);
 
 //Chance( 74 ) returns TRUE 74% of the time.  If uiChance >= 100, then it will always return TRUE.
 extern BOOLEAN Chance( UINT32 uiChance );
+extern BOOLEAN Chance(UINT32 uiChance, RandomStream);
 
 //Returns a pregenerated random number.
 //Used to deter Ian's tactic of shoot, miss, restore saved game :)
@@ -23,5 +86,3 @@ extern UINT32 guiPreRandomIndex;
 extern UINT32 guiPreRandomNums[ MAX_PREGENERATED_NUMS ];
 
 #endif
-
-extern std::mt19937 gRandomEngine;
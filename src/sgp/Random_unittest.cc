@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+
+#include "Random.h"
+
+#include <string.h>
+#include <vector>
+
+
+static std::vector<UINT32> Draw(RandomStream const stream, size_t const n)
+{
+	std::vector<UINT32> v;
+	for (size_t i = 0; i != n; ++i) v.push_back(Random(1000000, stream));
+	return v;
+}
+
+
+TEST(RandomTest, sameSeedReplaysTheSameNumbers)
+{
+	SeedRandom(1234);
+	EXPECT_EQ(GetRandomSeed(), 1234u);
+	std::vector<UINT32> const tactical  = Draw(RANDOM_TACTICAL, 500);
+	std::vector<UINT32> const strategic = Draw(RANDOM_STRATEGIC, 500);
+	UINT32 const pre = PreRandom(1000000);
+
+	SeedRandom(1234);
+	EXPECT_EQ(Draw(RANDOM_TACTICAL, 500), tactical);
+	EXPECT_EQ(Draw(RANDOM_STRATEGIC, 500), strategic);
+	EXPECT_EQ(PreRandom(1000000), pre);
+	EXPECT_NE(tactical, strategic);
+
+	SeedRandom(1235);
+	EXPECT_NE(Draw(RANDOM_TACTICAL, 500), tactical);
+}
+
+
+TEST(RandomTest, streamsDoNotDisturbEachOther)
+{
+	SeedRandom(99);
+	std::vector<UINT32> const tactical = Draw(RANDOM_TACTICAL, 300);
+
+	SeedRandom(99);
+	Draw(RANDOM_COSMETIC, 1000);
+	Draw(RANDOM_STRATEGIC, 77);
+	for (UINT32 i = 0; i != 600; ++i) PreRandom(100);
+	EXPECT_EQ(Draw(RANDOM_TACTICAL, 300), tactical);
+}
+
+
+TEST(RandomTest, bulkAndSingleNumbersFormOneSequence)
+{
+	RandomEngine single(42);
+	std::vector<UINT32> expected(1000);
+	for (UINT32& n : expected) n = single();
+
+	// Start in the middle of a block and make runs that do not fit the lanes
+	RandomEngine bulk(42);
+	std::vector<UINT32> got(1000);
+	got[0] = bulk();
+	got[1] = bulk();
+	bulk.Generate(&got[2], 3);
+	bulk.Generate(&got[5], 200);
+	got[205] = bulk();
+	bulk.Generate(&got[206], 794);
+	EXPECT_EQ(got, expected);
+}
+
+
+TEST(RandomTest, staysInRange)
+{
+	SeedRandom(7);
+	EXPECT_EQ(Random(0), 0u);
+	EXPECT_EQ(PreRandom(0), 0u);
+	EXPECT_FALSE(Chance(0));
+	EXPECT_TRUE(Chance(100));
+
+	UINT32 hits[6] = {};
+	for (UINT32 i = 0; i != 60000; ++i)
+	{
+		UINT32 const n = Random(6);
+		ASSERT_LT(n, 6u);
+		++hits[n];
+		ASSERT_LT(PreRandom(3), 3u);
+		ASSERT_LT(Random(UINT32_MAX, RANDOM_COSMETIC), UINT32_MAX);
+	}
+	RandomEngine engine(7);
+	EXPECT_EQ(Random(0, engine), 0u);
+	for (UINT32 i = 0; i != 1000; ++i) ASSERT_LT(Random(3, engine), 3u);
+	for (UINT32 const h : hits)
+	{
+		EXPECT_GT(h, 9000u);
+		EXPECT_LT(h, 11000u);
+	}
+}
+
+
+TEST(RandomTest, savedPregeneratedNumbersReplay)
+{
+	SeedRandom(2024);
+	for (UINT32 i = 0; i != 200; ++i) PreRandom(100);
+
+	// This is what a saved game keeps
+	UINT32 const index = guiPreRandomIndex;
+	UINT32 nums[MAX_PREGENERATED_NUMS];
+	memcpy(nums, guiPreRandomNums, sizeof(nums));
+
+	// Enough to refill the table in between
+	std::vector<UINT32> first;
+	for (UINT32 i = 0; i != 100; ++i) first.push_back(PreRandom(100));
+	EXPECT_EQ(guiPreRandomIndex, (index + 100) % MAX_PREGENERATED_NUMS);
+
+	// Loading the game gives the same rolls up to the refill, even after the
+	// other streams moved on
+	Draw(RANDOM_TACTICAL, 50);
+	guiPreRandomIndex = index;
+	memcpy(guiPreRandomNums, nums, sizeof(nums));
+	for (UINT32 i = 0; i != MAX_PREGENERATED_NUMS - index; ++i)
+	{
+		EXPECT_EQ(PreRandom(100), first[i]) << i;
+	}
+}
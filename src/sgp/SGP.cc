@@ -189,6 +189,8 @@ static void shutdownGame()
 
 	SLOGD("Shutting Down SDL");
 	SDL_Quit();
+
+	LogStopBackgroundWriter();
 }
 
 /** Deinitialize the game an exit. */
@@ -370,6 +372,7 @@ int main(int argc, char* argv[])
 			std::vector<ST::string> problems = InitGlobalLocale();
 			ST::string const tempFilename{get_temp_filename()};
 			Logger_initialize(tempFilename.c_str());
+			LogStartBackgroundWriter();
 			for (const ST::string& msg : problems)
 			{
 				SLOGW("%s", msg.c_str());
@@ -416,7 +419,7 @@ int main(int argc, char* argv[])
 		}
 
 		if (EngineOptions_shouldStartInDebugMode(params.get())) {
-			Logger_setLevel(LogLevel::Debug);
+			LogSetLevel(LogLevel::Debug);
 			GameMode::getInstance()->setDebugging(true);
 		}
 
@@ -430,7 +433,7 @@ int main(int argc, char* argv[])
 
 		if (EngineOptions_shouldRunUnittests(params.get())) {
 	#ifdef WITH_UNITTESTS
-			Logger_setLevel(LogLevel::Error);
+			LogSetLevel(LogLevel::Error);
 			testing::InitGoogleTest(&argc, argv);
 			return RUN_ALL_TESTS();
 	#else
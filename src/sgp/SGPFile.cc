@@ -6,6 +6,10 @@
 #include <string_theory/string>
 #include <string_theory/format>
 
+#include <algorithm>
+#include <atomic>
+#include <string.h>
+
 #define SDL_RWOPS_SGP 222
 
 void DeleteSGPFile(SGPFile *file)
@@ -66,10 +70,25 @@ static int SGPCloseRW(SDL_RWops *context)
 	return 0;
 }
 
+static std::atomic<uint64_t> guiFileSystemCalls{0};
+
+static void CountFileSystemCall()
+{
+    guiFileSystemCalls.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t SGPFile::fileSystemCalls()
+{
+    return guiFileSystemCalls.load(std::memory_order_relaxed);
+}
+
 SGPFile::SGPFile(VFile *f)
 {
     this->flags = SGPFILE_REAL;
     this->file = f;
+    this->bufferPos = 0;
+    this->readAhead = 0;
+    this->slurped = false;
 }
 
 SGPFile::~SGPFile()
@@ -77,8 +96,67 @@ SGPFile::~SGPFile()
     File_close(this->file);
 }
 
-void SGPFile::read(void *const pDest, size_t const uiBytesToRead)
+void SGPFile::bufferReads(size_t const bufferSize)
+{
+    if (this->slurped) return;
+    this->readAhead = bufferSize;
+}
+
+void SGPFile::slurp()
+{
+    if (this->slurped) return;
+
+    INT32 const position = this->pos();
+    this->seek(0, FILE_SEEK_FROM_START);
+    this->buffer = this->readToEnd();
+    this->bufferPos = std::min(static_cast<size_t>(position), this->buffer.size());
+    this->slurped = true;
+}
+
+void SGPFile::fillBuffer(size_t const minBytes)
+{
+    // a slurped buffer already holds everything and must keep starting at 0
+    if (this->slurped) return;
+
+    // keep what has not been handed out yet and append to it
+    this->buffer.erase(this->buffer.begin(), this->buffer.begin() + this->bufferPos);
+    this->bufferPos = 0;
+
+    size_t const have = this->buffer.size();
+    if (have >= minBytes) return;
+
+    size_t const want = std::max(minBytes, this->readAhead);
+    this->buffer.resize(want);
+    size_t got = have;
+    while (got < want)
+    {
+        size_t const n = this->readAtMostRaw(this->buffer.data() + got, want - got);
+        if (n == 0) break;
+        got += n;
+        if (got >= minBytes) break;
+    }
+    this->buffer.resize(got);
+}
+
+void SGPFile::dropBuffer()
 {
+    if (this->slurped)
+    {
+        // the underlying file is at the end, move it to the logical position
+        this->slurped = false;
+        this->seekRaw(static_cast<int64_t>(this->bufferPos), FILE_SEEK_FROM_START);
+    }
+    else if (this->bufferedBytes() != 0)
+    {
+        this->seekRaw(-static_cast<int64_t>(this->bufferedBytes()), FILE_SEEK_FROM_CURRENT);
+    }
+    this->buffer.clear();
+    this->bufferPos = 0;
+}
+
+void SGPFile::readRaw(void *const pDest, size_t const uiBytesToRead)
+{
+    CountFileSystemCall();
     bool success = File_readExact(this->file, reinterpret_cast<uint8_t *>(pDest), uiBytesToRead);
 
     if (!success)
@@ -88,8 +166,78 @@ void SGPFile::read(void *const pDest, size_t const uiBytesToRead)
     }
 }
 
+size_t SGPFile::readAtMostRaw(void *const pDest, size_t const uiBytesToRead)
+{
+    CountFileSystemCall();
+    size_t bytesRead = File_read(this->file, reinterpret_cast<uint8_t *>(pDest), uiBytesToRead);
+
+    if (bytesRead == SIZE_MAX)
+    {
+        RustPointer<char> err{getRustError()};
+        throw IoException(ST::format("SGPFile::readAtMost failed: {}", err.get()));
+    }
+
+    return bytesRead;
+}
+
+void SGPFile::read(void *const pDest, size_t const uiBytesToRead)
+{
+    if (uiBytesToRead == 0) return;
+
+    size_t const buffered = this->bufferedBytes();
+    if (uiBytesToRead <= buffered)
+    {
+        memcpy(pDest, this->buffer.data() + this->bufferPos, uiBytesToRead);
+        this->bufferPos += uiBytesToRead;
+        return;
+    }
+
+    if (!this->slurped && (this->readAhead == 0 || uiBytesToRead >= this->readAhead))
+    {
+        // large or unbuffered reads go straight to the file
+        if (buffered != 0) memcpy(pDest, this->buffer.data() + this->bufferPos, buffered);
+        this->buffer.clear();
+        this->bufferPos = 0;
+        this->readRaw(reinterpret_cast<uint8_t *>(pDest) + buffered, uiBytesToRead - buffered);
+        return;
+    }
+
+    this->fillBuffer(uiBytesToRead);
+    if (this->bufferedBytes() < uiBytesToRead)
+    {
+        throw IoException(ST::format("SGPFile::read failed: wanted {} bytes, only {} left", uiBytesToRead, this->bufferedBytes()));
+    }
+    memcpy(pDest, this->buffer.data() + this->bufferPos, uiBytesToRead);
+    this->bufferPos += uiBytesToRead;
+}
+
+const uint8_t* SGPFile::readInPlace(size_t const uiBytesToRead)
+{
+    if (this->bufferedBytes() < uiBytesToRead)
+    {
+        this->fillBuffer(uiBytesToRead);
+        if (this->bufferedBytes() < uiBytesToRead)
+        {
+            throw IoException(ST::format("SGPFile::readInPlace failed: wanted {} bytes, only {} left", uiBytesToRead, this->bufferedBytes()));
+        }
+    }
+    const uint8_t* const data = this->buffer.data() + this->bufferPos;
+    this->bufferPos += uiBytesToRead;
+    return data;
+}
+
 std::vector<uint8_t> SGPFile::readToEnd()
 {
+    std::vector<uint8_t> rest(this->buffer.begin() + this->bufferPos, this->buffer.end());
+    if (this->slurped)
+    {
+        this->bufferPos = this->buffer.size();
+        return rest;
+    }
+    this->buffer.clear();
+    this->bufferPos = 0;
+
+    CountFileSystemCall();
     RustPointer<VecU8> vec;
     vec.reset(File_readToEnd(this->file));
 
@@ -100,20 +248,25 @@ std::vector<uint8_t> SGPFile::readToEnd()
     }
     auto bytes = VecU8_as_ptr(vec.get());
     auto len = VecU8_len(vec.get());
-    return std::vector<uint8_t>(bytes, bytes + len);
+    rest.insert(rest.end(), bytes, bytes + len);
+    return rest;
 }
 
 size_t SGPFile::readAtMost(void *const pDest, size_t const uiBytesToRead)
 {
-    size_t bytesRead = File_read(this->file, reinterpret_cast<uint8_t *>(pDest), uiBytesToRead);
-
-    if (bytesRead == SIZE_MAX)
+    if (this->bufferedBytes() < uiBytesToRead && (this->slurped || (this->readAhead != 0 && uiBytesToRead < this->readAhead)))
     {
-        RustPointer<char> err{getRustError()};
-        throw IoException(ST::format("SGPFile::readAtMost failed: {}", err.get()));
+        this->fillBuffer(uiBytesToRead);
     }
 
-    return bytesRead;
+    size_t const buffered = std::min(this->bufferedBytes(), uiBytesToRead);
+    if (buffered != 0) memcpy(pDest, this->buffer.data() + this->bufferPos, buffered);
+    this->bufferPos += buffered;
+    if (buffered == uiBytesToRead || this->slurped) return buffered;
+
+    this->buffer.clear();
+    this->bufferPos = 0;
+    return buffered + this->readAtMostRaw(reinterpret_cast<uint8_t *>(pDest) + buffered, uiBytesToRead - buffered);
 }
 
 ST::string SGPFile::readString(size_t const uiBytesToRead)
@@ -133,6 +286,11 @@ ST::string SGPFile::readStringToEnd()
 
 void SGPFile::write(void const *const pDest, size_t const uiBytesToWrite)
 {
+    // writing goes to the file at the logical position, which also makes the
+    // buffered bytes stale
+    this->dropBuffer();
+
+    CountFileSystemCall();
     bool success = File_writeAll(this->file, reinterpret_cast<const uint8_t *>(pDest), uiBytesToWrite);
 
     if (!success)
@@ -142,8 +300,9 @@ void SGPFile::write(void const *const pDest, size_t const uiBytesToWrite)
     }
 }
 
-void SGPFile::seek(INT32 distance, FileSeekMode const how)
+void SGPFile::seekRaw(int64_t distance, FileSeekMode const how)
 {
+    CountFileSystemCall();
     bool success;
     switch (how)
     {
@@ -165,15 +324,72 @@ void SGPFile::seek(INT32 distance, FileSeekMode const how)
     }
 }
 
-INT32 SGPFile::pos() const
+void SGPFile::seek(INT32 distance, FileSeekMode const how)
 {
-    uint64_t position = File_seekFromCurrent(this->file, 0);
-    bool success = position != UINT64_MAX;
+    if (this->slurped)
+    {
+        int64_t target;
+        switch (how)
+        {
+        case FILE_SEEK_FROM_START: target = distance; break;
+        case FILE_SEEK_FROM_END:   target = static_cast<int64_t>(this->buffer.size()) + distance; break;
+        default:                   target = static_cast<int64_t>(this->bufferPos) + distance; break;
+        }
+        if (target < 0)
+        {
+            throw IoException(ST::format("SGPFile::seek failed: position {} is before the start of the file", target).c_str());
+        }
+        if (static_cast<size_t>(target) <= this->buffer.size())
+        {
+            this->bufferPos = static_cast<size_t>(target);
+            return;
+        }
+        // past the end, leave it to the file to decide what that means
+        this->slurped = false;
+        this->buffer.clear();
+        this->bufferPos = 0;
+        this->seekRaw(target, FILE_SEEK_FROM_START);
+        return;
+    }
 
-    if (!success)
+    int64_t rawDistance = distance;
+    if (how == FILE_SEEK_FROM_CURRENT)
     {
-        RustPointer<char> err{getRustError()};
-        throw IoException(ST::format("SGPFile::pos failed: {}", err.get()).c_str());
+        // skipping within the buffer needs no file system call
+        int64_t const target = static_cast<int64_t>(this->bufferPos) + distance;
+        if (target >= 0 && target <= static_cast<int64_t>(this->buffer.size()))
+        {
+            this->bufferPos = static_cast<size_t>(target);
+            return;
+        }
+        // the file is ahead of the logical position by the buffered bytes
+        rawDistance -= static_cast<int64_t>(this->bufferedBytes());
+    }
+
+    this->buffer.clear();
+    this->bufferPos = 0;
+    this->seekRaw(rawDistance, how);
+}
+
+INT32 SGPFile::pos() const
+{
+    uint64_t position;
+    if (this->slurped)
+    {
+        position = this->bufferPos;
+    }
+    else
+    {
+        CountFileSystemCall();
+        position = File_seekFromCurrent(this->file, 0);
+        bool success = position != UINT64_MAX;
+
+        if (!success)
+        {
+            RustPointer<char> err{getRustError()};
+            throw IoException(ST::format("SGPFile::pos failed: {}", err.get()).c_str());
+        }
+        position -= this->bufferedBytes();
     }
     if (position > INT32_MAX)
     {
@@ -185,14 +401,22 @@ INT32 SGPFile::pos() const
 
 UINT32 SGPFile::size() const
 {
-
-    uint64_t len = File_len(this->file);
-    bool success = len != UINT64_MAX;
-
-    if (!success)
+    uint64_t len;
+    if (this->slurped)
     {
-        RustPointer<char> err{getRustError()};
-        throw IoException(ST::format("SGPFile::size failed: {}", err.get()).c_str());
+        len = this->buffer.size();
+    }
+    else
+    {
+        CountFileSystemCall();
+        len = File_len(this->file);
+        bool success = len != UINT64_MAX;
+
+        if (!success)
+        {
+            RustPointer<char> err{getRustError()};
+            throw IoException(ST::format("SGPFile::size failed: {}", err.get()).c_str());
+        }
     }
     if (len > UINT32_MAX)
     {
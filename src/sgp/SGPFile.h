@@ -7,6 +7,8 @@
 
 #include <SDL_rwops.h>
 
+#include <vector>
+
 struct SGP_FILETIME
 {
 	uint32_t Lo;
@@ -29,18 +31,53 @@ enum FileSeekMode
 struct File;
 struct VfsFile;
 
+/** Default size of the read-ahead buffer, see SGPFile::bufferReads(). */
+#define SGPFILE_READ_AHEAD_SIZE (64 * 1024)
+
 class SGPFile
 {
 private:
 	SGPFileFlags flags;
 	VFile *file;
 
+	/** Bytes read from the file but not handed out yet, starting at bufferPos.
+	 * The position of the underlying file is always at the end of the buffer. */
+	std::vector<uint8_t> buffer;
+	size_t bufferPos;
+	/** Number of bytes to read ahead, 0 when reads are unbuffered. */
+	size_t readAhead;
+	/** The buffer holds the whole file, starting at offset 0. */
+	bool slurped;
+
+	size_t bufferedBytes() const { return buffer.size() - bufferPos; }
+	void fillBuffer(size_t minBytes);
+	void dropBuffer();
+
+	void readRaw(void *const pDest, size_t const bytesToRead);
+	size_t readAtMostRaw(void *const pDest, size_t const bytesToRead);
+	void seekRaw(int64_t distance, FileSeekMode const how);
+
 public:
 	/** Create a SGP file from a file on disk. */
 	SGPFile(VFile *file);
 	/** Closes file. */
 	~SGPFile();
 
+	/** Serve small reads from a read-ahead buffer of the given size instead of
+	 * going to the file system for each of them. Meant for files that are read
+	 * field by field. */
+	void bufferReads(size_t const bufferSize = SGPFILE_READ_AHEAD_SIZE);
+	/** Read the whole file into memory. All further reads, seeks and position
+	 * queries are served from memory without touching the file system. */
+	void slurp();
+	/** Read the next bytesToRead bytes and return a pointer to them, e.g. to
+	 * consume them with a DataReader. In buffered or slurped mode this does not
+	 * copy. The pointer stays valid until the next operation on the file. */
+	const uint8_t* readInPlace(size_t const bytesToRead);
+
+	/** Number of calls into the virtual file system made by all SGPFiles. */
+	static uint64_t fileSystemCalls();
+
 	/** Read exactly the number of bytes specified from the file into pDest. */
 	void read(void *const pDest, size_t const bytesToRead);
 	/** Read at most the number of bytes specified from the file into pDest. The actual number of bytes read is returned. */
@@ -19,6 +19,7 @@ static SGPImage* STCILoadRGB(    UINT16 contents, HWFILE, STCIHeader const*);
 SGPImage* LoadSTCIFileToImage(const ST::string& filename, UINT16 const fContents)
 {
 	AutoSGPFile f(GCM->openGameResForReading(filename));
+	f->bufferReads();
 
 	STCIHeader header;
 	f->read(&header, sizeof(header));
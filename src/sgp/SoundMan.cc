@@ -11,6 +11,7 @@
 #include "FileMan.h"
 #include "Random.h"
 #include "SoundMan.h"
+#include "SoundMix.h"
 #include "Timer.h"
 
 #include "ContentManager.h"
@@ -96,6 +97,16 @@ enum
 // Buffer size for a single channel in the sound system
 #define SOUND_RING_BUFFER_SIZE (128 * SOUND_SAMPLES)
 
+// Data of a sample that is pushed while it plays
+struct SoundStream
+{
+	std::mutex         mutex;
+	std::vector<UINT8> data;  // pushed and not yet mixed, in the format of the sample
+	bool               ended; // no more data will be pushed
+	ma_format          format;
+};
+
+
 // Struct definition for sample slots in the cache
 // Holds the regular sample data, as well as the data for the random samples
 struct SAMPLETAG
@@ -108,6 +119,7 @@ struct SAMPLETAG
 	UINT32 uiInMemoryChannels;
 	
 	ma_data_converter* pDataConverter; // pointer to a data converter that decodes the data from pData
+	std::shared_ptr<SoundStream> pStream; // pushed data the converter reads instead of pInMemoryBuffer (if streaming)
 
 	SGPFile* pFile;  // pointer to a SDL_RWops representing the file that we stream from
 	SDL_RWops* pRWOps; // RWOps on either pData or pSource
@@ -144,6 +156,8 @@ struct SOUNDTAG
 	UINT32        uiFadeTime;
 	UINT32        Loops;
 	UINT32        Pan;
+	INT32         MixVolL; // Volumes the channel was last mixed with, ramped towards
+	INT32         MixVolR; // the volume and pan to avoid clicks when they change
 
 	// The following properties might be accessed from multiple threads, so they need to be thread safe (or accessed in a thread safe way)
 	ma_pcm_rb*    pRingBuffer; // Pointer to the ring buffer that holds decoded and converted data
@@ -239,16 +253,14 @@ static SAMPLETAG* SoundLoadBuffer(UINT8* buf, UINT32 bufSize, ma_format format,
 static BOOLEAN    SoundCleanCache(void);
 static SAMPLETAG* SoundGetEmptySample(void);
 
-/* Play a sound sample from a Smacker Flick
+/* Play a stream of sound data that is pushed while it plays
  *
  * Allocates space for the sound sample within the sound system
  */
-UINT32 SoundPlayFromSmackBuff(const char* name, UINT8 channels, UINT8 depth, UINT32 rate, std::vector<UINT8>& buf, UINT32 volume, UINT32 pan, UINT32 loop, void (*end_callback)(void*), void* data)
+UINT32 SoundPlayStream(const char* name, UINT8 channels, UINT8 depth, UINT32 rate, UINT32 volume, UINT32 pan, std::shared_ptr<SoundStream>& stream)
 {
 	ma_format format;
 
-	if (buf.empty()) return SOUND_ERROR;
-
 	//Originaly Sound Blaster could only play mono unsigned 8-bit PCM data.
 	//Later it became capable of playing 16-bit audio data, but needed to be signed and LSB.
 	//They were the de facto standard so I'm assuming smacker uses the same.
@@ -256,25 +268,41 @@ UINT32 SoundPlayFromSmackBuff(const char* name, UINT8 channels, UINT8 depth, UIN
 	else if (depth == 16) format = ma_format_s16;
 	else return SOUND_ERROR;
 
-	UINT32 uiBufferSize = buf.size();
-	UINT8* inMemoryBuffer = new UINT8[uiBufferSize]{};
-	memcpy(inMemoryBuffer, buf.data(), uiBufferSize);
-	if (format == ma_format_s16) {
-		// We expect the Endianess for the Smacker buffer to be little endian, but ma_format_s16 is native endian, so we need to do some conversion
-		convertLittleEndianBufferToNativeEndianU16(inMemoryBuffer, uiBufferSize);
-	}
-
-	SAMPLETAG* s = SoundLoadBuffer(inMemoryBuffer, uiBufferSize, format, channels, rate);
+	SAMPLETAG* s = SoundLoadBuffer(NULL, 0, format, channels, rate);
 	if (s == NULL) return SOUND_ERROR;
 
 	s->pName           = name;
 	s->uiPanMax        = 64;
 	s->uiMaxInstances  = 1;
+	s->pStream         = std::make_shared<SoundStream>();
+	s->pStream->ended  = false;
+	s->pStream->format = format;
 
 	SOUNDTAG* const channel = SoundGetFreeChannel();
 	if (channel == NULL) return SOUND_ERROR;
 
-	return SoundStartSample(s, channel, volume, pan, loop, end_callback, data);
+	UINT32 const uiSoundID = SoundStartSample(s, channel, volume, pan, 1, NULL, NULL);
+	if (uiSoundID != SOUND_ERROR) stream = s->pStream;
+	return uiSoundID;
+}
+
+
+void SoundStreamPush(SoundStream& stream, const UINT8* data, size_t size)
+{
+	std::lock_guard<std::mutex> lock(stream.mutex);
+	size_t const start = stream.data.size();
+	stream.data.insert(stream.data.end(), data, data + size);
+	if (stream.format == ma_format_s16) {
+		// We expect the Endianess of pushed data to be little endian, but ma_format_s16 is native endian, so we need to do some conversion
+		convertLittleEndianBufferToNativeEndianU16(stream.data.data() + start, size);
+	}
+}
+
+
+void SoundStreamEnd(SoundStream& stream)
+{
+	std::lock_guard<std::mutex> lock(stream.mutex);
+	stream.ended = true;
 }
 
 
@@ -484,6 +512,7 @@ static void FillRingBuffer(SOUNDTAG* channel) {
 			throw std::runtime_error(ST::format("ma_pcm_rb_acquire_write: {}", ma_result_description(result)).c_str());
 		}
 		ma_uint64 framesRead = 0;
+		bool streamPending = false; // more data may still be pushed to the sample
 		if (sample->pDecoder != NULL) {
 			auto result = ma_decoder_seek_to_pcm_frame(sample->pDecoder, channel->Pos);
 			if (result != MA_SUCCESS) {
@@ -492,16 +521,27 @@ static void FillRingBuffer(SOUNDTAG* channel) {
 			// We stream from file
 			framesRead = ma_decoder_read_pcm_frames(sample->pDecoder, pFramesInClientFormat, bytesToWrite);
 		} else if (sample->pDataConverter != NULL) {
+			UINT8* buffer = sample->pInMemoryBuffer;
+			ma_uint64 bufferSize = sample->uiBufferSize;
+			std::unique_lock<std::mutex> streamLock;
+			if (sample->pStream) {
+				// The pushing thread must not move the data while we convert it
+				streamLock = std::unique_lock<std::mutex>(sample->pStream->mutex);
+				buffer = sample->pStream->data.data();
+				bufferSize = sample->pStream->data.size();
+				streamPending = !sample->pStream->ended;
+			}
 			auto bytesPerFrame = ma_get_bytes_per_frame(sample->eInMemoryFormat, sample->uiInMemoryChannels);
-			auto posInBytes = ma_data_converter_get_required_input_frame_count(sample->pDataConverter, channel->Pos) * bytesPerFrame;
+			// A stream drops what is mixed, so its data always starts at the current position
+			auto posInBytes = sample->pStream ? 0 : MIN(ma_data_converter_get_required_input_frame_count(sample->pDataConverter, channel->Pos) * bytesPerFrame, bufferSize);
 			auto requiredInputFrameCount = ma_data_converter_get_required_input_frame_count(sample->pDataConverter, bytesToWrite);
 			// We might not have as many bytes available
-			auto availableFrames = MIN(requiredInputFrameCount * bytesPerFrame, sample->uiBufferSize - posInBytes) / bytesPerFrame;
+			auto availableFrames = MIN(requiredInputFrameCount * bytesPerFrame, bufferSize - posInBytes) / bytesPerFrame;
 			auto expectedOutputFrameCount = ma_data_converter_get_expected_output_frame_count(sample->pDataConverter, availableFrames);
 			
 			auto result = ma_data_converter_process_pcm_frames(
 				sample->pDataConverter,
-				sample->pInMemoryBuffer + posInBytes,
+				buffer + posInBytes,
 				&availableFrames,
 				pFramesInClientFormat,
 				&expectedOutputFrameCount
@@ -509,6 +549,10 @@ static void FillRingBuffer(SOUNDTAG* channel) {
 			if (result != MA_SUCCESS) {
 				throw std::runtime_error(ST::format("ma_data_converter_process_pcm_frames: {}", ma_result_description(result)).c_str());
 			}
+			if (sample->pStream) {
+				auto& data = sample->pStream->data;
+				data.erase(data.begin(), data.begin() + availableFrames * bytesPerFrame);
+			}
 			framesRead = expectedOutputFrameCount;
 		} else {
 			throw std::runtime_error("Dont know how to process ring buffer");
@@ -520,8 +564,11 @@ static void FillRingBuffer(SOUNDTAG* channel) {
 
 		channel->Pos += framesRead;
 		if (framesRead < bytesToWrite) {
+			if (streamPending) {
+				// Wait for more data, the next service picks it up
+			}
 			// If the sound is looped, continue to fill buffer in the next iteration
-			if (channel->Loops > 1) {
+			else if (channel->Loops > 1) {
 				channel->Loops -= 1;
 				channel->Pos = 0;
 			} else {
@@ -893,6 +940,18 @@ static SOUNDTAG* SoundGetChannelByID(UINT32 uiSoundID)
 }
 
 
+static INT32 MixVolumeLeft(const SOUNDTAG* const s)
+{
+	return s->uiFadeVolume * (127 - s->Pan) / MAXVOLUME;
+}
+
+
+static INT32 MixVolumeRight(const SOUNDTAG* const s)
+{
+	return s->uiFadeVolume * (  0 + s->Pan) / MAXVOLUME;
+}
+
+
 static void SoundCallback(void* userdata, Uint8* stream, int len)
 {
 	if (len < 0)
@@ -928,8 +987,8 @@ static void SoundCallback(void* userdata, Uint8* stream, int len)
 
 			case CHANNEL_PLAY:
 			{
-				const INT vol_l   = Sound->uiFadeVolume * (127 - Sound->Pan) / MAXVOLUME;
-				const INT vol_r   = Sound->uiFadeVolume * (  0 + Sound->Pan) / MAXVOLUME;
+				const INT32 vol_l = MixVolumeLeft(Sound);
+				const INT32 vol_r = MixVolumeRight(Sound);
 				UINT32    samples = want_samples;
 				const INT16* src;
 				auto rbResult = ma_pcm_rb_acquire_read(Sound->pRingBuffer, &samples, (void**)&src);
@@ -938,13 +997,19 @@ static void SoundCallback(void* userdata, Uint8* stream, int len)
 					continue;
 				}
 
-				for (UINT32 i = 0; i < samples; ++i)
+				if (vol_l == Sound->MixVolL && vol_r == Sound->MixVolR)
 				{
-					gMixBuffer[2 * i + 0] += src[2 * i + 0] * vol_l >> 7;
-					gMixBuffer[2 * i + 1] += src[2 * i + 1] * vol_r >> 7;
+					SoundMixChannel(gMixBuffer.data(), src, samples, vol_l, vol_r);
+				}
+				else
+				{
+					SoundMixChannelRamp(gMixBuffer.data(), src, samples, Sound->MixVolL, Sound->MixVolR, vol_l, vol_r);
+					Sound->MixVolL = vol_l;
+					Sound->MixVolR = vol_r;
 				}
 
-				if (samples < want_samples) {
+				// A stream that is still being pushed just ran dry, so keep it alive
+				if (samples < want_samples && (Sound->DoneServicing || !Sound->pSample->pStream)) {
 					Sound->State = CHANNEL_DEAD;
 				}
 
@@ -959,13 +1024,7 @@ static void SoundCallback(void* userdata, Uint8* stream, int len)
 	}
 
 	// Clip sounds and fill the stream
-	INT16* Stream = (INT16*)stream;
-	for (UINT32 i = 0; i < want_values; ++i)
-	{
-		if (gMixBuffer[i] >= INT16_MAX)     Stream[i] = INT16_MAX;
-		else if(gMixBuffer[i] <= INT16_MIN) Stream[i] = INT16_MIN;
-		else                                Stream[i] = (INT16)gMixBuffer[i];
-	}
+	SoundMixClip((INT16*)stream, gMixBuffer.data(), want_values);
 
 	// "The callback must completely initialize the buffer"
 	// see: https://wiki.libsdl.org/SDL_AudioSpec
@@ -1099,6 +1158,8 @@ static UINT32 SoundStartSample(SAMPLETAG* sample, SOUNDTAG* channel, UINT32 volu
 	channel->uiFadeVolume  = volume;
 	channel->Loops         = loop;
 	channel->Pan           = pan;
+	channel->MixVolL       = MixVolumeLeft(channel);
+	channel->MixVolR       = MixVolumeRight(channel);
 	channel->EOSCallback   = end_callback;
 	channel->pCallbackData = data;
 
@@ -3,6 +3,7 @@
 
 #include "Types.h"
 
+#include <memory>
 #include <vector>
 
 
@@ -22,7 +23,23 @@ void InitializeSoundManager(void);
 void ShutdownSoundManager(void);
 
 
-UINT32 SoundPlayFromSmackBuff(const char* name, UINT8 channels, UINT8 depth, UINT32 rate, std::vector<UINT8>& buf, UINT32 volume, UINT32 pan, UINT32 loop, void (*end_callback)(void*), void* data);
+/* PCM data that is produced while it plays, like the audio track of a video
+ * that is decoded along with the frames. Data can be pushed and the stream
+ * ended from any thread. The channel plays silence while it waits for data
+ * and stops after all data up to the end has been played. */
+struct SoundStream;
+
+/* Starts playing a stream of little endian PCM data in the given format. The
+ * stream to push the data to is returned in stream.
+ *
+ * Returns: Unique sound ID if successful, SOUND_ERROR if not. */
+UINT32 SoundPlayStream(const char* name, UINT8 channels, UINT8 depth, UINT32 rate, UINT32 volume, UINT32 pan, std::shared_ptr<SoundStream>& stream);
+
+// Appends data to a stream
+void SoundStreamPush(SoundStream&, const UINT8* data, size_t size);
+
+// Marks that no more data will be pushed to a stream
+void SoundStreamEnd(SoundStream&);
 
 
 /* Starts a sample playing. If the sample is not loaded in the cache, it will
@@ -0,0 +1,100 @@
+#include "SoundMix.h"
+
+#include <algorithm>
+#include <stdint.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#	define SOUND_MIX_SSE2
+#	include <emmintrin.h>
+#elif defined __ARM_NEON
+#	define SOUND_MIX_NEON
+#	include <arm_neon.h>
+#endif
+
+
+void SoundMixChannelScalar(INT32* const mix, const INT16* const src, UINT32 const frames, INT32 const vol_l, INT32 const vol_r)
+{
+	for (UINT32 i = 0; i < frames; ++i)
+	{
+		mix[2 * i + 0] += src[2 * i + 0] * vol_l >> 7;
+		mix[2 * i + 1] += src[2 * i + 1] * vol_r >> 7;
+	}
+}
+
+
+void SoundMixChannel(INT32* const mix, const INT16* const src, UINT32 const frames, INT32 const vol_l, INT32 const vol_r)
+{
+	UINT32 const values = frames * 2;
+	UINT32       i      = 0;
+#if defined SOUND_MIX_SSE2
+	// The volumes fit into 16 bit, so the low and high halves of the 16 bit
+	// products together are the exact 32 bit products
+	__m128i const vol = _mm_set_epi16(vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l);
+	for (; i + 8 <= values; i += 8)
+	{
+		__m128i const s  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		__m128i const lo = _mm_mullo_epi16(s, vol);
+		__m128i const hi = _mm_mulhi_epi16(s, vol);
+		__m128i const p0 = _mm_srai_epi32(_mm_unpacklo_epi16(lo, hi), 7);
+		__m128i const p1 = _mm_srai_epi32(_mm_unpackhi_epi16(lo, hi), 7);
+		__m128i* const m = reinterpret_cast<__m128i*>(mix + i);
+		_mm_storeu_si128(m,     _mm_add_epi32(_mm_loadu_si128(m),     p0));
+		_mm_storeu_si128(m + 1, _mm_add_epi32(_mm_loadu_si128(m + 1), p1));
+	}
+#elif defined SOUND_MIX_NEON
+	int16_t const   vols[4] = { (int16_t)vol_l, (int16_t)vol_r, (int16_t)vol_l, (int16_t)vol_r };
+	int16x4_t const vol     = vld1_s16(vols);
+	for (; i + 8 <= values; i += 8)
+	{
+		int16x8_t const s  = vld1q_s16(src + i);
+		int32x4_t const p0 = vshrq_n_s32(vmull_s16(vget_low_s16(s),  vol), 7);
+		int32x4_t const p1 = vshrq_n_s32(vmull_s16(vget_high_s16(s), vol), 7);
+		vst1q_s32(mix + i,     vaddq_s32(vld1q_s32(mix + i),     p0));
+		vst1q_s32(mix + i + 4, vaddq_s32(vld1q_s32(mix + i + 4), p1));
+	}
+#endif
+	SoundMixChannelScalar(mix + i, src + i, (values - i) / 2, vol_l, vol_r);
+}
+
+
+void SoundMixChannelRamp(INT32* const mix, const INT16* const src, UINT32 const frames, INT32 const from_l, INT32 const from_r, INT32 const to_l, INT32 const to_r)
+{
+	UINT32 const steps = (frames + SOUND_MIX_RAMP_FRAMES - 1) / SOUND_MIX_RAMP_FRAMES;
+	for (UINT32 step = 0; step < steps; ++step)
+	{
+		INT32  const vol_l = from_l + (to_l - from_l) * INT32(step + 1) / INT32(steps);
+		INT32  const vol_r = from_r + (to_r - from_r) * INT32(step + 1) / INT32(steps);
+		UINT32 const first = step * SOUND_MIX_RAMP_FRAMES;
+		UINT32 const n     = std::min<UINT32>(SOUND_MIX_RAMP_FRAMES, frames - first);
+		SoundMixChannel(mix + 2 * first, src + 2 * first, n, vol_l, vol_r);
+	}
+}
+
+
+void SoundMixClipScalar(INT16* const dst, const INT32* const mix, UINT32 const values)
+{
+	for (UINT32 i = 0; i < values; ++i)
+	{
+		dst[i] = (INT16)std::clamp<INT32>(mix[i], INT16_MIN, INT16_MAX);
+	}
+}
+
+
+void SoundMixClip(INT16* const dst, const INT32* const mix, UINT32 const values)
+{
+	UINT32 i = 0;
+#if defined SOUND_MIX_SSE2
+	for (; i + 8 <= values; i += 8)
+	{
+		__m128i const a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mix + i));
+		__m128i const b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mix + i + 4));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(a, b));
+	}
+#elif defined SOUND_MIX_NEON
+	for (; i + 8 <= values; i += 8)
+	{
+		vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(vld1q_s32(mix + i)), vqmovn_s32(vld1q_s32(mix + i + 4))));
+	}
+#endif
+	SoundMixClipScalar(dst + i, mix + i, values - i);
+}
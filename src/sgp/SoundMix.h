@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Types.h"
+
+/* Mixing kernels of the sound manager. Sound data is interleaved 16 bit
+ * stereo, it is mixed into 32 bit sums with volumes of 0-127 per side. SSE2
+ * or NEON is used when the compiler targets it; the scalar versions give the
+ * same results bit for bit. */
+
+// Number of frames that are mixed with the same volumes while ramping
+#define SOUND_MIX_RAMP_FRAMES 8
+
+// Adds frames of src at the given volumes to mix
+void SoundMixChannel(INT32* mix, const INT16* src, UINT32 frames, INT32 vol_l, INT32 vol_r);
+void SoundMixChannelScalar(INT32* mix, const INT16* src, UINT32 frames, INT32 vol_l, INT32 vol_r);
+
+/* Like SoundMixChannel(), but the volumes move from the from_ to the to_
+ * values over the frames, in steps of SOUND_MIX_RAMP_FRAMES frames. The last
+ * step uses the to_ values. */
+void SoundMixChannelRamp(INT32* mix, const INT16* src, UINT32 frames, INT32 from_l, INT32 from_r, INT32 to_l, INT32 to_r);
+
+// Saturates the mixed values to 16 bit
+void SoundMixClip(INT16* dst, const INT32* mix, UINT32 values);
+void SoundMixClipScalar(INT16* dst, const INT32* mix, UINT32 values);
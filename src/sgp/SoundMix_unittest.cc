@@ -0,0 +1,136 @@
+#include "SoundMix.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+
+// The mixing loop of the sound callback before it used the kernels
+static void ReferenceMix(std::vector<INT32>& mix, const std::vector<INT16>& src, INT32 vol_l, INT32 vol_r)
+{
+	for (size_t i = 0; i < src.size() / 2; ++i)
+	{
+		mix[2 * i + 0] += src[2 * i + 0] * vol_l >> 7;
+		mix[2 * i + 1] += src[2 * i + 1] * vol_r >> 7;
+	}
+}
+
+
+static std::vector<INT16> RandomSamples(std::mt19937& rng, size_t frames)
+{
+	std::uniform_int_distribution<INT32> dist(INT16_MIN, INT16_MAX);
+	std::vector<INT16> v(frames * 2);
+	for (INT16& s : v) s = (INT16)dist(rng);
+	return v;
+}
+
+
+TEST(SoundMix, mixMatchesReference)
+{
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<INT32> vol(0, 127);
+	for (UINT32 frames : { 0, 1, 3, 4, 7, 64, 1023 })
+	{
+		std::vector<INT32> expected(frames * 2, 0);
+		std::vector<INT32> mixed(frames * 2, 0);
+		for (int channel = 0; channel < 8; ++channel)
+		{
+			std::vector<INT16> const src   = RandomSamples(rng, frames);
+			INT32              const vol_l = channel == 0 ? 127 : vol(rng);
+			INT32              const vol_r = channel == 0 ? 0   : vol(rng);
+			ReferenceMix(expected, src, vol_l, vol_r);
+			SoundMixChannel(mixed.data(), src.data(), frames, vol_l, vol_r);
+		}
+		EXPECT_EQ(mixed, expected);
+	}
+}
+
+
+TEST(SoundMix, clipMatchesReference)
+{
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<INT32> dist(4 * INT16_MIN, 4 * INT16_MAX);
+	std::vector<INT32> mix(1027);
+	for (INT32& v : mix) v = dist(rng);
+	mix[0] = INT16_MAX;
+	mix[1] = INT16_MIN;
+	mix[2] = INT16_MAX + 1;
+	mix[3] = INT16_MIN - 1;
+
+	std::vector<INT16> expected(mix.size());
+	for (size_t i = 0; i < mix.size(); ++i)
+	{
+		if (mix[i] >= INT16_MAX)      expected[i] = INT16_MAX;
+		else if (mix[i] <= INT16_MIN) expected[i] = INT16_MIN;
+		else                          expected[i] = (INT16)mix[i];
+	}
+
+	std::vector<INT16> clipped(mix.size());
+	SoundMixClip(clipped.data(), mix.data(), (UINT32)mix.size());
+	EXPECT_EQ(clipped, expected);
+}
+
+
+TEST(SoundMix, rampEndsAtTargetVolume)
+{
+	std::mt19937 rng(3);
+	UINT32             const frames = 100;
+	std::vector<INT16> const src    = RandomSamples(rng, frames);
+
+	// Without a change the ramp is the plain mix
+	std::vector<INT32> plain(frames * 2, 0);
+	std::vector<INT32> ramped(frames * 2, 0);
+	SoundMixChannel(plain.data(), src.data(), frames, 90, 30);
+	SoundMixChannelRamp(ramped.data(), src.data(), frames, 90, 30, 90, 30);
+	EXPECT_EQ(ramped, plain);
+
+	// The last block is mixed with the target volumes, the first not yet
+	std::vector<INT32> const silent(frames * 2, 0);
+	std::vector<INT32> up(frames * 2, 0);
+	SoundMixChannelRamp(up.data(), src.data(), frames, 0, 127, 127, 0);
+	UINT32 const last = (frames - 1) / SOUND_MIX_RAMP_FRAMES * SOUND_MIX_RAMP_FRAMES;
+	for (UINT32 i = last; i < frames; ++i)
+	{
+		EXPECT_EQ(up[2 * i + 0], src[2 * i + 0] * 127 >> 7);
+		EXPECT_EQ(up[2 * i + 1], 0);
+	}
+	for (UINT32 i = 0; i < SOUND_MIX_RAMP_FRAMES; ++i)
+	{
+		EXPECT_LT(std::abs(up[2 * i + 0]), std::abs(src[2 * i + 0] * 127 >> 7) / 4 + 1);
+	}
+}
+
+
+// Run with --gtest_also_run_disabled_tests to compare the kernels
+TEST(SoundMix, DISABLED_benchmark32Channels)
+{
+	std::mt19937 rng(1);
+	UINT32 const frames   = 1024;
+	UINT32 const channels = 32;
+	int    const rounds   = 2000;
+	std::vector<std::vector<INT16>> src;
+	for (UINT32 i = 0; i < channels; ++i) src.push_back(RandomSamples(rng, frames));
+	std::vector<INT32> mix(frames * 2);
+	std::vector<INT16> out(frames * 2);
+
+	auto const run = [&](auto mix_channel, auto clip)
+	{
+		auto const start = std::chrono::steady_clock::now();
+		for (int r = 0; r < rounds; ++r)
+		{
+			mix.assign(mix.size(), 0);
+			for (UINT32 c = 0; c < channels; ++c)
+			{
+				mix_channel(mix.data(), src[c].data(), frames, 100, 27 + c);
+			}
+			clip(out.data(), mix.data(), frames * 2);
+		}
+		std::chrono::duration<double, std::micro> const d = std::chrono::steady_clock::now() - start;
+		return d.count() / rounds;
+	};
+	double const scalar = run(SoundMixChannelScalar, SoundMixClipScalar);
+	double const simd   = run(SoundMixChannel,       SoundMixClip);
+	printf("32 channels x %u frames: scalar %.1fus, kernel %.1fus per callback\n", frames, scalar, simd);
+}
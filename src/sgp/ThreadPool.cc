@@ -0,0 +1,52 @@
+#include "ThreadPool.h"
+
+
+ThreadPool::ThreadPool(size_t numThreads) : m_stopping(false)
+{
+	if (numThreads == 0) numThreads = defaultSize();
+
+	m_workers.reserve(numThreads);
+	for (size_t i = 0; i < numThreads; ++i)
+	{
+		m_workers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+		m_tasks.clear();
+	}
+	m_condition.notify_all();
+	for (std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+
+size_t ThreadPool::defaultSize()
+{
+	size_t const n = std::thread::hardware_concurrency();
+	return n != 0 ? n : 2;
+}
+
+
+void ThreadPool::workerLoop()
+{
+	for (;;)
+	{
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+			if (m_stopping) return;
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		task();
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * A fixed set of worker threads executing queued tasks in FIFO order.
+ *
+ * Tasks must not touch game globals; they are meant for self-contained work
+ * like reading and parsing resources. Exceptions thrown by a task are stored
+ * in its future and rethrown on get(). Destroying the pool waits for running
+ * tasks to finish; tasks that have not started yet are dropped and their
+ * futures report std::future_errc::broken_promise.
+ */
+class ThreadPool
+{
+public:
+	/** Create a pool with numThreads workers, 0 means one per hardware thread. */
+	explicit ThreadPool(size_t numThreads = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/** Queue a task for execution on one of the workers. */
+	template<typename F>
+	std::future<std::invoke_result_t<F>> enqueue(F&& f)
+	{
+		using R = std::invoke_result_t<F>;
+		auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+		std::future<R> result = task->get_future();
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_tasks.emplace_back([task]() { (*task)(); });
+		}
+		m_condition.notify_one();
+		return result;
+	}
+
+	/** Number of worker threads. */
+	size_t size() const { return m_workers.size(); }
+
+	/** Number of worker threads used when none is specified. */
+	static size_t defaultSize();
+
+private:
+	void workerLoop();
+
+	std::vector<std::thread> m_workers;
+	std::deque<std::function<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_stopping;
+};
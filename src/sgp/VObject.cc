@@ -2,6 +2,7 @@
 #include "HImage.h"
 #include "MemMan.h"
 #include "FileMan.h"
+#include "ThreadPool.h"
 #include "VObject.h"
 #include "VObject_Blitters.h"
 #include "VSurface.h"
@@ -10,6 +11,7 @@
 #include <string_theory/string>
 
 #include <algorithm>
+#include <future>
 #include <iterator>
 #include <stdexcept>
 
@@ -277,6 +279,45 @@ SGPVObject* AddStandardVideoObjectFromFile(const ST::string& ImageFile)
 }
 
 
+// Workers for batch loads, started on first use
+static ThreadPool& ImageLoaderPool()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+
+#ifdef SGP_VIDEO_DEBUGGING
+static
+#endif
+void AddStandardVideoObjectsFromFiles(const std::vector<VideoObjectFile>& files)
+{
+	// Reading and decoding the images does not touch any shared state
+	std::vector<std::future<AutoSGPImage>> images;
+	images.reserve(files.size());
+	for (const VideoObjectFile& f : files)
+	{
+		ST::string const file = f.file;
+		images.push_back(ImageLoaderPool().enqueue([file]() {
+			return AutoSGPImage(CreateImage(file, IMAGE_ALLIMAGEDATA));
+		}));
+	}
+
+	// Video objects are linked into the global list, so create them here
+	std::vector<AutoSGPVObject> objects;
+	objects.reserve(files.size());
+	for (std::future<AutoSGPImage>& image : images)
+	{
+		objects.emplace_back(AddStandardVideoObjectFromHImage(image.get().get()));
+	}
+
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		*files[i].target = objects[i].release();
+	}
+}
+
+
 void BltVideoObject(SGPVSurface* const dst, SGPVObject const* const src, UINT16 const usRegionIndex, INT32 const iDestX, INT32 const iDestY)
 {
 	Assert(src->BPP() ==  8);
@@ -439,6 +480,16 @@ SGPVObject* AddAndRecordVObjectFromFile(const char* ImageFile, UINT32 uiLineNum,
 }
 
 
+void AddAndRecordVObjectsFromFiles(UINT32 uiLineNum, const char* pSourceFile, const std::vector<VideoObjectFile>& files)
+{
+	AddStandardVideoObjectsFromFiles(files);
+	for (const VideoObjectFile& f : files)
+	{
+		RecordVObject(*f.target, f.file.c_str(), uiLineNum, pSourceFile);
+	}
+}
+
+
 void PerformVideoInfoDumpIntoFile(const char* filename, BOOLEAN fAppend)
 {
 	DumpVObjectInfoIntoFile(filename, fAppend);
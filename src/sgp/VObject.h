@@ -3,7 +3,11 @@
 
 #include "Buffer.h"
 #include "Types.h"
+
+#include <string_theory/string>
+
 #include <memory>
+#include <vector>
 
 
 // Defines for HVOBJECT limits
@@ -99,20 +103,35 @@ void InitializeVideoObjectManager(void);
 // Deletes any video object placed into list
 void ShutdownVideoObjectManager(void);
 
-// Creates and adds a video object to list
+// One entry of a batch load: the loaded video object is stored in *target
+struct VideoObjectFile
+{
+	SGPVObject** target;
+	ST::string   file;
+};
+
+/* Creates and adds a video object to list.
+ * Batch loads are read and decoded concurrently, the video objects themselves
+ * are created in the order given. If any file fails to load, the objects
+ * created so far are deleted again and the error is rethrown, leaving all
+ * targets untouched. */
 #ifdef SGP_VIDEO_DEBUGGING
 extern UINT32 guiVObjectSize;
 
 	void PerformVideoInfoDumpIntoFile(const ST::string& filename, BOOLEAN fAppend);
 	SGPVObject* AddAndRecordVObjectFromHImage(SGPImage*, UINT32 uiLineNum, const ST::string& pSourceFile);
 	SGPVObject* AddAndRecordVObjectFromFile(const ST::string& ImageFile, UINT32 uiLineNum, const ST::string& pSourceFile);
+	void AddAndRecordVObjectsFromFiles(UINT32 uiLineNum, const ST::string& pSourceFile, const std::vector<VideoObjectFile>& files);
 	#define AddVideoObjectFromHImage(a) AddAndRecordVObjectFromHImage(a, __LINE__, __FILE__)
 	#define AddVideoObjectFromFile(a)   AddAndRecordVObjectFromFile(  a, __LINE__, __FILE__)
+	#define AddVideoObjectsFromFiles(...) AddAndRecordVObjectsFromFiles(__LINE__, __FILE__, __VA_ARGS__)
 #else
 	SGPVObject* AddStandardVideoObjectFromHImage(SGPImage*);
 	SGPVObject* AddStandardVideoObjectFromFile(const ST::string& ImageFile);
+	void AddStandardVideoObjectsFromFiles(const std::vector<VideoObjectFile>& files);
 	#define AddVideoObjectFromHImage(a) AddStandardVideoObjectFromHImage(a)
 	#define AddVideoObjectFromFile(a)   AddStandardVideoObjectFromFile(a)
+	#define AddVideoObjectsFromFiles(...) AddStandardVideoObjectsFromFiles(__VA_ARGS__)
 #endif
 
 // Removes a video object